@@ -410,6 +410,37 @@ TEST("require that fast forest evaluation is correct for all tree size categorie
     }
 }
 
+TEST("require that fast forest batch evaluation matches single evaluation") {
+    std::mt19937 gen(5489u);
+    std::uniform_real_distribution<float> dist(0.0, 1.0);
+    for (size_t tree_size: std::vector<size_t>({7,15,30,61,127})) {
+        vespalib::string expression = Model().max_features(35).less_percent(100).invert_percent(50).make_forest(67, tree_size);
+        auto function = Function::parse(expression);
+        auto forest = FastForest::try_convert(*function);
+        if ((tree_size <= 64) || is_little_endian()) {
+            ASSERT_TRUE(forest);
+            TEST_STATE(forest->impl_name().c_str());
+            size_t num_params = function->num_params();
+            for (size_t num_docs: std::vector<size_t>({1, 16, 37})) {
+                std::vector<float> columns(num_params * num_docs);
+                for (size_t i = 0; i < columns.size(); ++i) {
+                    columns[i] = ((i % 7) == 3) ? std::numeric_limits<float>::quiet_NaN() : dist(gen);
+                }
+                auto ctx = forest->create_context();
+                std::vector<double> results(num_docs, 31212.0);
+                forest->eval_batch(*ctx, &columns[0], num_docs, &results[0]);
+                for (size_t doc = 0; doc < num_docs; ++doc) {
+                    std::vector<float> row(num_params);
+                    for (size_t i = 0; i < num_params; ++i) {
+                        row[i] = columns[(i * num_docs) + doc];
+                    }
+                    EXPECT_EQUAL(results[doc], forest->eval(*ctx, &row[0]));
+                }
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 TEST("require that GDBT expressions can be detected") {
@@ -8,6 +8,7 @@
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <arpa/inet.h>
 
 namespace vespalib::eval::gbdt {
@@ -143,10 +144,34 @@ template <> vespalib::string fixed_impl_name<uint64_t>() { return "ff-fixed<64>"
 template <typename T>
 constexpr size_t max_leafs() { return (sizeof(T) * bits_per_byte); }
 
+// number of documents evaluated side by side when evaluating a batch
+constexpr size_t batch_lanes = 8;
+
+using BatchLimits = float __attribute__((vector_size(batch_lanes * sizeof(float))));
+using BatchSelect = int32_t __attribute__((vector_size(batch_lanes * sizeof(int32_t))));
+
+// one mask per lane for a single tree
+template <typename T> struct BatchMasks;
+#define VESPA_FF_BATCH_MASKS(T, S)                                                           \
+    template <> struct BatchMasks<T> {                                                       \
+        using Select = S __attribute__((vector_size(batch_lanes * sizeof(S))));              \
+        using Bits = T __attribute__((vector_size(batch_lanes * sizeof(T))));                \
+        static void convert(const BatchSelect &select, Bits &bits) {                         \
+            bits = (Bits)__builtin_convertvector(select, Select);                            \
+        }                                                                                    \
+    }
+VESPA_FF_BATCH_MASKS(uint8_t, int8_t);
+VESPA_FF_BATCH_MASKS(uint16_t, int16_t);
+VESPA_FF_BATCH_MASKS(uint32_t, int32_t);
+VESPA_FF_BATCH_MASKS(uint64_t, int64_t);
+#undef VESPA_FF_BATCH_MASKS
+
 template <typename T>
 struct FixedContext : FastForest::Context {
+    using BatchBits = typename BatchMasks<T>::Bits;
     std::vector<T> masks;
-    FixedContext(size_t num_trees) : masks(num_trees) {}
+    std::vector<BatchBits> batch_masks;
+    FixedContext(size_t num_trees) : masks(num_trees), batch_masks() {}
 };
 
 template <typename T>
@@ -197,9 +222,15 @@ struct FixedForest : FastForest {
     static void apply_masks(T *ctx_masks, const DMask *pos, const DMask *end);
     double get_result(const T *ctx_masks) const;
 
+    using BatchBits = typename BatchMasks<T>::Bits;
+    static void apply_batch_masks(BatchBits *ctx_masks, const Mask *pos, const Mask *end, const BatchLimits &limits, float max_limit);
+    static void apply_batch_masks(BatchBits *ctx_masks, const DMask *pos, const DMask *end, const BatchBits &select);
+    void get_batch_result(const BatchBits *ctx_masks, size_t num_docs, double *results) const;
+
     vespalib::string impl_name() const override { return fixed_impl_name<T>(); }
     Context::UP create_context() const override;
     double eval(Context &context, const float *params) const override;
+    void eval_batch(Context &context, const float *params, size_t num_docs, double *results) const override;
 };
 
 template <typename T>
@@ -306,6 +337,59 @@ FixedForest<T>::get_result(const T *ctx_masks) const
     return (result1 + result2);
 }
 
+// Batch state has one vector of masks per tree, with one mask for
+// each document. Comparisons are turned into select masks, letting
+// all documents be updated using simd instructions without branching.
+
+template <typename T>
+void
+FixedForest<T>::apply_batch_masks(BatchBits *ctx_masks, const Mask *pos, const Mask *end, const BatchLimits &limits, float max_limit)
+{
+    BatchBits select;
+    for (; (pos < end) && !(max_limit < pos->value); ++pos) {
+        // NaN limits never select a mask
+        BatchMasks<T>::convert(limits >= pos->value, select);
+        ctx_masks[pos->tree] &= (pos->bits | ~select);
+    }
+}
+
+template <typename T>
+void
+FixedForest<T>::apply_batch_masks(BatchBits *ctx_masks, const DMask *pos, const DMask *end, const BatchBits &select)
+{
+    for (; pos < end; ++pos) {
+        ctx_masks[pos->tree] &= (pos->bits | ~select);
+    }
+}
+
+template <typename T>
+void
+FixedForest<T>::get_batch_result(const BatchBits *ctx_masks, size_t num_docs, double *results) const
+{
+    // same summation order as get_result to produce identical results
+    double result1[batch_lanes] = {};
+    double result2[batch_lanes] = {};
+    const BatchBits *ctx_end = (ctx_masks + _num_trees);
+    const float *leafs = &_padded_leafs[0];
+    size_t leaf_cnt = _max_leafs;
+    for (; (ctx_masks + 3) < ctx_end; ctx_masks += 4, leafs += (leaf_cnt * 4)) {
+        for (size_t lane = 0; lane < batch_lanes; ++lane) {
+            result1[lane] += leafs[(0 * leaf_cnt) + get_lsb(T(ctx_masks[0][lane]))];
+            result2[lane] += leafs[(1 * leaf_cnt) + get_lsb(T(ctx_masks[1][lane]))];
+            result1[lane] += leafs[(2 * leaf_cnt) + get_lsb(T(ctx_masks[2][lane]))];
+            result2[lane] += leafs[(3 * leaf_cnt) + get_lsb(T(ctx_masks[3][lane]))];
+        }
+    }
+    for (; ctx_masks < ctx_end; ++ctx_masks, leafs += leaf_cnt) {
+        for (size_t lane = 0; lane < batch_lanes; ++lane) {
+            result1[lane] += leafs[get_lsb(T((*ctx_masks)[lane]))];
+        }
+    }
+    for (size_t lane = 0; lane < num_docs; ++lane) {
+        results[lane] = (result1[lane] + result2[lane]);
+    }
+}
+
 template <typename T>
 FastForest::Context::UP
 FixedForest<T>::create_context() const
@@ -335,13 +419,58 @@ FixedForest<T>::eval(Context &context, const float *params) const
     return get_result(ctx_masks);
 }
 
+template <typename T>
+void
+FixedForest<T>::eval_batch(Context &context, const float *params, size_t num_docs, double *results) const
+{
+    auto &batch_masks = static_cast<FixedContext<T>&>(context).batch_masks;
+    batch_masks.resize(_num_trees);
+    BatchBits *ctx_masks = &batch_masks[0];
+    for (size_t offset = 0; offset < num_docs; offset += batch_lanes) {
+        size_t num_lanes = std::min(batch_lanes, num_docs - offset);
+        memset(ctx_masks, 0xff, _num_trees * sizeof(BatchBits));
+        const Mask *mask_pos = &_masks[0];
+        for (size_t i = 0; i < _mask_sizes.size(); ++i) {
+            const float *column = params + (i * num_docs) + offset;
+            BatchLimits limits;
+            float max_limit = -std::numeric_limits<float>::infinity();
+            bool has_value = false;
+            bool has_nan = false;
+            for (size_t lane = 0; lane < batch_lanes; ++lane) {
+                // unused lanes are treated as missing values
+                limits[lane] = (lane < num_lanes) ? column[lane] : std::numeric_limits<float>::quiet_NaN();
+                if (!std::isnan(limits[lane])) {
+                    has_value = true;
+                    max_limit = std::max(max_limit, limits[lane]);
+                } else if (lane < num_lanes) {
+                    has_nan = true;
+                }
+            }
+            if (has_value) {
+                apply_batch_masks(ctx_masks, mask_pos, mask_pos + _mask_sizes[i], limits, max_limit);
+            }
+            if (has_nan) {
+                BatchBits nan_select;
+                BatchMasks<T>::convert(limits != limits, nan_select);
+                apply_batch_masks(ctx_masks,
+                                  &_default_masks[_default_offsets[i]],
+                                  &_default_masks[_default_offsets[i + 1]],
+                                  nan_select);
+            }
+            mask_pos += _mask_sizes[i];
+        }
+        get_batch_result(ctx_masks, num_lanes, results + offset);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // implementation using multiple words for each tree
 //-----------------------------------------------------------------------------
 
 struct MultiWordContext : FastForest::Context {
     std::vector<uint32_t> words;
-    MultiWordContext(size_t size) : words(size) {}
+    std::vector<float> params;
+    MultiWordContext(size_t size) : words(size), params() {}
 };
 
 struct MultiWordForest : FastForest {
@@ -440,6 +569,7 @@ struct MultiWordForest : FastForest {
     vespalib::string impl_name() const override { return "ff-multiword"; }
     Context::UP create_context() const override;
     double eval(Context &context, const float *params) const override;
+    void eval_batch(Context &context, const float *params, size_t num_docs, double *results) const override;
 };
 
 MultiWordForest::MultiWordForest(const State &state)
@@ -620,6 +750,20 @@ MultiWordForest::eval(Context &context, const float *params) const
     return get_result(ctx_words);
 }
 
+void
+MultiWordForest::eval_batch(Context &context, const float *params, size_t num_docs, double *results) const
+{
+    // large trees are evaluated one document at a time
+    auto &row = static_cast<MultiWordContext&>(context).params;
+    row.resize(_mask_sizes.size());
+    for (size_t doc = 0; doc < num_docs; ++doc) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            row[i] = params[(i * num_docs) + doc];
+        }
+        results[doc] = eval(context, &row[0]);
+    }
+}
+
 }
 
 //-----------------------------------------------------------------------------
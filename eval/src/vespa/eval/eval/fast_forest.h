@@ -36,6 +36,14 @@ public:
     virtual vespalib::string impl_name() const = 0;
     virtual Context::UP create_context() const = 0;
     virtual double eval(Context &context, const float *params) const = 0;
+    /**
+     * Evaluate the forest for a block of documents. Parameters are
+     * stored column-major; parameter i for document d is found at
+     * params[(i * num_docs) + d]. The result for document d is
+     * written to results[d] and is identical to what eval would
+     * produce for the same parameters.
+     **/
+    virtual void eval_batch(Context &context, const float *params, size_t num_docs, double *results) const = 0;
     double estimate_cost_us(const std::vector<double> &params, double budget = 5.0) const;
 };
 
@@ -12,13 +12,16 @@
 #include <vespa/searchlib/attribute/attribute_read_guard.h>
 #include <vespa/searchlib/attribute/attributefactory.h>
 #include <vespa/searchlib/attribute/bitvector_search_cache.h>
+#include <vespa/searchlib/attribute/filter_bitvector_cache.h>
 #include <vespa/searchlib/attribute/imported_attribute_vector.h>
 #include <vespa/searchlib/attribute/imported_attribute_vector_factory.h>
 #include <vespa/searchlib/attribute/interlock.h>
 #include <vespa/searchlib/attribute/predicate_attribute.h>
+#include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/predicate/predicate_hash.h>
 #include <vespa/searchlib/predicate/predicate_index.h>
+#include <vespa/searchlib/query/query_term_simple.h>
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
 #include <vespa/searchlib/tensor/tensor_attribute.h>
 #include <vespa/searchlib/test/directory_handler.h>
@@ -1007,6 +1010,62 @@ TEST_F(AttributeWriterTest, forceCommit_clears_search_cache_in_imported_attribut
     EXPECT_EQ(0u, _mgr->getImportedAttributes()->get("imported_b")->getSearchCache()->size());
 }
 
+TEST_F(AttributeWriterTest, feed_keeps_filter_bit_vector_cache_up_to_date)
+{
+    DocBuilder db([](auto& header) { header.addField("a1", DataType::T_INT); });
+    auto a1 = addAttribute({"a1", AVConfig(AVBasicType::INT32).set_filter_cache_min_lookups(1)});
+    allocAttributeWriter();
+    auto make_doc = [&db](const vespalib::string& id, int32_t value) {
+        auto doc = db.make_document(id);
+        doc->setValue("a1", IntFieldValue(value));
+        return doc;
+    };
+    QueryTermSimple term("5", QueryTermSimple::Type::WORD);
+    auto& cache = a1->get_filter_cache();
+    put(1, *make_doc("id:ns:searchdocument::1", 5), 1);
+    put(2, *make_doc("id:ns:searchdocument::2", 7), 2);
+    EXPECT_FALSE(cache.lookup(term));
+    commit(3);
+    auto entry = cache.lookup(term);
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(1u, entry->bit_vector().countTrueBits());
+    EXPECT_TRUE(entry->bit_vector().testBit(1));
+    EXPECT_EQ(3u, entry->doc_id_limit());
+    put(4, *make_doc("id:ns:searchdocument::3", 5), 3);
+    EXPECT_TRUE(entry->bit_vector().testBit(3));
+    EXPECT_EQ(4u, entry->doc_id_limit());
+    put(5, *make_doc("id:ns:searchdocument::2", 5), 2);
+    remove(6, 1);
+    EXPECT_FALSE(entry->bit_vector().testBit(1));
+    EXPECT_TRUE(entry->bit_vector().testBit(2));
+    EXPECT_EQ(2u, entry->bit_vector().countTrueBits());
+}
+
+TEST_F(AttributeWriterTest, commit_due_to_large_change_vector_keeps_filter_bit_vector_cache_up_to_date)
+{
+    DocBuilder db([](auto& header) { header.addField("a1", DataType::T_INT); });
+    auto a1 = addAttribute({"a1", AVConfig(AVBasicType::INT32).set_filter_cache_min_lookups(1).setMaxUnCommittedMemory(1)});
+    allocAttributeWriter();
+    auto make_doc = [&db](const vespalib::string& id, int32_t value) {
+        auto doc = db.make_document(id);
+        doc->setValue("a1", IntFieldValue(value));
+        return doc;
+    };
+    QueryTermSimple term("5", QueryTermSimple::Type::WORD);
+    auto& cache = a1->get_filter_cache();
+    put(1, *make_doc("id:ns:searchdocument::1", 5), 1);
+    EXPECT_FALSE(cache.lookup(term));
+    commit(2);
+    auto entry = cache.lookup(term);
+    ASSERT_TRUE(entry);
+    EXPECT_TRUE(entry->bit_vector().testBit(1));
+    // No writer commit, the attribute is committed because its change vector is too large.
+    _aw->put(3, *make_doc("id:ns:searchdocument::2", 5), 2, emptyCallback);
+    EXPECT_EQ(5, a1->getInt(2));
+    EXPECT_TRUE(entry->bit_vector().testBit(2));
+    EXPECT_EQ(2u, entry->bit_vector().countTrueBits());
+}
+
 TEST_F(AttributeWriterTest, ignores_force_commit_serial_not_greater_than_create_serial)
 {
     auto a1 = addAttribute("a1");
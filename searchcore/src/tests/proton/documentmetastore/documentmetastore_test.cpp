@@ -921,6 +921,27 @@ TEST(DocumentMetaStoreTest, removed_lids_are_cleared_as_active)
     EXPECT_EQ(2u, f.dms.getNumActiveLids());
 }
 
+TEST(DocumentMetaStoreTest, lid_state_generation_is_bumped_when_active_or_valid_lids_change)
+{
+    UserDocFixture f;
+    f.dms.constructFreeList();
+    uint64_t gen = f.dms.get_lid_state_generation();
+    f.addGlobalIds(2);
+    EXPECT_LT(gen, f.dms.get_lid_state_generation());
+    gen = f.dms.get_lid_state_generation();
+    f.dms.setBucketState(f.bid1, true);
+    EXPECT_LT(gen, f.dms.get_lid_state_generation());
+    gen = f.dms.get_lid_state_generation();
+    f.dms.setBucketState(f.bid1, false);
+    EXPECT_LT(gen, f.dms.get_lid_state_generation());
+    gen = f.dms.get_lid_state_generation();
+    f.dms.populateActiveBuckets({ f.bid1 });
+    EXPECT_LT(gen, f.dms.get_lid_state_generation());
+    gen = f.dms.get_lid_state_generation();
+    f.dms.remove(2, 0u);
+    EXPECT_LT(gen, f.dms.get_lid_state_generation());
+}
+
 TEST(DocumentMetaStoreTest, whitelist_blueprint_is_created)
 {
     UserDocFixture f;
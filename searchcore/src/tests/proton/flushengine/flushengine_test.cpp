@@ -3,6 +3,7 @@
 #include <vespa/searchcore/proton/flushengine/active_flush_stats.h>
 #include <vespa/searchcore/proton/flushengine/cachedflushtarget.h>
 #include <vespa/searchcore/proton/flushengine/flush_engine_explorer.h>
+#include <vespa/searchcore/proton/flushengine/flush_write_budget.h>
 #include <vespa/searchcore/proton/flushengine/flushengine.h>
 #include <vespa/searchcore/proton/flushengine/i_tls_stats_factory.h>
 #include <vespa/searchcore/proton/flushengine/threadedflushtarget.h>
@@ -13,6 +14,7 @@
 #include <vespa/searchlib/common/flush_token.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/test/insertion_operators.h>
+#include <vespa/vespalib/util/size_literals.h>
 #include <mutex>
 #include <thread>
 #include <vespa/vespalib/testkit/test_kit.h>
@@ -899,6 +901,34 @@ TEST("the oldest start time is tracked per flush handler in ActiveFlushStats")
     EXPECT_EQUAL(t1, stats.oldest_start_time("h1").value());
 }
 
+TEST("flush write budget is refilled at configured bandwidth up to burst size")
+{
+    using seconds = std::chrono::seconds;
+    vespalib::steady_time now = vespalib::steady_clock::now();
+    FlushWriteBudget budget;
+    EXPECT_FALSE(budget.enabled());
+    EXPECT_TRUE(budget.can_afford(1_Gi, now));
+    budget.consume(1_Gi, now);
+    EXPECT_EQUAL(1_Gi, budget.get_stats(now).consumed);
+    budget.set_limit(100_Mi, 1_Gi, now);
+    EXPECT_TRUE(budget.enabled());
+    EXPECT_EQUAL(int64_t(1_Gi), budget.get_stats(now).available);
+    // Flushes larger than the burst size can start when the budget is full
+    EXPECT_TRUE(budget.can_afford(2_Gi, now));
+    budget.consume(2_Gi, now);
+    EXPECT_EQUAL(-int64_t(1_Gi), budget.get_stats(now).available);
+    EXPECT_FALSE(budget.can_afford(1, now));
+    EXPECT_FALSE(budget.can_afford(0, now));
+    EXPECT_TRUE(budget.can_afford(0, now + seconds(11)));
+    EXPECT_FALSE(budget.can_afford(100_Mi, now + seconds(11)));
+    EXPECT_TRUE(budget.can_afford(100_Mi, now + seconds(12)));
+    auto stats = budget.get_stats(now + seconds(100));
+    EXPECT_EQUAL(int64_t(1_Gi), stats.available);
+    EXPECT_EQUAL(3_Gi, stats.consumed);
+    budget.note_deferred();
+    EXPECT_EQUAL(1u, budget.get_stats(now).deferred);
+}
+
 
 TEST_MAIN()
 {
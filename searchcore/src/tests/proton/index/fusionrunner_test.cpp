@@ -99,7 +99,7 @@ FusionRunnerTest::FusionRunnerTest()
       _fusion_spec(),
       _fileHeaderContext(),
       _service(1),
-      _ops(_fileHeaderContext,TuneFileIndexManager(), 0, _service.write())
+      _ops(_fileHeaderContext,TuneFileIndexManager(), 0, 0, 0, false, 1, 0, _service.write())
 { }
 
 FusionRunnerTest::~FusionRunnerTest() = default;
@@ -327,6 +327,21 @@ TEST_F(FusionRunnerTest, require_that_selectors_can_be_rebased)
     checkResults(fusion_id, disk_id, 3);
 }
 
+TEST_F(FusionRunnerTest, require_that_fields_can_be_merged_in_partitions)
+{
+    IndexManager::MaintainerOperations partitioned_ops(_fileHeaderContext, TuneFileIndexManager(), 0, 0, 0, false,
+                                                       4, 1, _service.write());
+    createIndex(base_dir, disk_id[0]);
+    createIndex(base_dir, disk_id[1]);
+    createIndex(base_dir, disk_id[2]);
+    uint32_t fusion_id = _fusion_runner->fuse(_fusion_spec, 0u, partitioned_ops, std::make_shared<search::FlushToken>());
+    EXPECT_EQ(disk_id[2], fusion_id);
+    auto field_dir = std::filesystem::path(getFusionIndexName(fusion_id)) / field_name;
+    EXPECT_FALSE(std::filesystem::exists(field_dir / "partition1"));
+
+    checkResults(fusion_id, disk_id, 3);
+}
+
 TEST_F(FusionRunnerTest, require_that_fusion_can_be_stopped)
 {
     createIndex(base_dir, disk_id[0]);
@@ -287,4 +287,117 @@ TEST_MT_FF("require that the adaptive scheduler handles fewer documents than thr
 
 //-----------------------------------------------------------------------------
 
+TEST("require that the work-stealing scheduler starts by dividing the docid space equally") {
+    WorkStealingDocidRangeScheduler scheduler(4, 4, 16);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 15u);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 5)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(5, 9)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(9, 13)));
+    TEST_DO(verify_range(scheduler.first_range(3), DocidRange(13, 16)));
+    EXPECT_EQUAL(scheduler.total_size(0), 4u);
+    EXPECT_EQUAL(scheduler.total_size(3), 3u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+    EXPECT_TRUE(scheduler.make_idle_observer().is_always_zero());
+}
+
+TEST("require that the work-stealing scheduler hands out shrinking chunks respecting the minimal task size") {
+    WorkStealingDocidRangeScheduler scheduler(1, 2, 50);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 7)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(7, 12)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(12, 16)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(16, 20)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(20, 23)));
+    EXPECT_EQUAL(scheduler.unassigned_size(), 27u);
+    EXPECT_EQUAL(scheduler.total_size(0), 22u);
+}
+
+TEST("require that the work-stealing scheduler steals the back half of the largest remaining range") {
+    WorkStealingDocidRangeScheduler scheduler(3, 8, 49);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 9)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(9, 17)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(17, 25)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(41, 49)));
+    EXPECT_EQUAL(scheduler.unassigned_size(), 16u);
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(25, 33)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(33, 41)));
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange()));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 32u);
+    EXPECT_EQUAL(scheduler.total_size(1), 8u);
+    EXPECT_EQUAL(scheduler.total_size(2), 8u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+}
+
+TEST("require that the work-stealing scheduler steals small ranges as a whole") {
+    WorkStealingDocidRangeScheduler scheduler(2, 3, 11);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 4)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(4, 6)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(6, 9)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(9, 11)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 10u);
+    EXPECT_EQUAL(scheduler.total_size(1), 0u);
+}
+
+struct WorkTracker {
+    WorkStealingDocidRangeScheduler scheduler;
+    std::vector<std::atomic<uint32_t>> seen;
+    WorkTracker(size_t num_threads, uint32_t min_task, uint32_t docid_limit)
+        : scheduler(num_threads, min_task, docid_limit), seen(docid_limit) {}
+};
+
+TEST_MT_FF("require that the work-stealing scheduler assigns each docid exactly once",
+           8, WorkTracker(num_threads, 7, 100000), TimeBomb(60))
+{
+    size_t my_work = 0;
+    for (DocidRange docid_range = f1.scheduler.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.scheduler.next_range(thread_id))
+    {
+        for (uint32_t docid = docid_range.begin; docid < docid_range.end; ++docid) {
+            f1.seen[docid].fetch_add(1, std::memory_order_relaxed);
+        }
+        my_work += docid_range.size();
+    }
+    EXPECT_EQUAL(f1.scheduler.total_size(thread_id), my_work);
+    TEST_BARRIER();
+    if (thread_id == 0) {
+        EXPECT_EQUAL(f1.scheduler.unassigned_size(), 0u);
+        EXPECT_EQUAL(f1.seen[0].load(), 0u);
+        size_t bad_cnt = 0;
+        for (uint32_t docid = 1; docid < f1.seen.size(); ++docid) {
+            bad_cnt += (f1.seen[docid].load() != 1);
+        }
+        EXPECT_EQUAL(bad_cnt, 0u);
+    }
+}
+
+TEST_MT_FF("require that the work-stealing scheduler handles no documents",
+           4, WorkStealingDocidRangeScheduler(num_threads, 1, 1), TimeBomb(60))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        TEST_ERROR("no threads should get any work");
+    }
+    EXPECT_EQUAL(f1.total_size(thread_id), 0u);
+}
+
+TEST_MT_FF("require that the work-stealing scheduler handles fewer documents than threads",
+           4, WorkStealingDocidRangeScheduler(num_threads, 1, 3), TimeBomb(60))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        EXPECT_TRUE(docid_range.size() == 1);
+    }
+    TEST_BARRIER();
+    EXPECT_EQUAL(f1.total_size(0) + f1.total_size(1) + f1.total_size(2) + f1.total_size(3), 2u);
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
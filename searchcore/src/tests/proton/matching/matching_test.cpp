@@ -443,7 +443,10 @@ struct MyWorld {
     }
 
     SearchReply::UP performSearch(const SearchRequest & req, size_t threads) {
-        Matcher::SP matcher = createMatcher();
+        return performSearch(createMatcher(), req, threads);
+    }
+
+    SearchReply::UP performSearch(Matcher::SP matcher, const SearchRequest & req, size_t threads) {
         SearchSession::OwnershipBundle owned_objects({std::make_unique<MockAttributeContext>(),
                                                       std::make_unique<FakeSearchContext>()},
                                                      std::make_shared<MySearchHandler>(matcher));
@@ -936,6 +939,61 @@ TEST_F(MatchingTest, require_that_search_session_can_be_cached)
     EXPECT_EQ("a", session->getSessionId());
 }
 
+TEST_F(MatchingTest, require_that_query_result_cache_is_used_until_commit_generation_changes)
+{
+    MyWorld world(shared_state());
+    world.basicSetup();
+    world.basicResults();
+    world.config.add(QueryResultCacheMaxEntries::NAME, "10");
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "spread");
+    SearchReply::UP reply = world.performSearch(matcher, *request, 1);
+    EXPECT_EQ(9u, reply->hits.size());
+    auto stats = matcher->getQueryResultCacheStats();
+    EXPECT_EQ(0u, stats.numHits);
+    EXPECT_EQ(1u, stats.numInsert);
+    reply = world.performSearch(matcher, *request, 1);
+    EXPECT_EQ(9u, reply->hits.size());
+    EXPECT_EQ(9u, world.matchingStats.docsMatched());
+    stats = matcher->getQueryResultCacheStats();
+    EXPECT_EQ(1u, stats.numHits);
+    EXPECT_EQ(0u, stats.numInsert);
+    EXPECT_EQ(1u, stats.numCached);
+    SearchRequest::SP other_request = MyWorld::createSimpleRequest("f1", "spread");
+    other_request->maxhits = 5;
+    reply = world.performSearch(matcher, *other_request, 1);
+    EXPECT_EQ(5u, reply->hits.size());
+    stats = matcher->getQueryResultCacheStats();
+    EXPECT_EQ(0u, stats.numHits);
+    EXPECT_EQ(2u, stats.numCached);
+    world.searchContext.setCommitGeneration(1);
+    reply = world.performSearch(matcher, *request, 1);
+    EXPECT_EQ(9u, reply->hits.size());
+    EXPECT_EQ(27u, world.matchingStats.docsMatched());
+    stats = matcher->getQueryResultCacheStats();
+    EXPECT_EQ(0u, stats.numHits);
+    EXPECT_EQ(2u, stats.numInvalidated);
+    EXPECT_EQ(1u, stats.numCached);
+}
+
+TEST_F(MatchingTest, require_that_query_result_cache_is_not_used_for_cached_search_sessions)
+{
+    MyWorld world(shared_state());
+    world.basicSetup();
+    world.basicResults();
+    world.config.add(QueryResultCacheMaxEntries::NAME, "10");
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "spread");
+    request->propertiesMap.lookupCreate(search::MapNames::CACHES).add("query", "true");
+    request->sessionId.push_back('a');
+    world.performSearch(matcher, *request, 1);
+    world.performSearch(matcher, *request, 1);
+    auto stats = matcher->getQueryResultCacheStats();
+    EXPECT_EQ(0u, stats.numHits);
+    EXPECT_EQ(0u, stats.numCached);
+    EXPECT_EQ(18u, world.matchingStats.docsMatched());
+}
+
 TEST_F(MatchingTest, require_that_summary_features_can_be_renamed)
 {
     MyWorld world(shared_state());
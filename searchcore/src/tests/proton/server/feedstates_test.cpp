@@ -16,6 +16,7 @@
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/foreground_thread_executor.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/buffer.h>
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/testkit/test_master.hpp>
@@ -73,6 +74,7 @@ struct Fixture
     bucketdb::BucketDBHandler _bucketDBHandler;
     ReplayThrottlingPolicy _replay_throttling_policy;
     MyIncSerialNum _inc_serial_num;
+    vespalib::ThreadStackExecutor _decode_executor;
     ReplayTransactionLogState state;
 
     Fixture();
@@ -89,7 +91,9 @@ Fixture::Fixture()
       _bucketDBHandler(_bucketDB),
       _replay_throttling_policy({}),
       _inc_serial_num(9u),
-      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttling_policy, _inc_serial_num)
+      _decode_executor(4),
+      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttling_policy, _inc_serial_num,
+            _decode_executor)
 {
 }
 Fixture::~Fixture() = default;
@@ -126,6 +130,7 @@ TEST_F("require that active FeedView can change during replay", Fixture)
         RemoveOperationContext opCtx(10);
         auto wrap = std::make_shared<PacketWrapper>(*opCtx.packet, nullptr);
         f.state.receive(wrap, executor);
+        wrap->gate.await();
     }
     EXPECT_EQUAL(1, f.feed_view1.remove_handled);
     EXPECT_EQUAL(0, f.feed_view2.remove_handled);
@@ -134,11 +139,31 @@ TEST_F("require that active FeedView can change during replay", Fixture)
         RemoveOperationContext opCtx(11);
         auto wrap = std::make_shared<PacketWrapper>(*opCtx.packet, nullptr);
         f.state.receive(wrap, executor);
+        wrap->gate.await();
     }
     EXPECT_EQUAL(1, f.feed_view1.remove_handled);
     EXPECT_EQUAL(1, f.feed_view2.remove_handled);
 }
 
+TEST_F("require that packets decoded ahead of replay are replayed in order", Fixture)
+{
+    vespalib::ThreadStackExecutor executor(1);
+    std::vector<std::unique_ptr<RemoveOperationContext>> opCtxs;
+    std::vector<std::shared_ptr<PacketWrapper>> wraps;
+    for (SerialNum serial = 10; serial < 20; ++serial) {
+        opCtxs.push_back(std::make_unique<RemoveOperationContext>(serial));
+        wraps.push_back(std::make_shared<PacketWrapper>(*opCtxs.back()->packet, nullptr));
+        f.state.receive(wraps.back(), executor);
+    }
+    opCtxs.clear();
+    for (const auto &wrap : wraps) {
+        wrap->gate.await();
+        EXPECT_EQUAL(search::transactionlog::client::RPC::OK, wrap->result);
+    }
+    EXPECT_EQUAL(10, f.feed_view1.remove_handled);
+    EXPECT_EQUAL(19u, f._inc_serial_num._serial_num);
+}
+
 TEST_F("require that replay progress is tracked", Fixture)
 {
     RemoveOperationContext opCtx(10);
@@ -147,6 +172,7 @@ TEST_F("require that replay progress is tracked", Fixture)
     ForegroundThreadExecutor executor;
 
     f.state.receive(wrap, executor);
+    wrap->gate.await();
     EXPECT_EQUAL(10u, progress.getCurrent());
     EXPECT_EQUAL(0.5, progress.getProgress());
 }
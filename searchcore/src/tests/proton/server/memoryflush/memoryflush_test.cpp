@@ -2,6 +2,7 @@
 
 #include <vespa/searchcore/proton/flushengine/active_flush_stats.h>
 #include <vespa/searchcore/proton/flushengine/flushcontext.h>
+#include <vespa/searchcore/proton/flushengine/flush_write_budget.h>
 #include <vespa/searchcore/proton/flushengine/tls_stats_map.h>
 #include <vespa/searchcore/proton/server/memoryflush.h>
 #include <vespa/searchcore/proton/test/dummy_flush_target.h>
@@ -34,6 +35,7 @@ private:
     SerialNum     _flushedSerial;
     system_time  _lastFlushTime;
     bool          _urgentFlush;
+    uint64_t      _bytesToWrite;
 public:
     MyFlushTarget(const vespalib::string &name, MemoryGain memoryGain,
                   DiskGain diskGain, SerialNum flushedSerial,
@@ -43,7 +45,8 @@ public:
         _diskGain(diskGain),
         _flushedSerial(flushedSerial),
         _lastFlushTime(lastFlushTime),
-        _urgentFlush(urgentFlush)
+        _urgentFlush(urgentFlush),
+        _bytesToWrite(0)
     {
     }
     MemoryGain getApproxMemoryGain() const override { return _memoryGain; }
@@ -51,6 +54,8 @@ public:
     SerialNum getFlushedSerialNum() const override { return _flushedSerial; }
     system_time getLastFlushTime() const override { return _lastFlushTime; }
     bool needUrgentFlush() const override { return _urgentFlush; }
+    uint64_t getApproxBytesToWriteToDisk() const override { return _bytesToWrite; }
+    void setBytesToWrite(uint64_t bytesToWrite) { _bytesToWrite = bytesToWrite; }
 };
 
 using StringList = std::vector<vespalib::string>;
@@ -293,6 +298,114 @@ TEST(MemoryFlushTest, can_handle_large_serial_numbers_when_ordering_by_tls_size)
     assertOrder({"t2", "t1"}, cb.flush_targets(flush));
 }
 
+TEST(MemoryFlushTest, write_budget_defers_targets_not_needed_for_memory_tls_or_disk_bloat_pressure)
+{
+    system_time now(vespalib::system_clock::now());
+    system_time start(now - seconds(20));
+    auto t1 = std::make_shared<MyFlushTarget>("t1", MemoryGain(50, 0), DiskGain(), SerialNum(), now - seconds(15), false);
+    auto t2 = std::make_shared<MyFlushTarget>("t2", MemoryGain(10, 0), DiskGain(), SerialNum(), now - seconds(10), false);
+    auto t3 = std::make_shared<MyFlushTarget>("t3", MemoryGain(100, 0), DiskGain(), SerialNum(), system_time(), false);
+    t1->setBytesToWrite(1_Gi);
+    t2->setBytesToWrite(10_Mi);
+    t3->setBytesToWrite(1_Gi);
+    auto budget = std::make_shared<flushengine::FlushWriteBudget>();
+    budget->set_limit(1_Mi, 100_Mi, vespalib::steady_clock::now());
+    budget->consume(90_Mi, vespalib::steady_clock::now());
+    { // MAXAGE order, t1 deferred
+        ContextBuilder cb;
+        cb.add(t1).add(t2);
+        MemoryFlush flush({1000, 20_Gi, 1.0, 1000, 1.0, seconds(2)}, start);
+        assertOrder({"t1", "t2"}, cb.flush_targets(flush));
+        flush.set_write_budget(budget);
+        assertOrder({"t2"}, cb.flush_targets(flush));
+        EXPECT_EQ(1u, budget->get_stats(vespalib::steady_clock::now()).deferred);
+    }
+    { // MEMORY order, nothing deferred
+        ContextBuilder cb;
+        cb.add(t1).add(t2).add(t3);
+        MemoryFlush flush({1000, 20_Gi, 1.0, 20, 1.0, seconds(2)}, start);
+        flush.set_write_budget(budget);
+        assertOrder({"t3", "t1", "t2"}, cb.flush_targets(flush));
+    }
+    { // DISKBLOAT order, nothing deferred
+        auto t4 = std::make_shared<MyFlushTarget>("t4", MemoryGain(), DiskGain(100 * milli, 80 * milli), SerialNum(), now - seconds(15), false);
+        t4->setBytesToWrite(1_Gi);
+        ContextBuilder cb;
+        cb.add(t4);
+        MemoryFlush flush({1000, 20_Gi, 1.0, 1000, 0.19, seconds(30)}, start);
+        flush.set_write_budget(budget);
+        assertOrder({"t4"}, cb.flush_targets(flush));
+    }
+}
+
+TEST(MemoryFlushTest, write_budget_paces_memory_and_tls_pressure_until_hard_limit)
+{
+    system_time now(vespalib::system_clock::now());
+    system_time start(now - seconds(20));
+    auto t1 = std::make_shared<MyFlushTarget>("t1", MemoryGain(50, 0), DiskGain(), SerialNum(), now - seconds(15), false);
+    auto t2 = std::make_shared<MyFlushTarget>("t2", MemoryGain(10, 0), DiskGain(), SerialNum(), now - seconds(10), false);
+    t1->setBytesToWrite(1_Gi);
+    t2->setBytesToWrite(10_Mi);
+    auto budget = std::make_shared<flushengine::FlushWriteBudget>();
+    budget->set_limit(1_Mi, 100_Mi, vespalib::steady_clock::now());
+    budget->consume(90_Mi, vespalib::steady_clock::now());
+    { // MEMORY order below hard limit, t1 deferred
+        ContextBuilder cb;
+        cb.add(t1).add(t2);
+        MemoryFlush flush({1000, 20_Gi, 1.0, 30, 1.0, seconds(30)}, start);
+        assertOrder({"t1", "t2"}, cb.flush_targets(flush));
+        flush.set_write_budget(budget);
+        assertOrder({"t2"}, cb.flush_targets(flush));
+    }
+    { // MEMORY order above hard limit, nothing deferred
+        ContextBuilder cb;
+        cb.add(t1).add(t2);
+        MemoryFlush flush({1000, 20_Gi, 1.0, 30, 1.0, seconds(30)}, start);
+        budget->set_hard_limit_factor(1.5);
+        flush.set_write_budget(budget);
+        assertOrder({"t1", "t2"}, cb.flush_targets(flush));
+        budget->set_hard_limit_factor(2.0);
+    }
+    { // TLSSIZE order below hard limit, t1 deferred
+        ContextBuilder cb;
+        cb.addTls("myhandler", {30_Gi, 1, 100});
+        cb.add(t1, 100).add(t2, 100);
+        MemoryFlush flush({1000, 20_Gi, 1.0, 1000, 1.0, seconds(30)}, start);
+        flush.set_write_budget(budget);
+        assertOrder({"t2"}, cb.flush_targets(flush));
+    }
+    { // TLSSIZE order above hard limit, nothing deferred
+        ContextBuilder cb;
+        cb.addTls("myhandler", {50_Gi, 1, 100});
+        cb.add(t1, 100).add(t2, 100);
+        MemoryFlush flush({1000, 20_Gi, 1.0, 1000, 1.0, seconds(30)}, start);
+        flush.set_write_budget(budget);
+        assertOrder({"t1", "t2"}, cb.flush_targets(flush));
+    }
+}
+
+TEST(MemoryFlushTest, write_budget_is_spent_on_targets_with_highest_benefit_per_byte)
+{
+    system_time now(vespalib::system_clock::now());
+    system_time start(now - seconds(20));
+    auto t1 = std::make_shared<MyFlushTarget>("t1", MemoryGain(100_Mi, 0), DiskGain(), SerialNum(), now - seconds(15), false);
+    auto t2 = std::make_shared<MyFlushTarget>("t2", MemoryGain(40_Mi, 0), DiskGain(), SerialNum(), now - seconds(10), false);
+    auto t3 = std::make_shared<MyFlushTarget>("t3", MemoryGain(30_Mi, 0), DiskGain(), SerialNum(), now - seconds(10), false);
+    t1->setBytesToWrite(80_Mi);
+    t2->setBytesToWrite(10_Mi);
+    t3->setBytesToWrite(10_Mi);
+    auto budget = std::make_shared<flushengine::FlushWriteBudget>();
+    budget->set_limit(1_Mi, 100_Mi, vespalib::steady_clock::now());
+    budget->consume(70_Mi, vespalib::steady_clock::now());
+    ContextBuilder cb;
+    cb.add(t1).add(t2).add(t3);
+    MemoryFlush flush({1_Gi, 20_Gi, 1.0, 90_Mi, 1.0, seconds(30)}, start);
+    assertOrder({"t1", "t2", "t3"}, cb.flush_targets(flush));
+    flush.set_write_budget(budget);
+    // t1 frees most memory, but t2 and t3 free more memory per byte written and fit in the budget
+    assertOrder({"t2", "t3"}, cb.flush_targets(flush));
+}
+
 TEST(MemoryFlushTest, order_type_is_preserved)
 {
     system_time now(vespalib::system_clock::now());
@@ -137,6 +137,12 @@ convert_config_to_slime(const Config& cfg, bool full, Cursor& object)
             auto& hnsw = object.setObject("hnsw");
             hnsw.setLong("max_links_per_node", hnsw_cfg.max_links_per_node());
             hnsw.setLong("neighbors_to_explore_at_insert", hnsw_cfg.neighbors_to_explore_at_insert());
+            if (hnsw_cfg.quantization_subvectors() > 0) {
+                hnsw.setLong("quantization_subvectors", hnsw_cfg.quantization_subvectors());
+                hnsw.setBool("quantization_rerank", hnsw_cfg.quantization_rerank());
+                hnsw.setLong("quantization_training_size", hnsw_cfg.quantization_training_size());
+            }
+            hnsw.setBool("paged_links", hnsw_cfg.paged_links());
         }
     }
 }
@@ -12,6 +12,7 @@
 #include <vespa/searchcommon/attribute/attribute_utils.h>
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchcore/proton/common/attribute_updater.h>
+#include <vespa/searchlib/attribute/filter_bitvector_cache.h>
 #include <vespa/searchlib/attribute/imported_attribute_vector.h>
 #include <vespa/searchlib/tensor/prepare_result.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
@@ -166,6 +167,7 @@ applyPutToAttribute(SerialNum serialNum, const FieldValue::UP &fieldValue, Docum
     } else {
         attr.clearDoc(lid);
     }
+    attr.get_filter_cache().note_changed(lid);
     attr.commitIfChangeVectorTooLarge();
 }
 
@@ -209,6 +211,7 @@ complete_put_to_attribute(SerialNum serial_num,
     } else {
         attr.clearDoc(docid);
     }
+    attr.get_filter_cache().note_changed(docid);
 }
 
 void
@@ -217,6 +220,7 @@ applyRemoveToAttribute(SerialNum serialNum, DocumentIdT lid,
 {
     ensureLidSpace(serialNum, lid, attr);
     attr.clearDoc(lid);
+    attr.get_filter_cache().note_changed(lid);
 }
 
 void
@@ -225,6 +229,7 @@ applyUpdateToAttribute(SerialNum serialNum, const FieldUpdate &fieldUpd,
 {
     ensureLidSpace(serialNum, lid, attr);
     AttributeUpdater::handleUpdate(attr, lid, fieldUpd);
+    attr.get_filter_cache().note_changed(lid);
     attr.commitIfChangeVectorTooLarge();
 }
 
@@ -242,6 +247,7 @@ applyHeartBeat(SerialNum serialNum, AttributeVector &attr)
     attr.reclaim_unused_memory();
     if (attr.getStatus().getLastSyncToken() <= serialNum) {
         attr.commit(search::CommitParam(serialNum));
+        attr.get_filter_cache().commit(attr);
     }
 }
 
@@ -255,6 +261,7 @@ applyCommit(CommitParam param, AttributeWriter::OnWriteDoneType , AttributeVecto
         } else {
             attr.commit(param.forceUpdateStats());
         }
+        attr.get_filter_cache().commit(attr);
     }
 }
 
@@ -272,6 +279,7 @@ applyCompactLidSpace(uint32_t wantedLidLimit, SerialNum serialNum, AttributeVect
             attr.compactLidSpace(wantedLidLimit);
         }
         attr.commit(CommitParam(serialNum));
+        attr.get_filter_cache().commit(attr);
     }
 }
 
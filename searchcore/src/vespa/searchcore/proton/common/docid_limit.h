@@ -12,12 +12,24 @@ class DocIdLimit
 {
 private:
     std::atomic<uint32_t> _docIdLimit;
+    std::atomic<uint64_t> _commitGeneration;
 
 public:
-    explicit DocIdLimit(uint32_t docIdLimit) : _docIdLimit(docIdLimit) {}
-    void set(uint32_t docIdLimit) { _docIdLimit = docIdLimit; }
+    explicit DocIdLimit(uint32_t docIdLimit) : _docIdLimit(docIdLimit), _commitGeneration(0) {}
+    void set(uint32_t docIdLimit) {
+        _docIdLimit = docIdLimit;
+        bumpCommitGeneration();
+    }
     uint32_t get() const { return _docIdLimit; }
 
+    /**
+     * The commit generation is bumped each time feed operations or
+     * commits are done, i.e. when the documents visible to search
+     * might have changed.
+     */
+    uint64_t getCommitGeneration() const { return _commitGeneration.load(std::memory_order_acquire); }
+    void bumpCommitGeneration() { _commitGeneration.fetch_add(1, std::memory_order_release); }
+
     void bumpUpLimit(uint32_t newLimit) {
         for (;;) {
             uint32_t oldLimit = _docIdLimit;
@@ -28,6 +40,7 @@ public:
                                                   std::memory_order_relaxed))
                 break;
         }
+        bumpCommitGeneration();
     }
 };
 
@@ -42,6 +42,8 @@ Memory TYPE("type");
 Memory MESSAGE("message");
 Memory TIMEOUT("timeout");
 
+constexpr size_t PREFETCH_CHUNK_SIZE = 64;
+
 }
 
 void
@@ -73,9 +75,16 @@ DocsumContext::createSlimeReply()
     Cursor & array = root.setArray(DOCSUMS);
     const Symbol docsumSym = response->insert(DOCSUM);
     _docsumState._omit_summary_features = (rci.res_class == nullptr) || rci.res_class->omit_summary_features();
+    const bool prefetch = (rci.res_class != nullptr) && !rci.all_fields_generated;
+    const auto & docIds = _docsumState._docsumbuf;
     uint32_t num_ok(0);
-    for (uint32_t docId : _docsumState._docsumbuf) {
+    for (uint32_t docId : docIds) {
         if (_request.expired() ) { break; }
+        if (prefetch && (num_ok % PREFETCH_CHUNK_SIZE == 0)) {
+            // Prefetch in chunks, so that an expired request does not read documents it will not use.
+            size_t end = std::min(docIds.size(), size_t(num_ok) + PREFETCH_CHUNK_SIZE);
+            _docsumStore.prefetch(std::vector<uint32_t>(docIds.begin() + num_ok, docIds.begin() + end));
+        }
         Cursor &docSumC = array.addObject();
         ObjectSymbolInserter inserter(docSumC, docsumSym);
         if ((docId != search::endDocId) && rci.res_class != nullptr) {
@@ -6,6 +6,8 @@
 #include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/eval/eval/value_codec.h>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/searchlib/queryeval/begin_and_end_id.h>
 #include <vespa/document/fieldvalue/tensorfieldvalue.h>
 
 #include <vespa/log/log.h>
@@ -20,7 +22,8 @@ DocumentStoreAdapter::
 DocumentStoreAdapter(const search::IDocumentStore & docStore,
                      const DocumentTypeRepo &repo)
     : _docStore(docStore),
-      _repo(repo)
+      _repo(repo),
+      _prefetched()
 {
 }
 
@@ -29,7 +32,14 @@ DocumentStoreAdapter::~DocumentStoreAdapter() = default;
 std::unique_ptr<const IDocsumStoreDocument>
 DocumentStoreAdapter::get_document(uint32_t docId)
 {
-    auto document = _docStore.read(docId, _repo);
+    search::IDocumentStore::DocumentUP document;
+    auto found = _prefetched.find(docId);
+    if (found != _prefetched.end()) {
+        document = std::move(found->second);
+        _prefetched.erase(found);
+    } else {
+        document = _docStore.read(docId, _repo);
+    }
     if ( ! document) {
         LOG(debug, "Did not find summary document for docId %u. Returning empty docsum", docId);
         return {};
@@ -38,4 +48,25 @@ DocumentStoreAdapter::get_document(uint32_t docId)
     return std::make_unique<DocsumStoreDocument>(std::move(document));
 }
 
+void
+DocumentStoreAdapter::prefetch(const std::vector<uint32_t> & docIds)
+{
+    std::vector<uint32_t> lids;
+    lids.reserve(docIds.size());
+    for (uint32_t docId : docIds) {
+        if ((docId != search::endDocId) && (_prefetched.find(docId) == _prefetched.end())) {
+            lids.push_back(docId);
+        }
+    }
+    if (lids.empty()) {
+        return;
+    }
+    auto documents = _docStore.read_batch(lids, _repo);
+    for (size_t i(0); i < lids.size(); i++) {
+        if (documents[i]) {
+            _prefetched[lids[i]] = std::move(documents[i]);
+        }
+    }
+}
+
 } // namespace proton
@@ -196,6 +196,7 @@ DocumentMetaStore::insert(GidToLidMapKey key, const RawDocumentMetaData &metaDat
                       _subDbType);
     _lidAlloc.updateActiveLids(lid, state.isActive());
     updateCommittedDocIdLimit();
+    bump_lid_state_generation();
 }
 
 bool
@@ -429,6 +430,7 @@ DocumentMetaStore::DocumentMetaStore(BucketDBOwnerSP bucketDB,
       _subDbType(subDbType),
       _trackDocumentSizes(true),
       _changesSinceCommit(0),
+      _lid_state_generation(0),
       _op_listener(),
       _should_compact_gid_to_lid_map(false)
 {
@@ -585,6 +587,7 @@ DocumentMetaStore::removeInternal(DocId lid, uint64_t prepare_serial_num)
     }
     _gidToLidMap.remove(itr);
     _lidAlloc.unregisterLid(lid);
+    bump_lid_state_generation();
     return _metaDataStore[lid];
 }
 
@@ -635,6 +638,7 @@ DocumentMetaStore::move(DocId fromLid, DocId toLid, uint64_t prepare_serial_num)
     itr.writeKey(GidToLidMapKey(toLid, find_key.get_gid_key()));
     _lidAlloc.moveLidEnd(fromLid, toLid);
     _changesSinceCommit++;
+    bump_lid_state_generation();
 }
 
 void
@@ -681,6 +685,7 @@ DocumentMetaStore::removeBatch(const std::vector<DocId> &lidsToRemove, const uin
     }
     remove_batch_internal_btree(removed);
     _lidAlloc.unregister_lids(lidsToRemove);
+    bump_lid_state_generation();
     {
         std::vector<RemoveBatchEntry> bdb_removed;
         bdb_removed.reserve(removed.size());
@@ -973,6 +978,7 @@ DocumentMetaStore::updateActiveLids(const BucketId &bucketId, bool active)
         }
         _lidAlloc.updateActiveLids(lid, active);
     }
+    bump_lid_state_generation();
 }
 
 void
@@ -991,6 +997,7 @@ DocumentMetaStore::clearDocs(DocId lidLow, DocId lidLimit, bool)
     assert(lidLow <= lidLimit);
     assert(lidLimit <= getNumDocs());
     _lidAlloc.clearDocs(lidLow, lidLimit);
+    bump_lid_state_generation();
 }
 
 void
@@ -998,6 +1005,7 @@ DocumentMetaStore::compactLidSpace(uint32_t wantedLidLimit)
 {
     AttributeVector::compactLidSpace(wantedLidLimit);
     set_shrink_lid_space_blockers(get_shrink_lid_space_blockers() + 1);
+    bump_lid_state_generation();
 }
 
 void
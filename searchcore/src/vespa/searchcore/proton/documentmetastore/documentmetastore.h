@@ -76,6 +76,7 @@ private:
     const SubDbType     _subDbType;
     bool                _trackDocumentSizes;
     size_t              _changesSinceCommit;
+    std::atomic<uint64_t> _lid_state_generation;
     OperationListenerSP _op_listener;
     bool                _should_compact_gid_to_lid_map;
 
@@ -108,6 +109,7 @@ private:
                                    const RawDocumentMetaData &newMetaData);
 
     void unload();
+    void bump_lid_state_generation() noexcept { _lid_state_generation.fetch_add(1, std::memory_order_release); }
     void updateActiveLids(const BucketId &bucketId, bool active) override;
 
     /**
@@ -231,6 +233,9 @@ public:
     void holdUnblockShrinkLidSpace() override;
     bool canShrinkLidSpace() const override;
     void set_operation_listener(std::shared_ptr<documentmetastore::OperationListener> op_listener) override;
+    uint64_t get_lid_state_generation() const noexcept override {
+        return _lid_state_generation.load(std::memory_order_acquire);
+    }
 
     SerialNum getLastSerialNum() const override {
         return getStatus().getLastSyncToken();
@@ -83,6 +83,13 @@ struct IDocumentMetaStore : public search::IDocumentMetaStore,
 
     virtual void set_operation_listener(std::shared_ptr<documentmetastore::OperationListener> op_listener) = 0;
 
+    /*
+     * Returns a generation that is bumped each time the set of valid or
+     * active lids changes, including bucket (de)activation which does not
+     * go through the feed pipeline.
+     */
+    virtual uint64_t get_lid_state_generation() const noexcept = 0;
+
 };
 
 } // namespace proton
@@ -2,6 +2,7 @@
 
 #include "flush_engine_explorer.h"
 #include "flushengine.h"
+#include "flush_write_budget.h"
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/data/slime/inserter.h>
 
@@ -47,6 +48,8 @@ convertToSlime(const FlushContext::List &allTargets,
         object.setLong("flushedSerialNum", target->getFlushedSerialNum());
         object.setLong("memoryGain", target->getApproxMemoryGain().gain());
         object.setLong("diskGain", target->getApproxDiskGain().gain());
+        object.setLong("approxBytesToWriteToDisk", target->getApproxBytesToWriteToDisk());
+        object.setDouble("replayOperationCost", target->get_replay_operation_cost());
         object.setString("lastFlushTime", vespalib::to_string(target->getLastFlushTime()));
         vespalib::duration timeSinceLastFlush = now - target->getLastFlushTime();
         object.setDouble("timeSinceLastFlush", vespalib::to_s(timeSinceLastFlush));
@@ -54,6 +57,17 @@ convertToSlime(const FlushContext::List &allTargets,
     }
 }
 
+void
+convertToSlime(const flushengine::FlushWriteBudget::Stats &stats, Cursor &object)
+{
+    object.setLong("bandwidth", stats.bandwidth);
+    object.setLong("burstSize", stats.burst_size);
+    object.setLong("available", stats.available);
+    object.setLong("consumed", stats.consumed);
+    object.setLong("deferred", stats.deferred);
+    object.setDouble("hardLimitFactor", stats.hard_limit_factor);
+}
+
 }
 
 FlushEngineExplorer::FlushEngineExplorer(const FlushEngine &engine)
@@ -71,6 +85,7 @@ FlushEngineExplorer::get_state(const Inserter &inserter, bool full) const
         FlushContext::List allTargets = _engine.getTargetList(true);
         sortTargetList(allTargets);
         convertToSlime(allTargets, now, object.setArray("allTargets"));
+        convertToSlime(_engine.get_write_budget()->get_stats(vespalib::steady_clock::now()), object.setObject("writeBudget"));
     }
 }
 
@@ -0,0 +1,125 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "flush_write_budget.h"
+#include <algorithm>
+
+namespace proton::flushengine {
+
+FlushWriteBudget::Stats::Stats() noexcept
+    : bandwidth(0),
+      burst_size(0),
+      available(0),
+      consumed(0),
+      deferred(0),
+      hard_limit_factor(0.0)
+{
+}
+
+FlushWriteBudget::FlushWriteBudget()
+    : _lock(),
+      _bandwidth(0),
+      _burst_size(0),
+      _available(0.0),
+      _last_refill(),
+      _consumed(0),
+      _deferred(0),
+      _hard_limit_factor(2.0)
+{
+}
+
+FlushWriteBudget::~FlushWriteBudget() = default;
+
+void
+FlushWriteBudget::refill(const std::lock_guard<std::mutex>&, vespalib::steady_time now)
+{
+    if (now > _last_refill) {
+        double elapsed = vespalib::to_s(now - _last_refill);
+        _available = std::min(static_cast<double>(_burst_size), _available + elapsed * _bandwidth);
+        _last_refill = now;
+    }
+}
+
+void
+FlushWriteBudget::set_limit(uint64_t bandwidth, uint64_t burst_size, vespalib::steady_time now)
+{
+    std::lock_guard guard(_lock);
+    if (_bandwidth == 0) {
+        // Start with a full budget
+        _available = burst_size;
+    } else {
+        refill(guard, now);
+        _available = std::min(static_cast<double>(burst_size), _available);
+    }
+    _bandwidth = bandwidth;
+    _burst_size = burst_size;
+    _last_refill = now;
+}
+
+bool
+FlushWriteBudget::enabled() const
+{
+    std::lock_guard guard(_lock);
+    return _bandwidth != 0;
+}
+
+void
+FlushWriteBudget::set_hard_limit_factor(double hard_limit_factor)
+{
+    std::lock_guard guard(_lock);
+    _hard_limit_factor = hard_limit_factor;
+}
+
+double
+FlushWriteBudget::hard_limit_factor() const
+{
+    std::lock_guard guard(_lock);
+    return _hard_limit_factor;
+}
+
+bool
+FlushWriteBudget::can_afford(uint64_t bytes, vespalib::steady_time now)
+{
+    std::lock_guard guard(_lock);
+    if (_bandwidth == 0) {
+        return true;
+    }
+    refill(guard, now);
+    return _available >= static_cast<double>(std::min(bytes, _burst_size));
+}
+
+void
+FlushWriteBudget::note_deferred()
+{
+    std::lock_guard guard(_lock);
+    ++_deferred;
+}
+
+void
+FlushWriteBudget::consume(uint64_t bytes, vespalib::steady_time now)
+{
+    std::lock_guard guard(_lock);
+    _consumed += bytes;
+    if (_bandwidth != 0) {
+        refill(guard, now);
+        _available -= bytes;
+    }
+}
+
+FlushWriteBudget::Stats
+FlushWriteBudget::get_stats(vespalib::steady_time now)
+{
+    std::lock_guard guard(_lock);
+    if (_bandwidth != 0) {
+        refill(guard, now);
+    }
+    Stats stats;
+    stats.bandwidth = _bandwidth;
+    stats.burst_size = _burst_size;
+    stats.available = _available;
+    stats.consumed = _consumed;
+    stats.deferred = _deferred;
+    stats.hard_limit_factor = _hard_limit_factor;
+    return stats;
+}
+
+}
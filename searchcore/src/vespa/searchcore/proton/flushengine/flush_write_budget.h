@@ -0,0 +1,71 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/util/time.h>
+#include <cstdint>
+#include <mutex>
+
+namespace proton::flushengine {
+
+/**
+ * Budget for disk write bandwidth used by flushes, implemented as a token bucket.
+ *
+ * Flushes consume the approximate number of bytes they will write to disk when started.
+ * The budget is refilled at the configured bandwidth, up to the burst size. A flush is
+ * affordable when the budget covers the bytes it will write, capped at the burst size,
+ * allowing large flushes to start when the budget is full. The budget is then left in
+ * debt, delaying later flushes until it has been paid back.
+ *
+ * A bandwidth of 0 disables the budget.
+ *
+ * Flushes needed to relieve memory or transaction log pressure are also paced, until
+ * the pressure exceeds the hard limit factor times the configured flush limits.
+ */
+class FlushWriteBudget {
+public:
+    struct Stats {
+        uint64_t bandwidth;
+        uint64_t burst_size;
+        int64_t  available;
+        uint64_t consumed;
+        uint64_t deferred; // number of flush strategy evaluations deferring flush targets
+        double   hard_limit_factor;
+        Stats() noexcept;
+    };
+
+private:
+    mutable std::mutex    _lock;
+    uint64_t              _bandwidth;  // bytes per second
+    uint64_t              _burst_size; // bytes
+    double                _available;  // bytes, negative when in debt
+    vespalib::steady_time _last_refill;
+    uint64_t              _consumed;
+    uint64_t              _deferred;
+    double                _hard_limit_factor;
+
+    void refill(const std::lock_guard<std::mutex>& guard, vespalib::steady_time now);
+public:
+    FlushWriteBudget();
+    ~FlushWriteBudget();
+    void set_limit(uint64_t bandwidth, uint64_t burst_size, vespalib::steady_time now);
+    bool enabled() const;
+    void set_hard_limit_factor(double hard_limit_factor);
+    double hard_limit_factor() const;
+
+    /**
+     * Returns true if a flush writing the given number of bytes can start now.
+     */
+    bool can_afford(uint64_t bytes, vespalib::steady_time now);
+    /**
+     * Called by a flush strategy when flush targets have been deferred due to lack of budget.
+     */
+    void note_deferred();
+
+    /**
+     * Called by the flush engine when a flush writing the given number of bytes is started.
+     */
+    void consume(uint64_t bytes, vespalib::steady_time now);
+    Stats get_stats(vespalib::steady_time now);
+};
+
+}
@@ -4,6 +4,7 @@
 #include "active_flush_stats.h"
 #include "cachedflushtarget.h"
 #include "flush_all_strategy.h"
+#include "flush_write_budget.h"
 #include "flushtask.h"
 #include "tls_stats_factory.h"
 #include "tls_stats_map.h"
@@ -103,7 +104,8 @@ FlushEngine::FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStats
       _tlsStatsFactory(std::move(tlsStatsFactory)),
       _pendingPrune(),
       _normal_flush_token(std::make_shared<search::FlushToken>()),
-      _gc_flush_token(std::make_shared<search::FlushToken>())
+      _gc_flush_token(std::make_shared<search::FlushToken>()),
+      _write_budget(std::make_shared<flushengine::FlushWriteBudget>())
 { }
 
 FlushEngine::~FlushEngine()
@@ -378,6 +380,7 @@ FlushEngine::flushAll(const FlushContext::List &lst)
         if (wait_for_slot(IFlushTarget::Priority::NORMAL)) {
             if (ctx->initFlush(get_flush_token(*ctx))) {
                 logTarget("initiated", *ctx);
+                consume_write_budget(*ctx);
                 _executor.execute(std::make_unique<FlushTask>(initFlush(*ctx, _priority_flush_token), *this, ctx));
             } else {
                 logTarget("failed to initiate", *ctx);
@@ -408,10 +411,17 @@ FlushEngine::flushNextTarget(const vespalib::string & name, const FlushContext::
                   name.c_str(), contexts.size());
         std::this_thread::sleep_for(100ms);
     }
+    consume_write_budget(*ctx);
     _executor.execute(std::make_unique<FlushTask>(initFlush(*ctx, {}), *this, ctx));
     return ctx->getName();
 }
 
+void
+FlushEngine::consume_write_budget(const FlushContext &ctx)
+{
+    _write_budget->consume(ctx.getTarget()->getApproxBytesToWriteToDisk(), vespalib::steady_clock::now());
+}
+
 uint32_t
 FlushEngine::initFlush(const FlushContext &ctx, std::shared_ptr<PriorityFlushToken> priority_flush_token)
 {
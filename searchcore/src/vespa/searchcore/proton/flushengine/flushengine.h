@@ -17,7 +17,10 @@ namespace search { class FlushToken; }
 
 namespace proton {
 
-namespace flushengine { class ITlsStatsFactory; }
+namespace flushengine {
+class FlushWriteBudget;
+class ITlsStatsFactory;
+}
 
 class FlushEngine
 {
@@ -74,6 +77,7 @@ private:
     PendingPrunes                       _pendingPrune;
     std::shared_ptr<search::FlushToken> _normal_flush_token;
     std::shared_ptr<search::FlushToken> _gc_flush_token;
+    std::shared_ptr<flushengine::FlushWriteBudget> _write_budget;
 
     FlushContext::List getTargetList(bool includeFlushingTargets) const;
     std::pair<FlushContext::List,bool> getSortedTargetList();
@@ -82,6 +86,7 @@ private:
     vespalib::string flushNextTarget(const vespalib::string & name, const FlushContext::List & contexts);
     void flushAll(const FlushContext::List &lst);
     bool prune();
+    void consume_write_budget(const FlushContext &ctx);
     uint32_t initFlush(const FlushContext &ctx, std::shared_ptr<PriorityFlushToken> priority_flush_token);
     uint32_t initFlush(const IFlushHandler::SP &handler, const IFlushTarget::SP &target, std::shared_ptr<PriorityFlushToken> priority_flush_token);
     void flushDone(const FlushContext &ctx, uint32_t taskId);
@@ -184,6 +189,11 @@ public:
 
     void setStrategy(IFlushStrategy::SP strategy);
     void mark_currently_flushing_tasks(std::shared_ptr<PriorityFlushToken> priority_flush_token);
+    /**
+     * Returns the disk write bandwidth budget charged when flushes are started.
+     * Flush strategies can use it to defer flushes that are not urgent.
+     */
+    const std::shared_ptr<flushengine::FlushWriteBudget>& get_write_budget() const noexcept { return _write_budget; }
     uint32_t maxConcurrentTotal() const { return _maxConcurrentNormal + 1; }
     uint32_t maxConcurrentNormal() const { return _maxConcurrentNormal; }
 };
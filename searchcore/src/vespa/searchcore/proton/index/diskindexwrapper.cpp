@@ -12,8 +12,10 @@ namespace proton {
 
 DiskIndexWrapper::DiskIndexWrapper(const vespalib::string &indexDir,
                                    const TuneFileSearch &tuneFileSearch,
-                                   size_t cacheSize)
-    : _index(indexDir, cacheSize),
+                                   size_t cacheSize,
+                                   size_t bitVectorCacheSize,
+                                   size_t postingListCacheSize)
+    : _index(indexDir, cacheSize, bitVectorCacheSize, postingListCacheSize),
       _serialNum(0)
 {
     bool setupIndexOk = _index.setup(tuneFileSearch);
@@ -24,8 +26,10 @@ DiskIndexWrapper::DiskIndexWrapper(const vespalib::string &indexDir,
 
 DiskIndexWrapper::DiskIndexWrapper(const DiskIndexWrapper &oldIndex,
                                    const TuneFileSearch &tuneFileSearch,
-                                   size_t cacheSize)
-    : _index(oldIndex._index.getIndexDir(), cacheSize),
+                                   size_t cacheSize,
+                                   size_t bitVectorCacheSize,
+                                   size_t postingListCacheSize)
+    : _index(oldIndex._index.getIndexDir(), cacheSize, bitVectorCacheSize, postingListCacheSize),
       _serialNum(0)
 {
     bool setupIndexOk = _index.setup(tuneFileSearch, oldIndex._index);
@@ -34,6 +38,16 @@ DiskIndexWrapper::DiskIndexWrapper(const DiskIndexWrapper &oldIndex,
     _serialNum = oldIndex.getSerialNum();
 }
 
+search::SearchableStats
+DiskIndexWrapper::getSearchableStats() const
+{
+    return search::SearchableStats()
+        .sizeOnDisk(_index.getSize())
+        .disk_index_cache_stats(_index.getIndexDir(),
+                                search::DiskIndexCacheStats(_index.get_posting_list_cache_stats(),
+                                                            _index.get_bit_vector_cache_stats()));
+}
+
 search::SerialNum
 DiskIndexWrapper::getSerialNum() const
 {
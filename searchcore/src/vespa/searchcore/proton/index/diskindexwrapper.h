@@ -16,11 +16,15 @@ private:
 public:
     DiskIndexWrapper(const vespalib::string &indexDir,
                      const search::TuneFileSearch &tuneFileSearch,
-                     size_t cacheSize);
+                     size_t cacheSize,
+                     size_t bitVectorCacheSize = 0,
+                     size_t postingListCacheSize = 0);
 
     DiskIndexWrapper(const DiskIndexWrapper &oldIndex,
                      const search::TuneFileSearch &tuneFileSearch,
-                     size_t cacheSize);
+                     size_t cacheSize,
+                     size_t bitVectorCacheSize = 0,
+                     size_t postingListCacheSize = 0);
 
     std::unique_ptr<search::queryeval::Blueprint>
     createBlueprint(const IRequestContext & requestContext, const FieldSpec &field, const Node &term) override {
@@ -30,9 +34,7 @@ public:
     createBlueprint(const IRequestContext & requestContext, const FieldSpecList &fields, const Node &term) override {
         return _index.createBlueprint(requestContext, fields, term);
     }
-    search::SearchableStats getSearchableStats() const override {
-        return search::SearchableStats().sizeOnDisk(_index.getSize());
-    }
+    search::SearchableStats getSearchableStats() const override;
 
     search::SerialNum getSerialNum() const override;
 
@@ -30,8 +30,18 @@ namespace proton::index {
 IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext &fileHeaderContext,
                                                          const TuneFileIndexManager &tuneFileIndexManager,
                                                          size_t cacheSize,
+                                                         size_t bitVectorCacheSize,
+                                                         size_t postingListCacheSize,
+                                                         bool blockMax,
+                                                         uint32_t fusionMaxFieldPartitions,
+                                                         uint64_t fusionMinFieldPartitionSize,
                                                          IThreadingService &threadingService)
     : _cacheSize(cacheSize),
+      _bitVectorCacheSize(bitVectorCacheSize),
+      _postingListCacheSize(postingListCacheSize),
+      _blockMax(blockMax),
+      _fusionMaxFieldPartitions(fusionMaxFieldPartitions),
+      _fusionMinFieldPartitionSize(fusionMinFieldPartitionSize),
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexManager._indexing),
       _tuneFileSearch(tuneFileIndexManager._search),
@@ -45,20 +55,22 @@ IndexManager::MaintainerOperations::createMemoryIndex(const Schema& schema,
                                                       SerialNum serialNum)
 {
     return std::make_shared<MemoryIndexWrapper>(schema, inspector, _fileHeaderContext, _tuneFileIndexing,
-                                                _threadingService, serialNum);
+                                                _blockMax, _threadingService, serialNum);
 }
 
 IDiskIndex::SP
 IndexManager::MaintainerOperations::loadDiskIndex(const vespalib::string &indexDir)
 {
-    return std::make_shared<DiskIndexWrapper>(indexDir, _tuneFileSearch, _cacheSize);
+    return std::make_shared<DiskIndexWrapper>(indexDir, _tuneFileSearch, _cacheSize, _bitVectorCacheSize,
+                                              _postingListCacheSize);
 }
 
 IDiskIndex::SP
 IndexManager::MaintainerOperations::reloadDiskIndex(const IDiskIndex &oldIndex)
 {
     return std::make_shared<DiskIndexWrapper>(dynamic_cast<const DiskIndexWrapper &>(oldIndex),
-                                              _tuneFileSearch, _cacheSize);
+                                              _tuneFileSearch, _cacheSize, _bitVectorCacheSize,
+                                              _postingListCacheSize);
 }
 
 bool
@@ -72,6 +84,11 @@ IndexManager::MaintainerOperations::runFusion(const Schema &schema,
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext, serialNum);
     Fusion fusion(schema, outputDir, sources, selectorArray,
                   _tuneFileIndexing, fileHeaderContext);
+    fusion.set_encode_block_max(_blockMax);
+    fusion.set_max_field_partitions(_fusionMaxFieldPartitions);
+    if (_fusionMinFieldPartitionSize != 0) {
+        fusion.set_min_field_partition_size(_fusionMinFieldPartitionSize);
+    }
     return fusion.merge(_threadingService.shared(), std::move(flush_token));
 }
 
@@ -86,7 +103,9 @@ IndexManager::IndexManager(const vespalib::string &baseDir,
                            const search::TuneFileIndexManager &tuneFileIndexManager,
                            const search::TuneFileAttributes &tuneFileAttributes,
                            const FileHeaderContext &fileHeaderContext) :
-    _operations(fileHeaderContext, tuneFileIndexManager, indexConfig.cacheSize, threadingService),
+    _operations(fileHeaderContext, tuneFileIndexManager, indexConfig.cacheSize,
+                indexConfig.bitVectorCacheSize, indexConfig.postingListCacheSize, indexConfig.blockMax,
+                indexConfig.fusionMaxFieldPartitions, indexConfig.fusionMinFieldPartitionSize, threadingService),
     _maintainer(IndexMaintainerConfig(baseDir, indexConfig.warmup, indexConfig.maxFlushed, schema, serialNum, tuneFileAttributes),
                 IndexMaintainerContext(threadingService, reconfigurer, fileHeaderContext, warmupExecutor),
                 _operations)
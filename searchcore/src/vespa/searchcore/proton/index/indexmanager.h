@@ -13,14 +13,29 @@ struct IndexConfig {
     using WarmupConfig = searchcorespi::index::WarmupConfig;
     IndexConfig() : IndexConfig(WarmupConfig(), 2, 0) { }
     IndexConfig(WarmupConfig warmup_, size_t maxFlushed_, size_t cacheSize_)
+        : IndexConfig(warmup_, maxFlushed_, cacheSize_, 0, 0, false, 1, 0)
+    { }
+    IndexConfig(WarmupConfig warmup_, size_t maxFlushed_, size_t cacheSize_,
+                size_t bitVectorCacheSize_, size_t postingListCacheSize_, bool blockMax_,
+                uint32_t fusionMaxFieldPartitions_, uint64_t fusionMinFieldPartitionSize_)
         : warmup(warmup_),
           maxFlushed(maxFlushed_),
-          cacheSize(cacheSize_)
+          cacheSize(cacheSize_),
+          bitVectorCacheSize(bitVectorCacheSize_),
+          postingListCacheSize(postingListCacheSize_),
+          blockMax(blockMax_),
+          fusionMaxFieldPartitions(fusionMaxFieldPartitions_),
+          fusionMinFieldPartitionSize(fusionMinFieldPartitionSize_)
     { }
 
     const WarmupConfig warmup;
     const size_t       maxFlushed;
     const size_t       cacheSize;
+    const size_t       bitVectorCacheSize;
+    const size_t       postingListCacheSize;
+    const bool         blockMax;
+    const uint32_t     fusionMaxFieldPartitions;
+    const uint64_t     fusionMinFieldPartitionSize;
 };
 
 /**
@@ -37,6 +52,11 @@ public:
         using IDiskIndex = searchcorespi::index::IDiskIndex;
         using IMemoryIndex = searchcorespi::index::IMemoryIndex;
         const size_t _cacheSize;
+        const size_t _bitVectorCacheSize;
+        const size_t _postingListCacheSize;
+        const bool _blockMax;
+        const uint32_t _fusionMaxFieldPartitions;
+        const uint64_t _fusionMinFieldPartitionSize;
         const search::common::FileHeaderContext &_fileHeaderContext;
         const search::TuneFileIndexing _tuneFileIndexing;
         const search::TuneFileSearch _tuneFileSearch;
@@ -46,6 +66,11 @@ public:
         MaintainerOperations(const search::common::FileHeaderContext &fileHeaderContext,
                              const search::TuneFileIndexManager &tuneFileIndexManager,
                              size_t cacheSize,
+                             size_t bitVectorCacheSize,
+                             size_t postingListCacheSize,
+                             bool blockMax,
+                             uint32_t fusionMaxFieldPartitions,
+                             uint64_t fusionMinFieldPartitionSize,
                              searchcorespi::index::IThreadingService &threadingService);
 
         IMemoryIndex::SP createMemoryIndex(const Schema& schema,
@@ -21,13 +21,15 @@ MemoryIndexWrapper::MemoryIndexWrapper(const search::index::Schema& schema,
                                        const search::index::IFieldLengthInspector& inspector,
                                        const search::common::FileHeaderContext& fileHeaderContext,
                                        const TuneFileIndexing& tuneFileIndexing,
+                                       bool encodeBlockMax,
                                        searchcorespi::index::IThreadingService& threadingService,
                                        search::SerialNum serialNum)
     : _index(schema, inspector, threadingService.field_writer(),
              threadingService.field_writer()),
       _serialNum(serialNum),
       _fileHeaderContext(fileHeaderContext),
-      _tuneFileIndexing(tuneFileIndexing)
+      _tuneFileIndexing(tuneFileIndexing),
+      _encodeBlockMax(encodeBlockMax)
 {
 }
 
@@ -39,6 +41,7 @@ MemoryIndexWrapper::flushToDisk(const vespalib::string &flushDir, uint32_t docId
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext, serialNum);
     IndexBuilder indexBuilder(_index.getSchema(), flushDir, docIdLimit,
                               numWords, *this, _tuneFileIndexing, fileHeaderContext);
+    indexBuilder.set_encode_block_max(_encodeBlockMax);
     _index.dump(indexBuilder);
 }
 
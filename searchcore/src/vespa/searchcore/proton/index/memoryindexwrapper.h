@@ -23,12 +23,14 @@ private:
     std::atomic<SerialNum> _serialNum;
     const search::common::FileHeaderContext &_fileHeaderContext;
     const search::TuneFileIndexing _tuneFileIndexing;
+    const bool _encodeBlockMax;
 
 public:
     MemoryIndexWrapper(const search::index::Schema& schema,
                        const search::index::IFieldLengthInspector& inspector,
                        const search::common::FileHeaderContext& fileHeaderContext,
                        const search::TuneFileIndexing& tuneFileIndexing,
+                       bool encodeBlockMax,
                        searchcorespi::index::IThreadingService& threadingService,
                        SerialNum serialNum);
 
@@ -7,6 +7,7 @@
 #include <vespa/vespalib/data/slime/binary_format.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/cpu_usage.h>
+#include <vespa/vespalib/util/numa.h>
 
 #include <vespa/log/log.h>
 
@@ -48,7 +49,7 @@ namespace proton {
 using namespace vespalib::slime;
 using vespalib::CpuUsage;
 
-MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async)
+MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async, bool numaPinning)
     : _lock(),
       _distributionKey(distributionKey),
       _async(async),
@@ -58,7 +59,8 @@ MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t di
       _executor(std::max(size_t(1), numThreads / threadsPerSearch),
                 CpuUsage::wrap(match_engine_executor, CpuUsage::Category::READ)),
       _threadBundlePool(std::max(size_t(1), threadsPerSearch),
-                        CpuUsage::wrap(match_engine_thread_bundle, CpuUsage::Category::READ)),
+                        CpuUsage::wrap(match_engine_thread_bundle, CpuUsage::Category::READ),
+                        numaPinning ? vespalib::numa_node_cpus() : vespalib::NumaNodeCpus()),
       _nodeUp(false),
       _nodeMaintenance(false)
 {
@@ -69,15 +69,36 @@ private:
     template <typename NodeType>
     void buildIntermediate(IntermediateBlueprint *b, NodeType &n) __attribute__((noinline));
 
+    // Block-max WAND scores all terms using the average field length of a single index field
+    void maybe_enable_block_max(WeakAndBlueprint &wand, const ProtonWeakAnd &n) {
+        const vespalib::string *field_name = nullptr;
+        for (auto node : n.getChildren()) {
+            auto *term = dynamic_cast<const ProtonTermData *>(node);
+            if ((term == nullptr) || (term->numFields() != 1) || term->field(0).attribute_field ||
+                ((field_name != nullptr) && (*field_name != term->field(0).getName()))) {
+                return;
+            }
+            field_name = &term->field(0).getName();
+        }
+        if (field_name != nullptr) {
+            auto field_length_info = _context.getIndexes().get_field_length_info(*field_name);
+            if (field_length_info.get_num_samples() > 0) {
+                wand.enable_block_max(field_length_info.get_average_field_length());
+            }
+        }
+    }
+
     void buildWeakAnd(ProtonWeakAnd &n) {
-        auto *wand = new WeakAndBlueprint(n.getTargetNumHits(),
-                                          _requestContext.get_attribute_blueprint_params().weakand_range,
-                                          is_search_multi_threaded());
+        const auto &params = _requestContext.get_attribute_blueprint_params();
+        auto *wand = new WeakAndBlueprint(n.getTargetNumHits(), params.weakand_range, is_search_multi_threaded());
         Blueprint::UP result(wand);
         for (auto node : n.getChildren()) {
             uint32_t weight = getWeightFromNode(*node).percent();
             wand->addTerm(build(_requestContext, *node, _context), weight);
         }
+        if (params.weakand_block_max) {
+            maybe_enable_block_max(*wand, n);
+        }
         _result = std::move(result);
     }
 
@@ -164,4 +164,88 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+DocidRange
+WorkStealingDocidRangeScheduler::take_chunk(size_t thread_id)
+{
+    auto &todo = _workers[thread_id].todo;
+    uint64_t old_todo = todo.load(std::memory_order_relaxed);
+    for (;;) {
+        DocidRange range = unpack(old_todo);
+        if (range.empty()) {
+            return DocidRange();
+        }
+        uint32_t chunk = std::min(uint32_t(range.size()), std::max(_min_task, uint32_t(range.size() / chunk_div)));
+        uint32_t mid = range.begin + chunk;
+        if (todo.compare_exchange_weak(old_todo, pack(mid, range.end), std::memory_order_relaxed)) {
+            return DocidRange(range.begin, mid);
+        }
+    }
+}
+
+bool
+WorkStealingDocidRangeScheduler::steal(size_t thread_id)
+{
+    for (;;) {
+        size_t victim = thread_id;
+        uint64_t victim_todo = 0;
+        size_t victim_size = 0;
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            uint64_t todo = _workers[i].todo.load(std::memory_order_relaxed);
+            size_t size = unpack(todo).size();
+            if ((i != thread_id) && (size > victim_size)) {
+                victim = i;
+                victim_todo = todo;
+                victim_size = size;
+            }
+        }
+        if (victim_size == 0) {
+            return false;
+        }
+        DocidRange range = unpack(victim_todo);
+        // a range too small to be split is stolen as a whole
+        uint32_t mid = (victim_size < (2 * _min_task)) ? range.begin : (range.begin + (victim_size / 2));
+        if (_workers[victim].todo.compare_exchange_strong(victim_todo, pack(range.begin, mid), std::memory_order_relaxed)) {
+            // only the owner can grow its own range, so a plain store is safe here
+            _workers[thread_id].todo.store(pack(mid, range.end), std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit)
+    : _min_task(std::max(1u, min_task)),
+      _workers(num_threads)
+{
+    DocidRangeSplitter splitter(DocidRange(1, docid_limit), num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        DocidRange range = splitter.get(i);
+        _workers[i].todo.store(pack(range.begin, range.end), std::memory_order_relaxed);
+    }
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() = default;
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    DocidRange range = take_chunk(thread_id);
+    while (range.empty() && steal(thread_id)) {
+        range = take_chunk(thread_id);
+    }
+    _workers[thread_id].assigned += range.size();
+    return range;
+}
+
+size_t
+WorkStealingDocidRangeScheduler::unassigned_size() const
+{
+    size_t sum = 0;
+    for (const auto &worker: _workers) {
+        sum += unpack(worker.todo.load(std::memory_order_relaxed)).size();
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+
 }
@@ -201,4 +201,41 @@ public:
     DocidRange share_range(size_t, DocidRange todo) override;
 };
 
+/**
+ * A lock-free scheduler that begins by giving each thread an equal
+ * part of the docid space. Each thread consumes its own part from the
+ * front in chunks that shrink as the part shrinks. A thread that runs
+ * out of work steals the back half of the largest remaining part
+ * owned by another thread. Work is handed out until all parts are
+ * empty. The remaining part of each thread is packed into a single
+ * atomic word and all updates are done with compare-and-swap.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> todo;
+        size_t                assigned;
+        Worker() noexcept : todo(0), assigned(0) {}
+    };
+    static constexpr uint32_t chunk_div = 8;
+    static uint64_t pack(uint32_t begin, uint32_t end) noexcept { return ((uint64_t(begin) << 32) | end); }
+    static DocidRange unpack(uint64_t todo) noexcept { return DocidRange(uint32_t(todo >> 32), uint32_t(todo)); }
+
+    uint32_t            _min_task;
+    std::vector<Worker> _workers;
+
+    VESPA_DLL_LOCAL DocidRange take_chunk(size_t thread_id);
+    VESPA_DLL_LOCAL bool steal(size_t thread_id);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit);
+    ~WorkStealingDocidRangeScheduler() override;
+    DocidRange first_range(size_t thread_id) override { return next_range(thread_id); }
+    DocidRange next_range(size_t thread_id) override;
+    size_t total_size(size_t thread_id) const override { return _workers[thread_id].assigned; }
+    size_t unassigned_size() const override;
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+};
+
 }
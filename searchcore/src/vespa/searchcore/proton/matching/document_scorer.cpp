@@ -27,7 +27,8 @@ extractScoreFeature(const RankProgram &rankProgram)
 
 DocumentScorer::DocumentScorer(RankProgram &rankProgram,
                                SearchIterator &searchItr)
-    : _searchItr(searchItr),
+    : _rankProgram(rankProgram),
+      _searchItr(searchItr),
       _scoreFeature(extractScoreFeature(rankProgram))
 {
 }
@@ -41,9 +42,35 @@ DocumentScorer::score(TaggedHits &hits)
     auto sort_on_docid = [](const TaggedHit &a, const TaggedHit &b){ return (a.first.first < b.first.first); };
     std::sort(hits.begin(), hits.end(), sort_on_docid);
     _searchItr.initRange(hits.front().first.first, hits.back().first.first + 1);
+    if (_rankProgram.max_batch_size() > 0) {
+        score_batch(hits);
+        return;
+    }
     for (auto &hit: hits) {
         hit.first.second = doScore(hit.first.first);
     }
 }
 
+void
+DocumentScorer::score_batch(TaggedHits &hits)
+{
+    size_t batch_size = _rankProgram.max_batch_size();
+    const feature_t *scores = _rankProgram.get_batch_seed();
+    std::vector<uint32_t> docids;
+    docids.reserve(batch_size);
+    for (size_t begin = 0; begin < hits.size(); begin += batch_size) {
+        size_t end = std::min(begin + batch_size, hits.size());
+        docids.clear();
+        for (size_t i = begin; i < end; ++i) {
+            uint32_t docid = hits[i].first.first;
+            _searchItr.unpack(docid);
+            docids.push_back(docid);
+        }
+        _rankProgram.execute_batch(docids);
+        for (size_t i = begin; i < end; ++i) {
+            hits[i].first.second = scores[i - begin];
+        }
+    }
+}
+
 }
@@ -21,6 +21,7 @@ namespace proton::matching {
 class DocumentScorer
 {
 private:
+    search::fef::RankProgram &_rankProgram;
     search::queryeval::SearchIterator &_searchItr;
     search::fef::LazyValue _scoreFeature;
 
@@ -38,6 +39,9 @@ public:
 
     // annotate hits with rank score, may change order
     void score(TaggedHits &hits);
+
+private:
+    void score_batch(TaggedHits &hits);
 };
 
 }
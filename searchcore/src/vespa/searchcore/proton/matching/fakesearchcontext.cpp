@@ -12,7 +12,8 @@ FakeSearchContext::FakeSearchContext(size_t initialNumDocs)
       _selector(std::make_shared<search::FixedSourceSelector>(0, "fs", initialNumDocs)),
       _indexes(std::make_shared<IndexCollection>(_selector)),
       _attrSearchable(),
-      _docIdLimit(initialNumDocs)
+      _docIdLimit(initialNumDocs),
+      _commitGeneration(0)
 {
     _attrSearchable.is_attr(true);
 }
@@ -30,6 +30,7 @@ private:
     IndexCollection::SP                    _indexes;
     FakeSearchable                         _attrSearchable;
     uint32_t                               _docIdLimit;
+    uint64_t                               _commitGeneration;
 
 public:
     FakeSearchContext(size_t initialNumDocs=0);
@@ -45,6 +46,11 @@ public:
         return *this;
     }
 
+    FakeSearchContext &setCommitGeneration(uint64_t generation) {
+        _commitGeneration = generation;
+        return *this;
+    }
+
     FakeSearchable &attr() { return _attrSearchable; }
 
     FakeIndexSearchable &idx(uint32_t i) {
@@ -65,6 +71,10 @@ public:
     uint32_t getDocIdLimit() override {
         return _docIdLimit;
     }
+
+    uint64_t getCommitGeneration() override {
+        return _commitGeneration;
+    }
     virtual const vespalib::Doom & getDoom() const { return _doom; }
 };
 
@@ -54,6 +54,15 @@ public:
      **/
     virtual uint32_t getDocIdLimit() = 0;
 
+    /**
+     * Obtain the commit generation of the searchable data. It is
+     * changed whenever the documents visible to search might have
+     * changed, and is used to invalidate cached query results.
+     *
+     * @return commit generation
+     **/
+    virtual uint64_t getCommitGeneration() = 0;
+
     /**
      * Deleting the context will trigger cleanup in the
      * implementation.
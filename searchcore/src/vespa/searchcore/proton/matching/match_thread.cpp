@@ -107,14 +107,46 @@ MatchThread::Context::Context(std::optional<double> first_phase_rank_score_drop_
       _first_phase_rank_score_drop_limit(first_phase_rank_score_drop_limit.value_or(0.0 /* ignored */)),
       _hits(hits),
       _doom(tools.getDoom()),
+      _rank_program(tools.rank_program()),
+      _batch_docids(),
+      _batch_scores(nullptr),
       dropped()
 {
+    if (_rank_program.max_batch_size() > 0) {
+        _batch_docids.reserve(_rank_program.max_batch_size());
+        _batch_scores = _rank_program.get_batch_seed();
+    }
 }
 
 template <MatchThread::RankDropLimitE use_rank_drop_limit>
 void
 MatchThread::Context::rankHit(uint32_t docId) {
-    double score = _score_feature.as_number(docId);
+    if (_batch_scores != nullptr) {
+        _batch_docids.push_back(docId);
+        if (_batch_docids.size() == _rank_program.max_batch_size()) {
+            flushBatch<use_rank_drop_limit>();
+        }
+    } else {
+        addRankedHit<use_rank_drop_limit>(docId, _score_feature.as_number(docId));
+    }
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::flushBatch() {
+    if (_batch_docids.empty()) {
+        return;
+    }
+    _rank_program.execute_batch(_batch_docids);
+    for (size_t i = 0; i < _batch_docids.size(); ++i) {
+        addRankedHit<use_rank_drop_limit>(_batch_docids[i], _batch_scores[i]);
+    }
+    _batch_docids.clear();
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::addRankedHit(uint32_t docId, double score) {
     // convert NaN and Inf scores to -Inf
     if (__builtin_expect(std::isnan(score) || std::isinf(score), false)) {
         score = -HUGE_VAL;
@@ -207,6 +239,9 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
             docId = Strategy::seek_next(*search, docId + 1);
         }
     }
+    if (do_rank) {
+        context.flushBatch<use_rank_drop_limit>();
+    }
     return docId;
 }
 
@@ -77,6 +77,8 @@ private:
                 uint32_t num_threads) __attribute__((noinline));
         template <RankDropLimitE use_rank_drop_limit>
         void rankHit(uint32_t docId);
+        template <RankDropLimitE use_rank_drop_limit>
+        void flushBatch();
         void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool    isAtLimit() const { return matches == _matches_limit; }
@@ -84,11 +86,17 @@ private:
         vespalib::duration timeLeft() const { return _doom.soft_left(); }
         uint32_t        matches;
     private:
+        template <RankDropLimitE use_rank_drop_limit>
+        void addRankedHit(uint32_t docId, double score);
+
         uint32_t        _matches_limit;
         LazyValue       _score_feature;
         double          _first_phase_rank_score_drop_limit;
         HitCollector   &_hits;
         const Doom      _doom;
+        RankProgram    &_rank_program;
+        std::vector<uint32_t> _batch_docids;
+        const search::feature_t *_batch_scores;
     public:
         std::vector<uint32_t> dropped;
     };
@@ -134,12 +134,14 @@ MatchTools::setup_first_phase(ExecutionProfiler *profiler)
 {
     setup(_rankSetup.create_first_phase_program(), profiler,
           TermwiseLimit::lookup(_queryEnv.getProperties(), _rankSetup.get_termwise_limit()));
+    _rank_program->setup_batch(FirstPhaseBatchSize::lookup(_queryEnv.getProperties(), _rankSetup.get_first_phase_batch_size()));
 }
 
 void
 MatchTools::setup_second_phase(ExecutionProfiler *profiler)
 {
     setup(_rankSetup.create_second_phase_program(), profiler);
+    _rank_program->setup_batch(SecondPhaseBatchSize::lookup(_queryEnv.getProperties(), _rankSetup.get_second_phase_batch_size()));
 }
 
 void
@@ -351,6 +353,7 @@ MatchToolsFactory::extract_attribute_blueprint_params(const RankSetup& rank_setu
     double target_hits_max_adjustment_factor = TargetHitsMaxAdjustmentFactor::lookup(rank_properties, rank_setup.get_target_hits_max_adjustment_factor());
     auto fuzzy_matching_algorithm = FuzzyAlgorithm::lookup(rank_properties, rank_setup.get_fuzzy_matching_algorithm());
     double weakand_range = temporary::WeakAndRange::lookup(rank_properties, rank_setup.get_weakand_range());
+    bool weakand_block_max = temporary::WeakAndBlockMax::lookup(rank_properties, rank_setup.get_weakand_block_max());
 
     // Note that we count the reserved docid 0 as active.
     // This ensures that when searchable-copies=1, the ratio is 1.0.
@@ -360,7 +363,8 @@ MatchToolsFactory::extract_attribute_blueprint_params(const RankSetup& rank_setu
             upper_limit * active_hit_ratio,
             target_hits_max_adjustment_factor,
             fuzzy_matching_algorithm,
-            weakand_range};
+            weakand_range,
+            weakand_block_max};
 }
 
 AttributeOperationTask::AttributeOperationTask(const RequestContext & requestContext,
@@ -113,7 +113,8 @@ Matcher::Matcher(const search::index::Schema &schema, Properties props, const st
     _startTime(my_clock::now()),
     _now_ref(now_ref),
     _queryLimiter(queryLimiter),
-    _distributionKey(distributionKey)
+    _distributionKey(distributionKey),
+    _queryResultCache()
 {
     search::features::setup_search_features(_blueprintFactory);
     search::fef::test::setup_fef_test_plugin(_blueprintFactory);
@@ -123,6 +124,10 @@ Matcher::Matcher(const search::index::Schema &schema, Properties props, const st
         throw vespalib::IllegalArgumentException(fmt("failed to compile rank setup :\n%s",
                                                      _rankSetup->getJoinedWarnings().c_str()), VESPA_STRLOC);
     }
+    uint32_t queryResultCacheMaxEntries = QueryResultCacheMaxEntries::lookup(_indexEnv.getProperties());
+    if (queryResultCacheMaxEntries > 0) {
+        _queryResultCache = std::make_unique<QueryResultCache>(queryResultCacheMaxEntries);
+    }
 }
 
 Matcher::~Matcher() = default;
@@ -136,6 +141,12 @@ Matcher::getStats()
     return stats;
 }
 
+QueryResultCache::Stats
+Matcher::getQueryResultCacheStats()
+{
+    return _queryResultCache ? _queryResultCache->get_stats() : QueryResultCache::Stats();
+}
+
 std::unique_ptr<MatchToolsFactory>
 Matcher::create_match_tools_factory(const search::engine::Request &request, ISearchContext &searchContext,
                                     IAttributeContext &attrContext, const search::IDocumentMetaStore &metaStore,
@@ -250,6 +261,17 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
                 }
             }
         }
+        vespalib::string resultCacheKey;
+        uint64_t commitGeneration = searchContext.getCommitGeneration();
+        if (_queryResultCache) {
+            resultCacheKey = QueryResultCache::make_key(request);
+            if (!resultCacheKey.empty()) {
+                SearchReply::UP cached = _queryResultCache->lookup(resultCacheKey, commitGeneration);
+                if (cached) {
+                    return cached;
+                }
+            }
+        }
         const Properties *feature_overrides = &request.propertiesMap.featureOverrides();
         if (shouldCacheSearchSession) {
             // These should have been moved instead.
@@ -290,15 +312,19 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
         vespalib::LimitedThreadBundleWrapper limitedThreadBundle(threadBundle, numThreadsPerSearch);
         MatchMaster master;
         uint32_t numParts = NumSearchPartitions::lookup(rankProperties, _rankSetup->getNumSearchPartitions());
+        bool workStealing = WorkStealing::lookup(rankProperties, _rankSetup->get_work_stealing());
         if (limitedThreadBundle.size() > 1) {
             attrContext.enableMultiThreadSafe();
         }
         ResultProcessor::Result::UP result = master.match(request.trace(), params, limitedThreadBundle, *mtf, rp,
-                                                          _distributionKey, numParts);
+                                                          _distributionKey, numParts, workStealing);
         my_stats = MatchMaster::getStats(std::move(master));
         reply = std::move(result->_reply);
         Coverage & coverage = reply->coverage;
         updateCoverage(coverage, mtf->match_limiter(), my_stats, metaStore, bucketdb);
+        if (!resultCacheKey.empty() && !coverage.wasDegradedByTimeout()) {
+            _queryResultCache->insert(resultCacheKey, commitGeneration, *reply);
+        }
 
         LOG(debug, "numThreadsPerSearch = %zu. Configured = %d, estimated hits=%d, totalHits=%" PRIu64 ", rankprofile=%s",
             numThreadsPerSearch, _rankSetup->getNumThreadsPerSearch(), mtf->estimate().estHits, reply->totalHitCount,
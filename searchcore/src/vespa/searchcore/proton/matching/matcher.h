@@ -5,6 +5,7 @@
 #include "docsum_matcher.h"
 #include "indexenvironment.h"
 #include "matching_stats.h"
+#include "query_result_cache.h"
 #include "querylimiter.h"
 #include "search_session.h"
 #include "viewresolver.h"
@@ -69,6 +70,7 @@ private:
     const std::atomic<steady_time> &_now_ref;
     QueryLimiter                   &_queryLimiter;
     uint32_t                        _distributionKey;
+    std::unique_ptr<QueryResultCache> _queryResultCache;
 
     size_t computeNumThreadsPerSearch(search::queryeval::Blueprint::HitEstimate hits,
                                       const Properties & rankProperties) const;
@@ -103,6 +105,14 @@ public:
      **/
     MatchingStats getStats();
 
+    /**
+     * Observe and reset stats for the query result cache of this
+     * object. Empty stats are returned if the cache is not enabled.
+     *
+     * @return stats
+     **/
+    QueryResultCache::Stats getQueryResultCacheStats();
+
     /**
      * Create the low-level tools needed to perform matching. This
      * function is exposed for testing purposes.
@@ -124,6 +134,10 @@ public:
      * @param attrContext abstract view of attribute data
      * @param sessionManager multilevel grouping session cache
      * @param metaStore the document meta store used to map from lid to gid
+     *
+     * If the query result cache is enabled in the rank profile, the
+     * reply may be a copy of the reply to an identical request
+     * matched against the same commit generation.
      **/
     std::unique_ptr<search::engine::SearchReply>
     match(const SearchRequest &request, vespalib::ThreadBundle &threadBundle,
@@ -0,0 +1,146 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "query_result_cache.h"
+#include <vespa/searchlib/common/mapnames.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+#include <algorithm>
+
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using search::fef::IPropertiesVisitor;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace proton::matching {
+
+namespace {
+
+/*
+ * Properties are backed by a hash map, so the keys are sorted to give
+ * the same serialized form for requests with the same properties.
+ */
+class SortedProperties : public IPropertiesVisitor {
+    std::vector<std::pair<vespalib::string, std::vector<vespalib::string>>> _entries;
+public:
+    SortedProperties() : _entries() {}
+    ~SortedProperties() override;
+    void visitProperty(const Property::Value &key, const Property &values) override {
+        std::vector<vespalib::string> v;
+        v.reserve(values.size());
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            v.push_back(values.getAt(i));
+        }
+        _entries.emplace_back(key, std::move(v));
+    }
+    void serialize(const Properties &props, vespalib::nbostream &os) {
+        _entries.clear();
+        props.visitProperties(*this);
+        std::sort(_entries.begin(), _entries.end());
+        os << uint32_t(_entries.size());
+        for (const auto &entry : _entries) {
+            os << entry.first << uint32_t(entry.second.size());
+            for (const auto &value : entry.second) {
+                os << value;
+            }
+        }
+    }
+};
+
+SortedProperties::~SortedProperties() = default;
+
+}
+
+QueryResultCache::QueryResultCache(uint32_t max_entries)
+    : _lock(),
+      _cache(max_entries),
+      _generation(0),
+      _stats()
+{
+}
+
+QueryResultCache::~QueryResultCache() = default;
+
+vespalib::string
+QueryResultCache::make_key(const SearchRequest &request)
+{
+    const Properties &cache_props = request.propertiesMap.cacheProperties();
+    if (cache_props.lookup("query").found() || cache_props.lookup("grouping").found()) {
+        // The reply must be backed by a session
+        return {};
+    }
+    if (request.trace().getLevel() > 0) {
+        return {};
+    }
+    vespalib::nbostream os;
+    os << request.ranking << request.location << request.getStackRef();
+    os << request.sortSpec << std::string_view(request.groupSpec.data(), request.groupSpec.size());
+    os << request.offset << request.maxhits;
+    SortedProperties sorted;
+    sorted.serialize(request.propertiesMap.rankProperties(), os);
+    sorted.serialize(request.propertiesMap.featureOverrides(), os);
+    sorted.serialize(request.propertiesMap.matchProperties(), os);
+    return {os.peek(), os.size()};
+}
+
+void
+QueryResultCache::sync_generation(uint64_t generation)
+{
+    if (generation > _generation) {
+        _stats.numInvalidated += _cache.size();
+        Cache empty(_cache.capacity());
+        _cache.swap(empty);
+        _generation = generation;
+    }
+}
+
+std::unique_ptr<SearchReply>
+QueryResultCache::lookup(const vespalib::string &key, uint64_t generation)
+{
+    std::shared_ptr<const SearchReply> reply;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        sync_generation(generation);
+        auto *found = (generation == _generation) ? _cache.findAndRef(key) : nullptr;
+        if (found == nullptr) {
+            _stats.numMisses++;
+            return {};
+        }
+        _stats.numHits++;
+        reply = *found;
+    }
+    return std::make_unique<SearchReply>(*reply);
+}
+
+void
+QueryResultCache::insert(const vespalib::string &key, uint64_t generation, const SearchReply &reply)
+{
+    auto copy = std::make_shared<const SearchReply>(reply);
+    std::lock_guard<std::mutex> guard(_lock);
+    sync_generation(generation);
+    if (generation == _generation) {
+        _cache[key] = std::move(copy);
+        _stats.numInsert++;
+    }
+}
+
+QueryResultCache::Stats
+QueryResultCache::get_stats()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    Stats stats = _stats;
+    stats.numCached = _cache.size();
+    _stats = Stats();
+    return stats;
+}
+
+size_t
+QueryResultCache::size() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _cache.size();
+}
+
+}
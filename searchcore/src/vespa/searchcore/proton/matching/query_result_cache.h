@@ -0,0 +1,70 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/stllike/lrucache_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <mutex>
+
+namespace search::engine {
+    class SearchReply;
+    class SearchRequest;
+}
+
+namespace proton::matching {
+
+/**
+ * Cache of search replies for a rank profile, used to avoid matching
+ * identical queries over and over again when nothing has been fed in
+ * between.
+ *
+ * Entries are keyed on everything in the search request that affects
+ * the reply, and are tagged with the commit generation of the
+ * searchable data they were produced from. Seeing a newer commit
+ * generation invalidates all cached entries, while replies produced
+ * from an older commit generation are never inserted.
+ **/
+class QueryResultCache {
+public:
+    struct Stats {
+        Stats() noexcept
+            : numHits(0),
+              numMisses(0),
+              numInsert(0),
+              numInvalidated(0),
+              numCached(0)
+        {}
+        uint32_t numHits;
+        uint32_t numMisses;
+        uint32_t numInsert;
+        uint32_t numInvalidated;
+        uint32_t numCached;
+    };
+
+private:
+    using Reply = search::engine::SearchReply;
+    using Cache = vespalib::lrucache_map<vespalib::LruParam<vespalib::string, std::shared_ptr<const Reply>>>;
+
+    mutable std::mutex _lock;
+    Cache              _cache;
+    uint64_t           _generation;
+    Stats              _stats;
+
+    void sync_generation(uint64_t generation);
+public:
+    explicit QueryResultCache(uint32_t max_entries);
+    ~QueryResultCache();
+
+    /**
+     * Returns the cache key for the given request, or an empty key if
+     * the request should not be served from the cache.
+     **/
+    static vespalib::string make_key(const search::engine::SearchRequest &request);
+
+    std::unique_ptr<Reply> lookup(const vespalib::string &key, uint64_t generation);
+    void insert(const vespalib::string &key, uint64_t generation, const Reply &reply);
+    Stats get_stats();
+    size_t size() const;
+};
+
+}
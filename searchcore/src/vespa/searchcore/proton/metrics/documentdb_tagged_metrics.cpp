@@ -99,11 +99,27 @@ DocumentDBTaggedMetrics::AttributeMetrics::ResourceUsageMetrics::ResourceUsageMe
 
 DocumentDBTaggedMetrics::AttributeMetrics::ResourceUsageMetrics::~ResourceUsageMetrics() = default;
 
+DocumentDBTaggedMetrics::IndexMetrics::CacheMetrics::CacheMetrics(const vespalib::string &name,
+                                                                  const vespalib::string &description,
+                                                                  MetricSet *parent)
+    : MetricSet(name, {}, description, parent),
+      memoryUsage("memory_usage", {}, "Memory usage of the cache (in bytes)", this),
+      elements("elements", {}, "Number of elements in the cache", this),
+      hitRate("hit_rate", {}, "Rate of hits in the cache compared to number of lookups", this),
+      lookups("lookups", {}, "Number of lookups in the cache (hits + misses)", this),
+      evictions("evictions", {}, "Number of elements evicted from the cache to stay within its size limit", this)
+{
+}
+
+DocumentDBTaggedMetrics::IndexMetrics::CacheMetrics::~CacheMetrics() = default;
+
 DocumentDBTaggedMetrics::IndexMetrics::IndexMetrics(MetricSet *parent)
     : MetricSet("index", {}, "Index metrics (memory and disk) for this document db", parent),
       diskUsage("disk_usage", {}, "Disk space usage in bytes", this),
       memoryUsage(this),
-      docsInMemory("docs_in_memory", {}, "Number of documents in memory index", this)
+      docsInMemory("docs_in_memory", {}, "Number of documents in memory index", this),
+      postingListCache("posting_list_cache", "Disk index decoded posting list cache metrics", this),
+      bitVectorCache("bit_vector_cache", "Disk index bit vector cache metrics", this)
 {
 }
 
@@ -102,9 +102,23 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
 
     struct IndexMetrics : metrics::MetricSet
     {
+        struct CacheMetrics : metrics::MetricSet
+        {
+            metrics::LongValueMetric memoryUsage;
+            metrics::LongValueMetric elements;
+            metrics::LongAverageMetric hitRate;
+            metrics::LongCountMetric lookups;
+            metrics::LongCountMetric evictions;
+
+            CacheMetrics(const vespalib::string &name, const vespalib::string &description, metrics::MetricSet *parent);
+            ~CacheMetrics() override;
+        };
+
         metrics::LongValueMetric diskUsage;
         MemoryUsageMetrics memoryUsage;
         metrics::LongValueMetric docsInMemory;
+        CacheMetrics postingListCache;
+        CacheMetrics bitVectorCache;
 
         IndexMetrics(metrics::MetricSet *parent);
         ~IndexMetrics() override;
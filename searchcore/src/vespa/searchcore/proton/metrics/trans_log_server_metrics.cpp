@@ -13,7 +13,9 @@ TransLogServerMetrics::DomainMetrics::DomainMetrics(metrics::MetricSet *parent,
             "Transaction log metrics for a document type", parent),
       entries("entries", {}, "The current number of entries in the transaction log", this),
       diskUsage("disk_usage", {}, "The disk usage (in bytes) of the transaction log", this),
-      replayTime("replay_time", {}, "The replay time (in seconds) of the transaction log during start-up", this)
+      replayTime("replay_time", {}, "The replay time (in seconds) of the transaction log during start-up", this),
+      commitQueueDepth("commit_queue_depth", {}, "The number of committed chunks waiting to be written or synced", this),
+      chunksPerSync("chunks_per_sync", {}, "The average number of chunks covered by each sync of the transaction log", this)
 {
 }
 
@@ -25,6 +27,10 @@ TransLogServerMetrics::DomainMetrics::update(const DomainInfo &stats)
     entries.set(stats.numEntries);
     diskUsage.set(stats.byteSize);
     replayTime.set(stats.maxSessionRunTime.count());
+    commitQueueDepth.set(stats.pendingCommits);
+    if (stats.numSyncs > 0) {
+        chunksPerSync.set(double(stats.numCommittedChunks) / stats.numSyncs);
+    }
 }
 
 void
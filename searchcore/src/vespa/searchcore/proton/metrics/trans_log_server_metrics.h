@@ -19,6 +19,8 @@ public:
         metrics::LongValueMetric entries;
         metrics::LongValueMetric diskUsage;
         metrics::DoubleValueMetric replayTime;
+        metrics::LongValueMetric commitQueueDepth;
+        metrics::DoubleValueMetric chunksPerSync;
 
         using UP = std::unique_ptr<DomainMetrics>;
         DomainMetrics(metrics::MetricSet *parent, const vespalib::string &documentType);
@@ -74,7 +74,9 @@ namespace {
 
 index::IndexConfig
 makeIndexConfig(const ProtonConfig::Index & cfg) {
-    return {WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), size_t(cfg.maxflushed), size_t(cfg.cache.size)};
+    return {WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), size_t(cfg.maxflushed), size_t(cfg.cache.size),
+            size_t(cfg.cache.bitvector.maxbytes), size_t(cfg.cache.postinglist.maxbytes), cfg.blockmax,
+            uint32_t(std::max(cfg.fusion.maxfieldpartitions, 1)), uint64_t(std::max(cfg.fusion.minfieldpartitionsize, int64_t(0)))};
 }
 
 ReplayThrottlingPolicy
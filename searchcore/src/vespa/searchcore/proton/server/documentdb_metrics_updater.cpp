@@ -44,6 +44,7 @@ DocumentDBMetricsUpdater::DocumentDBMetricsUpdater(const DocumentSubDBCollection
       _writeFilter(writeFilter),
       _feed_handler(feed_handler),
       _lastDocStoreCacheStats(),
+      _last_index_cache_stats(),
       _last_feed_handler_stats()
 {
 }
@@ -241,6 +242,55 @@ updateCountMetric(uint64_t currVal, uint64_t lastVal, metrics::LongCountMetric &
     metric.inc(delta);
 }
 
+CacheStats
+index_cache_stats_delta(const CacheStats &cacheStats, const CacheStats &lastCacheStats)
+{
+    if (cacheStats.hits < lastCacheStats.hits || cacheStats.misses < lastCacheStats.misses ||
+        cacheStats.evictions < lastCacheStats.evictions)
+    {
+        // The disk index was reloaded with new caches, counting restarted from zero.
+        return cacheStats;
+    }
+    CacheStats delta;
+    delta.hits = cacheStats.hits - lastCacheStats.hits;
+    delta.misses = cacheStats.misses - lastCacheStats.misses;
+    delta.evictions = cacheStats.evictions - lastCacheStats.evictions;
+    return delta;
+}
+
+void
+update_index_cache_metrics(DocumentDBTaggedMetrics::IndexMetrics::CacheMetrics &metrics,
+                           const CacheStats &cacheStats, const CacheStats &delta, TotalStats &totalStats)
+{
+    totalStats.memoryUsage.incAllocatedBytes(cacheStats.memory_used);
+    metrics.memoryUsage.set(cacheStats.memory_used);
+    metrics.elements.set(cacheStats.elements);
+    metrics.hitRate.addTotalValueWithCount(delta.hits, delta.lookups());
+    metrics.lookups.inc(delta.lookups());
+    metrics.evictions.inc(delta.evictions);
+}
+
+void
+update_index_cache_metrics(DocumentDBTaggedMetrics::IndexMetrics &metrics, const search::SearchableStats &stats,
+                           DocumentDBMetricsUpdater::IndexCacheStats &lastCacheStats, TotalStats &totalStats)
+{
+    // Deltas are computed per disk index, as disk indexes (and their caches) come and go with fusion.
+    search::DiskIndexCacheStats sum;
+    search::DiskIndexCacheStats delta;
+    const search::DiskIndexCacheStats no_stats;
+    for (const auto &[index_dir, cacheStats] : stats.disk_index_cache_stats()) {
+        auto itr = lastCacheStats.find(index_dir);
+        const auto &last = (itr != lastCacheStats.end()) ? itr->second : no_stats;
+        sum.posting_list += cacheStats.posting_list;
+        sum.bit_vector += cacheStats.bit_vector;
+        delta.posting_list += index_cache_stats_delta(cacheStats.posting_list, last.posting_list);
+        delta.bit_vector += index_cache_stats_delta(cacheStats.bit_vector, last.bit_vector);
+    }
+    update_index_cache_metrics(metrics.postingListCache, sum.posting_list, delta.posting_list, totalStats);
+    update_index_cache_metrics(metrics.bitVectorCache, sum.bit_vector, delta.bit_vector, totalStats);
+    lastCacheStats = stats.disk_index_cache_stats();
+}
+
 void
 updateDocumentStoreMetrics(DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics &metrics,
                            const IDocumentSubDB *subDb,
@@ -315,7 +365,9 @@ DocumentDBMetricsUpdater::updateMetrics(const metrics::MetricLockGuard & guard,
 {
     TotalStats totalStats;
     ExecutorThreadingServiceStats threadingServiceStats = _writeService.getStats();
-    updateIndexMetrics(metrics, _subDBs.getReadySubDB()->getSearchableStats(), totalStats);
+    auto index_stats = _subDBs.getReadySubDB()->getSearchableStats();
+    updateIndexMetrics(metrics, index_stats, totalStats);
+    update_index_cache_metrics(metrics.index, index_stats, _last_index_cache_stats, totalStats);
     updateAttributeMetrics(metrics, _subDBs, totalStats);
     updateMatchingMetrics(guard, metrics, *_subDBs.getReadySubDB());
     updateDocumentsMetrics(metrics, _subDBs);
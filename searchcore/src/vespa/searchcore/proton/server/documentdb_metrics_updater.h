@@ -3,7 +3,9 @@
 
 #include "feed_handler_stats.h"
 #include <vespa/searchcore/proton/metrics/documentdb_tagged_metrics.h>
+#include <vespa/searchlib/util/searchable_stats.h>
 #include <vespa/vespalib/stllike/cache_stats.h>
+#include <map>
 #include <optional>
 
 namespace proton {
@@ -29,6 +31,9 @@ public:
         DocumentStoreCacheStats() : readySubDb(), notReadySubDb(), removedSubDb() {}
     };
 
+    // Disk index cache statistics, keyed by disk index directory.
+    using IndexCacheStats = std::map<vespalib::string, search::DiskIndexCacheStats>;
+
 private:
     const DocumentSubDBCollection &_subDBs;
     ExecutorThreadingService      &_writeService;
@@ -37,6 +42,7 @@ private:
     FeedHandler                   &_feed_handler;
     // Last updated document store cache statistics. Necessary due to metrics implementation is upside down.
     DocumentStoreCacheStats        _lastDocStoreCacheStats;
+    IndexCacheStats                _last_index_cache_stats;
     std::optional<FeedHandlerStats> _last_feed_handler_stats;
 
     void updateMiscMetrics(DocumentDBTaggedMetrics &metrics, const ExecutorThreadingServiceStats &threadingServiceStats);
@@ -175,6 +175,17 @@ getStoreConfig(const ProtonConfig::Summary::Cache & cache, const vespalib::HwInf
             .updateStrategy(derive(cache.updateStrategy));
 }
 
+LogDataStore::Config::CompactOrder
+derive(ProtonConfig::Summary::Log::Compact::Order order) {
+    switch (order) {
+        case ProtonConfig::Summary::Log::Compact::Order::BUCKET:
+            return LogDataStore::Config::CompactOrder::BUCKET;
+        case ProtonConfig::Summary::Log::Compact::Order::LID:
+            return LogDataStore::Config::CompactOrder::LID;
+    }
+    return LogDataStore::Config::CompactOrder::BUCKET;
+}
+
 LogDocumentStore::Config
 deriveConfig(const ProtonConfig::Summary & summary, const vespalib::HwInfo & hwInfo) {
     DocumentStore::Config config(getStoreConfig(summary.cache, hwInfo));
@@ -186,6 +197,8 @@ deriveConfig(const ProtonConfig::Summary & summary, const vespalib::HwInfo & hwI
             .setMaxNumLids(log.maxnumlids)
             .setMaxBucketSpread(log.maxbucketspread).setMinFileSizeFactor(log.minfilesizefactor)
             .compactCompression(deriveCompression(log.compact.compression))
+            .setCompactDictionarySize(log.compact.dictionary.maxbytes)
+            .setCompactOrder(derive(log.compact.order))
             .setFileConfig(fileConfig);
     return {config, logConfig};
 }
@@ -56,6 +56,10 @@ ignoreOperation(const DocumentOperation &op) {
     return (op.getPrevTimestamp() != 0) && (op.getTimestamp() < op.getPrevTimestamp());
 }
 
+// Number of transaction log packets that can be decoded and queued for replay
+// while the master thread is replaying the oldest one.
+constexpr size_t MAX_REPLAY_PACKETS_IN_FLIGHT = 8;
+
 class TlsMgrWriter : public TlsWriter {
     TransactionLogManager &_tls_mgr;
     std::shared_ptr<search::transactionlog::Writer> _writer;
@@ -417,6 +421,7 @@ FeedHandler::FeedHandler(IThreadingService &writeService,
       _tlsMgrWriter(),
       _tlsWriter(tlsWriter),
       _tlsReplayProgress(),
+      _replayPacketsInFlight(),
       _serialNum(0),
       _prunedSerialNum(0),
       _replay_end_serial_num(0),
@@ -475,7 +480,8 @@ FeedHandler::replayTransactionLog(SerialNum flushedIndexMgrSerial, SerialNum flu
     assert(_activeFeedView);
     assert(_bucketDBHandler);
     auto state = make_shared<ReplayTransactionLogState>
-                          (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig, config_store, replay_throttling_policy, *this);
+                          (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig, config_store, replay_throttling_policy, *this,
+                           _writeService.shared());
     changeFeedState(state);
     // Resurrected attribute vector might cause oldestFlushedSerial to
     // be lower than _prunedSerialNum, so don't warn for now.
@@ -784,17 +790,33 @@ FeedHandler::RPC::Result
 FeedHandler::receive(const Packet &packet)
 {
     // Called directly when replaying transaction log (by fnet thread).
+    // Returns before the packet is replayed, to let the next packet be fetched and decoded meanwhile.
     FeedStateSP state = getFeedState();
     auto wrap = make_shared<PacketWrapper>(packet, _tlsReplayProgress.get());
     state->receive(wrap, _writeService.master());
-    wrap->gate.await();
-    return wrap->result;
+    _replayPacketsInFlight.push_back(std::move(wrap));
+    RPC::Result result = RPC::OK;
+    while ((result == RPC::OK) && !_replayPacketsInFlight.empty() &&
+           ((_replayPacketsInFlight.size() > MAX_REPLAY_PACKETS_IN_FLIGHT) ||
+            (_replayPacketsInFlight.front()->gate.getCount() == 0)))
+    {
+        _replayPacketsInFlight.front()->gate.await();
+        result = _replayPacketsInFlight.front()->result;
+        _replayPacketsInFlight.pop_front();
+    }
+    return result;
 }
 
 void
 FeedHandler::eof()
 {
     // Only called by visit, subscription gets one or more inSync() callbacks.
+    // The packets still in flight are handed to the master thread when decoded, wait for them to be
+    // replayed to ensure that eof is performed after them.
+    for (const auto &wrap : _replayPacketsInFlight) {
+        wrap->gate.await();
+    }
+    _replayPacketsInFlight.clear();
     _writeService.master().execute(makeLambdaTask([this]() { performEof(); }));
 }
 
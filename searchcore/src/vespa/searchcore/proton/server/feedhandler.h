@@ -15,6 +15,7 @@
 #include <vespa/searchcore/proton/common/doctypename.h>
 #include <vespa/searchcore/proton/common/feedtoken.h>
 #include <vespa/searchlib/transactionlog/client_common.h>
+#include <deque>
 #include <shared_mutex>
 
 namespace searchcorespi::index { struct IThreadingService; }
@@ -33,6 +34,7 @@ class IFeedView;
 struct IResourceWriteFilter;
 class IReplayConfig;
 class JoinBucketsOperation;
+struct PacketWrapper;
 class PutOperation;
 class RemoveOperation;
 class ReplayThrottlingPolicy;
@@ -75,6 +77,8 @@ private:
     std::unique_ptr<TlsWriter>             _tlsMgrWriter;
     TlsWriter                             *_tlsWriter;
     TlsReplayProgress::UP                  _tlsReplayProgress;
+    // Packets received from the transaction log, but not yet known to be replayed.
+    std::deque<std::shared_ptr<PacketWrapper>> _replayPacketsInFlight;
     // the serial num of the last feed operation processed by feed handler.
     std::atomic<SerialNum>                 _serialNum;
     // the serial num considered to be fully procssessed and flushed to stable storage. Used to prune transaction log.
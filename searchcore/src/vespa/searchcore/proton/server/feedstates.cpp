@@ -14,10 +14,12 @@
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/shared_operation_throttler.h>
 #include <cassert>
+#include <deque>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.feedstates");
 
+using document::DocumentTypeRepo;
 using search::transactionlog::Packet;
 using search::transactionlog::client::RPC;
 using search::SerialNum;
@@ -147,26 +149,48 @@ public:
     }
 };
 
+// Operations deserialized ahead of replay, in the same order as the packet entries.
+// Might cover only a prefix of the entries, ending before the first new config operation.
+using DecodedOperations = std::vector<std::unique_ptr<FeedOperation>>;
+
+DecodedOperations
+decodePacket(const Packet &packet, const DocumentTypeRepo &repo)
+{
+    DecodedOperations decoded;
+    decoded.reserve(packet.size());
+    vespalib::nbostream_longlivedbuf handle(packet.getHandle().data(), packet.getHandle().size());
+    while ( !handle.empty() ) {
+        Packet::Entry entry;
+        entry.deserialize(handle);
+        auto op = ReplayPacketDispatcher::deserializeEntry(entry, repo);
+        if ( ! op) {
+            break;
+        }
+        decoded.push_back(std::move(op));
+    }
+    return decoded;
+}
+
 class PacketDispatcher {
 public:
     PacketDispatcher(IReplayPacketHandler *packet_handler)
         : _packet_handler(packet_handler)
     {}
 
-    void handlePacket(PacketWrapper & wrap);
+    void handlePacket(PacketWrapper & wrap, const DecodedOperations &decoded);
 private:
-    void handleEntry(const Packet::Entry &entry);
+    void handleEntry(const Packet::Entry &entry, const FeedOperation *decoded);
     IReplayPacketHandler *_packet_handler;
 };
 
 void
-PacketDispatcher::handlePacket(PacketWrapper & wrap)
+PacketDispatcher::handlePacket(PacketWrapper & wrap, const DecodedOperations &decoded)
 {
     vespalib::nbostream_longlivedbuf handle(wrap.packet.getHandle().data(), wrap.packet.getHandle().size());
-    while ( !handle.empty() ) {
+    for (size_t i(0); !handle.empty(); ++i) {
         Packet::Entry entry;
         entry.deserialize(handle);
-        handleEntry(entry);
+        handleEntry(entry, (i < decoded.size()) ? decoded[i].get() : nullptr);
         if (wrap.progress != nullptr) {
             handleProgress(*wrap.progress, entry.serial());
         }
@@ -176,19 +200,43 @@ PacketDispatcher::handlePacket(PacketWrapper & wrap)
 }
 
 void
-PacketDispatcher::handleEntry(const Packet::Entry &entry) {
+PacketDispatcher::handleEntry(const Packet::Entry &entry, const FeedOperation *decoded) {
     // Called by handlePacket() in executor thread.
     LOG(spam, "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)", entry.serial(), entry.type());
 
     auto entry_serial_num = entry.serial();
     _packet_handler->check_serial_num(entry_serial_num);
     ReplayPacketDispatcher dispatcher(*_packet_handler);
-    dispatcher.replayEntry(entry);
+    if (decoded != nullptr) {
+        dispatcher.replayOperation(*decoded);
+    } else {
+        dispatcher.replayEntry(entry);
+    }
     _packet_handler->optionalCommit(entry_serial_num);
 }
 
 }  // namespace
 
+struct ReplayTransactionLogState::DecodedPacket {
+    PacketWrapper::SP  wrap;
+    DocumentTypeRepoSP repo;
+    Executor          &executor;
+    DecodedOperations  decoded;
+    bool               done;
+    DecodedPacket(PacketWrapper::SP wrap_in, DocumentTypeRepoSP repo_in, Executor &executor_in) noexcept
+        : wrap(std::move(wrap_in)),
+          repo(std::move(repo_in)),
+          executor(executor_in),
+          decoded(),
+          done(false)
+    { }
+};
+
+struct ReplayTransactionLogState::DecodeQueue {
+    std::mutex                                 lock;
+    std::deque<std::shared_ptr<DecodedPacket>> packets;
+};
+
 ReplayTransactionLogState::ReplayTransactionLogState(
         const vespalib::string &name,
         IFeedView *& feed_view_ptr,
@@ -196,19 +244,83 @@ ReplayTransactionLogState::ReplayTransactionLogState(
         IReplayConfig &replay_config,
         FeedConfigStore &config_store,
         const ReplayThrottlingPolicy &replay_throttling_policy,
-        IIncSerialNum& inc_serial_num)
+        IIncSerialNum& inc_serial_num,
+        Executor &decode_executor)
     : FeedState(REPLAY_TRANSACTION_LOG),
       _doc_type_name(name),
-      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store, replay_throttling_policy, inc_serial_num))
+      _feed_view_ptr(feed_view_ptr),
+      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store, replay_throttling_policy, inc_serial_num)),
+      _decode_executor(decode_executor),
+      _decode_repo_lock(),
+      _decode_repo(feed_view_ptr->getDocumentTypeRepo()),
+      _decode_queue(std::make_shared<DecodeQueue>())
 { }
 
 ReplayTransactionLogState::~ReplayTransactionLogState() = default;
 
+ReplayTransactionLogState::DocumentTypeRepoSP
+ReplayTransactionLogState::get_decode_repo() const
+{
+    std::lock_guard guard(_decode_repo_lock);
+    return _decode_repo;
+}
+
+bool
+ReplayTransactionLogState::is_current_repo(const DocumentTypeRepoSP &repo)
+{
+    // Called in executor thread, where the active feed view can change.
+    const DocumentTypeRepoSP &current = _feed_view_ptr->getDocumentTypeRepo();
+    if (current == repo) {
+        return true;
+    }
+    std::lock_guard guard(_decode_repo_lock);
+    _decode_repo = current;
+    return false;
+}
+
+void
+ReplayTransactionLogState::decoding_done(ReplayTransactionLogState *state, DecodeQueue &queue, DecodedPacket &packet)
+{
+    // Called in decode executor thread. Replay is handed to the master executor while
+    // holding the lock, to keep the packets in the order they were received.
+    std::lock_guard guard(queue.lock);
+    packet.done = true;
+    while (!queue.packets.empty() && queue.packets.front()->done) {
+        auto front = std::move(queue.packets.front());
+        queue.packets.pop_front();
+        front->executor.execute(makeLambdaTask([state, front]() { state->replay(*front); }));
+    }
+}
+
+void
+ReplayTransactionLogState::replay(DecodedPacket &packet)
+{
+    // Called in master executor thread.
+    if ( ! is_current_repo(packet.repo)) {
+        // A new config was replayed after the packet was decoded, deserialize it again.
+        packet.decoded.clear();
+    }
+    PacketDispatcher dispatcher(_packet_handler.get());
+    dispatcher.handlePacket(*packet.wrap, packet.decoded);
+    // Let the following packets be decoded with the repo of a config replayed by this packet.
+    is_current_repo(packet.repo);
+}
+
 void
 ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap, Executor &executor) {
-    executor.execute(makeLambdaTask([this, wrap = wrap] () {
-        PacketDispatcher dispatcher(_packet_handler.get());
-        dispatcher.handlePacket(*wrap);
+    auto packet = std::make_shared<DecodedPacket>(wrap, get_decode_repo(), executor);
+    {
+        std::lock_guard guard(_decode_queue->lock);
+        _decode_queue->packets.push_back(packet);
+    }
+    _decode_executor.execute(makeLambdaTask([state = this, queue = _decode_queue, packet = std::move(packet)]() {
+        try {
+            packet->decoded = decodePacket(packet->wrap->packet, *packet->repo);
+        } catch (...) {
+            // Deserialized again when replayed, either with a newer repo or failing as before.
+            packet->decoded.clear();
+        }
+        decoding_done(state, *queue, *packet);
     }));
 }
 
@@ -7,6 +7,9 @@
 #include "packetwrapper.h"
 #include "ireplaypackethandler.h"
 #include <vespa/searchcore/proton/common/commit_time_tracker.h>
+#include <mutex>
+
+namespace document { class DocumentTypeRepo; }
 
 namespace proton {
 
@@ -44,10 +47,29 @@ public:
 /**
  * The feed handler is replaying the transaction log.
  * Replayed messages from the transaction log are sent to the active feed view.
+ *
+ * Packets are deserialized by the decode executor, ahead of being replayed
+ * in order by the master executor. The replay of a packet is handed to the
+ * master executor when it and all packets received before it are decoded,
+ * so the master thread never waits for decoding.
  */
 class ReplayTransactionLogState : public FeedState {
+    using DocumentTypeRepoSP = std::shared_ptr<const document::DocumentTypeRepo>;
+    struct DecodedPacket;
+    struct DecodeQueue;
     vespalib::string _doc_type_name;
+    IFeedView *& _feed_view_ptr;
     std::unique_ptr<IReplayPacketHandler> _packet_handler;
+    vespalib::Executor &_decode_executor;
+    mutable std::mutex _decode_repo_lock;
+    DocumentTypeRepoSP _decode_repo;
+    // Shared with decode tasks, which might still be running when this state is destroyed.
+    std::shared_ptr<DecodeQueue> _decode_queue;
+
+    DocumentTypeRepoSP get_decode_repo() const;
+    bool is_current_repo(const DocumentTypeRepoSP &repo);
+    static void decoding_done(ReplayTransactionLogState *state, DecodeQueue &queue, DecodedPacket &packet);
+    void replay(DecodedPacket &packet);
 
 public:
     ReplayTransactionLogState(const vespalib::string &name,
@@ -56,7 +78,8 @@ public:
             IReplayConfig &replay_config,
             FeedConfigStore &config_store,
             const ReplayThrottlingPolicy &replay_throttling_policy,
-            IIncSerialNum &inc_serial_num);
+            IIncSerialNum &inc_serial_num,
+            vespalib::Executor &decode_executor);
 
     ~ReplayTransactionLogState() override;
     void handleOperation(FeedToken, FeedOperationUP op) override {
@@ -58,7 +58,11 @@ MatchView::getMatcher(const vespalib::string & rankProfile) const
 
 MatchContext
 MatchView::createContext() const {
-    auto searchCtx = std::make_unique<SearchContext>(_indexSearchable, _docIdLimit.get());
+    // Sample the commit generation before the docid limit, to never tag results with a too new generation.
+    // Bucket (de)activation changes the active lids without touching the docid limit, so the lid state
+    // generation of the meta store is folded in as well.
+    uint64_t commitGeneration = _docIdLimit.getCommitGeneration() + _metaStore->get().get_lid_state_generation();
+    auto searchCtx = std::make_unique<SearchContext>(_indexSearchable, _docIdLimit.get(), commitGeneration);
     return {_attrMgr->createContext(), std::move(searchCtx)};
 }
 
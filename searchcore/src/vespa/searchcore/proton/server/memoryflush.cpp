@@ -2,11 +2,13 @@
 
 #include "memoryflush.h"
 #include <vespa/searchcore/proton/flushengine/active_flush_stats.h>
+#include <vespa/searchcore/proton/flushengine/flush_write_budget.h>
 #include <vespa/searchcore/proton/flushengine/tls_stats_map.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/stllike/hash_set.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/time.h>
+#include <algorithm>
 #include <cinttypes>
 
 #include <vespa/log/log.h>
@@ -84,7 +86,8 @@ MemoryFlush::Config::toString() const {
 MemoryFlush::MemoryFlush(const Config &config, vespalib::system_time startTime)
     : _lock(),
       _config(config),
-      _startTime(startTime)
+      _startTime(startTime),
+      _write_budget()
 { }
 
 
@@ -108,6 +111,20 @@ MemoryFlush::setConfig(const Config &config)
     _config = config;
 }
 
+void
+MemoryFlush::set_write_budget(std::shared_ptr<flushengine::FlushWriteBudget> write_budget)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _write_budget = std::move(write_budget);
+}
+
+std::shared_ptr<flushengine::FlushWriteBudget>
+MemoryFlush::get_write_budget() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _write_budget;
+}
+
 namespace {
 
 vespalib::string
@@ -128,6 +145,22 @@ computeGain(const IFlushTarget::DiskGain & gain) {
     return std::max(INT64_C(100000000), std::max(gain.getBefore(), gain.getAfter()));
 }
 
+/*
+ * Benefit of flushing a target per byte written to disk. The benefit is the memory
+ * freed and the replay cost saved, where replaying the part of the transaction log
+ * needed by the target is weighted by the target's replay operation cost.
+ */
+double
+benefitPerByte(const FlushContext &ctx, const flushengine::TlsStatsMap &tlsStatsMap)
+{
+    const IFlushTarget &target = *ctx.getTarget();
+    const flushengine::TlsStats &tlsStats = tlsStatsMap.getTlsStats(ctx.getHandler()->getName());
+    double memoryGain = std::max(INT64_C(0), target.getApproxMemoryGain().gain());
+    double replayCost = estimateNeededTlsSizeForFlushTarget(tlsStats, target.getFlushedSerialNum()) *
+                        target.get_replay_operation_cost();
+    return (memoryGain + replayCost) / std::max(target.getApproxBytesToWriteToDisk(), UINT64_C(1));
+}
+
 }
 
 FlushContext::List
@@ -140,6 +173,9 @@ MemoryFlush::getFlushTargets(const FlushContext::List& targetList,
     IFlushTarget::DiskGain totalDisk;
     uint64_t totalTlsSize(0);
     const Config config(getConfig());
+    auto write_budget = get_write_budget();
+    double hardLimitFactor = write_budget ? write_budget->hard_limit_factor() : 1.0;
+    bool hardLimitReached = false;
     vespalib::hash_set<const void *> visitedHandlers;
     vespalib::system_time now(vespalib::system_clock::now());
     LOG(debug,
@@ -172,8 +208,14 @@ MemoryFlush::getFlushTargets(const FlushContext::List& targetList,
                 if ((totalTlsSize > config.maxGlobalTlsSize) && (order < TLSSIZE)) {
                     order = TLSSIZE;
                 }
+                if (totalTlsSize > config.maxGlobalTlsSize * hardLimitFactor) {
+                    hardLimitReached = true;
+                }
             }
         }
+        if (mgain >= config.maxMemoryGain * hardLimitFactor) {
+            hardLimitReached = true;
+        }
         if ((mgain >= config.maxMemoryGain) && (order < MEMORY)) {
             order = MEMORY;
         } else if ((dgain.gain() > config.diskBloatFactor * computeGain(dgain)) && (order < DISKBLOAT)) {
@@ -184,12 +226,13 @@ MemoryFlush::getFlushTargets(const FlushContext::List& targetList,
         LOG(debug,
             "getFlushTargets(): target(%s), totalMemoryGain(%" PRIu64 "), memoryGain(%" PRIu64 "), "
             "totalDiskGain(%" PRId64 "), diskGain(%" PRId64 "), "
-            "tlsSize(%" PRIu64 "), tlsSizeNeeded(%" PRIu64 "), "
+            "tlsSize(%" PRIu64 "), tlsSizeNeeded(%" PRIu64 "), bytesToWrite(%" PRIu64 "), "
             "flushedSerial(%" PRIu64 "), localLastSerial(%" PRIu64 "), serialDiff(%" PRId64 "), "
             "lastFlushTime(%fs), nowTime(%fs), timeDiff(%fs), order(%s)",
             ctx->getName().c_str(), totalMemory, mgain,
             totalDisk.gain(), dgain.gain(),
             tlsStats.getNumBytes(), estimateNeededTlsSizeForFlushTarget(tlsStats, target.getFlushedSerialNum()),
+            target.getApproxBytesToWriteToDisk(),
             target.getFlushedSerialNum(), localLastSerial, serialDiff,
             vespalib::to_s(lastFlushTime.time_since_epoch()),
             vespalib::to_s(now.time_since_epoch()),
@@ -200,6 +243,9 @@ MemoryFlush::getFlushTargets(const FlushContext::List& targetList,
         if ((totalMemory >= config.maxGlobalMemory) && (order < MEMORY)) {
             order = MEMORY;
         }
+        if (totalMemory >= config.maxGlobalMemory * hardLimitFactor) {
+            hardLimitReached = true;
+        }
         if ((totalDisk.gain() > config.globalDiskBloatFactor * computeGain(totalDisk)) && (order < DISKBLOAT)) {
             order = DISKBLOAT;
         }
@@ -213,6 +259,38 @@ MemoryFlush::getFlushTargets(const FlushContext::List& targetList,
         LOG(debug, "getFlushTargets(): empty list");
         return FlushContext::List();
     }
+    if (order != DISKBLOAT && !hardLimitReached && write_budget && write_budget->enabled()) {
+        // Pace flushes until disk bloat or a hard memory or tls limit forces them. Urgent targets
+        // keep their place first, while the budget is spent on the other targets giving the
+        // highest benefit per byte written.
+        auto first_non_urgent = std::stable_partition(fv.begin(), fv.end(), [](const FlushContext::SP &ctx) {
+            return ctx->getTarget()->needUrgentFlush();
+        });
+        std::vector<std::pair<double, FlushContext::SP>> ranked;
+        for (auto itr = first_non_urgent; itr != fv.end(); ++itr) {
+            ranked.emplace_back(benefitPerByte(**itr, tlsStatsMap), *itr);
+        }
+        std::stable_sort(ranked.begin(), ranked.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.first > rhs.first;
+        });
+        fv.erase(first_non_urgent, fv.end());
+        auto steady_now = vespalib::steady_clock::now();
+        uint64_t charged = 0;
+        size_t deferred = 0;
+        for (auto &entry : ranked) {
+            uint64_t bytes = entry.second->getTarget()->getApproxBytesToWriteToDisk();
+            if (write_budget->can_afford(charged + bytes, steady_now)) {
+                charged += bytes;
+                fv.push_back(std::move(entry.second));
+            } else {
+                ++deferred;
+            }
+        }
+        if (deferred != 0) {
+            LOG(debug, "getFlushTargets(): %zu targets deferred by write budget", deferred);
+            write_budget->note_deferred();
+        }
+    }
     if (LOG_WOULD_LOG(debug)) {
         vespalib::asciistream oss;
         for (size_t i = 0; i < fv.size(); ++i) {
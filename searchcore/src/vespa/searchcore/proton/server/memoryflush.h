@@ -5,6 +5,8 @@
 #include <vespa/vespalib/util/time.h>
 #include <mutex>
 
+namespace proton::flushengine { class FlushWriteBudget; }
+
 namespace proton {
 
 class MemoryFlush : public IFlushStrategy
@@ -55,6 +57,8 @@ private:
     Config             _config;
     /// The time when the strategy was started.
     vespalib::system_time  _startTime;
+    /// Budget used to pace flushes not needed to relieve disk bloat or hard memory or tls pressure.
+    std::shared_ptr<flushengine::FlushWriteBudget> _write_budget;
 
     class CompareTarget
     {
@@ -85,6 +89,8 @@ public:
 
     void setConfig(const Config &config);
     Config getConfig() const;
+    void set_write_budget(std::shared_ptr<flushengine::FlushWriteBudget> write_budget);
+    std::shared_ptr<flushengine::FlushWriteBudget> get_write_budget() const;
 };
 
 } // namespace proton
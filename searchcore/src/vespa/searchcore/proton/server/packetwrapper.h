@@ -10,18 +10,19 @@
 namespace proton {
 /**
  * Wrapper of transaction log packet to use when handing over to
- * executor thread.
+ * executor thread. The packet is copied, as it is replayed after
+ * the call receiving it has returned.
  */
 struct PacketWrapper {
     using SP = std::shared_ptr<PacketWrapper>;
 
-    const search::transactionlog::Packet &packet;
+    search::transactionlog::Packet packet;
     TlsReplayProgress *progress;
     search::transactionlog::client::RPC::Result result;
     vespalib::Gate gate;
 
-    PacketWrapper(const search::transactionlog::Packet &p, TlsReplayProgress *progress_) noexcept
-        : packet(p),
+    PacketWrapper(const search::transactionlog::Packet &p, TlsReplayProgress *progress_)
+        : packet(p.getHandle().data(), p.getHandle().size()),
           progress(progress_),
           result(search::transactionlog::client::RPC::ERROR),
           gate()
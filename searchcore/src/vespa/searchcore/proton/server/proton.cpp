@@ -25,6 +25,7 @@
 #include <vespa/metrics/updatehook.h>
 #include <vespa/searchcore/proton/attribute/i_attribute_usage_listener.h>
 #include <vespa/searchcore/proton/flushengine/flush_engine_explorer.h>
+#include <vespa/searchcore/proton/flushengine/flush_write_budget.h>
 #include <vespa/searchcore/proton/flushengine/flushengine.h>
 #include <vespa/searchcore/proton/flushengine/tls_stats_factory.h>
 #include <vespa/searchcore/proton/matchengine/matchengine.h>
@@ -122,6 +123,13 @@ diskMemUsageSamplerConfig(const ProtonConfig &proton, const vespalib::HwInfo &hw
              hwInfo };
 }
 
+void
+set_flush_write_budget(FlushEngine &flush_engine, const ProtonConfig::Flush::Memory &cfg)
+{
+    flush_engine.get_write_budget()->set_limit(cfg.write.bandwidth, cfg.write.burstsize, vespalib::steady_clock::now());
+    flush_engine.get_write_budget()->set_hard_limit_factor(cfg.write.hardlimitfactor);
+}
+
 uint32_t
 computeRpcTransportThreads(const ProtonConfig & cfg, const vespalib::HwInfo::Cpu &cpuInfo) {
     bool areSearchAndDocsumAsync = cfg.docsum.async && cfg.search.async;
@@ -305,7 +313,8 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _matchEngine = std::make_unique<MatchEngine>(protonConfig.numsearcherthreads,
                                                  getNumThreadsPerSearch(),
                                                  protonConfig.distributionkey,
-                                                 protonConfig.search.async);
+                                                 protonConfig.search.async,
+                                                 protonConfig.search.numapinning);
     _matchEngine->set_issue_forwarding(protonConfig.forwardIssues);
     _distributionKey = protonConfig.distributionkey;
     _summaryEngine = std::make_unique<SummaryEngine>(protonConfig.numsummarythreads, protonConfig.docsum.async);
@@ -313,10 +322,11 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _sessionManager = std::make_unique<matching::SessionManager>(protonConfig.grouping.sessionmanager.maxentries);
 
     IFlushStrategy::SP strategy;
+    std::shared_ptr<MemoryFlush> memoryFlush;
     const ProtonConfig::Flush & flush(protonConfig.flush);
     switch (flush.strategy) {
     case ProtonConfig::Flush::Strategy::MEMORY: {
-        auto memoryFlush = std::make_shared<MemoryFlush>(
+        memoryFlush = std::make_shared<MemoryFlush>(
                 MemoryFlushConfigUpdater::convertConfig(flush.memory, hwInfo.memory()), vespalib::system_clock::now());
         _memoryFlushConfigUpdater = std::make_unique<MemoryFlushConfigUpdater>(memoryFlush, flush.memory, hwInfo.memory());
         _diskMemUsageSampler->notifier().addDiskMemUsageListener(_memoryFlushConfigUpdater.get());
@@ -334,6 +344,10 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _tls->start(_transport, hwInfo.cpu().cores());
     _flushEngine = std::make_unique<FlushEngine>(std::make_shared<flushengine::TlsStatsFactory>(_tls->getTransLogServer()),
                                                  strategy, flush.maxconcurrent, vespalib::from_s(flush.idleinterval));
+    if (memoryFlush) {
+        memoryFlush->set_write_budget(_flushEngine->get_write_budget());
+    }
+    set_flush_write_budget(*_flushEngine, flush.memory);
     _metricsEngine->addExternalMetrics(_summaryEngine->getMetrics());
 
     LOG(debug, "Start proton server with root at %s and cwd at %s",
@@ -410,6 +424,7 @@ Proton::applyConfig(const BootstrapConfig::SP & configSnapshot)
     _diskMemUsageSampler->setConfig(diskMemUsageSamplerConfig(protonConfig, configSnapshot->getHwInfo()), *_scheduler);
     if (_memoryFlushConfigUpdater) {
         _memoryFlushConfigUpdater->setConfig(protonConfig.flush.memory);
+        set_flush_write_budget(*_flushEngine, protonConfig.flush.memory);
         _flushEngine->kick();
     }
 }
@@ -6,15 +6,72 @@
 
 using vespalib::make_string;
 using vespalib::IllegalStateException;
+using search::transactionlog::Packet;
 
 namespace proton {
 
+namespace {
+
+template <typename OperationType>
+std::unique_ptr<FeedOperation>
+deserialize(std::unique_ptr<OperationType> op, vespalib::nbostream &is, const Packet::Entry &entry,
+            const document::DocumentTypeRepo &repo)
+{
+    op->deserialize(is, repo);
+    op->setSerialNum(entry.serial());
+    return op;
+}
+
+std::unique_ptr<FeedOperation>
+deserializeOperation(vespalib::nbostream &is, const Packet::Entry &entry, const document::DocumentTypeRepo &repo)
+{
+    switch (entry.type()) {
+    case FeedOperation::PUT:
+        return deserialize(std::make_unique<PutOperation>(), is, entry, repo);
+    case FeedOperation::REMOVE:
+        return deserialize(std::make_unique<RemoveOperationWithDocId>(), is, entry, repo);
+    case FeedOperation::REMOVE_GID:
+        return deserialize(std::make_unique<RemoveOperationWithGid>(), is, entry, repo);
+    case FeedOperation::UPDATE:
+        return deserialize(std::make_unique<UpdateOperation>(static_cast<FeedOperation::Type>(entry.type())), is, entry, repo);
+    case FeedOperation::NOOP:
+        return deserialize(std::make_unique<NoopOperation>(), is, entry, repo);
+    case FeedOperation::DELETE_BUCKET:
+        return deserialize(std::make_unique<DeleteBucketOperation>(), is, entry, repo);
+    case FeedOperation::SPLIT_BUCKET:
+        return deserialize(std::make_unique<SplitBucketOperation>(), is, entry, repo);
+    case FeedOperation::JOIN_BUCKETS:
+        return deserialize(std::make_unique<JoinBucketsOperation>(), is, entry, repo);
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        return deserialize(std::make_unique<PruneRemovedDocumentsOperation>(), is, entry, repo);
+    case FeedOperation::MOVE:
+        return deserialize(std::make_unique<MoveOperation>(), is, entry, repo);
+    case FeedOperation::CREATE_BUCKET:
+        return deserialize(std::make_unique<CreateBucketOperation>(), is, entry, repo);
+    case FeedOperation::COMPACT_LID_SPACE:
+        return deserialize(std::make_unique<CompactLidSpaceOperation>(), is, entry, repo);
+    default:
+        throw IllegalStateException
+            (make_string("Got packet entry with unknown type id '%u' from TLS", entry.type()));
+    }
+}
+
+void
+checkAllConsumed(const vespalib::nbostream &is, const Packet::Entry &entry)
+{
+    if ( ! is.empty()) {
+        throw document::DeserializeException
+            (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
+                         entry.type(), is.size()));
+    }
+}
+
+}
+
 template <typename OperationType>
 void
-ReplayPacketDispatcher::replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry)
+ReplayPacketDispatcher::replay(const OperationType &op)
 {
-    op.deserialize(is, _handler.getDeserializeRepo());
-    op.setSerialNum(entry.serial());
     store(op);
     _handler.replay(op);
 }
@@ -29,70 +86,71 @@ ReplayPacketDispatcher::ReplayPacketDispatcher(IReplayPacketHandler &handler)
 void
 ReplayPacketDispatcher::replayEntry(const Packet::Entry &entry)
 {
-    vespalib::nbostream is(entry.data().c_str(), entry.data().size());
-    switch (entry.type()) {
-    case FeedOperation::PUT: {
-        PutOperation op;
-        replay(op, is, entry);
-        break;
-    } case FeedOperation::REMOVE: {
-        RemoveOperationWithDocId op;
-        replay(op, is, entry);
-        break;
-    } case FeedOperation::REMOVE_GID: {
-        RemoveOperationWithGid op;
-        replay(op, is, entry);
-        break;
-    } case FeedOperation::UPDATE: {
-        UpdateOperation op(static_cast<FeedOperation::Type>(entry.type()));
-        replay(op, is, entry);
-        break;
-    } case FeedOperation::NOOP: {
-        NoopOperation op;
-        replay(op, is, entry);
-        break;
-    } case FeedOperation::NEW_CONFIG: {
+    if (entry.type() == FeedOperation::NEW_CONFIG) {
+        vespalib::nbostream is(entry.data().c_str(), entry.data().size());
         NewConfigOperation op(entry.serial(), _handler.getNewConfigStreamHandler());
         op.deserialize(is, _handler.getDeserializeRepo());
+        checkAllConsumed(is, entry);
         _handler.replay(op);
+    } else {
+        replayOperation(*deserializeEntry(entry, _handler.getDeserializeRepo()));
+    }
+}
+
+void
+ReplayPacketDispatcher::replayOperation(const FeedOperation &op)
+{
+    switch (op.getType()) {
+    case FeedOperation::PUT:
+        replay(static_cast<const PutOperation &>(op));
+        break;
+    case FeedOperation::REMOVE:
+    case FeedOperation::REMOVE_GID:
+        replay(static_cast<const RemoveOperation &>(op));
         break;
-    } case FeedOperation::DELETE_BUCKET: {
-        DeleteBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::UPDATE:
+        replay(static_cast<const UpdateOperation &>(op));
         break;
-    } case FeedOperation::SPLIT_BUCKET: {
-        SplitBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::NOOP:
+        replay(static_cast<const NoopOperation &>(op));
         break;
-    } case FeedOperation::JOIN_BUCKETS: {
-        JoinBucketsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::DELETE_BUCKET:
+        replay(static_cast<const DeleteBucketOperation &>(op));
         break;
-    } case FeedOperation::PRUNE_REMOVED_DOCUMENTS: {
-        PruneRemovedDocumentsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::SPLIT_BUCKET:
+        replay(static_cast<const SplitBucketOperation &>(op));
         break;
-    } case FeedOperation::MOVE: {
-        MoveOperation op;
-        replay(op, is, entry);
+    case FeedOperation::JOIN_BUCKETS:
+        replay(static_cast<const JoinBucketsOperation &>(op));
         break;
-    } case FeedOperation::CREATE_BUCKET: {
-        CreateBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        replay(static_cast<const PruneRemovedDocumentsOperation &>(op));
         break;
-    } case FeedOperation::COMPACT_LID_SPACE: {
-        CompactLidSpaceOperation op;
-        replay(op, is, entry);
+    case FeedOperation::MOVE:
+        replay(static_cast<const MoveOperation &>(op));
         break;
-    } default:
+    case FeedOperation::CREATE_BUCKET:
+        replay(static_cast<const CreateBucketOperation &>(op));
+        break;
+    case FeedOperation::COMPACT_LID_SPACE:
+        replay(static_cast<const CompactLidSpaceOperation &>(op));
+        break;
+    default:
         throw IllegalStateException
-            (make_string("Got packet entry with unknown type id '%u' from TLS", entry.type()));
+            (make_string("Can not replay operation with type id '%u'", op.getType()));
     }
-    if ( ! is.empty()) {
-        throw document::DeserializeException
-            (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
-                         entry.type(), is.size()));
+}
+
+std::unique_ptr<FeedOperation>
+ReplayPacketDispatcher::deserializeEntry(const Packet::Entry &entry, const document::DocumentTypeRepo &repo)
+{
+    if (entry.type() == FeedOperation::NEW_CONFIG) {
+        return {};
     }
+    vespalib::nbostream is(entry.data().c_str(), entry.data().size());
+    auto op = deserializeOperation(is, entry, repo);
+    checkAllConsumed(is, entry);
+    return op;
 }
 
 
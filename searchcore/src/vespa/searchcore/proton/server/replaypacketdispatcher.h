@@ -4,6 +4,9 @@
 
 #include "ireplaypackethandler.h"
 #include <vespa/searchlib/transactionlog/common.h>
+#include <memory>
+
+namespace document { class DocumentTypeRepo; }
 
 namespace proton {
 
@@ -20,7 +23,7 @@ private:
     IReplayPacketHandler &_handler;
 
     template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
+    void replay(const OperationType &op);
 
 protected:
     virtual void store(const FeedOperation &op);
@@ -30,6 +33,21 @@ public:
     virtual ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+
+    /**
+     * Replay an operation already deserialized by deserializeEntry().
+     */
+    void replayOperation(const FeedOperation &op);
+
+    /**
+     * Deserialize a packet entry into a feed operation without replaying it.
+     * This can be done by any thread, ahead of replaying the operation.
+     * Returns an empty pointer for new config operations, as they can only be
+     * deserialized when replayed, and may change the repo used for the entries
+     * that follow.
+     */
+    static std::unique_ptr<FeedOperation> deserializeEntry(const Packet::Entry &entry,
+                                                           const document::DocumentTypeRepo &repo);
 };
 
 } // namespace proton
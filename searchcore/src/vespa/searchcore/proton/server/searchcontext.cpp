@@ -24,10 +24,17 @@ uint32_t SearchContext::getDocIdLimit()
     return _docIdLimit;
 }
 
-SearchContext::SearchContext(const std::shared_ptr<IndexSearchable> &indexSearchable, uint32_t docIdLimit)
+uint64_t SearchContext::getCommitGeneration()
+{
+    return _commitGeneration;
+}
+
+SearchContext::SearchContext(const std::shared_ptr<IndexSearchable> &indexSearchable, uint32_t docIdLimit,
+                             uint64_t commitGeneration)
     : _indexSearchable(indexSearchable),
       _attributeBlueprintFactory(),
-      _docIdLimit(docIdLimit)
+      _docIdLimit(docIdLimit),
+      _commitGeneration(commitGeneration)
 {
 }
 
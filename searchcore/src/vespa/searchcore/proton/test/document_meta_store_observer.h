@@ -181,6 +181,9 @@ struct DocumentMetaStoreObserver : public IDocumentMetaStore
     void set_operation_listener(documentmetastore::OperationListener::SP op_listener) override {
         _store.set_operation_listener(std::move(op_listener));
     }
+    uint64_t get_lid_state_generation() const noexcept override {
+        return _store.get_lid_state_generation();
+    }
 };
 
 }
@@ -6,6 +6,7 @@
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/signalhandler.h>
 #include <vespa/vespalib/util/exception.h>
+#include <vespa/vespalib/data/fileheader.h>
 #include <cinttypes>
 #include <cassert>
 
@@ -27,12 +28,14 @@ CreateIdxFileFromDatApp::usage(const char *self)
 }
 
 namespace {
+FileChunk::DictionarySP datDictionary;
+
 bool tryDecode(size_t chunks, size_t offset, const char * p, size_t sz, size_t nextSync)
 {
     bool success(false);
     for (size_t lengthError(0); !success && (sz + lengthError <= nextSync); lengthError++) {
         try {
-            Chunk chunk(chunks, p, sz + lengthError);
+            Chunk chunk(chunks, p, sz + lengthError, datDictionary);
             success = true;
         } catch (const vespalib::Exception & e) {
             fprintf(stdout, "Chunk %ld, with size=%ld failed with lengthError %ld due to '%s'\n", offset, sz, lengthError, e.what());
@@ -62,7 +65,7 @@ generate(uint64_t serialNum, size_t chunks, FastOS_FileInterface & idxFile, size
     vespalib::nbostream os;
     for (size_t lengthError(0); int64_t(sz+lengthError) <= nextStart-start; lengthError++) {
         try {
-            Chunk chunk(chunks, current, sz + lengthError);
+            Chunk chunk(chunks, current, sz + lengthError, datDictionary);
             fprintf(stdout, "id=%d lastSerial=%" PRIu64 " count=%ld\n", chunk.getId(), chunk.getLastSerial(), chunk.count());
             const Chunk::LidList & lidlist = chunk.getLids();
             if (chunk.getLastSerial() < serialNum) {
@@ -93,13 +96,19 @@ int CreateIdxFileFromDatApp::createIdxFile(const vespalib::string & datFileName,
     uint64_t datHeaderLen = FileChunk::readDataHeader(datFile);
     const char * start = static_cast<const char *>(datFile.getMapping());
     const char * end = start + fileSize;
+    if (datHeaderLen > 0) {
+        vespalib::GenericHeader::MMapReader reader(start, datHeaderLen);
+        vespalib::GenericHeader header;
+        header.read(reader);
+        datDictionary = FileChunk::readDictionary(header, FileChunk::READ_ONLY_DICTIONARY_LEVEL);
+    }
     uint64_t chunks(0);
     uint64_t entries(0);
     uint64_t alignment(512);
     FastOS_File idxFile(idxFileName.c_str());
     assert(idxFile.OpenWriteOnly());
     index::DummyFileHeaderContext fileHeaderContext;
-    idxFile.SetPosition(WriteableFileChunk::writeIdxHeader(fileHeaderContext, std::numeric_limits<uint32_t>::max(), idxFile));
+    idxFile.SetPosition(WriteableFileChunk::writeIdxHeader(fileHeaderContext, std::numeric_limits<uint32_t>::max(), datDictionary, idxFile));
     fprintf(stdout, "datHeaderLen=%" PRIu64 "\n", datHeaderLen);
     uint64_t serialNum(0);
     for (const char * current(start + datHeaderLen); current < end; ) {
@@ -26,6 +26,7 @@
 #include <vespa/fastos/file.h>
 #include <cmath>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 
 #include <vespa/log/log.h>
@@ -123,6 +124,22 @@ statSize(const AttributeVector &a)
     return resultSize;
 }
 
+/*
+ * Tells if the data file of the attribute is mapped into memory, as done by mmap load.
+ */
+bool
+isDataFileMapped(const AttributeVector &a)
+{
+    std::string path = fs::canonical(fs::path(a.getBaseFileName() + ".dat")).string();
+    std::ifstream maps("/proc/self/maps");
+    for (std::string line; std::getline(maps, line); ) {
+        if (line.ends_with(path)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 
 bool
 preciseEstimatedSize(const AttributeVector &a)
@@ -509,9 +526,15 @@ void AttributeTest::testReload(const AttributePtr & a)
     }
     EXPECT_TRUE( b->load() );
     EXPECT_EQ(43u, b->getCreateSerialNum());
+    if (a->getConfig().mmap_load()) {
+        EXPECT_TRUE(isDataFileMapped(*b));
+    }
     compare<VectorType, BufferType>
         (*(static_cast<VectorType *>(a.get())), *(static_cast<VectorType *>(b.get())));
     EXPECT_TRUE( c->load() );
+    if (a->getConfig().mmap_load()) {
+        EXPECT_TRUE(isDataFileMapped(*c));
+    }
     compare<VectorType, BufferType>
         (*(static_cast<VectorType *>(a.get())), *(static_cast<VectorType *>(c.get())));
 
@@ -556,6 +579,13 @@ void AttributeTest::testReload()
         testReloadInt(iv1, 0);
         testReloadInt(iv1, 100);
     }
+    {
+        Config cfg(BasicType::INT64, CollectionType::SINGLE);
+        cfg.set_mmap_load(true);
+        AttributePtr iv1 = createAttribute("smmapint64_1", cfg);
+        testReloadInt(iv1, 0);
+        testReloadInt(iv1, 100);
+    }
     // CollectionType::ARRAY
     {
         Config cfg(BasicType::INT8, CollectionType::ARRAY);
@@ -252,6 +252,18 @@ TEST("require that config can be converted")
         a.paged = true;
         EXPECT_TRUE(CC::convert(a).paged());
     }
+    {
+        CACA a;
+        EXPECT_TRUE(!CC::convert(a).mmap_load());
+        a.mmapload = true;
+        EXPECT_TRUE(CC::convert(a).mmap_load());
+    }
+    {
+        CACA a;
+        EXPECT_EQUAL(0u, CC::convert(a).filter_cache_min_lookups());
+        a.filtercache.minlookups = 100;
+        EXPECT_EQUAL(100u, CC::convert(a).filter_cache_min_lookups());
+    }
     { // tensor
         CACA a;
         a.datatype = CACAD::TENSOR;
@@ -4,6 +4,8 @@
 #include <vespa/searchlib/attribute/enum_store_loaders.h>
 #include <vespa/vespalib/test/memory_allocator_observer.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <random>
 
 #include <vespa/log/log.h>
 LOG_SETUP("enumstore_test");
@@ -1006,6 +1008,32 @@ TYPED_TEST(EnumStoreDictionaryTest, compact_worst_works)
     EXPECT_EQ(exp_values, values);
 }
 
+TEST(LoadedEnumSortTest, parallel_sort_gives_same_order_as_serial_sort)
+{
+    attribute::LoadedEnumAttributeVector loaded;
+    std::mt19937 rnd(42);
+    for (uint32_t doc_id = 1; doc_id < 100000; ++doc_id) {
+        uint32_t num_values = rnd() % 4;
+        for (uint32_t i = 0; i < num_values; ++i) {
+            // Skewed enum distribution, most values use the few lowest enums.
+            uint32_t e = (rnd() % 8 == 0) ? (rnd() % 10000) : (rnd() % 10);
+            loaded.emplace_back(e, doc_id, int32_t(i + 1));
+        }
+    }
+    auto expected = loaded;
+    std::shuffle(loaded.begin(), loaded.end(), rnd);
+    std::shuffle(expected.begin(), expected.end(), rnd);
+    attribute::sortLoadedByEnum(expected, nullptr);
+    vespalib::ThreadStackExecutor executor(4);
+    attribute::sortLoadedByEnum(loaded, &executor);
+    ASSERT_EQ(expected.size(), loaded.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].getEnum(), loaded[i].getEnum());
+        ASSERT_EQ(expected[i].getDocId(), loaded[i].getDocId());
+    }
+    EXPECT_TRUE(std::is_sorted(loaded.begin(), loaded.end(), attribute::LoadedEnumAttribute::EnumCompare()));
+}
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
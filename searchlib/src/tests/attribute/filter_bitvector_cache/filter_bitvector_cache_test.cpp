@@ -0,0 +1,156 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/filter_bitvector_cache.h>
+#include <vespa/searchlib/attribute/filter_bitvector_search_context.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::IntegerAttribute;
+using search::QueryTermSimple;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+using search::attribute::FilterBitVectorSearchContext;
+using search::attribute::ISearchContext;
+using search::attribute::SearchContextParams;
+using search::fef::TermFieldMatchData;
+using search::queryeval::ExecuteInfo;
+
+class FilterBitVectorCacheTest : public ::testing::Test {
+protected:
+    std::shared_ptr<AttributeVector> _attr;
+
+    FilterBitVectorCacheTest();
+    ~FilterBitVectorCacheTest() override;
+    IntegerAttribute& int_attr() { return dynamic_cast<IntegerAttribute&>(*_attr); }
+    void set_value(uint32_t docid, int64_t value) {
+        int_attr().update(docid, value);
+        _attr->get_filter_cache().note_changed(docid);
+    }
+    void commit() {
+        _attr->commit();
+        _attr->get_filter_cache().commit(*_attr);
+    }
+    std::unique_ptr<ISearchContext> make_search_context(const vespalib::string& term) {
+        return _attr->createSearchContext(std::make_unique<QueryTermSimple>(term, QueryTermSimple::Type::WORD),
+                                          SearchContextParams().useBitVector(true));
+    }
+    std::vector<uint32_t> search(const vespalib::string& term) {
+        auto sc = make_search_context(term);
+        sc->fetchPostings(ExecuteInfo::FULL, true);
+        TermFieldMatchData tfmd;
+        auto it = sc->createIterator(&tfmd, true);
+        it->initRange(1, _attr->getCommittedDocIdLimit());
+        std::vector<uint32_t> result;
+        for (uint32_t docid = it->seekFirst(1); !it->isAtEnd(); docid = it->seekNext(docid + 1)) {
+            result.push_back(docid);
+        }
+        return result;
+    }
+    bool is_cached(const vespalib::string& term) {
+        return dynamic_cast<const FilterBitVectorSearchContext*>(make_search_context(term).get()) != nullptr;
+    }
+};
+
+FilterBitVectorCacheTest::FilterBitVectorCacheTest()
+    : ::testing::Test(),
+      _attr(AttributeFactory::createAttribute("a", Config(BasicType::INT32, CollectionType::SINGLE, true).set_filter_cache_min_lookups(2)))
+{
+    _attr->addDocs(10);
+    for (uint32_t docid = 1; docid < 10; ++docid) {
+        int_attr().update(docid, docid % 3);
+    }
+    _attr->commit();
+}
+
+FilterBitVectorCacheTest::~FilterBitVectorCacheTest() = default;
+
+using Hits = std::vector<uint32_t>;
+
+TEST_F(FilterBitVectorCacheTest, hot_term_is_cached_after_commit)
+{
+    EXPECT_EQ(Hits({3, 6, 9}), search("0"));
+    EXPECT_FALSE(is_cached("0"));
+    EXPECT_EQ(0u, _attr->get_filter_cache().size());
+    commit();
+    EXPECT_EQ(1u, _attr->get_filter_cache().size());
+    EXPECT_TRUE(is_cached("0"));
+    EXPECT_FALSE(is_cached("1"));
+    EXPECT_EQ(Hits({3, 6, 9}), search("0"));
+}
+
+TEST_F(FilterBitVectorCacheTest, range_term_is_cached)
+{
+    search("<2");
+    search("<2");
+    commit();
+    EXPECT_TRUE(is_cached("<2"));
+    EXPECT_EQ(Hits({1, 3, 4, 6, 7, 9}), search("<2"));
+}
+
+TEST_F(FilterBitVectorCacheTest, cached_bit_vector_is_updated_when_documents_change)
+{
+    search("0");
+    search("0");
+    commit();
+    set_value(3, 1);
+    set_value(4, 0);
+    EXPECT_EQ(Hits({3, 6, 9}), search("0"));
+    commit();
+    EXPECT_EQ(Hits({4, 6, 9}), search("0"));
+    _attr->addDocs(1);
+    set_value(10, 0);
+    commit();
+    EXPECT_EQ(Hits({4, 6, 9, 10}), search("0"));
+}
+
+TEST_F(FilterBitVectorCacheTest, cache_is_only_used_for_filter_terms)
+{
+    auto params = SearchContextParams().useBitVector(false);
+    for (int i = 0; i < 3; ++i) {
+        _attr->createSearchContext(std::make_unique<QueryTermSimple>("0", QueryTermSimple::Type::WORD), params);
+    }
+    commit();
+    EXPECT_EQ(0u, _attr->get_filter_cache().size());
+}
+
+TEST_F(FilterBitVectorCacheTest, cache_is_cleared_when_disabled)
+{
+    search("0");
+    search("0");
+    commit();
+    EXPECT_EQ(1u, _attr->get_filter_cache().size());
+    auto cfg = _attr->getConfig();
+    cfg.set_filter_cache_min_lookups(0);
+    _attr->update_config(cfg);
+    EXPECT_EQ(0u, _attr->get_filter_cache().size());
+    EXPECT_FALSE(is_cached("0"));
+    EXPECT_EQ(Hits({3, 6, 9}), search("0"));
+}
+
+TEST_F(FilterBitVectorCacheTest, hot_term_is_cached_when_many_cold_terms_are_looked_up)
+{
+    auto cfg = _attr->getConfig();
+    cfg.set_filter_cache_min_lookups(50);
+    _attr->update_config(cfg);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        make_search_context(std::to_string(100 + i));
+        if (i % 100 == 0) {
+            make_search_context("0");
+        }
+    }
+    commit();
+    EXPECT_EQ(1u, _attr->get_filter_cache().size());
+    EXPECT_TRUE(is_cached("0"));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -2,6 +2,7 @@
 
 #include <vespa/searchlib/attribute/attribute_read_guard.h>
 #include <vespa/searchlib/attribute/attributeguard.h>
+#include <vespa/searchlib/queryeval/intermediate_blueprints.h>
 #include <vespa/searchlib/queryeval/nearest_neighbor_blueprint.h>
 #include <vespa/searchlib/tensor/default_nearest_neighbor_index_factory.h>
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
@@ -47,6 +48,7 @@ using search::attribute::DistanceMetric;
 using search::attribute::HnswIndexParams;
 using search::queryeval::GlobalFilter;
 using search::queryeval::NearestNeighborBlueprint;
+using search::queryeval::OrBlueprint;
 using search::tensor::DefaultNearestNeighborIndexFactory;
 using search::tensor::DenseTensorAttribute;
 using search::tensor::DirectTensorAttribute;
@@ -173,6 +175,7 @@ private:
     generation_t _transfer_gen;
     generation_t _trim_gen;
     mutable size_t _memory_usage_cnt;
+    mutable std::vector<size_t> _top_k_batch_sizes;
     int _index_value;
 
 public:
@@ -185,6 +188,7 @@ public:
           _transfer_gen(std::numeric_limits<generation_t>::max()),
           _trim_gen(std::numeric_limits<generation_t>::max()),
           _memory_usage_cnt(0),
+          _top_k_batch_sizes(),
           _index_value(0)
     {
     }
@@ -243,6 +247,7 @@ public:
     generation_t get_transfer_gen() const { return _transfer_gen; }
     generation_t get_trim_gen() const { return _trim_gen; }
     size_t memory_usage_cnt() const { return _memory_usage_cnt; }
+    const std::vector<size_t>& top_k_batch_sizes() const { return _top_k_batch_sizes; }
 
     void add_document(uint32_t docid) override {
         auto vector = _vectors.get_vector(docid, 0).typify<double>();
@@ -327,6 +332,24 @@ public:
         (void) distance_threshold;
         return {};
     }
+    std::vector<std::vector<Neighbor>> find_top_k_batch(uint32_t k,
+                                                        std::span<const search::tensor::BoundDistanceFunction* const> dfs,
+                                                        const GlobalFilter* filter, uint32_t explore_k,
+                                                        const vespalib::Doom& doom,
+                                                        double distance_threshold) const override
+    {
+        (void) k;
+        (void) filter;
+        (void) explore_k;
+        (void) doom;
+        (void) distance_threshold;
+        _top_k_batch_sizes.push_back(dfs.size());
+        std::vector<std::vector<Neighbor>> result;
+        for (uint32_t i = 0; i < dfs.size(); ++i) {
+            result.push_back({Neighbor(i + 1, 0.0)});
+        }
+        return result;
+    }
 
     search::tensor::DistanceFunctionFactory &distance_function_factory() const override {
         static search::tensor::DistanceFunctionFactory::UP my_dist_fun = search::tensor::make_distance_function_factory(search::attribute::DistanceMetric::Euclidean, vespalib::eval::CellType::DOUBLE);
@@ -344,9 +367,11 @@ class MockNearestNeighborIndexFactory : public NearestNeighborIndexFactory {
                                                size_t vector_size,
                                                bool multi_vector_index,
                                                CellType cell_type,
-                                               const search::attribute::HnswIndexParams& params) const override {
+                                               const search::attribute::HnswIndexParams& params,
+                                               std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator) const override {
         (void) vector_size;
         (void) params;
+        (void) memory_allocator;
         (void) multi_vector_index;
         assert(cell_type == CellType::DOUBLE);
         return std::make_unique<MockNearestNeighborIndex>(vectors);
@@ -1041,6 +1066,20 @@ public:
     DenseTensorAttributeHnswIndex() : TensorAttributeHnswIndex<HnswIndexType::SINGLE>(vec_2d_spec, FixtureTraits().hnsw()) {}
 };
 
+std::vector<HnswTestNode::LevelArray>
+load_hnsw_graph_with_executor(DenseTensorAttributeHnswIndex& f, vespalib::Executor& executor, uint32_t num_docs)
+{
+    f._tensorAttr = f.makeAttr();
+    f._attr = f._tensorAttr;
+    EXPECT_TRUE(f._attr->load(&executor));
+    auto& index = f.hnsw_index();
+    std::vector<HnswTestNode::LevelArray> result;
+    for (uint32_t nodeid = 1; nodeid <= num_docs; ++nodeid) {
+        result.emplace_back(index.get_node(nodeid).levels());
+    }
+    return result;
+}
+
 class MixedTensorAttributeHnswIndex : public TensorAttributeHnswIndex<HnswIndexType::MULTI> {
 public:
     MixedTensorAttributeHnswIndex() : TensorAttributeHnswIndex<HnswIndexType::MULTI>(vec_mixed_2d_spec, FixtureTraits().mixed_hnsw()) {}
@@ -1056,6 +1095,26 @@ TEST_F("Hnsw index is integrated in dense tensor attribute and can be saved and
     f.test_save_load(false);
 }
 
+TEST_F("Hnsw index rebuilt on load with multi-threaded executor is the same for each load", DenseTensorAttributeHnswIndex)
+{
+    constexpr uint32_t num_docs = 2500; // spans several batches of the index builder
+    for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+        f.set_tensor(docid, vec_2d((docid * 7919) % 1009, (docid * 104729) % 997));
+    }
+    f.save();
+    std::filesystem::remove(std::filesystem::path(attr_name + ".nnidx"));
+    vespalib::ThreadStackExecutor executor(4);
+    auto graph_a = load_hnsw_graph_with_executor(f, executor, num_docs);
+    EXPECT_LESS(0ul, executor.getStats().acceptedTasks);
+    auto graph_b = load_hnsw_graph_with_executor(f, executor, num_docs);
+    ASSERT_EQUAL(num_docs, graph_a.size());
+    ASSERT_EQUAL(num_docs, graph_b.size());
+    for (uint32_t i = 0; i < num_docs; ++i) {
+        EXPECT_EQUAL(graph_a[i].size(), graph_b[i].size());
+        EXPECT_TRUE(graph_a[i] == graph_b[i]);
+    }
+}
+
 TEST_F("Hnsw index is instantiated in mixed tensor attribute when specified in config", MixedTensorAttributeHnswIndex)
 {
     f.test_setup();
@@ -1331,11 +1390,11 @@ TEST_F("Nearest neighbor index with mips distance metrics stores square of max d
 template <typename ParentT>
 class NearestNeighborBlueprintFixtureBase : public ParentT {
 private:
-    std::unique_ptr<Value> _query_tensor;
+    std::vector<std::unique_ptr<Value>> _query_tensors;
 
 public:
     NearestNeighborBlueprintFixtureBase()
-        : _query_tensor()
+        : _query_tensors()
     {
         this->set_tensor(1, vec_2d(1, 1));
         this->set_tensor(2, vec_2d(2, 2));
@@ -1350,8 +1409,8 @@ public:
     }
 
     const Value& create_query_tensor(const TensorSpec& spec) {
-        _query_tensor = SimpleValue::from_spec(spec);
-        return *_query_tensor;
+        _query_tensors.push_back(SimpleValue::from_spec(spec));
+        return *_query_tensors.back();
     }
 
     std::unique_ptr<NearestNeighborBlueprint> make_blueprint(bool approximate = true,
@@ -1456,6 +1515,33 @@ TEST_F("NN blueprint handles strong filter triggering exact search", NearestNeig
     EXPECT_EQUAL(NNBA::EXACT_FALLBACK, bp->get_algorithm());
 }
 
+TEST_F("NN blueprints on the same index are searched in one batch", NearestNeighborBlueprintFixture)
+{
+    auto bp1 = f.make_blueprint();
+    auto bp2 = f.make_blueprint();
+    auto bp3 = f.make_blueprint(true, 0.05, 3.5);
+    std::vector<NearestNeighborBlueprint*> bps{bp1.get(), bp2.get(), bp3.get()};
+    auto empty_filter = GlobalFilter::create();
+    NearestNeighborBlueprint::set_global_filter(bps, *empty_filter, 0.2);
+    // bp3 gets a different adjusted targetHits and is searched separately
+    EXPECT_EQUAL(std::vector<size_t>({2}), f.mock_index().top_k_batch_sizes());
+    EXPECT_EQUAL(NNBA::INDEX_TOP_K, bp1->get_algorithm());
+    EXPECT_EQUAL(NNBA::INDEX_TOP_K, bp2->get_algorithm());
+    EXPECT_EQUAL(NNBA::INDEX_TOP_K, bp3->get_algorithm());
+    EXPECT_EQUAL(15u, bp1->get_adjusted_target_hits());
+    EXPECT_EQUAL(10u, bp3->get_adjusted_target_hits());
+}
+
+TEST_F("NN blueprint siblings are searched in one batch when setting global filter on parent", NearestNeighborBlueprintFixture)
+{
+    OrBlueprint parent;
+    parent.addChild(f.make_blueprint());
+    parent.addChild(f.make_blueprint());
+    auto empty_filter = GlobalFilter::create();
+    parent.set_global_filter(*empty_filter, 0.6);
+    EXPECT_EQUAL(std::vector<size_t>({2}), f.mock_index().top_k_batch_sizes());
+}
+
 TEST_F("NN blueprint wants global filter when having index", NearestNeighborBlueprintFixture)
 {
     auto bp = f.make_blueprint();
@@ -0,0 +1,103 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/diskindex/bit_vector_cache.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/size_literals.h>
+
+using search::BitVector;
+using search::diskindex::BitVectorCache;
+
+namespace {
+
+class MockBackingStore : public BitVectorCache::BackingStore {
+public:
+    mutable uint32_t bit_vector_reads;
+    MockBackingStore();
+    ~MockBackingStore() override;
+    std::shared_ptr<BitVector> read_uncached_bit_vector(const BitVectorCache::Key& key) const override {
+        ++bit_vector_reads;
+        if (key.word_num == 0) {
+            return {};
+        }
+        return BitVector::create(8000);
+    }
+};
+
+MockBackingStore::MockBackingStore()
+    : BitVectorCache::BackingStore(),
+      bit_vector_reads(0)
+{
+}
+
+MockBackingStore::~MockBackingStore() = default;
+
+}
+
+class BitVectorCacheTest : public ::testing::Test {
+protected:
+    MockBackingStore _backing_store;
+    BitVectorCache   _cache;
+
+    BitVectorCacheTest();
+    ~BitVectorCacheTest() override;
+};
+
+BitVectorCacheTest::BitVectorCacheTest()
+    : ::testing::Test(),
+      _backing_store(),
+      _cache(_backing_store, 256_Ki)
+{
+}
+
+BitVectorCacheTest::~BitVectorCacheTest() = default;
+
+TEST_F(BitVectorCacheTest, repeated_lookups_give_cache_hits)
+{
+    BitVectorCache::Key key(1, 42);
+    auto bv = _cache.read(key);
+    ASSERT_TRUE(bv);
+    EXPECT_EQ(bv, _cache.read(key));
+    EXPECT_EQ(1, _backing_store.bit_vector_reads);
+    auto stats = _cache.get_stats();
+    EXPECT_EQ(1, stats.hits);
+    EXPECT_EQ(1, stats.misses);
+    EXPECT_EQ(1, stats.elements);
+    EXPECT_LT(1000, stats.memory_used);
+}
+
+TEST_F(BitVectorCacheTest, key_identity_is_field_and_word_number)
+{
+    auto bv = _cache.read(BitVectorCache::Key(1, 42));
+    EXPECT_EQ(bv, _cache.read(BitVectorCache::Key(1, 42)));
+    EXPECT_NE(bv, _cache.read(BitVectorCache::Key(2, 42)));
+    EXPECT_NE(bv, _cache.read(BitVectorCache::Key(1, 43)));
+    EXPECT_EQ(3, _backing_store.bit_vector_reads);
+}
+
+TEST_F(BitVectorCacheTest, missing_bit_vectors_are_not_cached)
+{
+    EXPECT_FALSE(_cache.read(BitVectorCache::Key(1, 0)));
+    EXPECT_FALSE(_cache.read(BitVectorCache::Key(1, 0)));
+    auto bv = _cache.read(BitVectorCache::Key(1, 5));
+    EXPECT_TRUE(bv);
+    EXPECT_EQ(bv, _cache.read(BitVectorCache::Key(1, 5)));
+    EXPECT_EQ(3, _backing_store.bit_vector_reads);
+    auto stats = _cache.get_stats();
+    EXPECT_EQ(1, stats.hits);
+    EXPECT_EQ(3, stats.misses);
+    EXPECT_EQ(1, stats.elements);
+}
+
+TEST_F(BitVectorCacheTest, cache_size_is_bounded)
+{
+    for (uint32_t word_num = 1; word_num <= 1000; ++word_num) {
+        _cache.read(BitVectorCache::Key(1, word_num));
+    }
+    auto stats = _cache.get_stats();
+    EXPECT_GT(1000, stats.elements);
+    EXPECT_EQ(1000, stats.elements + stats.evictions);
+    EXPECT_GE(256_Ki + BitVectorCache::num_shards * 2000, stats.memory_used);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
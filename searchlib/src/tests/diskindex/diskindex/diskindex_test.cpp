@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/diskindex/decoded_posting_list.h>
 #include <vespa/searchlib/diskindex/disktermblueprint.h>
 #include <vespa/searchlib/test/diskindex/testdiskindex.h>
 #define ENABLE_GTEST_MIGRATION
@@ -17,11 +18,13 @@
 #include <vespa/searchlib/test/fakedata/fpfactory.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/stllike/asciistream.h>
+#include <vespa/vespalib/util/size_literals.h>
 #include <filesystem>
 #include <set>
 
 using search::BitVector;
 using search::BitVectorIterator;
+using search::diskindex::DecodedPostingList;
 using search::diskindex::DiskIndex;
 using search::diskindex::DiskTermBlueprint;
 using search::diskindex::TestDiskIndex;
@@ -84,6 +87,27 @@ Verifier::Verifier(FakePosting::SP fp)
 
 Verifier::~Verifier() = default;
 
+/*
+ * Describe all hits, with unpacked positions and interleaved features.
+ */
+std::vector<vespalib::string>
+describe_unpacked_hits(SearchIterator& itr, TermFieldMatchData& tfmd)
+{
+    std::vector<vespalib::string> result;
+    itr.initFullRange();
+    for (itr.seek(1); !itr.isAtEnd(); itr.seek(itr.getDocId() + 1)) {
+        itr.unpack(itr.getDocId());
+        vespalib::asciistream os;
+        os << "doc=" << tfmd.getDocId() << ",num_occs=" << tfmd.getNumOccs() << ",field_length=" << tfmd.getFieldLength();
+        for (const auto& pos : tfmd) {
+            os << ",[" << pos.getElementId() << "," << pos.getPosition() << "," << pos.getElementWeight() << "," <<
+               pos.getElementLen() << "]";
+        }
+        result.emplace_back(os.view());
+    }
+    return result;
+}
+
 struct EmptySettings
 {
     bool _empty_field;
@@ -125,6 +149,8 @@ protected:
     void requireThatBlueprintIsCreated();
     void requireThatBlueprintCanCreateSearchIterators();
     void requireThatSearchIteratorsConforms();
+    void require_that_decoded_posting_list_matches_posting_list(const DiskIndex& cached_index, uint32_t field_id,
+                                                                const vespalib::string& word);
     void build_index(const IOSettings& io_settings, const EmptySettings& empty_settings);
     void test_empty_settings(const EmptySettings& empty_settings);
     void test_io_settings(const IOSettings& io_settings);
@@ -363,6 +389,27 @@ DiskIndexTest::requireThatBlueprintCanCreateSearchIterators()
     }
 }
 
+void
+DiskIndexTest::require_that_decoded_posting_list_matches_posting_list(const DiskIndex& cached_index, uint32_t field_id,
+                                                                      const vespalib::string& word)
+{
+    SCOPED_TRACE(word);
+    LookupResult::UP r = _index->lookup(field_id, word);
+    ASSERT_TRUE(r);
+    TermFieldMatchData md;
+    md.setNeedInterleavedFeatures(true);
+    TermFieldMatchDataArray mda;
+    mda.add(&md);
+    auto handle = _index->readPostingList(*r);
+    auto expected = describe_unpacked_hits(*handle->createIterator(r->counts, mda), md);
+    EXPECT_EQ(r->counts._numDocs, expected.size());
+    auto decoded = cached_index.read_decoded_posting_list(*r);
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(r->counts._numDocs, decoded->size());
+    EXPECT_EQ(expected, describe_unpacked_hits(*decoded->create_iterator(mda), md));
+    EXPECT_EQ(decoded.get(), cached_index.read_decoded_posting_list(*r).get());
+}
+
 void
 DiskIndexTest::build_index(const IOSettings& io_settings, const EmptySettings& empty_settings)
 {
@@ -465,6 +512,56 @@ TEST_F(DiskIndexTest, io_settings_directio_mmap)
     test_io_settings(IOSettings().use_directio().use_mmap());
 }
 
+TEST_F(DiskIndexTest, decoded_posting_lists_are_cached)
+{
+    build_index(IOSettings(), EmptySettings());
+    DiskIndex cached_index("index/1", 0, 0, 1_Mi);
+    ASSERT_TRUE(cached_index.setup(search::TuneFileSearch()));
+    require_that_decoded_posting_list_matches_posting_list(cached_index, 0, "w1");
+    require_that_decoded_posting_list_matches_posting_list(cached_index, 1, "w1");
+    require_that_decoded_posting_list_matches_posting_list(cached_index, 1, "w2");
+    auto stats = cached_index.get_posting_list_cache_stats();
+    EXPECT_EQ(3u, stats.elements);
+    EXPECT_EQ(3u, stats.misses);
+    EXPECT_EQ(3u, stats.hits);
+    EXPECT_LT(0u, stats.memory_used);
+
+    FakeRequestContext request_context;
+    TermFieldMatchData md;
+    TermFieldMatchDataArray mda;
+    mda.add(&md);
+    auto b = cached_index.createBlueprint(request_context, FieldSpec("f1", 0, 0), makeTerm("w1"));
+    b->basic_plan(true, 1000);
+    b->fetchPostings(ExecuteInfo::FULL);
+    auto& leaf_b = dynamic_cast<LeafBlueprint&>(*b);
+    auto s = leaf_b.createLeafSearch(mda);
+    EXPECT_TRUE((dynamic_cast<ZcRareWordPosOccIterator<true, false> *>(s.get()) == nullptr));
+    EXPECT_EQ(SimpleResult({1,3}), SimpleResult().search(*s));
+    EXPECT_EQ(SimpleResult({1,3}), SimpleResult().search(*leaf_b.createFilterSearch(Blueprint::FilterConstraint::UPPER_BOUND)));
+    EXPECT_EQ(4u, cached_index.get_posting_list_cache_stats().hits);
+}
+
+TEST_F(DiskIndexTest, too_large_posting_lists_are_not_cached)
+{
+    build_index(IOSettings(), EmptySettings());
+    DiskIndex cached_index("index/1", 0, 0, 1_Ki);
+    ASSERT_TRUE(cached_index.setup(search::TuneFileSearch()));
+    LookupResult::UP r = cached_index.lookup(1, "w2");
+    ASSERT_TRUE(r);
+    EXPECT_FALSE(cached_index.read_decoded_posting_list(*r));
+    EXPECT_EQ(0u, cached_index.get_posting_list_cache_stats().lookups());
+
+    FakeRequestContext request_context;
+    TermFieldMatchData md;
+    TermFieldMatchDataArray mda;
+    mda.add(&md);
+    auto b = cached_index.createBlueprint(request_context, FieldSpec("f2", 0, 0), makeTerm("w2"));
+    b->basic_plan(true, 1000);
+    b->fetchPostings(ExecuteInfo::FULL);
+    auto s = dynamic_cast<LeafBlueprint&>(*b).createLeafSearch(mda);
+    EXPECT_EQ(SimpleResult({1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17}), SimpleResult().search(*s));
+}
+
 TEST_F(DiskIndexTest, search_iterators_conformance)
 {
     requireThatSearchIteratorsConforms();
@@ -27,6 +27,7 @@
 #include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <filesystem>
 
@@ -81,6 +82,8 @@ protected:
     bool try_merge_simple_indexes(const vespalib::string &dump_dir, const std::vector<vespalib::string> &sources, std::shared_ptr<IFlushToken> flush_token);
     void merge_simple_indexes(const vespalib::string &dump_dir, const std::vector<vespalib::string> &sources);
     void reconstruct_interleaved_features();
+    void make_partition_index(const vespalib::string &dump_dir);
+    void merge_partition_indexes(const vespalib::string &dump_dir, const std::vector<vespalib::string> &sources, uint32_t max_field_partitions);
 public:
     FusionTest();
 };
@@ -639,6 +642,124 @@ TEST_F(FusionTest, require_that_fusion_can_be_stopped)
     clean_stopped_fusion_testdirs();
 }
 
+namespace {
+
+constexpr uint32_t partition_test_num_docs = 600;
+
+void clean_partition_testdirs()
+{
+    std::filesystem::remove_all(std::filesystem::path("pdump2"));
+    std::filesystem::remove_all(std::filesystem::path("pdump3"));
+    std::filesystem::remove_all(std::filesystem::path("pdump4"));
+    std::filesystem::remove_all(std::filesystem::path("pdump5"));
+}
+
+std::vector<vespalib::string>
+make_partition_test_words()
+{
+    std::vector<vespalib::string> words({"a0", "a1", "b0", "b1", "b2", "z0", "z1"});
+    for (uint32_t doc_id = 1; doc_id < partition_test_num_docs; ++doc_id) {
+        words.emplace_back(vespalib::make_string("r%u", doc_id));
+    }
+    return words;
+}
+
+vespalib::string
+dump_posting_list(DiskIndex &d, uint32_t field_id, const vespalib::string &word)
+{
+    auto lookup_result = d.lookup(field_id, word);
+    if (!lookup_result) {
+        return "<missing>";
+    }
+    vespalib::asciistream os;
+    os << lookup_result->counts._numDocs << "," << lookup_result->counts._bitLength << ":";
+    auto handle = d.readPostingList(*lookup_result);
+    if (!handle) {
+        return "<no postings>";
+    }
+    TermFieldMatchData tfmd;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&tfmd);
+    auto itr = handle->createIterator(lookup_result->counts, tfmda);
+    itr->initFullRange();
+    for (uint32_t doc_id = itr->seekFirst(1); !itr->isAtEnd(); doc_id = itr->seekNext(doc_id + 1)) {
+        itr->unpack(doc_id);
+        os << doc_id << toString(tfmd.getIterator());
+    }
+    auto bv = d.readBitVector(*lookup_result);
+    if (bv) {
+        os << ",bv=" << bv->countTrueBits();
+    }
+    return os.str();
+}
+
+}
+
+void
+FusionTest::make_partition_index(const vespalib::string &dump_dir)
+{
+    MockFieldLengthInspector field_length_inspector;
+    FieldIndexCollection fic(_schema, field_length_inspector);
+    DocBuilder b(make_add_fields());
+    auto invertThreads = SequencedTaskExecutor::create(invert_executor, 2);
+    auto pushThreads = SequencedTaskExecutor::create(push_executor, 2);
+    DocumentInverterContext inv_context(_schema, *invertThreads, *pushThreads, fic);
+    DocumentInverter inv(inv_context);
+    StringFieldBuilder sfb(b);
+    for (uint32_t doc_id = 1; doc_id < partition_test_num_docs; ++doc_id) {
+        auto doc = b.make_document(vespalib::make_string("id:ns:searchdocument::%u", doc_id));
+        doc->setValue("f0", sfb.tokenize(vespalib::make_string("a%u b%u r%u z%u a%u", doc_id % 2, doc_id % 3, doc_id, doc_id % 2, (doc_id / 2) % 2)).build());
+        inv.invertDocument(doc_id, *doc, {});
+    }
+    myPushDocument(inv);
+
+    TuneFileIndexing tuneFileIndexing;
+    DummyFileHeaderContext fileHeaderContext;
+    IndexBuilder ib(_schema, dump_dir, partition_test_num_docs, 2 * partition_test_num_docs, field_length_inspector, tuneFileIndexing, fileHeaderContext);
+    fic.dump(ib);
+}
+
+void
+FusionTest::merge_partition_indexes(const vespalib::string &dump_dir, const std::vector<vespalib::string> &sources, uint32_t max_field_partitions)
+{
+    vespalib::ThreadStackExecutor executor(4);
+    TuneFileIndexing tuneFileIndexing;
+    DummyFileHeaderContext fileHeaderContext;
+    SelectorArray selector(partition_test_num_docs, 0);
+    for (uint32_t doc_id = 0; doc_id < partition_test_num_docs; ++doc_id) {
+        selector[doc_id] = doc_id % sources.size();
+    }
+    Fusion fusion(_schema, dump_dir, sources, selector, tuneFileIndexing, fileHeaderContext);
+    fusion.set_max_field_partitions(max_field_partitions);
+    fusion.set_min_field_partition_size(1);
+    ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
+}
+
+TEST_F(FusionTest, require_that_partitioned_field_merge_gives_same_result)
+{
+    clean_partition_testdirs();
+    make_partition_index("pdump2");
+    make_partition_index("pdump3");
+    merge_partition_indexes("pdump4", {"pdump2", "pdump3"}, 1);
+    merge_partition_indexes("pdump5", {"pdump2", "pdump3"}, 4);
+    EXPECT_FALSE(std::filesystem::exists(std::filesystem::path("pdump5/f0/partition1")));
+    DiskIndex exp_index("pdump4");
+    ASSERT_TRUE(exp_index.setup(TuneFileSearch()));
+    DiskIndex act_index("pdump5");
+    ASSERT_TRUE(act_index.setup(TuneFileSearch()));
+    uint32_t field_id = _schema.getIndexFieldId("f0");
+    uint32_t num_bit_vectors = 0;
+    for (const auto &word : make_partition_test_words()) {
+        auto exp = dump_posting_list(exp_index, field_id, word);
+        EXPECT_EQ(exp, dump_posting_list(act_index, field_id, word)) << "word " << word;
+        if (exp.find(",bv=") != vespalib::string::npos) {
+            ++num_bit_vectors;
+        }
+    }
+    EXPECT_LT(0u, num_bit_vectors);
+    clean_partition_testdirs();
+}
+
 }
 
 }
@@ -7,13 +7,16 @@
 #include <vespa/searchlib/docstore/chunkformat.h>
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/vespalib/objects/hexdump.h>
+#include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/zstd_dictionary.h>
 #include <zstd.h>
 
 LOG_SETUP("chunk_test");
 
 using namespace search;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
 
 TEST("require that Chunk obey limits")
 {
@@ -100,4 +103,63 @@ TEST("require that V2 can create and handle lz4, zstd, and none") {
     verifyChunkCompression(CompressionConfig::ZSTD, MY_LONG_STRING, strlen(MY_LONG_STRING), zstd_compressed_length);
 }
 
+vespalib::string
+makeDocument(uint32_t lid) {
+    vespalib::asciistream os;
+    os << "{\"title\":\"Document number " << lid << "\",\"category\":\"category-" << (lid % 7)
+       << "\",\"body\":\"All documents in this corpus share most of their fields and structure\",\"weight\":" << (lid * 13) << "}";
+    return os.str();
+}
+
+ZStdDictionary::SP
+trainDictionary() {
+    std::vector<vespalib::string> docs;
+    for (uint32_t lid(0); lid < 2000; lid++) {
+        docs.push_back(makeDocument(lid));
+    }
+    std::vector<vespalib::ConstBufferRef> samples;
+    for (const auto & doc : docs) {
+        samples.emplace_back(doc.data(), doc.size());
+    }
+    return ZStdDictionary::train(samples, 4096, 3);
+}
+
+size_t
+packChunk(const Chunk::Config & config, vespalib::DataBuffer & buffer) {
+    Chunk chunk(7, config);
+    for (uint32_t lid(1); lid <= 5; lid++) {
+        vespalib::string doc = makeDocument(lid);
+        chunk.append(lid, {doc.data(), doc.size()});
+    }
+    chunk.pack(9, buffer, CompressionConfig(CompressionConfig::ZSTD, 3, 100));
+    return buffer.getDataLen();
+}
+
+TEST("require that V3 compresses small chunks with the zstd dictionary") {
+    ZStdDictionary::SP dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    vespalib::DataBuffer plain;
+    vespalib::DataBuffer withDictionary;
+    size_t plainSize = packChunk(Chunk::Config(0x10000), plain);
+    size_t dictionarySize = packChunk(Chunk::Config(0x10000, dictionary), withDictionary);
+    EXPECT_LESS(dictionarySize, plainSize);
+    EXPECT_EQUAL(uint8_t(ChunkFormatV3::VERSION), uint8_t(withDictionary.getData()[0]));
+
+    Chunk chunk(7, withDictionary.getData(), withDictionary.getDataLen(), dictionary);
+    EXPECT_EQUAL(5u, chunk.count());
+    EXPECT_EQUAL(9u, chunk.getLastSerial());
+    for (uint32_t lid(1); lid <= 5; lid++) {
+        vespalib::ConstBufferRef data = chunk.getLid(lid);
+        EXPECT_EQUAL(makeDocument(lid), vespalib::string(data.c_str(), data.size()));
+    }
+}
+
+TEST("require that V3 can not be read without the matching dictionary") {
+    ZStdDictionary::SP dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    vespalib::DataBuffer buffer;
+    packChunk(Chunk::Config(0x10000, dictionary), buffer);
+    EXPECT_EXCEPTION(Chunk(7, buffer.getData(), buffer.getDataLen()), ChunkException, "dictionary");
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -68,6 +68,16 @@ TEST_FFF("require that cached docstore lookups are counted",
     EXPECT_EQUAL(1u, f3.getCacheStats().misses);
 }
 
+TEST_FFF("require that batched docstore lookups are counted",
+         DocumentStore::Config(CompressionConfig::NONE, 0),
+         NullDataStore(), DocumentStore(f1, f2))
+{
+    auto docs = f3.read_batch({1, 2, 3}, repo);
+    EXPECT_EQUAL(3u, docs.size());
+    EXPECT_FALSE(docs[0] || docs[1] || docs[2]);
+    EXPECT_EQUAL(3u, f3.getCacheStats().misses);
+}
+
 TEST("require that DocumentStore::Config equality operator detects inequality") {
     using C = DocumentStore::Config;
     EXPECT_TRUE(C() == C());
@@ -31,10 +31,18 @@ struct MyFileHeaderContext : public FileHeaderContext {
 
 struct SetLidObserver : public ISetLid {
     std::vector<uint32_t> lids;
+    LidInfoWithLidV lidInfos;
     void setLid(const unique_lock &guard, uint32_t lid, const LidInfo &lidInfo) override {
         (void) guard;
-        (void) lidInfo;
         lids.push_back(lid);
+        lidInfos.emplace_back(lidInfo, lid);
+    }
+};
+
+struct BufferVisitor : public IBufferVisitor {
+    std::vector<std::pair<uint32_t, vespalib::string>> visited;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override {
+        visited.emplace_back(lid, vespalib::string(buffer.c_str(), buffer.size()));
     }
 };
 
@@ -58,6 +66,14 @@ getData(uint32_t lid)
     return oss.str();
 }
 
+vespalib::string
+getLargeData(uint32_t lid)
+{
+    vespalib::string data = getData(lid);
+    data.append(vespalib::string(3000 + (lid % 7) * 100, char('a' + (lid % 26))));
+    return data;
+}
+
 struct FixtureBase {
     test::DirectoryHandler dir;
     ThreadStackExecutor executor;
@@ -119,7 +135,7 @@ struct WriteFixture : public FixtureBase {
                  bool dirCleanup = true)
         : FixtureBase(baseName, dirCleanup),
           chunk(executor, FileChunk::FileId(0), FileChunk::NameId(1234), baseName, serialNum, docIdLimit,
-                {CompressionConfig(), 0x1000}, tuneFile, fileHeaderCtx, &bucketizer)
+                {CompressionConfig(), 0x1000}, tuneFile, fileHeaderCtx, &bucketizer, {})
     {
         dir.cleanup(dirCleanup);
     }
@@ -128,7 +144,9 @@ struct WriteFixture : public FixtureBase {
         chunk.flushPendingChunks(serialNum);
     }
     WriteFixture &append(uint32_t lid) {
-        vespalib::string data = getData(lid);
+        return append(lid, getData(lid));
+    }
+    WriteFixture &append(uint32_t lid, const vespalib::string &data) {
         chunk.append(nextSerialNum(), lid, {data.c_str(), data.size()}, CpuUsage::Category::WRITE);
         return *this;
     }
@@ -225,6 +243,62 @@ TEST("require that entries with lid >= docIdLimit are skipped in updateLidMap()"
     }
 }
 
+struct ReadAheadProbe : public FileChunk {
+    using FileChunk::ChunkInfo;
+    using FileChunk::READ_AHEAD_BYTES;
+    static bool canReadTogether(const ChunkInfo &first, const ChunkInfo &prev, const ChunkInfo &next) {
+        return FileChunk::canReadTogether(first, prev, next);
+    }
+};
+
+TEST("require that read-ahead merges chunks adjacent on disk") {
+    using ChunkInfo = ReadAheadProbe::ChunkInfo;
+    ChunkInfo first(0x1000, 0x800, 1);
+    EXPECT_TRUE(ReadAheadProbe::canReadTogether(first, first, ChunkInfo(0x1800, 0x800, 2)));
+    // The alignment padding after the previous chunk is read along.
+    EXPECT_TRUE(ReadAheadProbe::canReadTogether(first, first, ChunkInfo(0x2000, 0x800, 2)));
+    EXPECT_TRUE(ReadAheadProbe::canReadTogether(first, ChunkInfo(0x2000, 0x800, 2), ChunkInfo(0x3000, 0x800, 3)));
+    // A gap of an alignment unit or more, or a chunk before the previous, needs a new read.
+    EXPECT_FALSE(ReadAheadProbe::canReadTogether(first, first, ChunkInfo(0x2800, 0x800, 2)));
+    EXPECT_FALSE(ReadAheadProbe::canReadTogether(first, ChunkInfo(0x3000, 0x800, 2), ChunkInfo(0x2000, 0x800, 3)));
+    EXPECT_FALSE(ReadAheadProbe::canReadTogether(first, first, ChunkInfo()));
+}
+
+TEST("require that read-ahead respects the byte limit") {
+    using ChunkInfo = ReadAheadProbe::ChunkInfo;
+    constexpr uint64_t limit = ReadAheadProbe::READ_AHEAD_BYTES;
+    ChunkInfo first(0x1000, 0x1000, 1);
+    ChunkInfo prev(0x1000 + limit - 0x2000, 0x1000, 2);
+    EXPECT_TRUE(ReadAheadProbe::canReadTogether(first, prev, ChunkInfo(0x1000 + limit - 0x1000, 0x1000, 3)));
+    EXPECT_FALSE(ReadAheadProbe::canReadTogether(first, prev, ChunkInfo(0x1000 + limit - 0x1000, 0x1001, 3)));
+    EXPECT_FALSE(ReadAheadProbe::canReadTogether(first, first, ChunkInfo(0x2000, limit, 2)));
+}
+
+TEST("require that lids spanning more than the read-ahead limit are all read back unchanged") {
+    constexpr uint32_t numLids = 1000;
+    {
+        WriteFixture f("tmp", 0, false);
+        for (uint32_t lid(1); lid <= numLids; lid++) {
+            f.append(lid, getLargeData(lid));
+        }
+        f.flush();
+    }
+    ReadFixture f("tmp");
+    f.updateLidMap(numLids + 1);
+    f.chunk.enableRead();
+    const LidInfoWithLidV &lidInfos = f.lidObserver.lidInfos;
+    ASSERT_EQUAL(numLids, lidInfos.size());
+    EXPECT_LESS(size_t(ReadAheadProbe::READ_AHEAD_BYTES), lidInfos.size() * getLargeData(1).size());
+    EXPECT_LESS(1u, lidInfos.back().getChunkId());
+    BufferVisitor visitor;
+    f.chunk.read(lidInfos.begin(), lidInfos.size(), visitor);
+    ASSERT_EQUAL(numLids, visitor.visited.size());
+    for (uint32_t i(0); i < numLids; i++) {
+        EXPECT_EQUAL(i + 1, visitor.visited[i].first);
+        EXPECT_EQUAL(getLargeData(i + 1), visitor.visited[i].second);
+    }
+}
+
 using vespalib::compression::CompressionConfig;
 
 TEST("require that operator == detects inequality") {
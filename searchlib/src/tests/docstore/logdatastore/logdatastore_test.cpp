@@ -18,6 +18,7 @@
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/memory.h>
+#include <algorithm>
 #include <filesystem>
 #include <iomanip>
 #include <random>
@@ -339,6 +340,75 @@ TEST("testThatIncompleteCompactedFilesAreRemoved") {
     EXPECT_TRUE(files.find(FileChunk::NameId(2422358701368384000)) != files.end());
 }
 
+vespalib::string
+makeLidOrderDoc(uint32_t lid)
+{
+    vespalib::asciistream os;
+    os << "doc_" << lid << "_";
+    for (uint32_t i(0); i < (lid % 37); i++) {
+        os << char('a' + ((lid + i) % 26));
+    }
+    return os.str();
+}
+
+void
+verifyLidOrderDocs(IDataStore & datastore, uint32_t docIdLimit)
+{
+    for (uint32_t lid(1); lid < docIdLimit; lid++) {
+        if ((lid % 3) == 0) {
+            vespalib::DataBuffer buf;
+            EXPECT_EQUAL(ssize_t(0), datastore.read(lid, buf));
+        } else {
+            vespalib::string doc = makeLidOrderDoc(lid);
+            TEST_DO(fetchAndTest(datastore, lid, doc.data(), doc.size()));
+        }
+    }
+}
+
+TEST("require that a store compacted in lid order returns every document unchanged") {
+    constexpr uint32_t docIdLimit = 4000;
+    DirectoryHandler tmpDir("lidordercompact");
+    LogDataStore::Config config;
+    config.setMaxFileSize(20000).setCompactOrder(LogDataStore::Config::CompactOrder::LID)
+            .setFileConfig({{}, 1000});
+    vespalib::ThreadStackExecutor executor(4);
+    DummyFileHeaderContext fileHeaderContext;
+    MyTlSyncer tlSyncer;
+    {
+        LogDataStore datastore(executor, "lidordercompact", config, GrowStrategy(),
+                               TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+        std::vector<uint32_t> lids;
+        for (uint32_t lid(1); lid < docIdLimit; lid++) {
+            lids.push_back(lid);
+        }
+        std::shuffle(lids.begin(), lids.end(), std::minstd_rand(383451));
+        SerialNum serial(0);
+        for (uint32_t lid : lids) {
+            vespalib::string doc = makeLidOrderDoc(lid);
+            datastore.write(++serial, lid, doc.data(), doc.size());
+        }
+        for (uint32_t lid(3); lid < docIdLimit; lid += 3) {
+            datastore.remove(++serial, lid);
+        }
+        datastore.flush(datastore.initFlush(serial));
+        size_t numFiles = datastore.getAllActiveFiles().size();
+        EXPECT_LESS(1u, numFiles);
+        size_t bloat = datastore.getDiskBloat();
+        EXPECT_LESS(0u, bloat);
+        for (size_t i(0); i < numFiles; i++) {
+            datastore.compactBloat(++serial);
+        }
+        EXPECT_GREATER(bloat, datastore.getDiskBloat());
+        TEST_DO(verifyLidOrderDocs(datastore, docIdLimit));
+        datastore.flush(datastore.initFlush(serial));
+    }
+    {
+        LogDataStore datastore(executor, "lidordercompact", config, GrowStrategy(),
+                               TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+        TEST_DO(verifyLidOrderDocs(datastore, docIdLimit));
+    }
+}
+
 class VisitStore {
 public:
     VisitStore() :
@@ -473,6 +543,18 @@ public:
     void read(uint32_t id) {
         *_datastore->read(id, _repo);
     }
+    void verifyReadBatch(const std::vector<uint32_t> & lids) {
+        auto docs = _datastore->read_batch(lids, _repo);
+        ASSERT_EQUAL(lids.size(), docs.size());
+        for (size_t i(0); i < lids.size(); i++) {
+            if (_inserted.find(lids[i]) != _inserted.end()) {
+                ASSERT_TRUE(docs[i]);
+                verifyDoc(*docs[i], lids[i]);
+            } else {
+                EXPECT_FALSE(docs[i]);
+            }
+        }
+    }
     void verifyDoc(const Document & doc, uint32_t id) {
         EXPECT_TRUE(doc == *_inserted[id]);
     }
@@ -567,8 +649,8 @@ TEST("Control static memory usage") {
     vespalib::MemoryUsage usage = ds.getMemoryUsage();
     constexpr size_t mutex_size = sizeof(std::mutex) * 2 * (113 + 1); // sizeof(std::mutex) is platform dependent
     constexpr size_t string_size = sizeof(vespalib::string);
-    EXPECT_EQUAL(74476 + mutex_size + 3 * string_size, usage.allocatedBytes());
-    EXPECT_EQUAL(752u + mutex_size + 3 * string_size, usage.usedBytes());
+    EXPECT_EQUAL(74492 + mutex_size + 3 * string_size, usage.allocatedBytes());
+    EXPECT_EQUAL(768u + mutex_size + 3 * string_size, usage.usedBytes());
 }
 
 TEST("test the update cache strategy") {
@@ -676,6 +758,26 @@ TEST("test that the integrated visit cache works.") {
     TEST_DO(verifyCacheStats(ds.getCacheStats(), 101, 108, 99, BASE_SZ-611));
 }
 
+TEST("require that documents can be read in a batch") {
+    VisitCacheStore vcs(DocumentStore::Config::UpdateStrategy::INVALIDATE);
+    IDocumentStore & ds = vcs.getStore();
+    for (size_t i(1); i <= 100; i++) {
+        vcs.write(i);
+    }
+    vcs.verifyRead(7);
+    TEST_DO(vcs.verifyReadBatch({88, 7, 3, 101, 42, 3}));
+    CacheStats cs = ds.getCacheStats();
+    EXPECT_EQUAL(1u, cs.hits);
+    EXPECT_EQUAL(6u, cs.misses);
+    EXPECT_EQUAL(4u, cs.elements);
+    TEST_DO(vcs.verifyReadBatch({3, 42, 88}));
+    EXPECT_EQUAL(4u, ds.getCacheStats().hits);
+    vcs.remove(42);
+    vcs.recreate();
+    TEST_DO(vcs.verifyReadBatch({1, 42, 100, 55}));
+    TEST_DO(vcs.verifyReadBatch({}));
+}
+
 TEST("testWriteRead") {
     std::filesystem::remove_all(std::filesystem::path("empty"));
     const char * bufA = "aaaaaaaaaaaaaaaaaaaaa";
@@ -1007,9 +1109,9 @@ TEST_F("require that lid space can be increased after being compacted and then s
 TEST_F("require that there is control of static memory usage", Fixture)
 {
     vespalib::MemoryUsage usage = f.store.getMemoryUsage();
-    EXPECT_EQUAL(456u + sizeof(LogDataStore::NameIdSet) + sizeof(std::mutex) + sizeof(vespalib::string), sizeof(LogDataStore));
-    EXPECT_EQUAL(73916u + 3 * sizeof(vespalib::string), usage.allocatedBytes());
-    EXPECT_EQUAL(192u + 3 * sizeof(vespalib::string), usage.usedBytes());
+    EXPECT_EQUAL(464u + sizeof(LogDataStore::NameIdSet) + sizeof(std::mutex) + sizeof(vespalib::string), sizeof(LogDataStore));
+    EXPECT_EQUAL(73932u + 3 * sizeof(vespalib::string), usage.allocatedBytes());
+    EXPECT_EQUAL(208u + 3 * sizeof(vespalib::string), usage.usedBytes());
 }
 
 TEST_F("require that lid space can be shrunk only after read guards are deleted", Fixture)
@@ -1060,6 +1162,7 @@ TEST("require that config equality operator detects inequality") {
     EXPECT_FALSE(C() == C().setMinFileSizeFactor(0.3));
     EXPECT_FALSE(C() == C().setFileConfig(WriteableFileChunk::Config({}, 70)));
     EXPECT_FALSE(C() == C().compactCompression({CompressionConfig::ZSTD}));
+    EXPECT_FALSE(C() == C().setCompactOrder(C::CompactOrder::LID));
 }
 
 TEST_MAIN() {
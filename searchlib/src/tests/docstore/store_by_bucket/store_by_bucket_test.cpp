@@ -148,4 +148,25 @@ TEST("test that iterators cover the whole corpus and maps to correct partid") {
     EXPECT_EQUAL(500u, COUNT_0 + COUNT_1 + COUNT_2);
 }
 
+TEST("test that lid ordered iterators give all lids in order over the partitions") {
+    BucketIndexStore lidIndexStore = BucketIndexStore::lidOrdered(501, NUM_PARTS);
+    EXPECT_TRUE(lidIndexStore.lidOrder());
+    for (size_t i(500); i >= 1u; i--) {
+        lidIndexStore.store(StoreByBucket::Index(createBucketId(i), 1, 2, i));
+    }
+    lidIndexStore.prepareForIterate();
+    EXPECT_EQUAL(500u, lidIndexStore.getLidCount());
+    uint32_t lastLid(0);
+    for (uint32_t partId(0); partId < NUM_PARTS; partId++) {
+        auto iter = lidIndexStore.createIterator(partId);
+        while (iter->has_next()) {
+            StoreByBucket::Index idx = iter->next();
+            EXPECT_EQUAL(lidIndexStore.toPartitionId(idx), partId);
+            EXPECT_EQUAL(lastLid + 1, idx._lid);
+            lastLid = idx._lid;
+        }
+    }
+    EXPECT_EQUAL(500u, lastLid);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
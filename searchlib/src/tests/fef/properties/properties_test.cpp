@@ -287,6 +287,24 @@ TEST(PropertiesTest, test_stuff)
             p.add("vespa.matching.termwise_limit", "0.05");
             EXPECT_EQ(matching::TermwiseLimit::lookup(p), 0.05);
         }
+        { // vespa.matching.first_phase_batch_size
+            EXPECT_EQ(matching::FirstPhaseBatchSize::NAME, vespalib::string("vespa.matching.first_phase_batch_size"));
+            EXPECT_EQ(matching::FirstPhaseBatchSize::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQ(matching::FirstPhaseBatchSize::lookup(p), 0u);
+            EXPECT_EQ(matching::FirstPhaseBatchSize::lookup(p, 64), 64u);
+            p.add("vespa.matching.first_phase_batch_size", "128");
+            EXPECT_EQ(matching::FirstPhaseBatchSize::lookup(p), 128u);
+        }
+        { // vespa.matching.second_phase_batch_size
+            EXPECT_EQ(matching::SecondPhaseBatchSize::NAME, vespalib::string("vespa.matching.second_phase_batch_size"));
+            EXPECT_EQ(matching::SecondPhaseBatchSize::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQ(matching::SecondPhaseBatchSize::lookup(p), 0u);
+            EXPECT_EQ(matching::SecondPhaseBatchSize::lookup(p, 64), 64u);
+            p.add("vespa.matching.second_phase_batch_size", "256");
+            EXPECT_EQ(matching::SecondPhaseBatchSize::lookup(p), 256u);
+        }
         { // vespa.matching.numthreads
             EXPECT_EQ(matching::NumThreadsPerSearch::NAME, vespalib::string("vespa.matching.numthreadspersearch"));
             EXPECT_EQ(matching::NumThreadsPerSearch::DEFAULT_VALUE, std::numeric_limits<uint32_t>::max());
@@ -312,6 +330,15 @@ TEST(PropertiesTest, test_stuff)
             p.add("vespa.matching.numsearchpartitions", "50");
             EXPECT_EQ(matching::NumSearchPartitions::lookup(p), 50u);
         }
+        { // vespa.matching.work_stealing
+            EXPECT_EQ(matching::WorkStealing::NAME, vespalib::string("vespa.matching.work_stealing"));
+            EXPECT_FALSE(matching::WorkStealing::DEFAULT_VALUE);
+            Properties p;
+            EXPECT_FALSE(matching::WorkStealing::lookup(p));
+            EXPECT_TRUE(matching::WorkStealing::lookup(p, true));
+            p.add("vespa.matching.work_stealing", "true");
+            EXPECT_TRUE(matching::WorkStealing::lookup(p));
+        }
         { // vespa.matchphase.degradation.attribute
             EXPECT_EQ(matchphase::DegradationAttribute::NAME, vespalib::string("vespa.matchphase.degradation.attribute"));
             EXPECT_EQ(matchphase::DegradationAttribute::DEFAULT_VALUE, "");
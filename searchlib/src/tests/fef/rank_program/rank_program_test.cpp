@@ -448,6 +448,71 @@ TEST(RankProgramTest, fast_forest_gbdt_evaluation_is_pure)
     EXPECT_EQ(f1.final_executor_name(), "search::features::FastForestExecutor");
 }
 
+TEST(RankProgramTest, batch_execution_is_not_set_up_when_disabled)
+{
+    Fixture f1;
+    f1.add_expr("rank", "docid+value(10)").compile();
+    EXPECT_FALSE(f1.program.setup_batch(0));
+    EXPECT_EQ(f1.program.max_batch_size(), 0u);
+    EXPECT_EQ(f1.get(3), 13.0);
+}
+
+TEST(RankProgramTest, batch_execution_needs_all_executors_to_support_it)
+{
+    Fixture f1;
+    f1.add("mysum(value(10),docid)").compile();
+    EXPECT_FALSE(f1.program.setup_batch(4));
+    EXPECT_EQ(f1.program.max_batch_size(), 0u);
+    EXPECT_EQ(f1.get(3), 13.0);
+}
+
+TEST(RankProgramTest, batch_execution_needs_a_single_seed)
+{
+    Fixture f1;
+    f1.add_expr("a", "docid+1").add_expr("b", "docid+2").compile();
+    EXPECT_FALSE(f1.program.setup_batch(4));
+}
+
+TEST(RankProgramTest, batch_execution_calculates_seed_for_all_documents)
+{
+    for (bool lazy: {false, true}) {
+        Fixture f1;
+        f1.lazy_expressions(lazy).add_expr("rank", "docid*2+value(10)").compile();
+        ASSERT_TRUE(f1.program.setup_batch(4));
+        EXPECT_EQ(f1.program.max_batch_size(), 4u);
+        std::vector<uint32_t> docids = {3, 5, 6, 10};
+        f1.program.execute_batch(docids);
+        const feature_t *scores = f1.program.get_batch_seed();
+        EXPECT_EQ(scores[0], 16.0);
+        EXPECT_EQ(scores[1], 20.0);
+        EXPECT_EQ(scores[2], 22.0);
+        EXPECT_EQ(scores[3], 30.0);
+        std::vector<uint32_t> partial = {7};
+        f1.program.execute_batch(partial);
+        EXPECT_EQ(scores[0], 24.0);
+        EXPECT_EQ(f1.get(7), 24.0);
+    }
+}
+
+TEST(RankProgramTest, batch_execution_broadcasts_const_seed)
+{
+    Fixture f1;
+    f1.use_fast_forest().add_expr("rank", tree_expr).compile();
+    ASSERT_TRUE(f1.program.setup_batch(2));
+    std::vector<uint32_t> docids = {1, 2};
+    f1.program.execute_batch(docids);
+    EXPECT_EQ(f1.program.get_batch_seed()[0], 21.0);
+    EXPECT_EQ(f1.program.get_batch_seed()[1], 21.0);
+}
+
+TEST(RankProgramTest, batch_execution_is_not_set_up_for_profiled_programs)
+{
+    Fixture f1;
+    ExecutionProfiler profiler(64);
+    f1.add_expr("rank", "docid+value(10)").compile(&profiler);
+    EXPECT_FALSE(f1.program.setup_batch(4));
+}
+
 TEST(RankProgramTest, rank_program_can_be_profiled)
 {
     Fixture f1;
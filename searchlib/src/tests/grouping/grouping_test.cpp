@@ -5,6 +5,9 @@
 #include <vespa/searchlib/aggregation/aggregation.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
 #include <vespa/searchlib/attribute/attributemanager.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/stringbase.h>
+#include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchlib/aggregation/hitsaggregationresult.h>
 #include <vespa/searchlib/aggregation/fs4hit.h>
 #include <vespa/searchlib/aggregation/predicates.h>
@@ -586,6 +589,38 @@ TEST("Verify that groups are sorted by group id")
     EXPECT_TRUE(testAggregation(ctx, request, expect));
 }
 
+TEST("Verify that grouping on enumerated string attribute uses enum handles and gives string ids")
+{
+    AggregationContext ctx;
+    auto attr = AttributeFactory::createAttribute("attr", Config(BasicType::STRING, CollectionType::SINGLE));
+    ASSERT_TRUE(attr->addDocs(6));
+    auto &string_attr = dynamic_cast<StringAttribute &>(*attr);
+    const char *values[] = {"b", "a", "b", "c", "a", "b"};
+    for (uint32_t docid = 0; docid < 6; ++docid) {
+        string_attr.update(docid, values[docid]);
+    }
+    attr->commit();
+    ctx.add(attr);
+    ctx.result().add(0).add(1).add(2).add(3).add(4).add(5);
+
+    auto node = MU<AttributeNode>("attr");
+    node->enableEnumOptimization(true);
+    GroupingLevel level = createGL(std::move(node));
+    level.addResult(CountAggregationResult().setExpression(MU<ConstantNode>(MU<Int64ResultNode>(0))));
+    Grouping request;
+    request.addLevel(std::move(level));
+
+    Group expect;
+    expect.addChild(Group().setId(StringResultNode("a"))
+                           .addResult(CountAggregationResult().setCount(2).setExpression(MU<ConstantNode>(MU<Int64ResultNode>(0)))))
+          .addChild(Group().setId(StringResultNode("b"))
+                           .addResult(CountAggregationResult().setCount(3).setExpression(MU<ConstantNode>(MU<Int64ResultNode>(0)))))
+          .addChild(Group().setId(StringResultNode("c"))
+                           .addResult(CountAggregationResult().setCount(1).setExpression(MU<ConstantNode>(MU<Int64ResultNode>(0)))));
+
+    EXPECT_TRUE(testAggregation(ctx, request, expect));
+}
+
 TEST("Verify that groups are tagged with the appropriate rank value")
 {
     AggregationContext ctx;
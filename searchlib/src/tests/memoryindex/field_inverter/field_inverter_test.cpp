@@ -188,6 +188,12 @@ struct FieldInverterTest : public ::testing::Test {
         }
     }
 
+    void prepare_push() {
+        for (auto &inverter : _inverters) {
+            inverter->prepare_push();
+        }
+    }
+
     void removeDocument(uint32_t docId) {
         for (auto &inverter : _inverters) {
             inverter->removeDocument(docId);
@@ -348,6 +354,42 @@ TEST_F(FieldInverterTest, require_that_mix_of_add_and_remove_works)
               _inserter_backend.toStr());
 }
 
+TEST_F(FieldInverterTest, require_that_prepared_push_works)
+{
+    invertDocument(10, *makeDoc10(_b));
+    invertDocument(11, *makeDoc11(_b));
+    invertDocument(12, *makeDoc12(_b));
+    removeDocument(12);
+    prepare_push();
+    pushDocuments();
+    EXPECT_EQ("f=0,w=a,a=10,a=11,"
+              "w=b,a=10,a=11,"
+              "w=c,a=10,w=d,a=10,"
+              "w=e,a=11,"
+              "w=f,a=11,"
+              "f=1,w=a,a=11,"
+              "w=g,a=11",
+              _inserter_backend.toStr());
+}
+
+TEST_F(FieldInverterTest, require_that_removes_added_after_prepared_push_works)
+{
+    invertDocument(10, *makeDoc10(_b));
+    prepare_push();
+    // Simulate removes applied by push thread
+    _inverters[0]->remove("a", 11);
+    _inverters[0]->remove("c", 9);
+    _inverters[0]->remove("d", 10);
+    _inverters[0]->remove("z", 12);
+    pushDocuments();
+    EXPECT_EQ("f=0,w=a,a=10,r=11,"
+              "w=b,a=10,"
+              "w=c,r=9,a=10,"
+              "w=d,r=10,a=10,"
+              "w=z,r=12",
+              _inserter_backend.toStr());
+}
+
 TEST_F(FieldInverterTest, require_that_empty_document_can_be_inverted)
 {
     invertDocument(15, *makeDoc15(_b));
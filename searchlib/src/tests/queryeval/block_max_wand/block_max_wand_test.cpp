@@ -0,0 +1,342 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/searchlib/fef/matchdatalayout.h>
+#include <vespa/searchlib/queryeval/block_max_info.h>
+#include <vespa/searchlib/queryeval/field_spec.h>
+#include <vespa/searchlib/queryeval/intermediate_blueprints.h>
+#include <vespa/searchlib/queryeval/leaf_blueprints.h>
+#include <vespa/searchlib/queryeval/wand/block_max_wand_search.h>
+#include <vespa/searchlib/queryeval/wand/weak_and_heap.h>
+#include <vespa/searchlib/queryeval/wand/weak_and_search.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+using namespace search::fef;
+using namespace search::queryeval;
+
+using score_t = wand::score_t;
+
+namespace {
+
+constexpr uint32_t num_docs = 5000;
+constexpr uint32_t block_size = 16;
+
+struct Posting {
+    uint32_t doc_id;
+    uint16_t num_occs;
+    uint16_t field_length;
+};
+
+using Postings = std::vector<Posting>;
+
+/**
+ * Strict term search over a fixed posting list, optionally exposing block
+ * max information for fixed size blocks of postings.
+ */
+class MyTermSearch : public SearchIterator, public BlockMaxInfo
+{
+    const Postings     &_postings;
+    TermFieldMatchData &_tfmd;
+    bool                _block_max;
+    size_t              _pos;
+    uint32_t           &_unpacks;
+public:
+    MyTermSearch(const Postings &postings, TermFieldMatchData &tfmd, bool block_max, uint32_t &unpacks)
+        : SearchIterator(),
+          _postings(postings),
+          _tfmd(tfmd),
+          _block_max(block_max),
+          _pos(0),
+          _unpacks(unpacks)
+    {}
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, end);
+        _pos = 0;
+    }
+    void doSeek(uint32_t docid) override {
+        while (_pos < _postings.size() && _postings[_pos].doc_id < docid) {
+            ++_pos;
+        }
+        if (_pos < _postings.size()) {
+            setDocId(_postings[_pos].doc_id);
+        } else {
+            setAtEnd();
+        }
+    }
+    void doUnpack(uint32_t docid) override {
+        ++_unpacks;
+        _tfmd.resetOnlyDocId(docid);
+        _tfmd.setNumOccs(_postings[_pos].num_occs);
+        _tfmd.setFieldLength(_postings[_pos].field_length);
+    }
+    Trinary is_strict() const override { return Trinary::True; }
+    BlockMaxInfo *as_block_max_info() noexcept override { return _block_max ? this : nullptr; }
+    bool find_block(uint32_t docid, Block &block) override {
+        auto itr = std::lower_bound(_postings.begin(), _postings.end(), docid,
+                                    [](const Posting &p, uint32_t d) { return p.doc_id < d; });
+        if (itr == _postings.end()) {
+            return false;
+        }
+        size_t begin = ((itr - _postings.begin()) / block_size) * block_size;
+        size_t end = std::min(begin + block_size, _postings.size());
+        block.last_doc_id = _postings[end - 1].doc_id;
+        block.max_num_occs = 0;
+        block.min_field_length = std::numeric_limits<uint32_t>::max();
+        for (size_t i = begin; i < end; ++i) {
+            block.max_num_occs = std::max(block.max_num_occs, uint32_t(_postings[i].num_occs));
+            block.min_field_length = std::min(block.min_field_length, uint32_t(_postings[i].field_length));
+        }
+        return true;
+    }
+};
+
+struct Hit {
+    uint32_t docid;
+    score_t  score;
+    bool operator<(const Hit &rhs) const noexcept {
+        return (score != rhs.score) ? (score > rhs.score) : (docid < rhs.docid);
+    }
+};
+
+using Hits = std::vector<Hit>;
+
+class BlockMaxWandTest : public ::testing::Test {
+protected:
+    std::vector<Postings>            _postings;
+    std::vector<int32_t>             _weights;
+    BlockMaxWandSearch::Scorer       _scorer;
+    uint32_t                         _unpacks;
+
+    BlockMaxWandTest();
+    ~BlockMaxWandTest() override;
+
+    void add_term(double hit_ratio, int32_t weight, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> hit_dist(0.0, 1.0);
+        std::uniform_int_distribution<uint32_t> occs_dist(1, 8);
+        std::uniform_int_distribution<uint32_t> len_dist(1, 40);
+        Postings postings;
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            if (hit_dist(gen) < hit_ratio) {
+                postings.push_back({docid, uint16_t(occs_dist(gen)), uint16_t(len_dist(gen))});
+            }
+        }
+        _postings.push_back(std::move(postings));
+        _weights.push_back(weight);
+    }
+
+    // exact top-k using the same per term scores as the iterator
+    Hits brute_force(uint32_t k) const {
+        std::vector<score_t> scores(num_docs, 0);
+        std::vector<bool> matched(num_docs, false);
+        for (size_t i = 0; i < _postings.size(); ++i) {
+            double factor = _scorer.calculate_term_factor(_postings[i].size(), _weights[i]);
+            for (const auto &p : _postings[i]) {
+                scores[p.doc_id] += _scorer.calculate_score(factor, p.num_occs, p.field_length);
+                matched[p.doc_id] = true;
+            }
+        }
+        Hits hits;
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            if (matched[docid]) {
+                hits.push_back({docid, scores[docid]});
+            }
+        }
+        std::sort(hits.begin(), hits.end());
+        hits.resize(std::min(size_t(k), hits.size()));
+        return hits;
+    }
+
+    Hits search(uint32_t k, bool block_max, bool strict) {
+        SharedWeakAndPriorityQueue heap(k);
+        MatchDataLayout layout;
+        std::vector<TermFieldHandle> handles;
+        for (size_t i = 0; i < _postings.size(); ++i) {
+            handles.push_back(layout.allocTermField(0));
+        }
+        auto md = layout.createMatchData();
+        TermFieldMatchData root_tfmd;
+        wand::Terms terms;
+        _unpacks = 0;
+        for (size_t i = 0; i < _postings.size(); ++i) {
+            auto *tfmd = md->resolveTermField(handles[i]);
+            terms.emplace_back(new MyTermSearch(_postings[i], *tfmd, block_max, _unpacks), _weights[i], _postings[i].size(), tfmd);
+        }
+        auto itr = BlockMaxWandSearch::create(terms, _scorer, wand::MatchParams(heap, 0, 1),
+                                              BlockMaxWandSearch::RankParams(root_tfmd, std::move(md)), strict, false);
+        Hits hits;
+        itr->initRange(1, num_docs);
+        if (strict) {
+            for (uint32_t docid = itr->seekFirst(1); !itr->isAtEnd(docid); docid = itr->seekNext(docid + 1)) {
+                itr->unpack(docid);
+                hits.push_back({docid, score_t(root_tfmd.getRawScore())});
+            }
+        } else {
+            for (uint32_t docid = 1; docid < num_docs; ++docid) {
+                if (itr->seek(docid)) {
+                    itr->unpack(docid);
+                    hits.push_back({docid, score_t(root_tfmd.getRawScore())});
+                }
+            }
+        }
+        std::sort(hits.begin(), hits.end());
+        hits.resize(std::min(size_t(k), hits.size()));
+        return hits;
+    }
+
+    std::unique_ptr<WeakAndBlueprint> make_weak_and(uint32_t k, bool block_max, MatchDataLayout &layout,
+                                                    const std::vector<FieldSpec> &fields) const
+    {
+        auto wand = std::make_unique<WeakAndBlueprint>(k, 0.0, false);
+        for (size_t i = 0; i < _postings.size(); ++i) {
+            FakeResult result;
+            for (const auto &p : _postings[i]) {
+                result.doc(p.doc_id).num_occs(p.num_occs).field_length(p.field_length);
+            }
+            FieldSpec field(fields[i].getName(), fields[i].getFieldId(), layout.allocTermField(fields[i].getFieldId()),
+                            fields[i].isFilter());
+            wand->addTerm(std::make_unique<FakeBlueprint>(field, result), _weights[i]);
+        }
+        if (block_max) {
+            wand->enable_block_max(20.0);
+        }
+        wand->setDocIdLimit(num_docs);
+        wand->basic_plan(true, num_docs);
+        wand->fetchPostings(ExecuteInfo::FULL);
+        return wand;
+    }
+
+    // only unpack interleaved features when asked for by the weakAnd blueprint
+    static MatchData::UP create_match_data(const MatchDataLayout &layout) {
+        auto md = layout.createMatchData();
+        for (uint32_t i = 0; i < md->getNumTermFields(); ++i) {
+            md->resolveTermField(i)->setNeedInterleavedFeatures(false);
+        }
+        return md;
+    }
+
+    std::vector<FieldSpec> same_field() const {
+        return std::vector<FieldSpec>(_postings.size(), FieldSpec("f", 0, 0));
+    }
+};
+
+BlockMaxWandTest::BlockMaxWandTest()
+    : ::testing::Test(),
+      _postings(),
+      _weights(),
+      _scorer(num_docs, 20.0),
+      _unpacks(0)
+{
+    add_term(0.30, 1, 1);
+    add_term(0.10, 2, 2);
+    add_term(0.05, 1, 3);
+    add_term(0.01, 3, 4);
+}
+
+BlockMaxWandTest::~BlockMaxWandTest() = default;
+
+void expect_same_scores(const Hits &expect, const Hits &actual) {
+    ASSERT_EQ(expect.size(), actual.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        EXPECT_EQ(expect[i].score, actual[i].score) << "i=" << i;
+    }
+}
+
+}
+
+TEST_F(BlockMaxWandTest, block_max_scorer_bounds_term_score)
+{
+    double factor = _scorer.calculate_term_factor(100, 1);
+    score_t max_score = _scorer.calculate_max_score(factor);
+    score_t block_max_score = _scorer.calculate_block_max_score(factor, 4, 10);
+    EXPECT_LT(block_max_score, max_score);
+    EXPECT_LT(_scorer.calculate_score(factor, 4, 10), block_max_score);
+    EXPECT_LT(_scorer.calculate_score(factor, 3, 10), block_max_score);
+    EXPECT_LT(_scorer.calculate_score(factor, 4, 11), block_max_score);
+    EXPECT_LT(_scorer.calculate_score(factor, 1000, 1), max_score);
+}
+
+TEST_F(BlockMaxWandTest, strict_search_finds_top_k)
+{
+    for (uint32_t k : {1u, 10u, 100u, 1000u}) {
+        SCOPED_TRACE(k);
+        auto expect = brute_force(k);
+        expect_same_scores(expect, search(k, false, true));
+        expect_same_scores(expect, search(k, true, true));
+    }
+}
+
+TEST_F(BlockMaxWandTest, non_strict_search_finds_top_k)
+{
+    for (uint32_t k : {1u, 10u, 100u}) {
+        SCOPED_TRACE(k);
+        auto expect = brute_force(k);
+        expect_same_scores(expect, search(k, false, false));
+        expect_same_scores(expect, search(k, true, false));
+    }
+}
+
+TEST_F(BlockMaxWandTest, block_max_reduces_number_of_evaluated_documents)
+{
+    search(10, false, true);
+    uint32_t unpacks_without_block_max = _unpacks;
+    search(10, true, true);
+    uint32_t unpacks_with_block_max = _unpacks;
+    EXPECT_LT(unpacks_with_block_max, unpacks_without_block_max);
+}
+
+TEST_F(BlockMaxWandTest, weak_and_blueprint_creates_block_max_wand_search_when_enabled)
+{
+    uint32_t k = 10;
+    MatchDataLayout layout;
+    auto wand = make_weak_and(k, true, layout, same_field());
+    auto md = create_match_data(layout);
+    auto itr = wand->createSearch(*md);
+    ASSERT_TRUE(dynamic_cast<BlockMaxWandSearch *>(itr.get()) != nullptr);
+    for (size_t i = 0; i < _postings.size(); ++i) {
+        EXPECT_TRUE(wand->getChild(i).getState().field(0).resolve(*md)->needs_interleaved_features());
+    }
+    std::vector<uint32_t> docids;
+    itr->initRange(1, num_docs);
+    for (uint32_t docid = itr->seekFirst(1); !itr->isAtEnd(docid); docid = itr->seekNext(docid + 1)) {
+        itr->unpack(docid);
+        docids.push_back(docid);
+    }
+    // all documents scoring better than the k-th best document must be found
+    auto expect = brute_force(k);
+    for (const auto &hit : expect) {
+        if (hit.score > expect.back().score) {
+            EXPECT_TRUE(std::binary_search(docids.begin(), docids.end(), hit.docid)) << "docid=" << hit.docid;
+        }
+    }
+}
+
+TEST_F(BlockMaxWandTest, weak_and_blueprint_creates_weak_and_search_when_block_max_is_not_usable)
+{
+    auto expect_weak_and_search = [this](bool block_max, const std::vector<FieldSpec> &fields) {
+        MatchDataLayout layout;
+        auto wand = make_weak_and(10, block_max, layout, fields);
+        auto md = create_match_data(layout);
+        auto itr = wand->createSearch(*md);
+        EXPECT_TRUE(dynamic_cast<WeakAndSearch *>(itr.get()) != nullptr);
+        EXPECT_FALSE(wand->getChild(0).getState().field(0).resolve(*md)->needs_interleaved_features());
+    };
+    {
+        SCOPED_TRACE("not enabled");
+        expect_weak_and_search(false, same_field());
+    }
+    {
+        SCOPED_TRACE("terms in different fields");
+        auto fields = same_field();
+        fields.back() = FieldSpec("g", 1, 0);
+        expect_weak_and_search(true, fields);
+    }
+    {
+        SCOPED_TRACE("filter field");
+        auto fields = same_field();
+        fields.back() = FieldSpec("f", 0, 0, true);
+        expect_weak_and_search(true, fields);
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,262 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/queryeval/wand/max_score_search.h>
+#define ENABLE_GTEST_MIGRATION
+#include <vespa/searchlib/test/weightedchildrenverifiers.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <map>
+#include <random>
+
+using namespace search::queryeval;
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::IDirectPostingStore;
+using search::IDocidWithWeightPostingStore;
+using search::IntegerAttribute;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::fef::TermFieldMatchData;
+using score_t = wand::score_t;
+using MatchParams = MaxScoreSearch::MatchParams;
+using LookupResult = IDirectPostingStore::LookupResult;
+
+constexpr uint32_t num_docs = 3000;
+constexpr uint32_t num_keys = 500;
+constexpr uint32_t keys_per_doc = 20;
+constexpr uint32_t num_query_terms = 150;
+
+struct DummyHeap : public WeakAndHeap {
+    DummyHeap() : WeakAndHeap(9001) {}
+    void adjust(score_t *, score_t *) override {}
+};
+
+class MaxScoreTest : public ::testing::Test {
+protected:
+    AttributeVector::SP                        _attr;
+    const IDocidWithWeightPostingStore        *_dww;
+    // key -> weight for each document
+    std::vector<std::map<int64_t, int32_t>>    _docs;
+    std::vector<int32_t>                       _weights;
+    std::vector<LookupResult>                  _dict_entries;
+    std::vector<int64_t>                       _query_keys;
+    TermFieldMatchData                         _tfmd;
+
+    MaxScoreTest();
+    ~MaxScoreTest() override;
+
+    void populate(uint32_t seed);
+    void make_query(uint32_t seed, int32_t min_weight);
+    score_t exact_score(uint32_t docid) const;
+    std::map<uint32_t, score_t> search(WeakAndHeap &heap, score_t threshold, bool strict, size_t *num_essential = nullptr);
+    void verify_top_k(uint32_t hits_to_track, bool strict);
+};
+
+MaxScoreTest::MaxScoreTest()
+    : ::testing::Test(),
+      _attr(),
+      _dww(nullptr),
+      _docs(),
+      _weights(),
+      _dict_entries(),
+      _query_keys(),
+      _tfmd()
+{
+    search::attribute::Config cfg(BasicType::INT64, CollectionType::WSET);
+    cfg.setFastSearch(true);
+    _attr = AttributeFactory::createAttribute("my_attribute", cfg);
+    _dww = _attr->as_docid_with_weight_posting_store();
+}
+
+MaxScoreTest::~MaxScoreTest() = default;
+
+void
+MaxScoreTest::populate(uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int64_t> key_dist(0, num_keys - 1);
+    std::uniform_int_distribution<int32_t> weight_dist(1, 100);
+    auto &int_attr = dynamic_cast<IntegerAttribute &>(*_attr);
+    _docs.resize(num_docs);
+    for (uint32_t i = 0; i < num_docs; ++i) {
+        uint32_t docid = 0;
+        _attr->addDoc(docid);
+    }
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        while (_docs[docid].size() < keys_per_doc) {
+            _docs[docid].emplace(key_dist(gen), weight_dist(gen));
+        }
+        for (const auto &[key, weight] : _docs[docid]) {
+            int_attr.append(docid, key, weight);
+        }
+    }
+    _attr->commit();
+}
+
+void
+MaxScoreTest::make_query(uint32_t seed, int32_t min_weight)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int64_t> key_dist(0, num_keys - 1);
+    std::uniform_int_distribution<int32_t> weight_dist(min_weight, 100);
+    auto snapshot = _dww->get_dictionary_snapshot();
+    while (_query_keys.size() < num_query_terms) {
+        int64_t key = key_dist(gen);
+        if (std::find(_query_keys.begin(), _query_keys.end(), key) != _query_keys.end()) {
+            continue;
+        }
+        auto result = _dww->lookup(vespalib::make_string("%" PRId64, key), snapshot);
+        ASSERT_TRUE(result.posting_idx.valid());
+        _query_keys.push_back(key);
+        _weights.push_back(weight_dist(gen));
+        _dict_entries.push_back(result);
+    }
+}
+
+score_t
+MaxScoreTest::exact_score(uint32_t docid) const
+{
+    score_t score = 0;
+    for (size_t i = 0; i < _query_keys.size(); ++i) {
+        auto itr = _docs[docid].find(_query_keys[i]);
+        if (itr != _docs[docid].end()) {
+            score += _weights[i] * (score_t)itr->second;
+        }
+    }
+    return score;
+}
+
+std::map<uint32_t, score_t>
+MaxScoreTest::search(WeakAndHeap &heap, score_t threshold, bool strict, size_t *num_essential)
+{
+    MatchParams match_params(heap, threshold, 1.0, 1, num_docs);
+    auto search = MaxScoreSearch::create(_tfmd, match_params, _weights, _dict_entries, *_dww, strict, false);
+    std::map<uint32_t, score_t> result;
+    search->initRange(1, num_docs);
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        if (search->seek(docid)) {
+            search->unpack(docid);
+            result[docid] = _tfmd.getRawScore();
+        } else if (strict) {
+            if (search->isAtEnd()) {
+                break;
+            }
+            docid = search->getDocId() - 1;
+        }
+    }
+    if (num_essential != nullptr) {
+        *num_essential = dynamic_cast<MaxScoreSearch &>(*search).get_num_essential_terms();
+    }
+    return result;
+}
+
+void
+MaxScoreTest::verify_top_k(uint32_t hits_to_track, bool strict)
+{
+    std::vector<score_t> all_scores;
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        all_scores.push_back(exact_score(docid));
+    }
+    std::sort(all_scores.begin(), all_scores.end(), std::greater<>());
+    score_t kth_score = all_scores[hits_to_track - 1];
+    size_t num_essential = 0;
+    auto heap = WeakAndPriorityQueue::createHeap(hits_to_track, false);
+    auto result = search(*heap, heap->getMinScore(), strict, &num_essential);
+    for (const auto &[docid, score] : result) {
+        EXPECT_EQ(exact_score(docid), score) << "docid " << docid;
+    }
+    size_t expected_hits = 0;
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        if (exact_score(docid) > kth_score) {
+            ++expected_hits;
+            EXPECT_TRUE(result.contains(docid)) << "docid " << docid << " with score " << exact_score(docid) << " not found";
+        }
+    }
+    EXPECT_LT(expected_hits, result.size());
+    EXPECT_GT(num_docs - 1, result.size());
+    EXPECT_LT(num_essential, _weights.size());
+}
+
+TEST_F(MaxScoreTest, terms_are_ordered_by_increasing_max_score)
+{
+    populate(42);
+    make_query(7, 1);
+    auto heap = WeakAndPriorityQueue::createHeap(10, false);
+    MatchParams match_params(*heap, heap->getMinScore(), 1.0, 1, num_docs);
+    auto search = MaxScoreSearch::create(_tfmd, match_params, _weights, _dict_entries, *_dww, true, false);
+    auto &max_score = dynamic_cast<MaxScoreSearch &>(*search);
+    ASSERT_EQ(num_query_terms, max_score.get_num_terms());
+    score_t max_bound = 0;
+    for (size_t i = 0; i < _weights.size(); ++i) {
+        max_bound = std::max(max_bound, _weights[i] * (score_t)_dict_entries[i].max_weight);
+    }
+    for (size_t i = 1; i < max_score.get_num_terms(); ++i) {
+        EXPECT_LE(max_score.get_max_score(i - 1), max_score.get_max_score(i));
+    }
+    EXPECT_EQ(max_bound, max_score.get_max_score(num_query_terms - 1));
+    EXPECT_EQ(num_query_terms, max_score.get_num_essential_terms());
+}
+
+TEST_F(MaxScoreTest, strict_search_finds_top_k_hits)
+{
+    populate(42);
+    make_query(7, 1);
+    verify_top_k(10, true);
+    verify_top_k(100, true);
+}
+
+TEST_F(MaxScoreTest, unstrict_search_finds_top_k_hits)
+{
+    populate(42);
+    make_query(7, 1);
+    verify_top_k(10, false);
+    verify_top_k(100, false);
+}
+
+TEST_F(MaxScoreTest, negative_query_weights_are_handled)
+{
+    populate(43);
+    make_query(11, -50);
+    verify_top_k(10, true);
+    verify_top_k(10, false);
+}
+
+TEST_F(MaxScoreTest, strict_and_unstrict_search_give_same_hits_with_fixed_threshold)
+{
+    populate(44);
+    make_query(13, 1);
+    std::map<uint32_t, score_t> expected;
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        if (exact_score(docid) > 20000) {
+            expected[docid] = exact_score(docid);
+        }
+    }
+    ASSERT_LT(10u, expected.size());
+    DummyHeap heap;
+    EXPECT_EQ(expected, search(heap, 20000, true));
+    EXPECT_EQ(expected, search(heap, 20000, false));
+}
+
+class Verifier : public search::test::DwwIteratorChildrenVerifier {
+private:
+    SearchIterator::UP create(bool strict) const override {
+        MatchParams match_params(_dummy_heap, _dummy_heap.getMinScore(), 1.0, 1);
+        std::vector<LookupResult> dict_entries;
+        for (size_t i = 0; i < _num_children; ++i) {
+            dict_entries.push_back(_helper.dww().lookup(vespalib::make_string("%zu", i).c_str(), _helper.dww().get_dictionary_snapshot()));
+        }
+        return MaxScoreSearch::create(_tfmd, match_params, _weights, dict_entries, _helper.dww(), strict, false);
+    }
+    mutable DummyHeap _dummy_heap;
+};
+
+TEST(MaxScoreConformanceTest, verify_search_iterator_conformance)
+{
+    Verifier verifier;
+    verifier.verify();
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -335,6 +335,16 @@ searchAndCompare(SearchIterator::UP s, uint32_t docIdLimit)
         for (size_t i(0); i < a.size(); i++) {
             EXPECT_EQ(a[i], b[i]);
         }
+        for (uint32_t beginId : {1u, 100u, 1027u}) {
+            s->initRange(beginId, docIdLimit);
+            BitVector::UP hits = s->get_hits(beginId);
+            H c;
+            hits->foreach_truebit([&c](uint32_t key) { c.push_back(key); });
+            H expected;
+            std::copy_if(a.begin(), a.end(), std::back_inserter(expected), [beginId](uint32_t docId) { return docId >= beginId; });
+            EXPECT_EQ(expected, c);
+            EXPECT_EQ(expected.size(), hits->countTrueBits());
+        }
     }
 }
 
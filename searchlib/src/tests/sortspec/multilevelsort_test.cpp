@@ -449,4 +449,52 @@ TEST("test that [docid] uses attribute when one exists") {
     EXPECT_EQUAL(0, memcmp(SECOND_DESC, sr2.first, 8));
 }
 
+TEST("require that partial sort on several keys gives the same top hits as full sort") {
+    search::uca::UcaConverterFactory ucaFactory;
+    constexpr uint32_t num_docs = 5000;
+    constexpr uint32_t topn = 10;
+    Config cfg(BasicType::INT32, CollectionType::SINGLE);
+    auto first = AttributeFactory::createAttribute("first", cfg);
+    auto second = AttributeFactory::createAttribute("second", cfg);
+    ASSERT_TRUE(first->addDocs(num_docs + 1));
+    ASSERT_TRUE(second->addDocs(num_docs + 1));
+    for (uint32_t lid(1); lid <= num_docs; lid++) {
+        dynamic_cast<IntegerAttribute &>(*first).update(lid, lid % 7);
+        dynamic_cast<IntegerAttribute &>(*second).update(lid, (lid * 7919) % 1000);
+    }
+    first->commit();
+    second->commit();
+    search::AttributeManager mgr;
+    mgr.add(first);
+    mgr.add(second);
+    search::AttributeContext ac(mgr);
+    std::vector<RankedHit> full_hits;
+    for (uint32_t lid(num_docs); lid > 0; --lid) {
+        full_hits.emplace_back(lid, 0.0);
+    }
+    std::vector<RankedHit> partial_hits(full_hits);
+    FastS_SortSpec full("no-metastore", 7, vespalib::Doom::never(), ucaFactory);
+    FastS_SortSpec partial("no-metastore", 7, vespalib::Doom::never(), ucaFactory);
+    EXPECT_TRUE(full.Init("+first -second +[docid]", ac));
+    EXPECT_TRUE(partial.Init("+first -second +[docid]", ac));
+    full.sortResults(full_hits.data(), num_docs, num_docs);
+    partial.sortResults(partial_hits.data(), num_docs, topn);
+    for (uint32_t i(0); i < topn; ++i) {
+        EXPECT_EQUAL(full_hits[i].getDocId(), partial_hits[i].getDocId());
+        auto full_ref = full.getSortRef(i);
+        auto partial_ref = partial.getSortRef(i);
+        EXPECT_EQUAL(full_ref.second, partial_ref.second);
+        EXPECT_EQUAL(0, memcmp(full_ref.first, partial_ref.first, full_ref.second));
+    }
+    std::vector<uint32_t> full_docids;
+    std::vector<uint32_t> partial_docids;
+    for (uint32_t i(0); i < num_docs; ++i) {
+        full_docids.push_back(full_hits[i].getDocId());
+        partial_docids.push_back(partial_hits[i].getDocId());
+    }
+    std::sort(full_docids.begin(), full_docids.end());
+    std::sort(partial_docids.begin(), partial_docids.end());
+    EXPECT_TRUE(full_docids == partial_docids);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
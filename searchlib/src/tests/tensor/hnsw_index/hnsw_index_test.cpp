@@ -20,8 +20,10 @@
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/fake_doom.h>
 #include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/stllike/asciistream.h>
+#include <filesystem>
 #include <type_traits>
 #include <vector>
 
@@ -211,11 +213,15 @@ public:
     }
 
     void init(bool heuristic_select_neighbors) {
+        init(heuristic_select_neighbors, {});
+    }
+    void init(bool heuristic_select_neighbors, std::shared_ptr<vespalib::alloc::MemoryAllocator> links_memory_allocator) {
         auto generator = std::make_unique<LevelGenerator>();
         level_generator = generator.get();
         index = std::make_unique<IndexType>(vectors, dff(),
                                             std::move(generator),
-                                            HnswIndexConfig(5, 2, 10, 0, heuristic_select_neighbors));
+                                            HnswIndexConfig(5, 2, 10, 0, heuristic_select_neighbors),
+                                            std::move(links_memory_allocator));
     }
     void add_document(uint32_t docid, uint32_t max_level = 0) {
         level_generator->level = max_level;
@@ -928,6 +934,52 @@ TYPED_TEST(HnswIndexTest, hnsw_graph_can_be_saved_and_loaded)
     this->check_savetest_index("after load");
 }
 
+TYPED_TEST(HnswIndexTest, batch_search_gives_same_result_as_separate_searches)
+{
+    this->init(true);
+    for (uint32_t docid = 1; docid < 10; ++docid) {
+        this->add_document(docid, (docid % 3 == 0) ? 1 : ((docid == 7) ? 2 : 0));
+    }
+    std::vector<std::vector<float>> queries = {{0, 0}, {2, 2}, {8, 3}, {4, 5}, {3, 3}, {2, 2}};
+    std::vector<std::unique_ptr<BoundDistanceFunction>> owned_dfs;
+    std::vector<const BoundDistanceFunction*> dfs;
+    for (auto& qv : queries) {
+        vespalib::eval::TypedCells qv_cells(vespalib::ConstArrayRef<float>(qv.data(), qv.size()));
+        owned_dfs.emplace_back(this->index->distance_function_factory().for_query_vector(qv_cells));
+        dfs.push_back(owned_dfs.back().get());
+    }
+    auto doom = this->_doom->get_doom();
+    auto batch = this->index->find_top_k_batch(3, dfs, nullptr, 10, doom, 10000.0);
+    ASSERT_EQ(queries.size(), batch.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        SCOPED_TRACE(i);
+        EXPECT_EQ(this->index->find_top_k(3, *dfs[i], 10, doom, 10000.0), batch[i]);
+        EXPECT_EQ(3, batch[i].size());
+    }
+    this->set_filter({2, 3, 4, 6});
+    batch = this->index->find_top_k_batch(3, dfs, this->global_filter.get(), 10, doom, 10000.0);
+    ASSERT_EQ(queries.size(), batch.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        SCOPED_TRACE(i);
+        EXPECT_EQ(this->index->find_top_k_with_filter(3, *dfs[i], *this->global_filter, 10, doom, 10000.0), batch[i]);
+    }
+}
+
+TYPED_TEST(HnswIndexTest, hnsw_graph_links_can_be_stored_in_memory_mapped_file)
+{
+    vespalib::string dir_name("mmap-file-allocator-dir");
+    auto allocator = std::make_shared<vespalib::alloc::MmapFileAllocator>(dir_name);
+    this->init(false, allocator);
+    this->make_savetest_index();
+    this->check_savetest_index("paged links");
+    EXPECT_LT(0u, allocator->get_end_offset());
+    this->expect_top_3_by_docid("{0, 0}", {0, 0}, {4, 7});
+    this->commit_and_update_stat();
+    this->index.reset();
+    allocator.reset();
+    std::filesystem::remove_all(std::filesystem::path(dir_name));
+}
+
 TYPED_TEST(HnswIndexTest, search_during_remove)
 {
     this->init(false);
@@ -1093,6 +1145,38 @@ TEST(LevelGeneratorTest, gives_various_levels)
     EXPECT_TRUE(hist.size() < 14);
 }
 
+TEST(LevelGeneratorTest, levels_for_document_subspaces_are_independent_of_call_order)
+{
+    InvLogLevelGenerator generator(4);
+    InvLogLevelGenerator same_seed_generator(4);
+    InvLogLevelGenerator other_seed_generator(4, 42);
+    uint32_t num_docs = 100000;
+    std::vector<uint32_t> levels(num_docs);
+    for (uint32_t docid = 0; docid < num_docs; ++docid) {
+        levels[docid] = generator.max_level_for(docid, 0);
+    }
+    uint32_t diffs = 0;
+    std::vector<uint32_t> hist;
+    for (uint32_t docid = num_docs; docid-- > 0;) {
+        EXPECT_EQ(levels[docid], same_seed_generator.max_level_for(docid, 0));
+        if (levels[docid] != other_seed_generator.max_level_for(docid, 0)) {
+            ++diffs;
+        }
+        if (hist.size() <= levels[docid]) {
+            hist.resize(levels[docid] + 1);
+        }
+        hist[levels[docid]]++;
+    }
+    EXPECT_LT(0u, diffs);
+    uint32_t left = num_docs;
+    for (uint32_t i = 0; i < 3; ++i) {
+        double expected = left * 0.75;
+        EXPECT_LT(hist[i], expected * 1.05 + 100);
+        EXPECT_GT(hist[i], expected * 0.95 - 100);
+        left -= hist[i];
+    }
+}
+
 template <typename IndexType>
 class TwoPhaseTest : public HnswIndexTest<IndexType> {
 public:
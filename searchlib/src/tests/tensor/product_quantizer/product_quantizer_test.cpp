@@ -0,0 +1,259 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <vespa/searchlib/tensor/doc_vector_access.h>
+#include <vespa/searchlib/tensor/empty_subspace.h>
+#include <vespa/searchlib/tensor/hnsw_index.h>
+#include <vespa/searchlib/tensor/inv_log_level_generator.h>
+#include <vespa/searchlib/tensor/product_quantizer.h>
+#include <vespa/searchlib/tensor/quantized_distance.h>
+#include <vespa/searchlib/tensor/quantized_vector_store.h>
+#include <vespa/searchlib/tensor/subspace_type.h>
+#include <vespa/searchlib/tensor/vector_bundle.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/fake_doom.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <algorithm>
+#include <random>
+
+using search::attribute::DistanceMetric;
+using vespalib::GenerationHandler;
+using vespalib::eval::CellType;
+using vespalib::eval::TypedCells;
+using vespalib::eval::ValueType;
+using namespace search::tensor;
+
+namespace {
+
+constexpr uint32_t dim = 8;
+
+std::vector<float>
+make_random_vectors(uint32_t num_vectors, uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(-1.0, 1.0);
+    std::vector<float> result(size_t(num_vectors) * dim);
+    for (auto& cell : result) {
+        cell = dist(gen);
+    }
+    return result;
+}
+
+double
+squared_l2(const float* a, const float* b, uint32_t size)
+{
+    double sum = 0.0;
+    for (uint32_t i = 0; i < size; ++i) {
+        double diff = a[i] - b[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+double
+dot(const float* a, const float* b, uint32_t size)
+{
+    double sum = 0.0;
+    for (uint32_t i = 0; i < size; ++i) {
+        sum += double(a[i]) * b[i];
+    }
+    return sum;
+}
+
+class MyDocVectorAccess : public DocVectorAccess {
+    std::vector<float> _vectors;
+    SubspaceType       _subspace_type;
+    EmptySubspace      _empty;
+public:
+    MyDocVectorAccess(std::vector<float> vectors)
+        : _vectors(std::move(vectors)),
+          _subspace_type(ValueType::make_type(CellType::FLOAT, {{"x", dim}})),
+          _empty(_subspace_type)
+    {
+    }
+    uint32_t size() const noexcept { return _vectors.size() / dim; }
+    const float* data(uint32_t docid) const noexcept { return _vectors.data() + size_t(docid) * dim; }
+    TypedCells get_vector(uint32_t docid, uint32_t subspace) const noexcept override {
+        auto bundle = get_vectors(docid);
+        return (subspace < bundle.subspaces()) ? bundle.cells(subspace) : _empty.cells();
+    }
+    VectorBundle get_vectors(uint32_t docid) const noexcept override {
+        return {data(docid), 1, _subspace_type};
+    }
+};
+
+}
+
+TEST(ProductQuantizerTest, vectors_with_few_distinct_subvectors_are_encoded_exactly)
+{
+    // Only 4 distinct values per subvector, all of them become centroids.
+    std::vector<float> samples;
+    for (uint32_t i = 0; i < 64; ++i) {
+        for (uint32_t j = 0; j < dim; ++j) {
+            samples.push_back(float((i + j) % 4));
+        }
+    }
+    ProductQuantizer pq(dim, 4);
+    pq.train(samples.data(), 64, 5);
+    EXPECT_EQ(dim, pq.dim());
+    EXPECT_EQ(4u, pq.code_size());
+    EXPECT_EQ(64u, pq.num_centroids());
+    std::vector<float> table(pq.table_size());
+    std::vector<uint8_t> code(pq.code_size());
+    const float* query = samples.data() + 5 * dim;
+    pq.make_distance_table(query, false, table.data());
+    for (uint32_t i = 0; i < 64; ++i) {
+        const float* vector = samples.data() + i * dim;
+        pq.encode(vector, code.data());
+        EXPECT_FLOAT_EQ(squared_l2(query, vector, dim), ProductQuantizer::calc_distance(table.data(), code.data(), code.size()));
+    }
+}
+
+TEST(ProductQuantizerTest, number_of_subvectors_is_clamped_to_dimension)
+{
+    ProductQuantizer pq(dim, 100);
+    EXPECT_EQ(dim, pq.code_size());
+    ProductQuantizer pq0(dim, 0);
+    EXPECT_EQ(1u, pq0.code_size());
+}
+
+TEST(ProductQuantizerTest, adc_distance_approximates_full_precision_distance)
+{
+    auto samples = make_random_vectors(2000, 42);
+    ProductQuantizer pq(dim, 4);
+    pq.train(samples.data(), 2000, 10);
+    EXPECT_EQ(256u, pq.num_centroids());
+    auto queries = make_random_vectors(10, 7);
+    std::vector<float> table(pq.table_size());
+    std::vector<uint8_t> code(pq.code_size());
+    double l2_error = 0.0;
+    double dot_error = 0.0;
+    for (uint32_t q = 0; q < 10; ++q) {
+        const float* query = queries.data() + q * dim;
+        for (uint32_t i = 0; i < 100; ++i) {
+            const float* vector = samples.data() + i * dim;
+            pq.encode(vector, code.data());
+            pq.make_distance_table(query, false, table.data());
+            l2_error += std::abs(squared_l2(query, vector, dim) - ProductQuantizer::calc_distance(table.data(), code.data(), code.size()));
+            pq.make_distance_table(query, true, table.data());
+            dot_error += std::abs(-dot(query, vector, dim) - ProductQuantizer::calc_distance(table.data(), code.data(), code.size()));
+        }
+    }
+    // Average squared distance between random vectors is 8 * 2/3.
+    EXPECT_LT(l2_error / 1000, 0.5);
+    EXPECT_LT(dot_error / 1000, 0.25);
+}
+
+TEST(ProductQuantizerTest, bound_quantized_distance_uses_full_precision_distance_units)
+{
+    auto samples = make_random_vectors(500, 3);
+    QuantizedVectorStore store(4, 500);
+    EXPECT_FALSE(store.trained());
+    auto exact_ff = make_distance_function_factory(DistanceMetric::Euclidean, CellType::FLOAT);
+    QuantizedDistanceFunctionFactory ff(*exact_ff, store, DistanceMetric::Euclidean);
+    TypedCells query(samples.data(), CellType::FLOAT, dim);
+    EXPECT_EQ(nullptr, ff.for_query_vector(query)->as_quantized());
+    store.train(samples, dim);
+    for (uint32_t i = 0; i < 500; ++i) {
+        store.set_code(i, TypedCells(samples.data() + i * dim, CellType::FLOAT, dim));
+    }
+    store.publish();
+    EXPECT_TRUE(store.trained());
+    auto df = ff.for_query_vector(query);
+    auto quantized = df->as_quantized();
+    ASSERT_NE(nullptr, quantized);
+    EXPECT_EQ(nullptr, ff.for_insertion_vector(query)->as_quantized());
+    double error = 0.0;
+    for (uint32_t i = 0; i < 500; ++i) {
+        TypedCells rhs(samples.data() + i * dim, CellType::FLOAT, dim);
+        error += std::abs(df->calc(rhs) - quantized->calc_code(store.acquire_code(i)));
+    }
+    EXPECT_LT(error / 500, 0.5);
+}
+
+class QuantizedHnswIndexTest : public ::testing::Test {
+protected:
+    static constexpr uint32_t num_docs = 2000;
+    MyDocVectorAccess                               vectors;
+    GenerationHandler                               gen_handler;
+    std::unique_ptr<HnswIndex<HnswIndexType::SINGLE>> index;
+    vespalib::FakeDoom                              doom;
+
+    QuantizedHnswIndexTest()
+        : vectors(make_random_vectors(num_docs, 1)),
+          gen_handler(),
+          index(),
+          doom()
+    {
+    }
+    ~QuantizedHnswIndexTest() override;
+
+    void make_index(bool rerank) {
+        HnswIndexConfig cfg(32, 16, 100, 0, true);
+        cfg.set_product_quantization(DistanceMetric::Euclidean, 4, rerank).set_quantization_training_size(500);
+        index = std::make_unique<HnswIndex<HnswIndexType::SINGLE>>(vectors,
+                make_distance_function_factory(DistanceMetric::Euclidean, CellType::FLOAT),
+                std::make_unique<InvLogLevelGenerator>(16), cfg);
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            index->add_document(docid);
+            index->assign_generation(gen_handler.getCurrentGeneration());
+            gen_handler.incGeneration();
+            index->reclaim_memory(gen_handler.get_oldest_used_generation());
+        }
+        index->wait_for_quantizer_training();
+    }
+    std::vector<uint32_t> exact_top_k(const float* query, uint32_t k) {
+        std::vector<std::pair<double, uint32_t>> all;
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            all.emplace_back(squared_l2(query, vectors.data(docid), dim), docid);
+        }
+        std::partial_sort(all.begin(), all.begin() + k, all.end());
+        std::vector<uint32_t> result;
+        for (uint32_t i = 0; i < k; ++i) {
+            result.push_back(all[i].second);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+    double recall(uint32_t k, uint32_t explore_k) {
+        auto queries = make_random_vectors(20, 11);
+        uint32_t found = 0;
+        for (uint32_t q = 0; q < 20; ++q) {
+            const float* query = queries.data() + q * dim;
+            auto df = index->distance_function_factory().for_query_vector(TypedCells(query, CellType::FLOAT, dim));
+            EXPECT_NE(nullptr, df->as_quantized());
+            auto hits = index->find_top_k(k, *df, explore_k, doom.get_doom(), 10000.0);
+            auto exact = exact_top_k(query, k);
+            for (const auto& hit : hits) {
+                if (std::binary_search(exact.begin(), exact.end(), hit.docid)) {
+                    ++found;
+                }
+                EXPECT_DOUBLE_EQ(df->calc(vectors.get_vector(hit.docid, 0)), hit.distance);
+            }
+        }
+        return double(found) / (20 * k);
+    }
+};
+
+QuantizedHnswIndexTest::~QuantizedHnswIndexTest() = default;
+
+TEST_F(QuantizedHnswIndexTest, search_with_quantized_vectors_and_rerank_has_high_recall)
+{
+    make_index(true);
+    auto state = index->memory_usage();
+    EXPECT_GT(state.allocatedBytes(), 0u);
+    EXPECT_GT(recall(10, 100), 0.9);
+}
+
+TEST_F(QuantizedHnswIndexTest, search_with_quantized_vectors_without_rerank_returns_candidates)
+{
+    make_index(false);
+    auto queries = make_random_vectors(1, 11);
+    auto df = index->distance_function_factory().for_query_vector(TypedCells(queries.data(), CellType::FLOAT, dim));
+    ASSERT_NE(nullptr, df->as_quantized());
+    auto hits = index->find_top_k(10, *df, 100, doom.get_doom(), 10000.0);
+    EXPECT_EQ(10u, hits.size());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -908,6 +908,26 @@ TEST("testSync") {
     EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
 }
 
+TEST("test group commit covers many chunks with each sync") {
+    const unsigned int NUM_PACKETS = 200;
+    const unsigned int NUM_ENTRIES = 4;
+    const vespalib::string name("groupcommit");
+
+    DummyFileHeaderContext fileHeaderContext;
+    test::DirectoryHandler testDir("test_group_commit");
+    TLS tlss(testDir.getDir(), 18377, ".", fileHeaderContext,
+             createDomainConfig(0x1000000).setFSyncOnCommit(true).setGroupCommitLatency(1s));
+    TransLogClient tls(tlss.transport, "tcp/localhost:18377");
+    createDomainTest(tls, name, 0);
+
+    fillDomainTest(tlss.tls, name, NUM_PACKETS, NUM_ENTRIES);
+    DomainInfo info = tlss.tls.getDomainStats()[name];
+    EXPECT_EQUAL(NUM_PACKETS * NUM_ENTRIES, info.numEntries);
+    EXPECT_EQUAL(0u, info.pendingCommits);
+    EXPECT_LESS_EQUAL(1u, info.numSyncs);
+    EXPECT_LESS_EQUAL(info.numSyncs, info.numCommittedChunks);
+}
+
 TEST("test truncate on version mismatch") {
     const unsigned int NUM_PACKETS = 3;
     const unsigned int NUM_ENTRIES = 4;
@@ -23,8 +23,10 @@ Config::Config(BasicType bt, CollectionType ct, bool fastSearch_) noexcept
       _fastAccess(false),
       _mutable(false),
       _paged(false),
+      _mmap_load(false),
       _distance_metric(DistanceMetric::Euclidean),
       _match(Match::UNCASED),
+      _filter_cache_min_lookups(0),
       _dictionary(),
       _maxUnCommittedMemory(MAX_UNCOMMITTED_MEMORY),
       _growStrategy(),
@@ -51,8 +53,10 @@ Config::operator==(const Config &b) const noexcept
            _fastAccess == b._fastAccess &&
            _mutable == b._mutable &&
            _paged == b._paged &&
+           _mmap_load == b._mmap_load &&
            _maxUnCommittedMemory == b._maxUnCommittedMemory &&
            _match == b._match &&
+           _filter_cache_min_lookups == b._filter_cache_min_lookups &&
            _dictionary == b._dictionary &&
            _growStrategy == b._growStrategy &&
            _compactionStrategy == b._compactionStrategy &&
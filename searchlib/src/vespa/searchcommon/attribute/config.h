@@ -37,6 +37,8 @@ public:
     CollectionType collectionType()       const noexcept { return _type; }
     bool fastSearch()                     const noexcept { return _fastSearch; }
     bool paged()                          const noexcept { return _paged; }
+    bool mmap_load()                      const noexcept { return _mmap_load; }
+    uint32_t filter_cache_min_lookups()   const noexcept { return _filter_cache_min_lookups; }
     const PredicateParams &predicateParams() const noexcept { return _predicateParams; }
     const vespalib::eval::ValueType & tensorType() const noexcept { return _tensorType; }
     DistanceMetric distance_metric() const noexcept { return _distance_metric; }
@@ -84,6 +86,16 @@ public:
     Config & setIsFilter(bool isFilter) { _isFilter = isFilter; return *this; }
     Config & setMutable(bool isMutable) { _mutable = isMutable; return *this; }
     Config & setPaged(bool paged_in) { _paged = paged_in; return *this; }
+    /**
+     * Let fixed width single value attributes map their data file as backing store when loaded,
+     * instead of reading it into memory. Pages are copied when updated.
+     */
+    Config & set_mmap_load(bool v) { _mmap_load = v; return *this; }
+    /**
+     * Cache bit vectors for filter terms that are looked up at least this many times.
+     * 0 disables the filter bit vector cache.
+     */
+    Config & set_filter_cache_min_lookups(uint32_t v) { _filter_cache_min_lookups = v; return *this; }
     Config & setFastAccess(bool v) { _fastAccess = v; return *this; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config & setCompactionStrategy(const CompactionStrategy &compactionStrategy) {
@@ -106,8 +118,10 @@ private:
     bool           _fastAccess : 1;
     bool           _mutable : 1;
     bool           _paged : 1;
+    bool           _mmap_load : 1;
     DistanceMetric                 _distance_metric;
     Match                          _match;
+    uint32_t                       _filter_cache_min_lookups;
     DictionaryConfig               _dictionary;
     uint64_t                       _maxUnCommittedMemory;
     GrowStrategy                   _growStrategy;
@@ -17,28 +17,50 @@ private:
     // This is always the same as in the attribute config, and is duplicated here to simplify usage.
     DistanceMetric _distance_metric;
     bool _multi_threaded_indexing;
+    // 0 means no product quantization.
+    uint32_t _quantization_subvectors;
+    bool _quantization_rerank;
+    // Whether the graph link arrays use the memory allocator of the (paged) attribute.
+    bool _paged_links;
+    uint32_t _quantization_training_size;
 
 public:
     HnswIndexParams(uint32_t max_links_per_node_in,
                     uint32_t neighbors_to_explore_at_insert_in,
                     DistanceMetric distance_metric_in,
-                    bool multi_threaded_indexing_in = false) noexcept
+                    bool multi_threaded_indexing_in = false,
+                    uint32_t quantization_subvectors_in = 0,
+                    bool quantization_rerank_in = true,
+                    bool paged_links_in = false,
+                    uint32_t quantization_training_size_in = 10000) noexcept
             : _max_links_per_node(max_links_per_node_in),
               _neighbors_to_explore_at_insert(neighbors_to_explore_at_insert_in),
               _distance_metric(distance_metric_in),
-              _multi_threaded_indexing(multi_threaded_indexing_in)
+              _multi_threaded_indexing(multi_threaded_indexing_in),
+              _quantization_subvectors(quantization_subvectors_in),
+              _quantization_rerank(quantization_rerank_in),
+              _paged_links(paged_links_in),
+              _quantization_training_size(quantization_training_size_in)
     {}
 
     uint32_t max_links_per_node() const { return _max_links_per_node; }
     uint32_t neighbors_to_explore_at_insert() const { return _neighbors_to_explore_at_insert; }
     DistanceMetric distance_metric() const { return _distance_metric; }
     bool multi_threaded_indexing() const { return _multi_threaded_indexing; }
+    uint32_t quantization_subvectors() const { return _quantization_subvectors; }
+    bool quantization_rerank() const { return _quantization_rerank; }
+    bool paged_links() const { return _paged_links; }
+    uint32_t quantization_training_size() const { return _quantization_training_size; }
 
     bool operator==(const HnswIndexParams& rhs) const {
         return (_max_links_per_node == rhs._max_links_per_node &&
                 _neighbors_to_explore_at_insert == rhs._neighbors_to_explore_at_insert &&
                 _distance_metric == rhs._distance_metric &&
-                _multi_threaded_indexing == rhs._multi_threaded_indexing);
+                _multi_threaded_indexing == rhs._multi_threaded_indexing &&
+                _quantization_subvectors == rhs._quantization_subvectors &&
+                _quantization_rerank == rhs._quantization_rerank &&
+                _paged_links == rhs._paged_links &&
+                _quantization_training_size == rhs._quantization_training_size);
     }
 };
 
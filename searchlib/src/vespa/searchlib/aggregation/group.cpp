@@ -3,8 +3,10 @@
 #include "group.h"
 #include "grouping.h"
 #include <vespa/searchlib/expression/aggregationrefnode.h>
+#include <vespa/searchlib/expression/enumresultnode.h>
 
 #include <vespa/vespalib/objects/visit.hpp>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/stllike/hash_set.hpp>
 #include <cassert>
 
@@ -89,26 +91,65 @@ Group::groupNext(const GroupingLevel & level, const Doc & doc, HitRank rank)
     level.group(*this, selectResult, doc, rank);
 }
 
+/**
+ * Maps the ids of the children to their index during aggregation.
+ * Groups on enumerated attributes have enum handles as ids, and are
+ * looked up directly on the handle. This avoids virtual hashing and
+ * comparison of result nodes when probing the map for every hit. The
+ * enum handles are converted to strings after aggregation, only for
+ * the groups kept.
+ */
+class Group::Value::ChildMap {
+public:
+    ChildMap(size_t size, const GroupList * children)
+        : _groups(size, GroupHasher(children), GroupEqual(children)),
+          _enums(size)
+    { }
+    static bool isEnum(const ResultNode & id) {
+        return id.getClass().id() == expression::EnumResultNode::classId;
+    }
+    size_t size() const { return _groups.size() + _enums.size(); }
+    void insert(const ResultNode & id, uint32_t index) {
+        if (isEnum(id)) {
+            _enums[id.getEnum()] = index;
+        } else {
+            _groups.insert(index);
+        }
+    }
+    const uint32_t * find(const ResultNode & id) {
+        if (isEnum(id)) {
+            auto found = _enums.find(id.getEnum());
+            return (found != _enums.end()) ? &found->second : nullptr;
+        }
+        auto found = _groups.find(id);
+        return (found != _groups.end()) ? &*found : nullptr;
+    }
+private:
+    using EnumHash = vespalib::hash_map<int64_t, uint32_t>;
+    GroupHash _groups;
+    EnumHash  _enums;
+};
+
 Group *
 Group::Value::groupSingle(const ResultNode & selectResult, HitRank rank, const GroupingLevel & level)
 {
     if (_childInfo._childMap == nullptr) {
         assert(getChildrenSize() == 0);
-        _childInfo._childMap = new GroupHash(1, GroupHasher(&_children), GroupEqual(&_children));
+        _childInfo._childMap = new ChildMap(1, &_children);
     }
-    GroupHash & childMap = *_childInfo._childMap;
+    ChildMap & childMap = *_childInfo._childMap;
     Group * group(nullptr);
-    auto found = childMap.find(selectResult);
-    if (found == childMap.end()) { // group not present in child map
+    const uint32_t * found = childMap.find(selectResult);
+    if (found == nullptr) { // group not present in child map
         if (level.allowMoreGroups(childMap.size())) {
             group = new Group(level.getGroupPrototype());
             group->setId(selectResult);
             group->setRank(rank);
             addChild(group);
-            childMap.insert(getChildrenSize() - 1);
+            childMap.insert(selectResult, getChildrenSize() - 1);
         }
     } else {
-        group = _children[(*found)];
+        group = _children[*found];
         if ( ! level.isFrozen()) {
             group->updateRank(rank);
         }
@@ -327,11 +368,11 @@ void
 Group::Value::preAggregate()
 {
     assert(_childInfo._childMap == nullptr);
-    _childInfo._childMap = new GroupHash(getChildrenSize()*2, GroupHasher(&_children), GroupEqual(&_children));
-    GroupHash & childMap = *_childInfo._childMap;
+    _childInfo._childMap = new ChildMap(getChildrenSize()*2, &_children);
+    ChildMap & childMap = *_childInfo._childMap;
     for (ChildP *it(_children), *mt(_children + getChildrenSize()); it != mt; ++it) {
         (*it)->preAggregate();
-        childMap.insert(it - _children);
+        childMap.insert((*it)->getId(), it - _children);
     }
 }
 
@@ -116,6 +116,7 @@ public:
 
         using  ExpressionVector = ExpressionNode::CP *;
         using GroupHash = vespalib::hash_set<uint32_t, GroupHasher, GroupEqual >;
+        class ChildMap;
         void setAggrSize(uint32_t v);
         void setExprSize(uint32_t v);
         void setOrderBySize(uint32_t v);
@@ -143,7 +144,7 @@ public:
 
         ChildP          *_children;             // the sub-groups of this group. Great care must be taken to ensure proper destruct.
         union ChildInfo {
-            GroupHash *_childMap;               // child map used during aggregation
+            ChildMap  *_childMap;               // child map used during aggregation
             size_t     _allChildren;            // Keep real number of children.
         }                _childInfo;
         uint32_t         _childrenLength;
@@ -33,6 +33,7 @@
 #include <vespa/searchlib/queryeval/nearest_neighbor_blueprint.h>
 #include <vespa/searchlib/queryeval/orlikesearch.h>
 #include <vespa/searchlib/queryeval/predicate_blueprint.h>
+#include <vespa/searchlib/queryeval/wand/max_score_search.h>
 #include <vespa/searchlib/queryeval/wand/parallel_weak_and_blueprint.h>
 #include <vespa/searchlib/queryeval/wand/parallel_weak_and_search.h>
 #include <vespa/searchlib/queryeval/weighted_set_term_blueprint.h>
@@ -512,10 +513,14 @@ public:
             return std::make_unique<queryeval::EmptySearch>();
         }
         bool readonly_scores_heap = (_matching_phase != MatchingPhase::FIRST_PHASE);
-        return queryeval::ParallelWeakAndSearch::create(*tfmda[0],
-                queryeval::ParallelWeakAndSearch::MatchParams(*_scores, _scoreThreshold, _thresholdBoostFactor,
-                                                              _scoresAdjustFrequency, get_docid_limit()),
-                                                        _weights, _terms, _attr, strict(), readonly_scores_heap);
+        queryeval::ParallelWeakAndSearch::MatchParams match_params(*_scores, _scoreThreshold, _thresholdBoostFactor,
+                                                                   _scoresAdjustFrequency, get_docid_limit());
+        if (_terms.size() >= queryeval::MaxScoreSearch::min_num_terms) {
+            return queryeval::MaxScoreSearch::create(*tfmda[0], match_params, _weights, _terms, _attr,
+                                                     strict(), readonly_scores_heap);
+        }
+        return queryeval::ParallelWeakAndSearch::create(*tfmda[0], match_params, _weights, _terms, _attr,
+                                                        strict(), readonly_scores_heap);
     }
     std::unique_ptr<SearchIterator> createFilterSearch(FilterConstraint constraint) const override;
     bool always_needs_unpack() const override { return true; }
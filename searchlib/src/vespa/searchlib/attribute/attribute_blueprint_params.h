@@ -17,17 +17,20 @@ struct AttributeBlueprintParams
     double target_hits_max_adjustment_factor;
     vespalib::FuzzyMatchingAlgorithm fuzzy_matching_algorithm;
     double weakand_range;
+    bool weakand_block_max;
 
     AttributeBlueprintParams(double global_filter_lower_limit_in,
                              double global_filter_upper_limit_in,
                              double target_hits_max_adjustment_factor_in,
                              vespalib::FuzzyMatchingAlgorithm fuzzy_matching_algorithm_in,
-                             double weakand_range_in)
+                             double weakand_range_in,
+                             bool weakand_block_max_in)
         : global_filter_lower_limit(global_filter_lower_limit_in),
           global_filter_upper_limit(global_filter_upper_limit_in),
           target_hits_max_adjustment_factor(target_hits_max_adjustment_factor_in),
           fuzzy_matching_algorithm(fuzzy_matching_algorithm_in),
-          weakand_range(weakand_range_in)
+          weakand_range(weakand_range_in),
+          weakand_block_max(weakand_block_max_in)
     {
     }
 
@@ -36,7 +39,8 @@ struct AttributeBlueprintParams
                                    fef::indexproperties::matching::GlobalFilterUpperLimit::DEFAULT_VALUE,
                                    fef::indexproperties::matching::TargetHitsMaxAdjustmentFactor::DEFAULT_VALUE,
                                    fef::indexproperties::matching::FuzzyAlgorithm::DEFAULT_VALUE,
-                                   fef::indexproperties::temporary::WeakAndRange::DEFAULT_VALUE)
+                                   fef::indexproperties::temporary::WeakAndRange::DEFAULT_VALUE,
+                                   fef::indexproperties::temporary::WeakAndBlockMax::DEFAULT_VALUE)
     {
     }
 };
@@ -5,6 +5,8 @@
 #include "attribute_read_guard.h"
 #include "attributefilesavetarget.h"
 #include "attributesaver.h"
+#include "filter_bitvector_cache.h"
+#include "filter_bitvector_search_context.h"
 #include "floatbase.h"
 #include "interlock.h"
 #include "ipostinglistattributebase.h"
@@ -19,6 +21,7 @@
 #include <vespa/searchlib/common/tunefileinfo.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/query/query_term_decoder.h>
+#include <vespa/searchlib/tensor/quantized_distance.h>
 #include <vespa/searchlib/util/file_settings.h>
 #include <vespa/vespalib/util/jsonwriter.h>
 #include <vespa/vespalib/util/exceptions.h>
@@ -51,10 +54,22 @@ const vespalib::string dataTypeTag = "datatype";
 const vespalib::string collectionTypeTag = "collectiontype";
 const vespalib::string docIdLimitTag = "docIdLimit";
 
+/*
+ * A quantized hnsw index searches the graph using the in-memory codes, and only reads the
+ * full precision vectors when reranking and inserting, so they are stored as for a paged attribute.
+ */
+bool
+quantized_hnsw_index(const search::attribute::Config& config)
+{
+    const auto& params = config.hnsw_index_params();
+    return params.has_value() && params->quantization_subvectors() > 0 &&
+           search::tensor::QuantizedDistanceFunctionFactory::supports(params->distance_metric());
+}
+
 bool
 allow_paged(const search::attribute::Config& config)
 {
-    if (!config.paged()) {
+    if (!config.paged() && !quantized_hnsw_index(config)) {
         return false;
     }
     using Type = search::attribute::BasicType::Type;
@@ -101,8 +116,10 @@ AttributeVector::AttributeVector(std::string_view baseFileName, const Config &c)
       _loaded(false),
       _isUpdateableInMemoryOnly(attribute::isUpdateableInMemoryOnly(getName(), getConfig())),
       _nextStatUpdateTime(),
-      _memory_allocator(make_memory_allocator(_baseFileName.getAttributeName(), c))
+      _memory_allocator(make_memory_allocator(_baseFileName.getAttributeName(), c)),
+      _filter_cache(std::make_unique<attribute::FilterBitVectorCache>())
 {
+    _filter_cache->set_min_lookups(c.filter_cache_min_lookups());
 }
 
 AttributeVector::~AttributeVector() = default;
@@ -380,6 +397,13 @@ AttributeVector::getSearch(QueryPacketT searchSpec, const SearchContextParams &p
 std::unique_ptr<attribute::ISearchContext>
 AttributeVector::createSearchContext(QueryTermSimpleUP term, const attribute::SearchContextParams &params) const
 {
+    // Cached bit vectors carry no match details, so they are only used for filter terms
+    if (_filter_cache->enabled() && (params.useBitVector() || getIsFilter())) {
+        auto entry = _filter_cache->lookup(*term);
+        if (entry) {
+            return std::make_unique<attribute::FilterBitVectorSearchContext>(getSearch(std::move(term), params), std::move(entry));
+        }
+    }
     return getSearch(std::move(term), params);
 }
 
@@ -682,6 +706,8 @@ AttributeVector::commitIfChangeVectorTooLarge() {
     bool needCommit = getChangeVectorMemoryUsage().usedBytes() > getConfig().getMaxUnCommittedMemory();
     if (needCommit) {
         commit(false);
+        // Keep the cached filter bit vectors in sync with the values now visible to queries.
+        _filter_cache->commit(*this);
     }
     return needCommit;
 }
@@ -716,6 +742,8 @@ AttributeVector::update_config(const Config& cfg)
 {
     commit(true);
     _config->setGrowStrategy(cfg.getGrowStrategy());
+    _config->set_filter_cache_min_lookups(cfg.filter_cache_min_lookups());
+    _filter_cache->set_min_lookups(cfg.filter_cache_min_lookups());
     if (cfg.getCompactionStrategy() == _config->getCompactionStrategy()) {
         return;
     }
@@ -66,6 +66,7 @@ namespace search {
         class Config;
         class ValueModifier;
         class EnumModifier;
+        class FilterBitVectorCache;
     }
 
     namespace fileutil {
@@ -283,6 +284,11 @@ public:
 
     const Config &getConfig() const noexcept { return *_config; }
     void update_config(const Config& cfg);
+    /**
+     * Cache of bit vectors for frequently searched filter terms. Changed documents must be
+     * reported to it, and it must be committed after the attribute is committed.
+     */
+    attribute::FilterBitVectorCache& get_filter_cache() noexcept { return *_filter_cache; }
     const attribute::BaseName & getBaseFileName() const { return _baseFileName; }
     void setBaseFileName(std::string_view name) { _baseFileName = name; }
     bool isUpdateableInMemoryOnly() const { return _isUpdateableInMemoryOnly; }
@@ -430,6 +436,7 @@ private:
     bool                                  _isUpdateableInMemoryOnly;
     vespalib::steady_time                 _nextStatUpdateTime;
     std::shared_ptr<vespalib::alloc::MemoryAllocator> _memory_allocator;
+    std::unique_ptr<attribute::FilterBitVectorCache>  _filter_cache;
 
     /// Clean up [0, firstUsed>
     virtual void reclaim_memory(generation_t oldest_used_gen);
@@ -494,6 +501,10 @@ public:
     static bool isEnumerated(const vespalib::GenericHeader &header);
 
     virtual vespalib::MemoryUsage getChangeVectorMemoryUsage() const;
+    /**
+     * Commits, including the filter bit vector cache, if the change vector uses more memory than
+     * allowed by the config. Called by the writer thread.
+     */
     bool commitIfChangeVectorTooLarge();
 
     void drain_hold(uint64_t hold_limit);
@@ -0,0 +1,316 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "filter_bitvector_cache.h"
+#include "attributevector.h"
+#include "search_context.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_ucs4.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <algorithm>
+#include <limits>
+
+namespace search::attribute {
+
+namespace {
+
+std::unique_ptr<SearchContext>
+make_search_context(const AttributeVector& attr, const vespalib::string& term)
+{
+    return attr.getSearch(std::make_unique<QueryTermUCS4>(term, QueryTermSimple::Type::WORD), SearchContextParams());
+}
+
+/*
+ * Leave room for the docid limit to grow before the bit vector must be materialized again.
+ */
+uint32_t
+calc_bit_vector_size(uint32_t doc_id_limit)
+{
+    return doc_id_limit + doc_id_limit / 8 + 1024;
+}
+
+std::shared_ptr<FilterBitVectorCache::Entry>
+materialize(const AttributeVector& attr, const vespalib::string& term)
+{
+    auto sc = make_search_context(attr, term);
+    if (!sc->valid()) {
+        return {};
+    }
+    uint32_t doc_id_limit = attr.getCommittedDocIdLimit();
+    auto bv = BitVector::create(calc_bit_vector_size(doc_id_limit));
+    sc->fetchPostings(queryeval::ExecuteInfo::FULL, true);
+    fef::TermFieldMatchData tfmd;
+    auto it = sc->createIterator(&tfmd, true);
+    it->initRange(1, doc_id_limit);
+    for (uint32_t docid = it->seekFirst(1); !it->isAtEnd(); docid = it->seekNext(docid + 1)) {
+        bv->setBit(docid);
+    }
+    bv->invalidateCachedCount();
+    bv->countTrueBits();
+    return std::make_shared<FilterBitVectorCache::Entry>(std::move(bv), doc_id_limit);
+}
+
+}
+
+FilterBitVectorCache::Entry::Entry(std::unique_ptr<BitVector> bit_vector, uint32_t doc_id_limit)
+    : _bit_vector(std::move(bit_vector)),
+      _doc_id_limit(doc_id_limit),
+      _hits(0)
+{
+}
+
+FilterBitVectorCache::Entry::~Entry() = default;
+
+FilterBitVectorCache::Shard::Shard()
+    : mutex(),
+      lookup_counts(),
+      entries()
+{
+}
+
+FilterBitVectorCache::Shard::~Shard() = default;
+
+void
+FilterBitVectorCache::Shard::evict_cold_lookup_counts()
+{
+    std::vector<vespalib::string> cold;
+    for (auto& kv : lookup_counts) {
+        kv.second /= 2;
+        if (kv.second == 0) {
+            cold.emplace_back(kv.first);
+        }
+    }
+    for (const auto& term : cold) {
+        lookup_counts.erase(term);
+    }
+}
+
+FilterBitVectorCache::FilterBitVectorCache()
+    : _min_lookups(0),
+      _track_changes(false),
+      _wanted_mutex(),
+      _wanted(),
+      _num_entries(0),
+      _shards(),
+      _changed_lids()
+{
+}
+
+FilterBitVectorCache::~FilterBitVectorCache() = default;
+
+FilterBitVectorCache::Shard&
+FilterBitVectorCache::shard(const vespalib::string& term) noexcept
+{
+    return _shards[vespalib::hashValue(term.data(), term.size()) % NUM_SHARDS];
+}
+
+void
+FilterBitVectorCache::set_min_lookups(uint32_t min_lookups)
+{
+    _min_lookups.store(min_lookups, std::memory_order_relaxed);
+    if (min_lookups == 0) {
+        clear();
+    }
+}
+
+bool
+FilterBitVectorCache::is_cacheable(const QueryTermSimple& term) noexcept
+{
+    // Range terms with a hit limit depend on more than the term itself
+    return term.isWord() && term.isValid() && !term.empty() && (term.getRangeLimit() == 0);
+}
+
+void
+FilterBitVectorCache::add_wanted(const vespalib::string& term)
+{
+    std::lock_guard guard(_wanted_mutex);
+    if (_wanted.size() < MAX_ENTRIES) {
+        _wanted.emplace_back(term);
+    }
+}
+
+std::shared_ptr<const FilterBitVectorCache::Entry>
+FilterBitVectorCache::lookup(const QueryTermSimple& term)
+{
+    uint32_t wanted_lookups = min_lookups();
+    if (wanted_lookups == 0 || !is_cacheable(term)) {
+        return {};
+    }
+    const auto& key = term.getTermString();
+    auto& s = shard(key);
+    {
+        std::lock_guard guard(s.mutex);
+        auto itr = s.entries.find(key);
+        if (itr != s.entries.end()) {
+            itr->second->_hits.fetch_add(1, std::memory_order_relaxed);
+            return itr->second;
+        }
+        while (s.lookup_counts.size() >= MAX_TRACKED_TERMS / NUM_SHARDS) {
+            s.evict_cold_lookup_counts();
+        }
+        uint32_t& count = s.lookup_counts[key];
+        if (++count < wanted_lookups) {
+            return {};
+        }
+        s.lookup_counts.erase(key);
+    }
+    add_wanted(key);
+    return {};
+}
+
+void
+FilterBitVectorCache::evict_least_used()
+{
+    Shard* victim_shard = nullptr;
+    vespalib::string victim;
+    uint64_t victim_hits = std::numeric_limits<uint64_t>::max();
+    for (auto& s : _shards) {
+        std::lock_guard guard(s.mutex);
+        for (auto& kv : s.entries) {
+            uint64_t hits = kv.second->_hits.load(std::memory_order_relaxed);
+            if (hits < victim_hits) {
+                victim_shard = &s;
+                victim = kv.first;
+                victim_hits = hits;
+            }
+            kv.second->_hits.store(hits / 2, std::memory_order_relaxed);
+        }
+    }
+    if (victim_shard != nullptr) {
+        std::lock_guard guard(victim_shard->mutex);
+        auto itr = victim_shard->entries.find(victim);
+        if (itr != victim_shard->entries.end()) {
+            victim_shard->entries.erase(itr);
+            _num_entries.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void
+FilterBitVectorCache::insert(const vespalib::string& term, std::shared_ptr<Entry> entry)
+{
+    auto& s = shard(term);
+    {
+        std::lock_guard guard(s.mutex);
+        auto itr = s.entries.find(term);
+        if (itr != s.entries.end()) {
+            entry->_hits.store(itr->second->_hits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            itr->second = std::move(entry);
+            return;
+        }
+    }
+    if (_num_entries.load(std::memory_order_relaxed) >= MAX_ENTRIES) {
+        evict_least_used();
+    }
+    std::lock_guard guard(s.mutex);
+    s.entries[term] = std::move(entry);
+    _num_entries.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+FilterBitVectorCache::commit(const AttributeVector& attr)
+{
+    if (!enabled()) {
+        return;
+    }
+    std::vector<std::pair<vespalib::string, std::shared_ptr<Entry>>> entries;
+    std::vector<vespalib::string> wanted;
+    for (const auto& s : _shards) {
+        std::lock_guard guard(s.mutex);
+        for (const auto& kv : s.entries) {
+            entries.emplace_back(kv.first, kv.second);
+        }
+    }
+    {
+        std::lock_guard guard(_wanted_mutex);
+        wanted.swap(_wanted);
+    }
+    uint32_t doc_id_limit = attr.getCommittedDocIdLimit();
+    for (auto& [term, entry] : entries) {
+        BitVector& bv = *entry->_bit_vector;
+        if (doc_id_limit > bv.size()) {
+            auto replacement = materialize(attr, term);
+            if (replacement) {
+                insert(term, std::move(replacement));
+            }
+            continue;
+        }
+        if (!_changed_lids.empty()) {
+            auto sc = make_search_context(attr, term);
+            for (uint32_t lid : _changed_lids) {
+                if (lid >= bv.size()) {
+                    continue;
+                }
+                if (lid < doc_id_limit && sc->matches(lid)) {
+                    bv.setBitAndMaintainCount(lid);
+                } else {
+                    bv.clearBitAndMaintainCount(lid);
+                }
+            }
+        }
+        entry->_doc_id_limit.store(doc_id_limit, std::memory_order_release);
+    }
+    _changed_lids.clear();
+    for (const auto& term : wanted) {
+        bool present = std::any_of(entries.begin(), entries.end(), [&term](const auto& kv) { return kv.first == term; });
+        if (!present && enabled()) {
+            auto entry = materialize(attr, term);
+            if (entry) {
+                insert(term, std::move(entry));
+            }
+        }
+    }
+    update_track_changes();
+}
+
+void
+FilterBitVectorCache::update_track_changes()
+{
+    _track_changes.store(_num_entries.load(std::memory_order_relaxed) != 0, std::memory_order_relaxed);
+}
+
+void
+FilterBitVectorCache::clear()
+{
+    {
+        std::lock_guard guard(_wanted_mutex);
+        _wanted.clear();
+    }
+    for (auto& s : _shards) {
+        std::lock_guard guard(s.mutex);
+        s.lookup_counts.clear();
+        s.entries.clear();
+    }
+    _num_entries.store(0, std::memory_order_relaxed);
+    _track_changes.store(false, std::memory_order_relaxed);
+    _changed_lids.clear();
+}
+
+size_t
+FilterBitVectorCache::size() const
+{
+    return _num_entries.load(std::memory_order_relaxed);
+}
+
+vespalib::MemoryUsage
+FilterBitVectorCache::get_memory_usage() const
+{
+    size_t self_size = sizeof(FilterBitVectorCache) - sizeof(_shards);
+    size_t allocated = self_size;
+    size_t used = self_size;
+    for (const auto& s : _shards) {
+        std::lock_guard guard(s.mutex);
+        size_t bit_vectors_size = 0;
+        for (const auto& kv : s.entries) {
+            bit_vectors_size += sizeof(Entry) + kv.second->bit_vector().getFileBytes();
+        }
+        size_t shard_self_size = sizeof(Shard) - sizeof(Entries) - sizeof(LookupCounts);
+        allocated += shard_self_size + s.entries.getMemoryConsumption() + s.lookup_counts.getMemoryConsumption() + bit_vectors_size;
+        used += shard_self_size + s.entries.getMemoryUsed() + s.lookup_counts.getMemoryUsed() + bit_vectors_size;
+    }
+    return vespalib::MemoryUsage(allocated, used, 0, 0);
+}
+
+}
@@ -0,0 +1,112 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace search {
+class AttributeVector;
+class BitVector;
+class QueryTermSimple;
+}
+namespace vespalib { class MemoryUsage; }
+
+namespace search::attribute {
+
+/**
+ * Adaptive cache of bit vectors for filter terms that are searched often on an attribute.
+ *
+ * Query threads count the lookups of each term. A term that has been looked up
+ * min_lookups times is wanted, and its bit vector is materialized by the attribute
+ * writer thread at the next commit. After that, the writer thread keeps the bit vector
+ * up to date by evaluating the term again for the documents changed since the
+ * previous commit. A limited number of bit vectors are kept, the least used one is
+ * evicted when a new term becomes wanted.
+ *
+ * Lookup counts and entries are split into shards selected by term hash, so query
+ * threads looking up different terms rarely contend on the same lock. When a shard
+ * tracks too many terms, all its counts are halved and the terms whose count drops to
+ * zero are forgotten, so hot terms keep (half) their counts while cold terms go away.
+ */
+class FilterBitVectorCache {
+public:
+    class Entry {
+        std::unique_ptr<BitVector> _bit_vector;
+        std::atomic<uint32_t>      _doc_id_limit;
+        mutable std::atomic<uint64_t> _hits;
+        friend class FilterBitVectorCache;
+    public:
+        Entry(std::unique_ptr<BitVector> bit_vector, uint32_t doc_id_limit);
+        ~Entry();
+        const BitVector& bit_vector() const noexcept { return *_bit_vector; }
+        uint32_t doc_id_limit() const noexcept { return _doc_id_limit.load(std::memory_order_acquire); }
+    };
+    static constexpr size_t MAX_ENTRIES = 64;
+    static constexpr size_t MAX_TRACKED_TERMS = 4096;
+    static constexpr size_t NUM_SHARDS = 16;
+
+private:
+    using Entries = vespalib::hash_map<vespalib::string, std::shared_ptr<Entry>>;
+    using LookupCounts = vespalib::hash_map<vespalib::string, uint32_t>;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        LookupCounts       lookup_counts;
+        Entries            entries;
+        Shard();
+        ~Shard();
+        void evict_cold_lookup_counts();
+    };
+
+    std::atomic<uint32_t> _min_lookups; // 0 means disabled
+    std::atomic<bool>     _track_changes;
+    std::mutex            _wanted_mutex;
+    std::vector<vespalib::string> _wanted;
+    std::atomic<size_t>   _num_entries;
+    Shard                 _shards[NUM_SHARDS];
+    std::vector<uint32_t> _changed_lids; // Only accessed by the writer thread
+
+    Shard& shard(const vespalib::string& term) noexcept;
+    void add_wanted(const vespalib::string& term);
+    void evict_least_used();
+    void update_track_changes();
+    void insert(const vespalib::string& term, std::shared_ptr<Entry> entry);
+public:
+    FilterBitVectorCache();
+    ~FilterBitVectorCache();
+    void set_min_lookups(uint32_t min_lookups);
+    uint32_t min_lookups() const noexcept { return _min_lookups.load(std::memory_order_relaxed); }
+    bool enabled() const noexcept { return min_lookups() != 0; }
+    static bool is_cacheable(const QueryTermSimple& term) noexcept;
+
+    /**
+     * Called by query threads. Returns the cached entry for the term if present,
+     * otherwise the lookup is counted and an empty pointer is returned.
+     */
+    std::shared_ptr<const Entry> lookup(const QueryTermSimple& term);
+
+    /**
+     * Called by the writer thread when a document has changed.
+     */
+    void note_changed(uint32_t lid) {
+        if (_track_changes.load(std::memory_order_relaxed)) {
+            _changed_lids.push_back(lid);
+        }
+    }
+
+    /**
+     * Called by the writer thread after the attribute has been committed.
+     * Brings cached bit vectors up to date and materializes wanted terms.
+     */
+    void commit(const AttributeVector& attr);
+    void clear();
+    size_t size() const;
+    vespalib::MemoryUsage get_memory_usage() const;
+};
+
+}
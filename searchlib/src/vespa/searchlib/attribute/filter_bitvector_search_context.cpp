@@ -0,0 +1,38 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "filter_bitvector_search_context.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <algorithm>
+
+namespace search::attribute {
+
+FilterBitVectorSearchContext::FilterBitVectorSearchContext(std::unique_ptr<ISearchContext> context,
+                                                           std::shared_ptr<const FilterBitVectorCache::Entry> entry)
+    : _context(std::move(context)),
+      _entry(std::move(entry)),
+      _doc_id_limit(std::min(_entry->doc_id_limit(), _context->get_committed_docid_limit()))
+{
+}
+
+FilterBitVectorSearchContext::~FilterBitVectorSearchContext() = default;
+
+HitEstimate
+FilterBitVectorSearchContext::calc_hit_estimate() const
+{
+    return HitEstimate(std::min(_entry->bit_vector().countTrueBits(), _doc_id_limit));
+}
+
+std::unique_ptr<queryeval::SearchIterator>
+FilterBitVectorSearchContext::createIterator(fef::TermFieldMatchData* matchData, bool strict)
+{
+    return BitVectorIterator::create(&_entry->bit_vector(), _doc_id_limit, *matchData, strict);
+}
+
+void
+FilterBitVectorSearchContext::fetchPostings(const queryeval::ExecuteInfo &, bool)
+{
+    // Postings are already available in the cached bit vector
+}
+
+}
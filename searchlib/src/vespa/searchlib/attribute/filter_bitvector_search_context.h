@@ -0,0 +1,38 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "filter_bitvector_cache.h"
+#include <vespa/searchcommon/attribute/i_search_context.h>
+
+namespace search::attribute {
+
+/**
+ * Search context for a filter term with a bit vector in the filter bit vector cache
+ * of the attribute. Iterators are created over the cached bit vector, while all
+ * other requests are passed on to the regular search context for the term.
+ */
+class FilterBitVectorSearchContext : public ISearchContext {
+    std::unique_ptr<ISearchContext>                     _context;
+    std::shared_ptr<const FilterBitVectorCache::Entry> _entry;
+    uint32_t                                            _doc_id_limit;
+
+    int32_t onFind(DocId docId, int32_t elemId, int32_t &weight) const override { return _context->find(docId, elemId, weight); }
+    int32_t onFind(DocId docId, int32_t elemId) const override { return _context->find(docId, elemId); }
+public:
+    FilterBitVectorSearchContext(std::unique_ptr<ISearchContext> context,
+                                 std::shared_ptr<const FilterBitVectorCache::Entry> entry);
+    ~FilterBitVectorSearchContext() override;
+
+    HitEstimate calc_hit_estimate() const override;
+    std::unique_ptr<queryeval::SearchIterator> createIterator(fef::TermFieldMatchData* matchData, bool strict) override;
+    void fetchPostings(const queryeval::ExecuteInfo &execInfo, bool strict) override;
+    bool valid() const override { return _context->valid(); }
+    Int64Range getAsIntegerTerm() const override { return _context->getAsIntegerTerm(); }
+    DoubleRange getAsDoubleTerm() const override { return _context->getAsDoubleTerm(); }
+    const QueryTermUCS4 * queryTerm() const override { return _context->queryTerm(); }
+    const vespalib::string& attributeName() const override { return _context->attributeName(); }
+    uint32_t get_committed_docid_limit() const noexcept override { return _context->get_committed_docid_limit(); }
+};
+
+}
@@ -2,19 +2,103 @@
 
 #include "loadedenumvalue.h"
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/cpu_usage.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <algorithm>
+#include <array>
+
+using vespalib::CpuUsage;
 
 namespace search::attribute {
 
+namespace {
+
+constexpr size_t PARALLEL_SORT_MIN_VALUES = 64_Ki;
+constexpr uint32_t NUM_PARTITIONS = 64;
+
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+sort_range(LoadedEnumAttribute *values, size_t num_values)
 {
     ShiftBasedRadixSorter<LoadedEnumAttribute,
         LoadedEnumAttribute::EnumRadix,
         LoadedEnumAttribute::EnumCompare, 56>::
         radix_sort(LoadedEnumAttribute::EnumRadix(),
                    LoadedEnumAttribute::EnumCompare(),
-                   loaded.data(), loaded.size(), 16);
+                   values, num_values, 16);
+}
+
+/*
+ * Move the values in place into NUM_PARTITIONS consecutive partitions, each
+ * covering a disjoint range of enum values. Returns the partition boundaries.
+ */
+std::array<size_t, NUM_PARTITIONS + 1>
+partition_by_enum(LoadedEnumAttributeVector &loaded)
+{
+    uint64_t enum_limit = 1;
+    for (const auto &value : loaded) {
+        enum_limit = std::max(enum_limit, uint64_t(value.getEnum()) + 1);
+    }
+    auto partition = [enum_limit](const LoadedEnumAttribute &value) noexcept {
+        return uint32_t((uint64_t(value.getEnum()) * NUM_PARTITIONS) / enum_limit);
+    };
+    std::array<size_t, NUM_PARTITIONS + 1> bounds{};
+    for (const auto &value : loaded) {
+        ++bounds[partition(value) + 1];
+    }
+    for (uint32_t i = 0; i < NUM_PARTITIONS; ++i) {
+        bounds[i + 1] += bounds[i];
+    }
+    std::array<size_t, NUM_PARTITIONS> next;
+    std::copy(bounds.begin(), bounds.end() - 1, next.begin());
+    for (uint32_t i = 0; i < NUM_PARTITIONS; ++i) {
+        while (next[i] < bounds[i + 1]) {
+            LoadedEnumAttribute value = loaded[next[i]];
+            uint32_t dest = partition(value);
+            while (dest != i) {
+                std::swap(value, loaded[next[dest]++]);
+                dest = partition(value);
+            }
+            loaded[next[i]++] = value;
+        }
+    }
+    return bounds;
 }
 
 }
 
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor)
+{
+    if (executor == nullptr || loaded.size() < PARALLEL_SORT_MIN_VALUES) {
+        sort_range(loaded.data(), loaded.size());
+        return;
+    }
+    auto bounds = partition_by_enum(loaded);
+    uint32_t num_tasks = 0;
+    for (uint32_t i = 0; i < NUM_PARTITIONS; ++i) {
+        if (bounds[i + 1] - bounds[i] > 1) {
+            ++num_tasks;
+        }
+    }
+    vespalib::CountDownLatch latch(num_tasks);
+    for (uint32_t i = 0; i < NUM_PARTITIONS; ++i) {
+        size_t begin = bounds[i];
+        size_t num_values = bounds[i + 1] - begin;
+        if (num_values > 1) {
+            auto task = vespalib::makeLambdaTask([&loaded, begin, num_values, &latch]() {
+                sort_range(loaded.data() + begin, num_values);
+                latch.countDown();
+            });
+            auto rejected = executor->execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
+            if (rejected) {
+                rejected->run();
+            }
+        }
+    }
+    latch.await();
+}
+
+}
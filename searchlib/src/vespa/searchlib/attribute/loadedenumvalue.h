@@ -7,6 +7,8 @@
 #include <cassert>
 #include <limits>
 
+namespace vespalib { class Executor; }
+
 namespace search::attribute {
 
 /**
@@ -137,6 +139,11 @@ public:
     }
 };
 
-void sortLoadedByEnum(LoadedEnumAttributeVector &loaded);
+/**
+ * Sort loaded values by enum, then by docid. When an executor is given and
+ * there are many values, the values are first partitioned into disjoint enum
+ * ranges and the ranges are then sorted in parallel using the executor.
+ */
+void sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor);
 
 }
@@ -20,6 +20,11 @@ namespace search {
         T getNextData() { return _datReader.readHostOrder(); }
         size_t getDataCount() const { return getDataCountHelper(sizeof(T)); }
         FileReader<T> & getReader() { return _datReader; }
+        /**
+         * Map the data as a private, copy on write, allocation with room for capacity elements.
+         * Returns an empty allocation if the data can not be mapped.
+         */
+        vespalib::alloc::Alloc map_data(size_t capacity) const { return _datFile.map_data(capacity * sizeof(T)); }
     private:
         FileReader<T> _datReader;
     };
@@ -11,6 +11,8 @@
 
 namespace search {
 
+template <typename T> class PrimitiveReader;
+
 template <typename B>
 class SingleValueNumericAttribute final : public B {
 private:
@@ -61,6 +63,7 @@ public:
     bool onLoad(vespalib::Executor *executor) override;
 
     bool onLoadEnumerated(ReaderBase &attrReader);
+    bool onLoadMapped(PrimitiveReader<T> &attrReader, size_t numDocs);
 
     std::unique_ptr<attribute::SearchContext>
     getSearch(std::unique_ptr<QueryTermSimple> term, const attribute::SearchContextParams & params) const override;
@@ -127,6 +127,23 @@ SingleValueNumericAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
 }
 
 
+template <typename B>
+bool
+SingleValueNumericAttribute<B>::onLoadMapped(PrimitiveReader<T> &attrReader, size_t numDocs)
+{
+    if (this->getConfig().paged()) {
+        // Paged attributes keep their data in the allocator selected for paging, use normal load.
+        return false;
+    }
+    // Room to grow is reserved as anonymous memory after the mapped file data.
+    auto alloc = attrReader.map_data(this->getConfig().getGrowStrategy().calc_new_size(numDocs));
+    if (alloc.get() == nullptr) {
+        return false;
+    }
+    _data.replaceVector(vespalib::Array<T>(std::move(alloc), numDocs));
+    return true;
+}
+
 template <typename B>
 bool
 SingleValueNumericAttribute<B>::onLoad(vespalib::Executor *)
@@ -146,9 +163,11 @@ SingleValueNumericAttribute<B>::onLoad(vespalib::Executor *)
     const size_t sz(attrReader.getDataCount());
     getGenerationHolder().reclaim_all();
     _data.reset();
-    _data.unsafe_reserve(sz);
-    for (uint32_t i = 0; i < sz; ++i) {
-        _data.push_back(attrReader.getNextData());
+    if ( ! (this->getConfig().mmap_load() && onLoadMapped(attrReader, sz))) {
+        _data.unsafe_reserve(sz);
+        for (uint32_t i = 0; i < sz; ++i) {
+            _data.push_back(attrReader.getNextData());
+        }
     }
 
     B::setNumDocs(sz);
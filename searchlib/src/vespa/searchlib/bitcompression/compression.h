@@ -69,6 +69,7 @@ private:
 #define K_VALUE_ZCPOSTING_L2SKIPSIZE 10
 #define K_VALUE_ZCPOSTING_L3SKIPSIZE 8
 #define K_VALUE_ZCPOSTING_L4SKIPSIZE 6
+#define K_VALUE_ZCPOSTING_BLOCKMAXSIZE 10
 #define K_VALUE_ZCPOSTING_FEATURESSIZE 25
 #define K_VALUE_ZCPOSTING_DELTA_DOCID 22
 #define K_VALUE_ZCPOSTING_FIELD_LENGTH 9
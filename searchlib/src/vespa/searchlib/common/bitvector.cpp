@@ -286,6 +286,68 @@ BitVector::andWith(const BitVector & right)
 }
 
 
+template <bool isAnd>
+void
+BitVector::assignCombined(const std::vector<Source> &sources, Index limit)
+{
+    Index end = std::min(limit, size());
+    if (sources.empty() || (end <= getStartIndex())) {
+        clear();
+        return;
+    }
+    constexpr size_t BlockWords = 128 / sizeof(Word);
+    Word *dest = getActiveStart();
+    size_t words = numActiveWords(getStartIndex(), end);
+    size_t blockWords = words - (words % BlockWords);
+    size_t offset = getStartWordNum() * sizeof(Word);
+    const IAccelerated & accel = IAccelerated::getAccelerator();
+    Index numTrue = isAnd
+        ? accel.andN(offset, blockWords * sizeof(Word), sources, dest)
+        : accel.orN(offset, blockWords * sizeof(Word), sources, dest);
+    for (size_t i(blockWords); i < words; i++) {
+        size_t index = getStartWordNum() + i;
+        Word word = load(static_cast<const Word *>(sources[0].first)[index]);
+        word = sources[0].second ? ~word : word;
+        for (size_t j(1); j < sources.size(); j++) {
+            Word other = load(static_cast<const Word *>(sources[j].first)[index]);
+            other = sources[j].second ? ~other : other;
+            word = isAnd ? (word & other) : (word | other);
+        }
+        store(dest[i], word);
+        numTrue += Optimized::popCount(word);
+    }
+    // Only the first and last word can hold bits outside [start, end>, recount them after repair.
+    auto wordRange = [this](size_t i) {
+        Index first = (getStartWordNum() + i) << numWordBits();
+        return Range(first, first + WordLen);
+    };
+    numTrue -= Optimized::popCount(dest[0]);
+    if (words > 1) {
+        numTrue -= Optimized::popCount(dest[words - 1]);
+    }
+    if (end < size()) {
+        clearIntervalNoInvalidation(Range(end, size()));
+    }
+    repairEnds();
+    numTrue += countInterval(wordRange(0));
+    if (words > 1) {
+        numTrue += countInterval(wordRange(words - 1));
+    }
+    setTrueBits(numTrue);
+}
+
+void
+BitVector::assignAnd(const std::vector<Source> &sources, Index limit)
+{
+    assignCombined<true>(sources, limit);
+}
+
+void
+BitVector::assignOr(const std::vector<Source> &sources, Index limit)
+{
+    assignCombined<false>(sources, limit);
+}
+
 void
 BitVector::andNotWith(const BitVector& right)
 {
@@ -7,6 +7,7 @@
 #include <vespa/vespalib/util/atomic.h>
 #include "vespa/vespalib/util/arrayref.h"
 #include <algorithm>
+#include <vector>
 #if VESPA_ENABLE_BITVECTOR_RANGE_CHECK
 #include <cassert>
 #endif
@@ -180,6 +181,16 @@ public:
     void andNotWith(const BitVector &right);
     void notSelf();
 
+    /**
+     * Assign the AND/OR of multiple, optionally inverted, sources to this bit vector in a
+     * single pass, keeping the count of true bits valid. Each source is given by its word
+     * start (see getStart()) and must be readable up to and including the word holding
+     * bit limit. Bits from limit and out are cleared.
+     */
+    using Source = std::pair<const void *, bool>;
+    void assignAnd(const std::vector<Source> &sources, Index limit);
+    void assignOr(const std::vector<Source> &sources, Index limit);
+
     /**
      * Clear all bits in the bit vector.
      */
@@ -346,6 +357,8 @@ private:
         }
     }
     VESPA_DLL_LOCAL void repairEnds();
+    template <bool isAnd>
+    VESPA_DLL_LOCAL void assignCombined(const std::vector<Source> &sources, Index limit);
     Range sanitize(Range range) const {
         return {std::max(range.start(), getStartIndex()),
                 std::min(range.end(), size())};
@@ -5,6 +5,8 @@
 #include <vespa/searchcommon/attribute/iattributecontext.h>
 #include <vespa/vespalib/util/array.h>
 #include <vespa/vespalib/util/issue.h>
+#include <algorithm>
+#include <span>
 
 using vespalib::Issue;
 
@@ -23,6 +25,9 @@ namespace {
 
 constexpr size_t MMAP_LIMIT = 0x2000000;
 
+// Preselect candidates on the first sort key when at most this fraction of the hits are wanted
+constexpr uint32_t TOP_CANDIDATES_MIN_RATIO = 4;
+
 template<typename T>
 class RadixHelper
 {
@@ -193,12 +198,13 @@ FastS_SortSpec::Add(IAttributeContext & vecMan, const SortInfo & sInfo)
 }
 
 void
-FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
+FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n, size_t numVectors)
 {
     freeSortData();
+    auto vectors = std::span<const VectorRef>(_vectors).first(numVectors);
     size_t fixedWidth = 0;
     size_t variableWidth = 0;
-    for (const auto & vec : _vectors) {
+    for (const auto & vec : vectors) {
         if (vec._type >= ASC_DOCID) { // doc id
             fixedWidth += (vec._vector != nullptr)
                     ? vec._vector->getFixedWidth()
@@ -222,7 +228,7 @@ FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
     size_t offset = 0;
     for (uint32_t i(0), idx(0); (i < n) && !_doom.hard_doom(); ++i) {
         uint32_t len = 0;
-        for (const auto & vec : _vectors) {
+        for (const auto & vec : vectors) {
             int written = initSortData(vec, hits[i], offset);
             offset += written;
             len += written;
@@ -367,7 +373,7 @@ FastS_SortSpec::freeSortData()
 void
 FastS_SortSpec::initWithoutSorting(const RankedHit * hits, uint32_t hitCnt)
 {
-    initSortData(hits, hitCnt);
+    initSortData(hits, hitCnt, _vectors.size());
 }
 
 
@@ -426,15 +432,50 @@ public:
 };
 
 
+bool
+FastS_SortSpec::sameSortData(const SortData & a, const SortData & b) const
+{
+    return (a._len == b._len) && (memcmp(_binarySortData.data() + a._idx, _binarySortData.data() + b._idx, a._len) == 0);
+}
+
+uint32_t
+FastS_SortSpec::selectTopCandidates(RankedHit a[], uint32_t n, uint32_t topn)
+{
+    initSortData(a, n, 1);
+    if (_doom.hard_doom()) {
+        return n;
+    }
+    auto first = _sortDataArray.begin();
+    auto nth = first + (topn - 1);
+    std::nth_element(first, nth, _sortDataArray.end(), StdSortDataCompare(_binarySortData.data()));
+    // Hits tied with the last wanted hit on the first key might still be among the top hits
+    auto candidatesEnd = std::partition(nth + 1, _sortDataArray.end(),
+                                        [this, &pivot = *nth](const SortData & sd) { return sameSortData(sd, pivot); });
+    for (uint32_t i(0); i < n; ++i) {
+        a[i]._rankValue = _sortDataArray[i]._rankValue;
+        a[i]._docId = _sortDataArray[i]._docId;
+    }
+    return candidatesEnd - first;
+}
+
 void
 FastS_SortSpec::sortResults(RankedHit a[], uint32_t n, uint32_t topn)
 {
-    initSortData(a, n);
+    /*
+     * When only a small part of the hits are wanted, the first sort key
+     * is used to select the candidates for the top hits. Sort data for
+     * the remaining keys is then only built for the candidates.
+     */
+    uint32_t candidates = n;
+    if ((_vectors.size() > 1) && (topn > 0) && (topn <= n / TOP_CANDIDATES_MIN_RATIO)) {
+        candidates = selectTopCandidates(a, n, topn);
+    }
+    initSortData(a, candidates, _vectors.size());
     {
         SortData * sortData = _sortDataArray.data();
         const uint8_t * binary = _binarySortData.data();
-        Array<uint32_t> radixScratchPad(n, Alloc::alloc(0, MMAP_LIMIT));
-        search::radix_sort(SortDataRadix(binary), StdSortDataCompare(binary), SortDataEof(), 1, sortData, n, radixScratchPad.data(), 0, 96, topn);
+        Array<uint32_t> radixScratchPad(candidates, Alloc::alloc(0, MMAP_LIMIT));
+        search::radix_sort(SortDataRadix(binary), StdSortDataCompare(binary), SortDataEof(), 1, sortData, candidates, radixScratchPad.data(), 0, 96, topn);
     }
     for (uint32_t i(0); i < _sortDataArray.size(); ++i) {
         a[i]._rankValue = _sortDataArray[i]._rankValue;
@@ -105,8 +105,10 @@ private:
     SortDataArray            _sortDataArray;
 
     bool Add(search::attribute::IAttributeContext & vecMan, const search::common::SortInfo & sInfo);
-    void initSortData(const search::RankedHit *a, uint32_t n);
+    void initSortData(const search::RankedHit *a, uint32_t n, size_t numVectors);
     int initSortData(const VectorRef & vec, const search::RankedHit & hit, size_t offset);
+    bool sameSortData(const SortData & a, const SortData & b) const;
+    uint32_t selectTopCandidates(search::RankedHit a[], uint32_t n, uint32_t topn);
 
 public:
     FastS_SortSpec(const FastS_SortSpec &) = delete;
@@ -0,0 +1,77 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bit_vector_cache.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/vespalib/stllike/cache.hpp>
+
+namespace search::diskindex {
+
+namespace {
+
+struct BitVectorSize {
+    size_t operator()(const std::shared_ptr<BitVector>& bv) const noexcept {
+        return bv ? (sizeof(BitVector) + bv->getFileBytes()) : 0;
+    }
+};
+
+class BitVectorStore {
+    const BitVectorCache::BackingStore& _backing_store;
+public:
+    explicit BitVectorStore(const BitVectorCache::BackingStore& backing_store) noexcept
+        : _backing_store(backing_store)
+    { }
+    bool read(const BitVectorCache::Key& key, std::shared_ptr<BitVector>& value) const {
+        value = _backing_store.read_uncached_bit_vector(key);
+        return static_cast<bool>(value);
+    }
+    void write(const BitVectorCache::Key&, const std::shared_ptr<BitVector>&) { }
+    void erase(const BitVectorCache::Key&) { }
+};
+
+using BitVectorCacheParam = vespalib::CacheParam<vespalib::LruParam<BitVectorCache::Key, std::shared_ptr<BitVector>>,
+                                                 BitVectorStore,
+                                                 vespalib::zero<BitVectorCache::Key>,
+                                                 BitVectorSize>;
+
+}
+
+class BitVectorCache::Shard {
+    BitVectorStore                       _store;
+    vespalib::cache<BitVectorCacheParam> _cache;
+public:
+    Shard(const BackingStore& backing_store, size_t max_bytes)
+        : _store(backing_store),
+          _cache(_store, max_bytes)
+    { }
+    std::shared_ptr<BitVector> read(const Key& key) { return _cache.read(key); }
+    vespalib::CacheStats get_stats() const { return _cache.get_stats(); }
+};
+
+BitVectorCache::BitVectorCache(const BackingStore& backing_store, size_t max_bytes)
+    : _shards()
+{
+    _shards.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) {
+        _shards.emplace_back(std::make_unique<Shard>(backing_store, max_bytes / num_shards));
+    }
+}
+
+BitVectorCache::~BitVectorCache() = default;
+
+std::shared_ptr<BitVector>
+BitVectorCache::read(const Key& key)
+{
+    return _shards[key.hash() % num_shards]->read(key);
+}
+
+vespalib::CacheStats
+BitVectorCache::get_stats() const
+{
+    vespalib::CacheStats stats;
+    for (const auto& shard : _shards) {
+        stats += shard->get_stats();
+    }
+    return stats;
+}
+
+}
@@ -0,0 +1,61 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/cache_stats.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace search { class BitVector; }
+
+namespace search::diskindex {
+
+/**
+ * Cache of bit vectors read from a disk index, keyed by field id and word
+ * number and bounded by a byte limit.
+ *
+ * Decoded posting lists are cached separately, see PostingListCache.
+ *
+ * The cache is split into shards (selected by key hash) to reduce lock
+ * contention between concurrent queries.
+ */
+class BitVectorCache {
+public:
+    struct Key {
+        uint32_t field_id;
+        uint64_t word_num;
+
+        Key() noexcept : Key(0, 0) { }
+        Key(uint32_t field_id_in, uint64_t word_num_in) noexcept
+            : field_id(field_id_in),
+              word_num(word_num_in)
+        { }
+        size_t hash() const noexcept { return (word_num * 0x9e3779b97f4a7c15ul) ^ field_id; }
+        bool operator==(const Key& rhs) const noexcept {
+            return field_id == rhs.field_id && word_num == rhs.word_num;
+        }
+    };
+
+    /**
+     * Interface used to read bit vectors on cache miss.
+     */
+    class BackingStore {
+    public:
+        virtual ~BackingStore() = default;
+        virtual std::shared_ptr<BitVector> read_uncached_bit_vector(const Key& key) const = 0;
+    };
+
+    static constexpr size_t num_shards = 16;
+
+    BitVectorCache(const BackingStore& backing_store, size_t max_bytes);
+    ~BitVectorCache();
+    std::shared_ptr<BitVector> read(const Key& key);
+    vespalib::CacheStats get_stats() const;
+private:
+    class Shard;
+
+    std::vector<std::unique_ptr<Shard>> _shards;
+};
+
+}
@@ -0,0 +1,168 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "decoded_posting_list.h"
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+#include <vespa/searchlib/queryeval/iterators.h>
+#include <algorithm>
+#include <cassert>
+
+using search::fef::TermFieldMatchData;
+using search::fef::TermFieldMatchDataArray;
+using search::fef::TermFieldMatchDataPosition;
+using search::queryeval::SearchIterator;
+
+namespace search::diskindex {
+
+namespace {
+
+constexpr size_t bytes_per_doc = 2 * sizeof(uint32_t);
+constexpr size_t bytes_per_doc_interleaved_features = 2 * sizeof(uint16_t);
+
+/**
+ * Search iterator over a decoded posting list.
+ *
+ * Unpacks features the same way as the compressed posting list iterators:
+ * positions only when normal features are needed, and interleaved features
+ * only when they are needed and present in the posting list.
+ */
+class DecodedPostingListIterator : public queryeval::RankedSearchIteratorBase {
+    const DecodedPostingList& _list;
+    const uint32_t*           _begin;
+    const uint32_t*           _pos;
+    const uint32_t*           _end;
+
+    void set_doc_id_from_pos() {
+        if (_pos == _end || isAtEnd(*_pos)) {
+            setAtEnd();
+        } else {
+            setDocId(*_pos);
+        }
+    }
+public:
+    DecodedPostingListIterator(const DecodedPostingList& list, TermFieldMatchDataArray match_data)
+        : RankedSearchIteratorBase(std::move(match_data)),
+          _list(list),
+          _begin(list.doc_ids().data()),
+          _pos(_begin),
+          _end(_begin + list.doc_ids().size())
+    { }
+
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, end);
+        _pos = std::lower_bound(_begin, _end, begin);
+        set_doc_id_from_pos();
+        clearUnpacked();
+    }
+
+    void doSeek(uint32_t doc_id) override {
+        if (getUnpacked()) {
+            clearUnpacked();
+        }
+        _pos = std::lower_bound(_pos, _end, doc_id);
+        set_doc_id_from_pos();
+    }
+
+    void doUnpack(uint32_t doc_id) override {
+        if (!_matchData.valid() || getUnpacked()) {
+            return;
+        }
+        assert(doc_id == getDocId());
+        uint32_t idx = _pos - _begin;
+        TermFieldMatchData* tfmd = _matchData[0];
+        tfmd->reset(doc_id);
+        if (tfmd->needs_normal_features()) {
+            for (auto itr = _list.positions_begin(idx), end = _list.positions_end(idx); itr != end; ++itr) {
+                tfmd->appendPosition(*itr);
+            }
+        }
+        if (tfmd->needs_interleaved_features() && _list.has_interleaved_features()) {
+            tfmd->setNumOccs(_list.num_occs(idx));
+            tfmd->setFieldLength(_list.field_length(idx));
+        }
+        setUnpacked();
+    }
+
+    Trinary is_strict() const override { return Trinary::True; }
+};
+
+}
+
+DecodedPostingList::DecodedPostingList()
+    : _doc_ids(),
+      _position_offsets(),
+      _positions(),
+      _num_occs(),
+      _field_lengths()
+{
+}
+
+DecodedPostingList::~DecodedPostingList() = default;
+
+std::shared_ptr<const DecodedPostingList>
+DecodedPostingList::decode(SearchIterator& itr, TermFieldMatchData& match_data, size_t max_bytes)
+{
+    auto list = std::make_shared<DecodedPostingList>();
+    size_t bytes = sizeof(DecodedPostingList) + sizeof(uint32_t);
+    if (bytes > max_bytes) {
+        return {};
+    }
+    bool interleaved_features = false;
+    list->_position_offsets.push_back(0);
+    itr.initFullRange();
+    for (itr.seek(1); !itr.isAtEnd(); itr.seek(itr.getDocId() + 1)) {
+        uint32_t doc_id = itr.getDocId();
+        // Interleaved features are only set by unpack if the posting list file has them.
+        match_data.setNumOccs(0);
+        match_data.setFieldLength(0);
+        itr.unpack(doc_id);
+        if (list->_doc_ids.empty()) {
+            interleaved_features = (match_data.getNumOccs() != 0);
+        }
+        bytes += bytes_per_doc + match_data.size() * sizeof(TermFieldMatchDataPosition);
+        if (interleaved_features) {
+            bytes += bytes_per_doc_interleaved_features;
+        }
+        if (bytes > max_bytes) {
+            return {};
+        }
+        list->_doc_ids.push_back(doc_id);
+        list->_positions.insert(list->_positions.end(), match_data.begin(), match_data.end());
+        list->_position_offsets.push_back(list->_positions.size());
+        if (interleaved_features) {
+            list->_num_occs.push_back(match_data.getNumOccs());
+            list->_field_lengths.push_back(match_data.getFieldLength());
+        }
+    }
+    list->_doc_ids.shrink_to_fit();
+    list->_position_offsets.shrink_to_fit();
+    list->_positions.shrink_to_fit();
+    list->_num_occs.shrink_to_fit();
+    list->_field_lengths.shrink_to_fit();
+    return list;
+}
+
+size_t
+DecodedPostingList::min_memory_usage(uint64_t num_docs) noexcept
+{
+    return sizeof(DecodedPostingList) + sizeof(uint32_t) + num_docs * bytes_per_doc;
+}
+
+size_t
+DecodedPostingList::memory_usage() const noexcept
+{
+    return sizeof(DecodedPostingList) +
+        _doc_ids.capacity() * sizeof(uint32_t) +
+        _position_offsets.capacity() * sizeof(uint32_t) +
+        _positions.capacity() * sizeof(TermFieldMatchDataPosition) +
+        _num_occs.capacity() * sizeof(uint16_t) +
+        _field_lengths.capacity() * sizeof(uint16_t);
+}
+
+std::unique_ptr<SearchIterator>
+DecodedPostingList::create_iterator(const TermFieldMatchDataArray& match_data) const
+{
+    return std::make_unique<DecodedPostingListIterator>(*this, match_data);
+}
+
+}
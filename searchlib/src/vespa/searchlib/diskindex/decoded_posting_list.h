@@ -0,0 +1,74 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/fef/termfieldmatchdataposition.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace search::fef {
+class TermFieldMatchData;
+class TermFieldMatchDataArray;
+}
+namespace search::queryeval { class SearchIterator; }
+
+namespace search::diskindex {
+
+/**
+ * A posting list from a disk index decoded into plain arrays of doc ids
+ * and features, so that queries can iterate it without decompressing it.
+ *
+ * Positions are stored as the TermFieldMatchDataPosition instances produced
+ * by the compressed posting list iterator, and interleaved features (number
+ * of occurrences and field length) are stored when the posting list file
+ * has them.
+ */
+class DecodedPostingList {
+    std::vector<uint32_t>                        _doc_ids;
+    std::vector<uint32_t>                        _position_offsets; // _doc_ids.size() + 1 entries
+    std::vector<fef::TermFieldMatchDataPosition> _positions;
+    std::vector<uint16_t>                        _num_occs;
+    std::vector<uint16_t>                        _field_lengths;
+
+public:
+    DecodedPostingList();
+    ~DecodedPostingList();
+
+    /**
+     * Decode all hits from the given compressed posting list iterator.
+     *
+     * @param itr iterator created with match_data as its only term field match data.
+     * @param match_data term field match data requesting both normal and interleaved features.
+     * @param max_bytes give up (and return nullptr) when the decoded list would use more memory than this.
+     */
+    static std::shared_ptr<const DecodedPostingList> decode(queryeval::SearchIterator& itr,
+                                                            fef::TermFieldMatchData& match_data,
+                                                            size_t max_bytes);
+
+    /**
+     * Lower bound on the memory used by a decoded posting list with the given number of documents.
+     */
+    static size_t min_memory_usage(uint64_t num_docs) noexcept;
+
+    size_t memory_usage() const noexcept;
+    uint32_t size() const noexcept { return _doc_ids.size(); }
+    bool has_interleaved_features() const noexcept { return !_num_occs.empty(); }
+
+    /**
+     * Create an iterator over this posting list. This instance must outlive the iterator.
+     */
+    std::unique_ptr<queryeval::SearchIterator> create_iterator(const fef::TermFieldMatchDataArray& match_data) const;
+
+    const std::vector<uint32_t>& doc_ids() const noexcept { return _doc_ids; }
+    const fef::TermFieldMatchDataPosition* positions_begin(uint32_t idx) const noexcept {
+        return _positions.data() + _position_offsets[idx];
+    }
+    const fef::TermFieldMatchDataPosition* positions_end(uint32_t idx) const noexcept {
+        return _positions.data() + _position_offsets[idx + 1];
+    }
+    uint16_t num_occs(uint32_t idx) const noexcept { return _num_occs[idx]; }
+    uint16_t field_length(uint32_t idx) const noexcept { return _field_lengths[idx]; }
+};
+
+}
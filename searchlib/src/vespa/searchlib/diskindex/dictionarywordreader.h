@@ -2,6 +2,7 @@
 #pragma once
 
 #include "pagedict4file.h"
+#include <vector>
 
 
 namespace search::diskindex {
@@ -9,28 +10,48 @@ namespace search::diskindex {
 /*
  * Helper class, will be used by fusion later to handle generation of
  * word numbering without writing a word list file.
+ *
+ * It can also split the new word numbers into ranges with roughly
+ * partition_bits of input posting lists each, used when merging
+ * a field in word range partitions.
  */
 class WordAggregator
 {
 private:
     vespalib::string _word;
     uint64_t _wordNum;
+    uint64_t _postingBits;
+    const uint64_t _partitionBits;
+    std::vector<uint64_t> _partitionStarts; // First word number for each partition after the first one
 
 public:
     WordAggregator()
+        : WordAggregator(0)
+    {
+    }
+
+    explicit WordAggregator(uint64_t partition_bits)
         : _word(),
-          _wordNum(0)
+          _wordNum(0),
+          _postingBits(0),
+          _partitionBits(partition_bits),
+          _partitionStarts()
     {
     }
 
-    void tryWriteWord(std::string_view word) {
+    void tryWriteWord(std::string_view word, uint64_t posting_bits) {
         if (word != _word || _wordNum == 0) {
+            if (_partitionBits != 0 && _postingBits >= _partitionBits * (_partitionStarts.size() + 1)) {
+                _partitionStarts.push_back(_wordNum + 1);
+            }
             ++_wordNum;
             _word = word;
         }
+        _postingBits += posting_bits;
     }
 
     uint64_t getWordNum() const { return _wordNum; }
+    const std::vector<uint64_t> &get_partition_starts() const noexcept { return _partitionStarts; }
 };
 
 
@@ -85,7 +106,7 @@ public:
     void writeNewWordNum(uint64_t newWordNum);
 
     void write(WordAggregator &writer) {
-        writer.tryWriteWord(_word);
+        writer.tryWriteWord(_word, _counts._bitLength);
         writeNewWordNum(writer.getWordNum());
     }
 };
@@ -1,9 +1,12 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "diskindex.h"
+#include "decoded_posting_list.h"
 #include "disktermblueprint.h"
 #include "pagedict4randread.h"
 #include "fileheader.h"
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/index/schemautil.h>
 #include <vespa/searchlib/queryeval/create_blueprint_visitor_helper.h>
 #include <vespa/searchlib/queryeval/leaf_blueprints.h>
@@ -19,6 +22,8 @@ LOG_SETUP(".diskindex.diskindex");
 using namespace search::index;
 using namespace search::query;
 using namespace search::queryeval;
+using search::fef::TermFieldMatchData;
+using search::fef::TermFieldMatchDataArray;
 
 namespace search::diskindex {
 
@@ -46,7 +51,8 @@ DiskIndex::Key::Key(const Key &) = default;
 DiskIndex::Key & DiskIndex::Key::operator = (const Key &) = default;
 DiskIndex::Key::~Key() = default;
 
-DiskIndex::DiskIndex(const vespalib::string &indexDir, size_t cacheSize)
+DiskIndex::DiskIndex(const vespalib::string &indexDir, size_t cacheSize, size_t bitVectorCacheSize,
+                     size_t postingListCacheSize)
     : _indexDir(indexDir),
       _cacheSize(cacheSize),
       _schema(),
@@ -55,8 +61,16 @@ DiskIndex::DiskIndex(const vespalib::string &indexDir, size_t cacheSize)
       _dicts(),
       _tuneFileSearch(),
       _cache(*this, cacheSize),
+      _bit_vector_cache(),
+      _posting_list_cache(),
       _size(0)
 {
+    if (bitVectorCacheSize > 0) {
+        _bit_vector_cache = std::make_unique<BitVectorCache>(static_cast<const BitVectorCache::BackingStore &>(*this), bitVectorCacheSize);
+    }
+    if (postingListCacheSize > 0) {
+        _posting_list_cache = std::make_unique<PostingListCache>(static_cast<const PostingListCache::BackingStore &>(*this), postingListCacheSize);
+    }
     calculateSize();
 }
 
@@ -314,6 +328,69 @@ DiskIndex::readBitVector(const LookupResult &lookupRes) const
     return dict->lookup(lookupRes.wordNum);
 }
 
+std::shared_ptr<BitVector>
+DiskIndex::read_uncached_bit_vector(const BitVectorCache::Key &key) const
+{
+    SchemaUtil::IndexIterator it(_schema, key.field_id);
+    BitVectorDictionary * dict = _bitVectorDicts[it.getIndex()].get();
+    if (dict == nullptr) {
+        return {};
+    }
+    return dict->lookup(key.word_num);
+}
+
+std::shared_ptr<BitVector>
+DiskIndex::read_bit_vector(const LookupResult &lookupRes) const
+{
+    if (!_bit_vector_cache) {
+        return readBitVector(lookupRes);
+    }
+    return _bit_vector_cache->read(BitVectorCache::Key(lookupRes.indexId, lookupRes.wordNum));
+}
+
+vespalib::CacheStats
+DiskIndex::get_bit_vector_cache_stats() const
+{
+    return _bit_vector_cache ? _bit_vector_cache->get_stats() : vespalib::CacheStats();
+}
+
+std::shared_ptr<const DecodedPostingList>
+DiskIndex::read_uncached_posting_list(const PostingListCache::Key &key, size_t max_bytes) const
+{
+    LookupResult lookupRes;
+    lookupRes.indexId = key.field_id;
+    lookupRes.wordNum = key.word_num;
+    lookupRes.counts = key.counts;
+    lookupRes.bitOffset = key.bit_offset;
+    auto handle = readPostingList(lookupRes);
+    if (!handle) {
+        return {};
+    }
+    TermFieldMatchData tfmd;
+    tfmd.setNeedNormalFeatures(true);
+    tfmd.setNeedInterleavedFeatures(true);
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&tfmd);
+    auto itr = handle->createIterator(lookupRes.counts, tfmda, false);
+    return DecodedPostingList::decode(*itr, tfmd, max_bytes);
+}
+
+std::shared_ptr<const DecodedPostingList>
+DiskIndex::read_decoded_posting_list(const LookupResult &lookupRes) const
+{
+    if (!_posting_list_cache || !lookupRes.valid()) {
+        return {};
+    }
+    return _posting_list_cache->read(PostingListCache::Key(lookupRes.indexId, lookupRes.wordNum,
+                                                           lookupRes.bitOffset, lookupRes.counts));
+}
+
+vespalib::CacheStats
+DiskIndex::get_posting_list_cache_stats() const
+{
+    return _posting_list_cache ? _posting_list_cache->get_stats() : vespalib::CacheStats();
+}
+
 void
 DiskIndex::calculateSize()
 {
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "bitvectordictionary.h"
+#include "bit_vector_cache.h"
+#include "posting_list_cache.h"
 #include "zcposoccrandread.h"
 #include <vespa/searchlib/index/dictionaryfile.h>
 #include <vespa/searchlib/index/field_length_info.h>
@@ -10,6 +12,7 @@
 #include <vespa/searchcommon/common/schema.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/stllike/cache.h>
+#include <vespa/vespalib/stllike/cache_stats.h>
 
 namespace search::diskindex {
 
@@ -19,8 +22,11 @@ namespace search::diskindex {
  * Each field index has a dictionary, posting list files and bit vector files.
  * Parts of the disk dictionary and all bit vector dictionaries are loaded into memory during setup.
  * All other files are just opened, ready for later access.
+ * Bit vectors and decoded posting lists read during query setup can optionally be cached.
  */
-class DiskIndex : public queryeval::Searchable {
+class DiskIndex : public queryeval::Searchable,
+                  private BitVectorCache::BackingStore,
+                  private PostingListCache::BackingStore {
 public:
     /**
      * The result after performing a disk dictionary lookup.
@@ -80,12 +86,17 @@ private:
     std::vector<std::unique_ptr<index::DictionaryFileRandRead>> _dicts;
     TuneFileSearch                         _tuneFileSearch;
     Cache                                  _cache;
+    std::unique_ptr<BitVectorCache>        _bit_vector_cache;
+    std::unique_ptr<PostingListCache>      _posting_list_cache;
     uint64_t                               _size;
 
     void calculateSize();
     bool loadSchema();
     bool openDictionaries(const TuneFileSearch &tuneFileSearch);
     bool openField(const vespalib::string &fieldDir, const TuneFileSearch &tuneFileSearch);
+    std::shared_ptr<BitVector> read_uncached_bit_vector(const BitVectorCache::Key &key) const override;
+    std::shared_ptr<const DecodedPostingList> read_uncached_posting_list(const PostingListCache::Key &key,
+                                                                         size_t max_bytes) const override;
 
 public:
     /**
@@ -93,8 +104,11 @@ public:
      *
      * @param indexDir the directory where the disk index is located.
      * @param cacheSize optional size (in bytes) of the disk dictionary lookup cache.
+     * @param bitVectorCacheSize optional size (in bytes) of the bit vector cache.
+     * @param postingListCacheSize optional size (in bytes) of the decoded posting list cache.
      */
-    explicit DiskIndex(const vespalib::string &indexDir, size_t cacheSize=0);
+    explicit DiskIndex(const vespalib::string &indexDir, size_t cacheSize=0, size_t bitVectorCacheSize=0,
+                       size_t postingListCacheSize=0);
     ~DiskIndex() override;
 
     /**
@@ -133,6 +147,25 @@ public:
      */
     BitVector::UP readBitVector(const LookupResult &lookupRes) const;
 
+    /**
+     * Read the bit vector corresponding to the given lookup result,
+     * using the bit vector cache if enabled.
+     */
+    std::shared_ptr<BitVector> read_bit_vector(const LookupResult &lookupRes) const;
+
+    vespalib::CacheStats get_bit_vector_cache_stats() const;
+
+    /**
+     * Read and decode the posting list corresponding to the given lookup
+     * result, using the decoded posting list cache.
+     *
+     * @return the decoded posting list, or nullptr if the cache is disabled
+     *         or the posting list is too large to be cached.
+     */
+    std::shared_ptr<const DecodedPostingList> read_decoded_posting_list(const LookupResult &lookupRes) const;
+
+    vespalib::CacheStats get_posting_list_cache_stats() const;
+
     std::unique_ptr<queryeval::Blueprint> createBlueprint(const queryeval::IRequestContext & requestContext,
                                                           const queryeval::FieldSpec &field,
                                                           const query::Node &term) override;
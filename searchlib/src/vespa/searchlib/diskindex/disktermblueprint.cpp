@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "disktermblueprint.h"
+#include "decoded_posting_list.h"
 #include <vespa/searchlib/common/bitvectoriterator.h>
 #include <vespa/searchlib/queryeval/booleanmatchiteratorwrapper.h>
 #include <vespa/searchlib/queryeval/filter_wrapper.h>
@@ -49,6 +50,7 @@ DiskTermBlueprint::DiskTermBlueprint(const FieldSpec & field,
     _useBitVector(useBitVector),
     _fetchPostingsDone(false),
     _postingHandle(),
+    _decodedPostingList(),
     _bitVector()
 {
     setEstimate(HitEstimate(_lookupRes->counts._numDocs,
@@ -60,9 +62,12 @@ DiskTermBlueprint::fetchPostings(const queryeval::ExecuteInfo &execInfo)
 {
     (void) execInfo;
     if (!_fetchPostingsDone) {
-        _bitVector = _diskIndex.readBitVector(*_lookupRes);
+        _bitVector = _diskIndex.read_bit_vector(*_lookupRes);
         if (!_useBitVector || !_bitVector) {
-            _postingHandle = _diskIndex.readPostingList(*_lookupRes);
+            _decodedPostingList = _diskIndex.read_decoded_posting_list(*_lookupRes);
+            if (!_decodedPostingList) {
+                _postingHandle = _diskIndex.readPostingList(*_lookupRes);
+            }
         }
     }
     _fetchPostingsDone = true;
@@ -75,6 +80,15 @@ DiskTermBlueprint::calculate_flow_stats(uint32_t docid_limit) const
     return {rel_est, disk_index_cost(rel_est), disk_index_strict_cost(rel_est)};
 }
 
+SearchIterator::UP
+DiskTermBlueprint::createPostingIterator(const TermFieldMatchDataArray & tfmda) const
+{
+    if (_decodedPostingList) {
+        return _decodedPostingList->create_iterator(tfmda);
+    }
+    return _postingHandle->createIterator(_lookupRes->counts, tfmda, _useBitVector);
+}
+
 SearchIterator::UP
 DiskTermBlueprint::createLeafSearch(const TermFieldMatchDataArray & tfmda) const
 {
@@ -83,7 +97,7 @@ DiskTermBlueprint::createLeafSearch(const TermFieldMatchDataArray & tfmda) const
             getName(_lookupRes->indexId).c_str(), _lookupRes->wordNum, _lookupRes->counts._numDocs);
         return BitVectorIterator::create(_bitVector.get(), *tfmda[0], strict());
     }
-    SearchIterator::UP search(_postingHandle->createIterator(_lookupRes->counts, tfmda, _useBitVector));
+    SearchIterator::UP search(createPostingIterator(tfmda));
     if (_useBitVector) {
         LOG(debug, "Return BooleanMatchIteratorWrapper: %s, wordNum(%" PRIu64 "), docCount(%" PRIu64 ")",
             getName(_lookupRes->indexId).c_str(), _lookupRes->wordNum, _lookupRes->counts._numDocs);
@@ -102,7 +116,7 @@ DiskTermBlueprint::createFilterSearch(FilterConstraint) const
     if (_bitVector) {
         wrapper->wrap(BitVectorIterator::create(_bitVector.get(), *tfmda[0], strict()));
     } else {
-        wrapper->wrap(_postingHandle->createIterator(_lookupRes->counts, tfmda, _useBitVector));
+        wrapper->wrap(createPostingIterator(tfmda));
     }
     return wrapper;
 }
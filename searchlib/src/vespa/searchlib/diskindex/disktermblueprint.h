@@ -20,7 +20,10 @@ private:
     bool                             _useBitVector;
     bool                             _fetchPostingsDone;
     index::PostingListHandle::UP     _postingHandle;
-    BitVector::UP                    _bitVector;
+    std::shared_ptr<const DecodedPostingList> _decodedPostingList;
+    std::shared_ptr<BitVector>       _bitVector;
+
+    std::unique_ptr<queryeval::SearchIterator> createPostingIterator(const fef::TermFieldMatchDataArray & tfmda) const;
 
 public:
     /**
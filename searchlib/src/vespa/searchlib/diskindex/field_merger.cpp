@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "field_merger.h"
+#include "field_merger_partition.h"
 #include "fieldreader.h"
 #include "field_length_scanner.h"
 #include "fusion_input_index.h"
@@ -73,6 +74,12 @@ FieldMerger::FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index,
       _writer(),
       _field_length_scanner(),
       _open_reader_idx(std::numeric_limits<uint32_t>::max()),
+      _partition_starts(),
+      _partitions(),
+      _schedule_partitions(false),
+      _pending_partitions(0u),
+      _partitions_failed(false),
+      _append_partition_idx(0u),
       _state(State::MERGE_START),
       _failed(false)
 {
@@ -176,6 +183,34 @@ FieldMerger::read_mapping_files()
     return true;
 }
 
+/*
+ * Returns the wanted number of input posting list bits for each word
+ * range partition, or 0 if the field should not be partitioned.
+ */
+uint64_t
+FieldMerger::calc_partition_bits() const
+{
+    uint32_t max_partitions = _fusion_out_index.get_max_field_partitions();
+    if (max_partitions <= 1) {
+        return 0;
+    }
+    SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
+    uint64_t posting_size = 0;
+    for (const auto & oi : _fusion_out_index.get_old_indexes()) {
+        if (!index.hasOldFields(oi.getSchema())) {
+            continue;
+        }
+        std::error_code ec;
+        auto size = std::filesystem::file_size(std::filesystem::path(oi.getPath() + "/" + _field_name + "/posocc.dat.compressed"), ec);
+        if (!ec) {
+            posting_size += size;
+        }
+    }
+    uint64_t partitions = std::min(posting_size / std::max(_fusion_out_index.get_min_field_partition_size(), uint64_t(1)),
+                                   uint64_t(max_partitions));
+    return (partitions > 1) ? (posting_size * 8 / partitions) : 0;
+}
+
 bool
 FieldMerger::renumber_word_ids_start()
 {
@@ -183,7 +218,7 @@ FieldMerger::renumber_word_ids_start()
     if (!open_input_word_readers()) {
         return false;
     }
-    _word_aggregator = std::make_unique<WordAggregator>();
+    _word_aggregator = std::make_unique<WordAggregator>(calc_partition_bits());
     _word_heap->setup(renumber_word_ids_heap_limit);
     _word_heap->set_merge_chunk(_fusion_out_index.get_force_small_merge_chunk() ? 1u : renumber_word_ids_merge_chunk);
     return true;
@@ -205,6 +240,7 @@ FieldMerger::renumber_word_ids_finish()
 {
     _word_heap.reset();
     _num_word_ids = _word_aggregator->getWordNum();
+    _partition_starts = _word_aggregator->get_partition_starts();
     _word_aggregator.reset();
 
     // Close files
@@ -279,6 +315,9 @@ FieldMerger::open_input_field_readers()
         _readers.push_back(FieldReader::allocFieldReader(index, oldSchema, _field_length_scanner));
         auto& reader = *_readers.back();
         reader.setup(_word_num_mappings[oi.getIndex()], oi.getDocIdMapping());
+        if (!_partition_starts.empty()) {
+            reader.set_word_num_range(1, _partition_starts.front());
+        }
         if (!open_input_field_reader()) {
             merge_postings_failed();
             return;
@@ -314,14 +353,15 @@ FieldMerger::scan_element_lengths()
 
 
 bool
-FieldMerger::open_field_writer()
+FieldMerger::open_field_writer(FieldWriter& writer, const FieldReaders& readers) const
 {
     FieldLengthInfo field_length_info;
-    if (!_readers.empty()) {
-        field_length_info = _readers.back()->get_field_length_info();
+    if (!readers.empty()) {
+        field_length_info = readers.back()->get_field_length_info();
     }
     SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
-    if (!_writer->open(64, 262144, _fusion_out_index.get_dynamic_k_pos_index_format(),
+    writer.set_encode_block_max(_fusion_out_index.get_encode_block_max());
+    if (!writer.open(64, 262144, _fusion_out_index.get_dynamic_k_pos_index_format(),
                        index.use_interleaved_features(), index.getSchema(),
                        index.getIndex(),
                        field_length_info,
@@ -332,7 +372,7 @@ FieldMerger::open_field_writer()
 }
 
 bool
-FieldMerger::select_cooked_or_raw_features(FieldReader& reader)
+FieldMerger::select_cooked_or_raw_features(FieldWriter& writer, FieldReader& reader)
 {
     bool rawFormatOK = true;
     bool cookedFormatOK = true;
@@ -345,7 +385,7 @@ FieldMerger::select_cooked_or_raw_features(FieldReader& reader)
         return true;
     }
     {
-        _writer->getFeatureParams(featureParams);
+        writer.getFeatureParams(featureParams);
         cookedFormat = featureParams.getStr("cookedEncoding");
         rawFormat = featureParams.getStr("encoding");
         if (rawFormat == "") {
@@ -391,22 +431,21 @@ FieldMerger::select_cooked_or_raw_features(FieldReader& reader)
 }
 
 bool
-FieldMerger::setup_merge_heap()
+FieldMerger::setup_merge_heap(FieldReaderHeap& heap, FieldWriter& writer, FieldReaders& readers) const
 {
-    _heap = std::make_unique<PostingPriorityQueueMerger<FieldReader, FieldWriter>>();
-    for (auto &reader : _readers) {
-        if (!select_cooked_or_raw_features(*reader)) {
+    for (auto &reader : readers) {
+        if (!select_cooked_or_raw_features(writer, *reader)) {
             return false;
         }
         if (reader->isValid()) {
             reader->read();
         }
         if (reader->isValid()) {
-            _heap->initialAdd(reader.get());
+            heap.initialAdd(reader.get());
         }
     }
-    _heap->setup(merge_postings_heap_limit);
-    _heap->set_merge_chunk(_fusion_out_index.get_force_small_merge_chunk() ? 1u : merge_postings_merge_chunk);
+    heap.setup(merge_postings_heap_limit);
+    heap.set_merge_chunk(_fusion_out_index.get_force_small_merge_chunk() ? 1u : merge_postings_merge_chunk);
     return true;
 }
 
@@ -417,16 +456,37 @@ FieldMerger::merge_postings_start()
     _writer = std::make_unique<FieldWriter>(_fusion_out_index.get_doc_id_limit(), _num_word_ids, _field_dir + "/");
     _readers.reserve(_fusion_out_index.get_old_indexes().size());
     allocate_field_length_scanner();
+    if (_field_length_scanner) {
+        // Regenerating interleaved features needs to scan all input posting lists first
+        _partition_starts.clear();
+    }
     _open_reader_idx = 0;
     _state = State::OPEN_POSTINGS_FIELD_READERS;
 }
 
+void
+FieldMerger::create_partitions()
+{
+    for (size_t i = 0; i < _partition_starts.size(); ++i) {
+        uint64_t word_num_end = (i + 1 < _partition_starts.size()) ? _partition_starts[i + 1] : std::numeric_limits<uint64_t>::max();
+        vespalib::asciistream dir;
+        dir << _field_dir << "/partition" << (i + 1);
+        _partitions.emplace_back(std::make_unique<FieldMergerPartition>(*this, dir.str(), _partition_starts[i], word_num_end));
+    }
+    _schedule_partitions = !_partitions.empty();
+    _pending_partitions = _partitions.size() + 1;
+    _partitions_failed = false;
+    _append_partition_idx = 0;
+}
+
 void
 FieldMerger::merge_postings_open_field_readers_done()
 {
-    if (!open_field_writer() || !setup_merge_heap()) {
+    _heap = std::make_unique<FieldReaderHeap>();
+    if (!open_field_writer(*_writer, _readers) || !setup_merge_heap(*_heap, *_writer, _readers)) {
         merge_postings_failed();
     } else {
+        create_partitions();
         _state = State::MERGE_POSTINGS;
     }
 }
@@ -436,8 +496,77 @@ FieldMerger::merge_postings_main()
 {
     _heap->merge(*_writer, *_flush_token);
     if (_flush_token->stop_requested()) {
-        _failed = true;
+        if (_partitions.empty()) {
+            _failed = true;
+        } else {
+            _state = State::MERGE_POSTINGS_WAIT_PARTITIONS;
+        }
     } else if (_heap->empty()) {
+        _state = _partitions.empty() ? State::MERGE_POSTINGS_FINISH : State::MERGE_POSTINGS_WAIT_PARTITIONS;
+    }
+}
+
+std::vector<FieldMergerPartition*>
+FieldMerger::take_unscheduled_partitions()
+{
+    std::vector<FieldMergerPartition*> result;
+    if (_schedule_partitions) {
+        for (auto& partition : _partitions) {
+            result.emplace_back(partition.get());
+        }
+        _schedule_partitions = false;
+    }
+    return result;
+}
+
+bool
+FieldMerger::wait_for_partitions()
+{
+    if (_state != State::MERGE_POSTINGS_WAIT_PARTITIONS) {
+        return false;
+    }
+    _state = State::APPEND_PARTITIONS;
+    return _pending_partitions.fetch_sub(1, std::memory_order_acq_rel) != 1;
+}
+
+bool
+FieldMerger::partition_done(bool failed)
+{
+    if (failed) {
+        _partitions_failed = true;
+    }
+    return _pending_partitions.fetch_sub(1, std::memory_order_acq_rel) == 1;
+}
+
+void
+FieldMerger::remove_partitions()
+{
+    std::error_code ec;
+    for (auto& partition : _partitions) {
+        std::filesystem::remove_all(std::filesystem::path(partition->get_dir()), ec);
+    }
+    _partitions.clear();
+}
+
+void
+FieldMerger::append_partition()
+{
+    if (_partitions_failed || _flush_token->stop_requested()) {
+        remove_partitions();
+        merge_postings_failed();
+        return;
+    }
+    auto& partition = *_partitions[_append_partition_idx];
+    if (!_writer->append(partition.get_dir() + "/", partition.get_first_align(), _fusion_out_index.get_tune_file_indexing()._read)) {
+        remove_partitions();
+        merge_postings_failed();
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(std::filesystem::path(partition.get_dir()), ec);
+    if (++_append_partition_idx == _partitions.size()) {
+        LOG(debug, "Appended %zu partitions for field %s", _partitions.size(), _field_name.c_str());
+        _partitions.clear();
         _state = State::MERGE_POSTINGS_FINISH;
     }
 }
@@ -545,6 +674,9 @@ FieldMerger::process_merge_field()
     case State::MERGE_POSTINGS:
         merge_postings_main();
         break;
+    case State::APPEND_PARTITIONS:
+        append_partition();
+        break;
     case State::MERGE_POSTINGS_FINISH:
         merge_field_finish();
         break;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/string.h>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -16,6 +17,7 @@ namespace search::diskindex {
 
 class DictionaryWordReader;
 class FieldLengthScanner;
+class FieldMergerPartition;
 class FieldReader;
 class FieldWriter;
 class FusionOutputIndex;
@@ -24,10 +26,19 @@ class WordNumMapping;
 
 /*
  * Class for merging posting lists for a single field during fusion.
+ *
+ * Fields with large posting list files are split into word ranges
+ * while renumbering word ids. The first word range is merged by this
+ * class directly to the output for the field while the other word
+ * ranges are merged in parallel by FieldMergerPartition instances.
+ * Their outputs are appended to the output for the field when all
+ * word ranges have been merged.
  */
 class FieldMerger
 {
     using WordNumMappingList = std::vector<WordNumMapping>;
+    using FieldReaders = std::vector<std::unique_ptr<FieldReader>>;
+    using FieldReaderHeap = PostingPriorityQueueMerger<FieldReader, FieldWriter>;
 
     enum class State {
         MERGE_START,
@@ -37,6 +48,8 @@ class FieldMerger
         SCAN_ELEMENT_LENGTHS,
         OPEN_POSTINGS_FIELD_READERS_FINISH,
         MERGE_POSTINGS,
+        MERGE_POSTINGS_WAIT_PARTITIONS,
+        APPEND_PARTITIONS,
         MERGE_POSTINGS_FINISH,
         MERGE_DONE
     };
@@ -51,18 +64,27 @@ class FieldMerger
     std::unique_ptr<WordAggregator> _word_aggregator;
     WordNumMappingList _word_num_mappings;
     uint64_t _num_word_ids;
-    std::vector<std::unique_ptr<FieldReader>> _readers;
-    std::unique_ptr<PostingPriorityQueueMerger<FieldReader, FieldWriter>> _heap;
+    FieldReaders _readers;
+    std::unique_ptr<FieldReaderHeap> _heap;
     std::unique_ptr<FieldWriter> _writer;
     std::shared_ptr<FieldLengthScanner> _field_length_scanner;
     uint32_t _open_reader_idx;
+    std::vector<uint64_t> _partition_starts;
+    std::vector<std::unique_ptr<FieldMergerPartition>> _partitions;
+    bool _schedule_partitions;
+    std::atomic<uint32_t> _pending_partitions; // Including first word range
+    std::atomic<bool> _partitions_failed;
+    uint32_t _append_partition_idx;
     State _state;
     bool _failed;
 
+    friend class FieldMergerPartition;
+
     void make_tmp_dirs();
     bool clean_tmp_dirs();
     bool open_input_word_readers();
     bool read_mapping_files();
+    uint64_t calc_partition_bits() const;
     bool renumber_word_ids_start();
     void renumber_word_ids_main();
     bool renumber_word_ids_finish();
@@ -71,12 +93,15 @@ class FieldMerger
     bool open_input_field_reader();
     void open_input_field_readers();
     void scan_element_lengths();
-    bool open_field_writer();
-    bool select_cooked_or_raw_features(FieldReader& reader);
-    bool setup_merge_heap();
+    bool open_field_writer(FieldWriter& writer, const FieldReaders& readers) const;
+    static bool select_cooked_or_raw_features(FieldWriter& writer, FieldReader& reader);
+    bool setup_merge_heap(FieldReaderHeap& heap, FieldWriter& writer, FieldReaders& readers) const;
     void merge_postings_start();
+    void create_partitions();
     void merge_postings_open_field_readers_done();
     void merge_postings_main();
+    void remove_partitions();
+    void append_partition();
     bool merge_postings_finish();
     void merge_postings_failed();
 public:
@@ -85,6 +110,12 @@ public:
     void merge_field_start();
     void merge_field_finish();
     void process_merge_field(); // Called multiple times
+    // Returns partitions that needs to be scheduled for merging
+    std::vector<FieldMergerPartition*> take_unscheduled_partitions();
+    // Returns true if field merger should not be rescheduled until all partitions are done
+    bool wait_for_partitions();
+    // Returns true if field merger should be rescheduled
+    bool partition_done(bool failed);
     uint32_t get_id() const noexcept { return _id; }
     bool done() const noexcept { return _state == State::MERGE_DONE; }
     bool failed() const noexcept { return _failed; }
@@ -0,0 +1,118 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "field_merger_partition.h"
+#include "field_merger.h"
+#include "fieldreader.h"
+#include "fieldwriter.h"
+#include "fusion_input_index.h"
+#include "fusion_output_index.h"
+#include <vespa/searchlib/common/i_flush_token.h>
+#include <vespa/searchlib/index/schemautil.h>
+#include <vespa/searchlib/util/posting_priority_queue_merger.hpp>
+#include <vespa/vespalib/util/exceptions.h>
+#include <filesystem>
+
+#include <vespa/log/log.h>
+
+LOG_SETUP(".diskindex.field_merger_partition");
+
+using search::index::Schema;
+using search::index::SchemaUtil;
+
+namespace search::diskindex {
+
+FieldMergerPartition::FieldMergerPartition(const FieldMerger& field_merger, const vespalib::string& dir, uint64_t word_num_begin, uint64_t word_num_end)
+    : _field_merger(field_merger),
+      _dir(dir),
+      _word_num_begin(word_num_begin),
+      _word_num_end(word_num_end),
+      _readers(),
+      _heap(),
+      _writer(),
+      _first_align(),
+      _opened(false),
+      _done(false),
+      _failed(false)
+{
+}
+
+FieldMergerPartition::~FieldMergerPartition() = default;
+
+bool
+FieldMergerPartition::open()
+{
+    const auto& fusion_out_index = _field_merger._fusion_out_index;
+    std::filesystem::create_directory(std::filesystem::path(_dir));
+    SchemaUtil::IndexIterator index(fusion_out_index.get_schema(), _field_merger._id);
+    for (const auto& oi : fusion_out_index.get_old_indexes()) {
+        const Schema &oldSchema = oi.getSchema();
+        if (!index.hasOldFields(oldSchema)) {
+            continue; // drop data
+        }
+        _readers.push_back(FieldReader::allocFieldReader(index, oldSchema, {}));
+        auto& reader = *_readers.back();
+        reader.setup(_field_merger._word_num_mappings[oi.getIndex()], oi.getDocIdMapping());
+        reader.set_word_num_range(_word_num_begin, _word_num_end);
+        if (!reader.open(oi.getPath() + "/" + _field_merger._field_name + "/", fusion_out_index.get_tune_file_indexing()._read)) {
+            _readers.pop_back();
+            return false;
+        }
+    }
+    _writer = std::make_unique<FieldWriter>(fusion_out_index.get_doc_id_limit(), _field_merger._num_word_ids, _dir + "/");
+    _heap = std::make_unique<PostingPriorityQueueMerger<FieldReader, FieldWriter>>();
+    try {
+        if (!_field_merger.open_field_writer(*_writer, _readers)) {
+            return false;
+        }
+    } catch (const vespalib::IllegalArgumentException& e) {
+        LOG(error, "%s", e.getMessage().c_str());
+        return false;
+    }
+    return _field_merger.setup_merge_heap(*_heap, *_writer, _readers);
+}
+
+bool
+FieldMergerPartition::close()
+{
+    _heap.reset();
+    for (auto &reader : _readers) {
+        if (!reader->close()) {
+            return false;
+        }
+    }
+    _readers.clear();
+    if (!_writer->close()) {
+        return false;
+    }
+    _first_align = _writer->get_first_align();
+    _writer.reset();
+    return true;
+}
+
+void
+FieldMergerPartition::process()
+{
+    auto& flush_token = *_field_merger._flush_token;
+    if (!_opened) {
+        _opened = true;
+        if (!open()) {
+            LOG(error, "Could not open partition for field %s dir %s", _field_merger._field_name.c_str(), _dir.c_str());
+            _failed = true;
+            _done = true;
+        }
+        return;
+    }
+    _heap->merge(*_writer, flush_token);
+    if (flush_token.stop_requested()) {
+        _failed = true;
+        _done = true;
+    } else if (_heap->empty()) {
+        if (!close()) {
+            LOG(error, "Could not close partition for field %s dir %s", _field_merger._field_name.c_str(), _dir.c_str());
+            _failed = true;
+        }
+        _done = true;
+    }
+}
+
+}
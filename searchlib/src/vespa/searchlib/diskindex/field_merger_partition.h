@@ -0,0 +1,56 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "zc4_posting_writer_base.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace search {
+template <class Reader, class Writer> class PostingPriorityQueueMerger;
+}
+
+namespace search::diskindex {
+
+class FieldMerger;
+class FieldReader;
+class FieldWriter;
+
+/*
+ * Class for merging posting lists for a word range of a single field
+ * during fusion. The output is written to a separate directory and is
+ * appended to the output for the field by the field merger when all
+ * word ranges have been merged.
+ *
+ * Memory usage is bounded by the buffers for the input field readers
+ * and the output field writer, as for the field merger itself.
+ */
+class FieldMergerPartition
+{
+    const FieldMerger&     _field_merger;
+    const vespalib::string _dir;
+    const uint64_t         _word_num_begin;
+    const uint64_t         _word_num_end;
+    std::vector<std::unique_ptr<FieldReader>> _readers;
+    std::unique_ptr<PostingPriorityQueueMerger<FieldReader, FieldWriter>> _heap;
+    std::unique_ptr<FieldWriter> _writer;
+    Zc4PostingFirstAlign   _first_align;
+    bool                   _opened;
+    bool                   _done;
+    bool                   _failed;
+
+    bool open();
+    bool close();
+public:
+    FieldMergerPartition(const FieldMerger& field_merger, const vespalib::string& dir, uint64_t word_num_begin, uint64_t word_num_end);
+    ~FieldMergerPartition();
+    void process(); // Called multiple times
+    bool done() const noexcept { return _done; }
+    bool failed() const noexcept { return _failed; }
+    const vespalib::string& get_dir() const noexcept { return _dir; }
+    const Zc4PostingFirstAlign& get_first_align() const noexcept { return _first_align; }
+};
+
+}
@@ -0,0 +1,21 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "field_merger_partition_task.h"
+#include "field_merger.h"
+#include "field_merger_partition.h"
+#include "field_mergers_state.h"
+
+namespace search::diskindex {
+
+void
+FieldMergerPartitionTask::run()
+{
+    _partition.process();
+    if (!_partition.done()) {
+        _field_mergers_state.schedule_partition_task(_field_merger, _partition);
+    } else if (_field_merger.partition_done(_partition.failed())) {
+        _field_mergers_state.schedule_task(_field_merger);
+    }
+}
+
+}
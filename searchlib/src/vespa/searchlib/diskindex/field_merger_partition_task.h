@@ -0,0 +1,33 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/threadexecutor.h>
+
+namespace search::diskindex {
+
+class FieldMerger;
+class FieldMergerPartition;
+class FieldMergersState;
+
+/*
+ * Task for processing a portion of a field merge partition.
+ */
+class FieldMergerPartitionTask : public vespalib::Executor::Task
+{
+    FieldMerger&          _field_merger;
+    FieldMergerPartition& _partition;
+    FieldMergersState&    _field_mergers_state;
+
+    void run() override;
+public:
+    FieldMergerPartitionTask(FieldMerger& field_merger, FieldMergerPartition& partition, FieldMergersState& field_mergers_state)
+        : vespalib::Executor::Task(),
+          _field_merger(field_merger),
+          _partition(partition),
+          _field_mergers_state(field_mergers_state)
+    {
+    }
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include "field_merger_task.h"
 #include "field_merger.h"
+#include "field_merger_partition.h"
 #include "field_mergers_state.h"
 
 namespace search::diskindex {
@@ -15,7 +16,12 @@ FieldMergerTask::run()
     } else if (_field_merger.done()) {
         _field_mergers_state.field_merger_done(_field_merger, false);
     } else {
-        _field_mergers_state.schedule_task(_field_merger);
+        for (auto partition : _field_merger.take_unscheduled_partitions()) {
+            _field_mergers_state.schedule_partition_task(_field_merger, *partition);
+        }
+        if (!_field_merger.wait_for_partitions()) {
+            _field_mergers_state.schedule_task(_field_merger);
+        }
     }
 }
 
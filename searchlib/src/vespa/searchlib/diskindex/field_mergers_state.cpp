@@ -2,6 +2,7 @@
 
 #include "field_mergers_state.h"
 #include "field_merger.h"
+#include "field_merger_partition_task.h"
 #include "field_merger_task.h"
 #include "fusion_output_index.h"
 #include <vespa/searchcommon/common/schema.h>
@@ -74,4 +75,12 @@ FieldMergersState::schedule_task(FieldMerger& field_merger)
     assert(!rejected);
 }
 
+void
+FieldMergersState::schedule_partition_task(FieldMerger& field_merger, FieldMergerPartition& partition)
+{
+    auto task = std::make_unique<FieldMergerPartitionTask>(field_merger, partition, *this);
+    auto rejected = _executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::COMPACT));
+    assert(!rejected);
+}
+
 }
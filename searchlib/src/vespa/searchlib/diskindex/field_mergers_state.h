@@ -12,6 +12,7 @@ namespace vespalib { class Executor; }
 namespace search::diskindex {
 
 class FieldMerger;
+class FieldMergerPartition;
 class FusionOutputIndex;
 
 /*
@@ -34,6 +35,7 @@ public:
     void field_merger_done(FieldMerger& field_merger, bool failed);
     void wait_field_mergers_done();
     void schedule_task(FieldMerger& field_merger);
+    void schedule_partition_task(FieldMerger& field_merger, FieldMergerPartition& partition);
     uint32_t get_failed() const noexcept { return _failed; }
 };
 
@@ -40,7 +40,9 @@ FieldReader::FieldReader()
       _oldWordNum(noWordNumHigh()),
       _residue(0u),
       _docIdLimit(0u),
-      _word()
+      _word(),
+      _wordNumBegin(noWordNum()),
+      _wordNumEnd(noWordNumHigh())
 {
 }
 
@@ -53,6 +55,14 @@ FieldReader::readCounts()
 {
     PostingListCounts counts;
     _dictFile->readWord(_word, _oldWordNum, counts);
+    while (_oldWordNum != noWordNumHigh() && _wordNumMapper.map(_oldWordNum) < _wordNumBegin) {
+        _oldposoccfile->skipWord(counts);
+        _dictFile->readWord(_word, _oldWordNum, counts);
+    }
+    if (_oldWordNum != noWordNumHigh() && _wordNumMapper.map(_oldWordNum) >= _wordNumEnd) {
+        _oldWordNum = noWordNumHigh();
+        counts.clear();
+    }
     _oldposoccfile->readCounts(counts);
     if (_oldWordNum != noWordNumHigh()) {
         _wordNum = _wordNumMapper.map(_oldWordNum);
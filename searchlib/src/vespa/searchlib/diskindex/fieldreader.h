@@ -51,6 +51,8 @@ protected:
     uint32_t _residue;
     uint32_t _docIdLimit;
     vespalib::string _word;
+    uint64_t _wordNumBegin; // Skip words with lower (mapped) word number
+    uint64_t _wordNumEnd;   // Stop at words with this or higher (mapped) word number
 
     static uint64_t noWordNumHigh() {
         return std::numeric_limits<uint64_t>::max();
@@ -91,6 +93,17 @@ public:
     }
 
     virtual void setup(const WordNumMapping &wordNumMapping, const DocIdMapping &docIdMapping);
+
+    /*
+     * Limit reader to words with (mapped) word numbers in the range
+     * [begin, end), used when a field is merged in word range partitions.
+     * Posting lists for words before the range are skipped without being
+     * decoded.
+     */
+    void set_word_num_range(uint64_t begin, uint64_t end) {
+        _wordNumBegin = begin;
+        _wordNumEnd = end;
+    }
     virtual bool open(const vespalib::string &prefix, const TuneFileSeqRead &tuneFileRead);
     virtual bool close();
     virtual void setFeatureParams(const PostingListParams &params);
@@ -4,8 +4,10 @@
 #include "zcposocc.h"
 #include "extposocc.h"
 #include "pagedict4file.h"
+#include "bitvectordictionary.h"
 #include <vespa/vespalib/util/error.h>
 #include <filesystem>
+#include <limits>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".diskindex.fieldwriter");
@@ -20,6 +22,7 @@ using common::FileHeaderContext;
 FieldWriter::FieldWriter(uint32_t docIdLimit, uint64_t numWordIds, std::string_view prefix)
     : _dictFile(),
       _posoccfile(),
+      _first_align(),
       _bvc(docIdLimit),
       _bmapfile(BitVectorKeyScope::PERFIELD_WORDS),
       _prefix(prefix),
@@ -28,7 +31,8 @@ FieldWriter::FieldWriter(uint32_t docIdLimit, uint64_t numWordIds, std::string_v
       _compactWordNum(0),
       _wordNum(noWordNum()),
       _prevDocId(0),
-      _docIdLimit(docIdLimit)
+      _docIdLimit(docIdLimit),
+      _encode_block_max(false)
 {
 }
 
@@ -63,6 +67,9 @@ FieldWriter::open(uint32_t minSkipDocs,
     }
     if (encode_interleaved_features) {
         params.set("interleaved_features", encode_interleaved_features);
+        if (_encode_block_max) {
+            params.set("block_max", true);
+        }
     }
     
     _dictFile = std::make_unique<PageDict4FileSeqWrite>();
@@ -109,7 +116,7 @@ FieldWriter::flush()
     } else {
         assert(counts._bitLength == 0);
         assert(_bvc.empty());
-        assert(_compactWordNum == 0);
+        assert(_compactWordNum == 0 || _wordNum == noWordNum());
     }
 }
 
@@ -139,6 +146,7 @@ FieldWriter::close()
     flush();
     _wordNum = noWordNum();
     if (_posoccfile) {
+        _first_align = static_cast<Zc4PostingSeqWrite &>(*_posoccfile).get_first_align();
         bool closeRes = _posoccfile->close();
         if (!closeRes) {
             LOG(error, "Could not close posocc file for write");
@@ -159,6 +167,59 @@ FieldWriter::close()
     return ret;
 }
 
+bool
+FieldWriter::append(const vespalib::string &prefix, const Zc4PostingFirstAlign &first_align, const TuneFileSeqRead &tuneFileRead)
+{
+    flush();
+    _wordNum = noWordNum();
+    vespalib::string name = prefix + "posocc.dat.compressed";
+    int32_t pad_delta = 0;
+    if (!static_cast<Zc4PostingSeqWrite &>(*_posoccfile).append(name, first_align, tuneFileRead, pad_delta)) {
+        LOG(error, "Could not append posocc file %s", name.c_str());
+        return false;
+    }
+
+    PageDict4FileSeqRead dictFile;
+    vespalib::string cname = prefix + "dictionary";
+    if (!dictFile.open(cname, tuneFileRead)) {
+        LOG(error, "Could not open posocc count file %s for read", cname.c_str());
+        return false;
+    }
+    vespalib::string word;
+    uint64_t wordNum = noWordNum();
+    PostingListCounts counts;
+    uint64_t compactWordNumBase = _compactWordNum;
+    for (;;) {
+        dictFile.readWord(word, wordNum, counts);
+        if (wordNum == std::numeric_limits<uint64_t>::max()) {
+            break;
+        }
+        if (first_align._pos != 0 && _compactWordNum - compactWordNumBase == first_align._word_idx) {
+            counts._bitLength += pad_delta;
+            if (!counts._segments.empty()) {
+                counts._segments.front()._bitLength += pad_delta;
+            }
+        }
+        ++_compactWordNum;
+        _dictFile->writeWord(word, counts);
+    }
+    if (!dictFile.close()) {
+        LOG(error, "Could not close posocc count file %s for read", cname.c_str());
+        return false;
+    }
+
+    BitVectorDictionary bitVectorDict;
+    if (!bitVectorDict.open(prefix, TuneFileRandRead(), BitVectorKeyScope::PERFIELD_WORDS)) {
+        return false;
+    }
+    for (const auto &entry : bitVectorDict.getEntries()) {
+        auto bv = bitVectorDict.lookup(entry._wordNum);
+        assert(bv);
+        _bmapfile.addWordSingle(compactWordNumBase + entry._wordNum, *bv);
+    }
+    return true;
+}
+
 void
 FieldWriter::getFeatureParams(PostingListParams &params)
 {
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "bitvectorfile.h"
+#include "zc4_posting_writer_base.h"
 #include <vespa/searchlib/index/dictionaryfile.h>
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/posocccompression.h>
@@ -44,6 +45,13 @@ public:
 
     uint64_t getSparseWordNum() const { return _wordNum; }
 
+    /*
+     * Write block max info for posting lists with interleaved features.
+     * Older versions can not read posting lists with block max info.
+     * Must be set before open.
+     */
+    void set_encode_block_max(bool encode_block_max) { _encode_block_max = encode_block_max; }
+
     bool open(uint32_t minSkipDocs, uint32_t minChunkDocs,
               bool dynamicKPosOccFormat,
               bool encode_interleaved_features,
@@ -54,6 +62,17 @@ public:
 
     bool close();
 
+    /*
+     * Append the output of another field writer for a later word range,
+     * written with the same parameters to the given prefix. Used when a
+     * field is merged in word range partitions. No more words can be added
+     * after this.
+     */
+    bool append(const vespalib::string &prefix, const Zc4PostingFirstAlign &first_align, const TuneFileSeqRead &tuneFileRead);
+
+    // Location of first byte alignment in posting list file, valid after close.
+    const Zc4PostingFirstAlign &get_first_align() const { return _first_align; }
+
     void getFeatureParams(PostingListParams &params);
     static void remove(const vespalib::string &prefix);
 private:
@@ -62,6 +81,7 @@ private:
     using PostingListCounts = index::PostingListCounts;
     std::unique_ptr<DictionaryFileSeqWrite>  _dictFile;
     std::unique_ptr<PostingListFileSeqWrite> _posoccfile;
+    Zc4PostingFirstAlign    _first_align;
     BitVectorCandidate      _bvc;
     BitVectorFileWrite      _bmapfile;
     const vespalib::string  _prefix;
@@ -71,6 +91,7 @@ private:
     uint64_t                _wordNum;
     uint32_t                _prevDocId;
     const uint32_t          _docIdLimit;
+    bool                    _encode_block_max;
     void flush();
     static uint64_t noWordNum() { return 0u; }
 };
@@ -44,6 +44,15 @@ public:
     ~Fusion();
     void set_dynamic_k_pos_index_format(bool dynamic_k_pos_index_format) { _fusion_out_index.set_dynamic_k_pos_index_format(dynamic_k_pos_index_format); }
     void set_force_small_merge_chunk(bool force_small_merge_chunk) { _fusion_out_index.set_force_small_merge_chunk(force_small_merge_chunk); }
+    // Write block max info for fields with interleaved features, see FieldWriter.
+    void set_encode_block_max(bool encode_block_max) { _fusion_out_index.set_encode_block_max(encode_block_max); }
+    /*
+     * Fields with large posting list files are merged in up to max_field_partitions
+     * word range partitions in parallel, each covering at least min_field_partition_size
+     * bytes of input posting lists. Disabled by default (max_field_partitions = 1).
+     */
+    void set_max_field_partitions(uint32_t max_field_partitions) { _fusion_out_index.set_max_field_partitions(max_field_partitions); }
+    void set_min_field_partition_size(uint64_t min_field_partition_size) { _fusion_out_index.set_min_field_partition_size(min_field_partition_size); }
     bool merge(vespalib::Executor& shared_executor, std::shared_ptr<IFlushToken> flush_token);
 };
 
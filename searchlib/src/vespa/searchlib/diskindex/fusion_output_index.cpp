@@ -2,6 +2,7 @@
 
 #include "fusion_output_index.h"
 #include "fusion_input_index.h"
+#include <vespa/vespalib/util/size_literals.h>
 
 namespace search::diskindex {
 
@@ -12,6 +13,9 @@ FusionOutputIndex::FusionOutputIndex(const index::Schema& schema, const vespalib
       _doc_id_limit(doc_id_limit),
       _dynamic_k_pos_index_format(false),
       _force_small_merge_chunk(false),
+      _encode_block_max(false),
+      _max_field_partitions(1),
+      _min_field_partition_size(1_Gi),
       _tune_file_indexing(tune_file_indexing),
       _file_header_context(file_header_context)
 {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/string.h>
+#include <cstdint>
 #include <vector>
 
 namespace search         { class TuneFileIndexing; }
@@ -26,6 +27,9 @@ private:
     const uint32_t                       _doc_id_limit;
     bool                                 _dynamic_k_pos_index_format;
     bool                                 _force_small_merge_chunk;
+    bool                                 _encode_block_max;
+    uint32_t                             _max_field_partitions;
+    uint64_t                             _min_field_partition_size;
     const TuneFileIndexing&              _tune_file_indexing;
     const common::FileHeaderContext&     _file_header_context;
 public:
@@ -34,12 +38,18 @@ public:
 
     void set_dynamic_k_pos_index_format(bool dynamic_k_pos_index_format) { _dynamic_k_pos_index_format = dynamic_k_pos_index_format; }
     void set_force_small_merge_chunk(bool force_small_merge_chunk) { _force_small_merge_chunk = force_small_merge_chunk; }
+    void set_encode_block_max(bool encode_block_max) { _encode_block_max = encode_block_max; }
+    void set_max_field_partitions(uint32_t max_field_partitions) { _max_field_partitions = max_field_partitions; }
+    void set_min_field_partition_size(uint64_t min_field_partition_size) { _min_field_partition_size = min_field_partition_size; }
     const index::Schema& get_schema() const noexcept { return _schema; }
     const vespalib::string& get_path() const noexcept { return _path; }
     const std::vector<FusionInputIndex>& get_old_indexes() const noexcept { return _old_indexes; }
     uint32_t get_doc_id_limit() const noexcept { return _doc_id_limit; }
     bool get_dynamic_k_pos_index_format() const noexcept { return _dynamic_k_pos_index_format; }
     bool get_force_small_merge_chunk() const noexcept { return _force_small_merge_chunk; }
+    bool get_encode_block_max() const noexcept { return _encode_block_max; }
+    uint32_t get_max_field_partitions() const noexcept { return _max_field_partitions; }
+    uint64_t get_min_field_partition_size() const noexcept { return _min_field_partition_size; }
     const TuneFileIndexing& get_tune_file_indexing() const noexcept { return _tune_file_indexing; }
     const common::FileHeaderContext& get_file_header_context() const noexcept { return _file_header_context; }
 };
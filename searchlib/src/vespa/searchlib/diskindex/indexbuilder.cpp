@@ -42,6 +42,7 @@ public:
               const SchemaUtil::IndexIterator &index,
               uint32_t docIdLimit, uint64_t numWordIds,
               const FieldLengthInfo &field_length_info,
+              bool encode_block_max,
               const TuneFileSeqWrite &tuneFileWrite,
               const FileHeaderContext &fileHeaderContext);
 
@@ -143,12 +144,14 @@ FileHandle::open(std::string_view dir,
                  const SchemaUtil::IndexIterator &index,
                  uint32_t docIdLimit, uint64_t numWordIds,
                  const FieldLengthInfo &field_length_info,
+                 bool encode_block_max,
                  const TuneFileSeqWrite &tuneFileWrite,
                  const FileHeaderContext &fileHeaderContext)
 {
     assert( ! _fieldWriter);
 
     _fieldWriter = std::make_shared<FieldWriter>(docIdLimit, numWordIds, dir + "/");
+    _fieldWriter->set_encode_block_max(encode_block_max);
 
     if (!_fieldWriter->open(64, 262144u, false,
                             index.use_interleaved_features(),
@@ -187,7 +190,8 @@ FieldHandle::FieldHandle(const Schema &schema, uint32_t fieldId, IndexBuilder &b
 {
     std::filesystem::create_directory(std::filesystem::path(getDir()));
     _file.open(getDir(), SchemaUtil::IndexIterator(_schema, getIndexId()), docIdLimit, numWordIds,
-               field_length_inspector.get_field_length_info(getName()), tuneFileWrite, fileHeaderContext);
+               field_length_inspector.get_field_length_info(getName()), builder.get_encode_block_max(),
+               tuneFileWrite, fileHeaderContext);
 }
 
 FieldHandle::~FieldHandle() {
@@ -257,7 +261,8 @@ IndexBuilder::IndexBuilder(const Schema &schema, std::string_view prefix, uint32
       _numWordIds(numWordIds),
       _field_length_inspector(field_length_inspector),
       _tuneFileIndexing(tuneFileIndexing),
-      _fileHeaderContext(fileHeaderContext)
+      _fileHeaderContext(fileHeaderContext),
+      _encode_block_max(false)
 {
     if (!_prefix.empty()) {
         std::filesystem::create_directory(std::filesystem::path(_prefix));
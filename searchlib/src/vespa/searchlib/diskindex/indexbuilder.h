@@ -29,6 +29,9 @@ public:
 
     std::unique_ptr<index::FieldIndexBuilder> startField(uint32_t fieldId) override;
     vespalib::string appendToPrefix(std::string_view name) const;
+    // Write block max info for fields with interleaved features, see FieldWriter.
+    void set_encode_block_max(bool encode_block_max) { _encode_block_max = encode_block_max; }
+    bool get_encode_block_max() const noexcept { return _encode_block_max; }
 private:
     std::vector<int>          _fields;
     const vespalib::string    _prefix;
@@ -37,6 +40,7 @@ private:
     const index::IFieldLengthInspector       &_field_length_inspector;
     const TuneFileIndexing                   &_tuneFileIndexing;
     const search::common::FileHeaderContext  &_fileHeaderContext;
+    bool                                      _encode_block_max;
 
     static uint64_t noWordNumHigh() {
         return std::numeric_limits<uint64_t>::max();
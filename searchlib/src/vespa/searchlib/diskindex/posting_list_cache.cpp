@@ -0,0 +1,113 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "posting_list_cache.h"
+#include "decoded_posting_list.h"
+#include <vespa/vespalib/stllike/cache.hpp>
+
+namespace search::diskindex {
+
+namespace {
+
+struct PostingListKeySize {
+    size_t operator()(const PostingListCache::Key& key) const noexcept {
+        return sizeof(PostingListCache::Key) + key.counts._segments.capacity() * sizeof(index::PostingListCounts::Segment);
+    }
+};
+
+struct DecodedPostingListSize {
+    size_t operator()(const std::shared_ptr<const DecodedPostingList>& list) const noexcept {
+        return list ? list->memory_usage() : 0;
+    }
+};
+
+class PostingListStore {
+    const PostingListCache::BackingStore& _backing_store;
+    size_t                                _max_entry_bytes;
+public:
+    PostingListStore(const PostingListCache::BackingStore& backing_store, size_t max_entry_bytes) noexcept
+        : _backing_store(backing_store),
+          _max_entry_bytes(max_entry_bytes)
+    { }
+    bool read(const PostingListCache::Key& key, std::shared_ptr<const DecodedPostingList>& value) const {
+        value = _backing_store.read_uncached_posting_list(key, _max_entry_bytes);
+        return static_cast<bool>(value);
+    }
+    void write(const PostingListCache::Key&, const std::shared_ptr<const DecodedPostingList>&) { }
+    void erase(const PostingListCache::Key&) { }
+};
+
+using PostingListCacheParam = vespalib::CacheParam<vespalib::LruParam<PostingListCache::Key,
+                                                                      std::shared_ptr<const DecodedPostingList>>,
+                                                   PostingListStore,
+                                                   PostingListKeySize,
+                                                   DecodedPostingListSize>;
+
+}
+
+PostingListCache::Key::Key() noexcept
+    : field_id(0),
+      word_num(0),
+      bit_offset(0),
+      counts()
+{
+}
+
+PostingListCache::Key::Key(uint32_t field_id_in, uint64_t word_num_in, uint64_t bit_offset_in,
+                           const index::PostingListCounts& counts_in)
+    : field_id(field_id_in),
+      word_num(word_num_in),
+      bit_offset(bit_offset_in),
+      counts(counts_in)
+{
+}
+
+PostingListCache::Key::Key(const Key&) = default;
+PostingListCache::Key& PostingListCache::Key::operator=(const Key&) = default;
+PostingListCache::Key::Key(Key&&) noexcept = default;
+PostingListCache::Key& PostingListCache::Key::operator=(Key&&) noexcept = default;
+PostingListCache::Key::~Key() = default;
+
+class PostingListCache::Shard {
+    PostingListStore                       _store;
+    vespalib::cache<PostingListCacheParam> _cache;
+public:
+    Shard(const BackingStore& backing_store, size_t max_bytes, size_t max_entry_bytes)
+        : _store(backing_store, max_entry_bytes),
+          _cache(_store, max_bytes)
+    { }
+    std::shared_ptr<const DecodedPostingList> read(const Key& key) { return _cache.read(key); }
+    vespalib::CacheStats get_stats() const { return _cache.get_stats(); }
+};
+
+PostingListCache::PostingListCache(const BackingStore& backing_store, size_t max_bytes)
+    : _shards(),
+      _max_entry_bytes(max_bytes / num_shards / 4)
+{
+    _shards.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) {
+        _shards.emplace_back(std::make_unique<Shard>(backing_store, max_bytes / num_shards, _max_entry_bytes));
+    }
+}
+
+PostingListCache::~PostingListCache() = default;
+
+std::shared_ptr<const DecodedPostingList>
+PostingListCache::read(const Key& key)
+{
+    if (DecodedPostingList::min_memory_usage(key.counts._numDocs) > _max_entry_bytes) {
+        return {};
+    }
+    return _shards[key.hash() % num_shards]->read(key);
+}
+
+vespalib::CacheStats
+PostingListCache::get_stats() const
+{
+    vespalib::CacheStats stats;
+    for (const auto& shard : _shards) {
+        stats += shard->get_stats();
+    }
+    return stats;
+}
+
+}
@@ -0,0 +1,79 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/index/postinglistcounts.h>
+#include <vespa/vespalib/stllike/cache_stats.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace search::diskindex {
+
+class DecodedPostingList;
+
+/**
+ * Cache of decoded posting lists read from a disk index, keyed by field id
+ * and word number and bounded by the memory used by the decoded posting
+ * lists.
+ *
+ * Posting lists using more than a quarter of a cache shard are not cached,
+ * and the caller should iterate the compressed posting list instead. This
+ * keeps a single head term from flushing the rest of its shard.
+ *
+ * The cache is split into shards (selected by key hash) to reduce lock
+ * contention between concurrent queries.
+ */
+class PostingListCache {
+public:
+    /**
+     * Cache key. Only field id and word number identify the posting list,
+     * the remaining members are the dictionary lookup result needed to read
+     * the posting list on cache miss.
+     */
+    struct Key {
+        uint32_t                 field_id;
+        uint64_t                 word_num;
+        uint64_t                 bit_offset;
+        index::PostingListCounts counts;
+
+        Key() noexcept;
+        Key(uint32_t field_id_in, uint64_t word_num_in, uint64_t bit_offset_in, const index::PostingListCounts& counts_in);
+        Key(const Key&);
+        Key& operator=(const Key&);
+        Key(Key&&) noexcept;
+        Key& operator=(Key&&) noexcept;
+        ~Key();
+        size_t hash() const noexcept { return (word_num * 0x9e3779b97f4a7c15ul) ^ field_id; }
+        bool operator==(const Key& rhs) const noexcept {
+            return field_id == rhs.field_id && word_num == rhs.word_num;
+        }
+    };
+
+    /**
+     * Interface used to read and decode posting lists on cache miss.
+     */
+    class BackingStore {
+    public:
+        virtual ~BackingStore() = default;
+        virtual std::shared_ptr<const DecodedPostingList> read_uncached_posting_list(const Key& key, size_t max_bytes) const = 0;
+    };
+
+    static constexpr size_t num_shards = 16;
+
+    PostingListCache(const BackingStore& backing_store, size_t max_bytes);
+    ~PostingListCache();
+    /*
+     * Returns nullptr if the posting list is too large to be cached.
+     */
+    std::shared_ptr<const DecodedPostingList> read(const Key& key);
+    vespalib::CacheStats get_stats() const;
+    size_t max_entry_bytes() const noexcept { return _max_entry_bytes; }
+private:
+    class Shard;
+
+    std::vector<std::unique_ptr<Shard>> _shards;
+    size_t                              _max_entry_bytes;
+};
+
+}
@@ -22,6 +22,7 @@ struct Zc4PostingHeader {
     uint32_t _l2_skip_size;
     uint32_t _l3_skip_size;
     uint32_t _l4_skip_size;
+    uint32_t _block_max_size;
     uint64_t _features_size;
     uint32_t _last_doc_id;
 
@@ -175,6 +175,53 @@ Zc4PostingReaderBase::L4Skip::check(const L3Skip &l3_skip, bool decode_features)
     assert(_l3_skip_pos == l3_skip.get_l3_skip_pos());
 }
 
+Zc4PostingReaderBase::BlockMax::BlockMax()
+    : _zc_buf(),
+      _doc_id(0),
+      _max_num_occs(0),
+      _min_field_length(0)
+{
+}
+
+Zc4PostingReaderBase::BlockMax::~BlockMax() = default;
+
+void
+Zc4PostingReaderBase::BlockMax::next_block()
+{
+    _doc_id += (_zc_buf.decode() + 1);
+    _max_num_occs = _zc_buf.decode() + 1;
+    _min_field_length = _zc_buf.decode() + 1;
+}
+
+void
+Zc4PostingReaderBase::BlockMax::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id)
+{
+    assert(size != 0);
+    _zc_buf.clearReserve(size);
+    decode_context.readBytes(_zc_buf._valI, size);
+    _zc_buf._valE = _zc_buf._valI + size;
+    _doc_id = doc_id;
+    next_block();
+}
+
+void
+Zc4PostingReaderBase::BlockMax::check(const NoSkip &no_skip)
+{
+    assert(no_skip.get_doc_id() <= _doc_id);
+    assert(no_skip.get_num_occs() <= _max_num_occs);
+    assert(no_skip.get_field_length() >= _min_field_length);
+    if (no_skip.get_doc_id() == _doc_id && _zc_buf._valI < _zc_buf._valE) {
+        next_block();
+    }
+}
+
+void
+Zc4PostingReaderBase::BlockMax::check_end(uint32_t last_doc_id)
+{
+    assert(_doc_id == last_doc_id);
+    assert(_zc_buf._valI == _zc_buf._valE);
+}
+
 Zc4PostingReaderBase::Zc4PostingReaderBase(bool dynamic_k)
     : _doc_id_k(K_VALUE_ZCPOSTING_DELTA_DOCID),
       _num_docs(0),
@@ -187,6 +234,7 @@ Zc4PostingReaderBase::Zc4PostingReaderBase(bool dynamic_k)
       _l2_skip(),
       _l3_skip(),
       _l4_skip(),
+      _block_max(),
       _chunkNo(0),
       _features_size(0),
       _counts(),
@@ -220,12 +268,18 @@ Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_contex
         _l1_skip.next_skip_entry();
     }
     _no_skip.read(_posting_params._encode_interleaved_features);
+    if (_posting_params._encode_block_max) {
+        _block_max.check(_no_skip);
+    }
     if (_residue == 1) {
         _no_skip.check_end(_last_doc_id);
         _l1_skip.check_end(_last_doc_id);
         _l2_skip.check_end(_last_doc_id);
         _l3_skip.check_end(_last_doc_id);
         _l4_skip.check_end(_last_doc_id);
+        if (_posting_params._encode_block_max) {
+            _block_max.check_end(_last_doc_id);
+        }
     } else {
         _no_skip.check_not_end(_last_doc_id);
     }
@@ -253,6 +307,9 @@ Zc4PostingReaderBase::read_word_start_with_skip(DecodeContext64Base &decode_cont
     _l2_skip.setup(decode_context, header._l2_skip_size, prev_doc_id, _last_doc_id);
     _l3_skip.setup(decode_context, header._l3_skip_size, prev_doc_id, _last_doc_id);
     _l4_skip.setup(decode_context, header._l4_skip_size, prev_doc_id, _last_doc_id);
+    if (_posting_params._encode_block_max) {
+        _block_max.setup(decode_context, header._block_max_size, prev_doc_id);
+    }
     if (_has_more || has_more) {
         assert(_last_doc_id == _counts._segments[_chunkNo]._lastDoc);
     }
@@ -60,6 +60,7 @@ Zc4PostingWriter<bigEndian>::flush_word_with_skip(bool hasMore)
     uint32_t l2SkipSize = _l2Skip.size();
     uint32_t l3SkipSize = _l3Skip.size();
     uint32_t l4SkipSize = _l4Skip.size();
+    uint32_t blockMaxSize = _blockMax.size();
 
     e.encodeExpGolomb(docIdsSize - 1, K_VALUE_ZCPOSTING_DOCIDSSIZE);
     e.encodeExpGolomb(l1SkipSize, K_VALUE_ZCPOSTING_L1SKIPSIZE);
@@ -72,6 +73,9 @@ Zc4PostingWriter<bigEndian>::flush_word_with_skip(bool hasMore)
             }
         }
     }
+    if (_encode_block_max) {
+        e.encodeExpGolomb(blockMaxSize, K_VALUE_ZCPOSTING_BLOCKMAXSIZE);
+    }
     if (_encode_features != nullptr) {
         e.encodeExpGolomb(_featureOffset, K_VALUE_ZCPOSTING_FEATURESSIZE);
     }
@@ -89,6 +93,11 @@ Zc4PostingWriter<bigEndian>::flush_word_with_skip(bool hasMore)
                           K_VALUE_ZCPOSTING_LASTDOCID);
     }
 
+    if (_first_align._pos == 0) {
+        _first_align._pos = e.getWriteOffset();
+        _first_align._pad = (- _first_align._pos) & 7;
+        _first_align._word_idx = _numWords;
+    }
     e.smallAlign(8);    // Byte align
 
     uint8_t *docIds = _zcDocIds._mallocStart;
@@ -119,6 +128,12 @@ Zc4PostingWriter<bigEndian>::flush_word_with_skip(bool hasMore)
                     0,
                     l4SkipSize * 8);
     }
+    if (blockMaxSize > 0) {
+        uint8_t *blockMax = _blockMax._mallocStart;
+        e.writeBits(reinterpret_cast<const uint64_t *>(blockMax),
+                    0,
+                    blockMaxSize * 8);
+    }
 
     // Write features
     e.writeBits(_featureWriteContext.getComprBuf(), 0, _featureOffset);
@@ -240,9 +255,18 @@ void
 Zc4PostingWriter<bigEndian>::on_open()
 {
     _numWords = 0;
+    _first_align = Zc4PostingFirstAlign();
     _writePos = _encode_context.getWriteOffset(); // Position after file header 
 }
 
+template <bool bigEndian>
+void
+Zc4PostingWriter<bigEndian>::on_append(uint64_t num_words)
+{
+    _numWords += num_words;
+    _writePos = _encode_context.getWriteOffset();
+}
+
 template <bool bigEndian>
 void
 Zc4PostingWriter<bigEndian>::on_close()
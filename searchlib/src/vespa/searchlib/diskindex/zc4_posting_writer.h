@@ -42,6 +42,7 @@ public:
     void write_docid_and_features(const index::DocIdAndFeatures &features);
     void set_encode_features(EncodeContext *encode_features);
     void on_open();
+    void on_append(uint64_t num_words);
     void on_close();
 
     EncodeContext &get_encode_features() { return *_encode_features; }
@@ -3,7 +3,9 @@
 #include "zc4_posting_writer_base.h"
 #include <vespa/searchlib/index/postinglistcounts.h>
 #include <vespa/searchlib/index/postinglistparams.h>
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 using search::index::PostingListCounts;
 using search::index::PostingListParams;
@@ -208,12 +210,15 @@ Zc4PostingWriterBase::Zc4PostingWriterBase(PostingListCounts &counts)
       _writePos(0),
       _dynamicK(false),
       _encode_interleaved_features(false),
+      _encode_block_max(false),
       _zcDocIds(),
       _l1Skip(),
       _l2Skip(),
       _l3Skip(),
       _l4Skip(),
+      _blockMax(),
       _numWords(0),
+      _first_align(),
       _counts(counts),
       _writeContext(sizeof(uint64_t)),
       _featureWriteContext(sizeof(uint64_t))
@@ -225,6 +230,7 @@ Zc4PostingWriterBase::Zc4PostingWriterBase(PostingListCounts &counts)
     _l2Skip.maybeExpand();
     _l3Skip.maybeExpand();
     _l4Skip.maybeExpand();
+    _blockMax.maybeExpand();
 }
 
 Zc4PostingWriterBase::~Zc4PostingWriterBase() = default;
@@ -233,6 +239,7 @@ Zc4PostingWriterBase::~Zc4PostingWriterBase() = default;
 #define L2SKIPSTRIDE 8
 #define L3SKIPSTRIDE 8
 #define L4SKIPSTRIDE 8
+#define BLOCKMAXSTRIDE 64
 
 void
 Zc4PostingWriterBase::calc_skip_info(bool encode_features)
@@ -271,6 +278,36 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
     l2_skip_encoder.write_partial_skip(_l2Skip, doc_id_encoder.get_doc_id());
     l3_skip_encoder.write_partial_skip(_l3Skip, doc_id_encoder.get_doc_id());
     l4_skip_encoder.write_partial_skip(_l4Skip, doc_id_encoder.get_doc_id());
+    if (_encode_block_max) {
+        calc_block_max_info();
+    }
+}
+
+void
+Zc4PostingWriterBase::calc_block_max_info()
+{
+    uint32_t prev_doc_id = _counts._segments.empty() ? 0u : _counts._segments.back()._lastDoc;
+    uint32_t max_num_occs = 0;
+    uint32_t min_field_length = std::numeric_limits<uint32_t>::max();
+    uint32_t block_docs = 0;
+    uint32_t docs_left = _docIds.size();
+    for (const auto &doc_id_and_feature_size : _docIds) {
+        max_num_occs = std::max(max_num_occs, doc_id_and_feature_size._num_occs);
+        min_field_length = std::min(min_field_length, doc_id_and_feature_size._field_length);
+        --docs_left;
+        if (++block_docs >= BLOCKMAXSTRIDE || docs_left == 0) {
+            // Last document id in block, max num occs and min field length
+            uint32_t doc_id = doc_id_and_feature_size._doc_id;
+            assert(max_num_occs > 0 && min_field_length > 0);
+            _blockMax.encode(doc_id - prev_doc_id - 1);
+            _blockMax.encode(max_num_occs - 1);
+            _blockMax.encode(min_field_length - 1);
+            prev_doc_id = doc_id;
+            max_num_occs = 0;
+            min_field_length = std::numeric_limits<uint32_t>::max();
+            block_docs = 0;
+        }
+    }
 }
 
 void
@@ -281,6 +318,7 @@ Zc4PostingWriterBase::clear_skip_info()
     _l2Skip.clear();
     _l3Skip.clear();
     _l4Skip.clear();
+    _blockMax.clear();
 }
 
 void
@@ -290,6 +328,9 @@ Zc4PostingWriterBase::set_posting_list_params(const PostingListParams &params)
     params.get("minChunkDocs", _minChunkDocs);
     params.get("minSkipDocs", _minSkipDocs);
     params.get("interleaved_features", _encode_interleaved_features);
+    params.get("block_max", _encode_block_max);
+    // Block max info is derived from interleaved features
+    _encode_block_max = _encode_block_max && _encode_interleaved_features;
 }
 
 }
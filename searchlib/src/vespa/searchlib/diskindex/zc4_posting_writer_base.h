@@ -13,8 +13,31 @@ class PostingListParams;
 
 namespace search::diskindex {
 
+/*
+ * Location of the first byte alignment padding in a posting list file.
+ * The padding depends on the file position, thus it must be adjusted
+ * when the posting lists are appended to another posting list file.
+ */
+struct Zc4PostingFirstAlign {
+    uint64_t _pos;      // Bit position before padding, 0 if no padding
+    uint32_t _pad;      // Number of padding bits
+    uint64_t _word_idx; // Index of word with padding
+
+    Zc4PostingFirstAlign() noexcept
+        : _pos(0),
+          _pad(0),
+          _word_idx(0)
+    {
+    }
+};
+
 /*
  * Base class for writing posting lists that might have basic skip info.
+ *
+ * When block max info is enabled (requires interleaved features), each
+ * chunk with skip info also gets a table with one entry per block of
+ * documents, containing the last document id in the block, the max
+ * number of occurrences and the min field length within the block.
  */
 class Zc4PostingWriterBase
 {
@@ -44,13 +67,16 @@ protected:
     uint64_t _writePos; // Bit position for start of current word
     bool _dynamicK;     // Caclulate EG compression parameters ?
     bool _encode_interleaved_features;
+    bool _encode_block_max;
     ZcBuf _zcDocIds;    // Document id deltas
     ZcBuf _l1Skip;      // L1 skip info
     ZcBuf _l2Skip;      // L2 skip info
     ZcBuf _l3Skip;      // L3 skip info
     ZcBuf _l4Skip;      // L4 skip info
+    ZcBuf _blockMax;    // Block max info
 
     uint64_t _numWords; // Number of words in file
+    Zc4PostingFirstAlign _first_align;
     index::PostingListCounts &_counts;
     search::ComprFileWriteContext _writeContext;
     search::ComprFileWriteContext _featureWriteContext;
@@ -62,6 +88,7 @@ protected:
     Zc4PostingWriterBase(index::PostingListCounts &counts);
     ~Zc4PostingWriterBase();
     void calc_skip_info(bool encode_features);
+    void calc_block_max_info();
     void clear_skip_info();
 
 public:
@@ -71,8 +98,10 @@ public:
     uint32_t get_min_skip_docs() const { return _minSkipDocs; }
     uint32_t get_docid_limit() const { return _docIdLimit; }
     uint64_t get_num_words() const { return _numWords; }
+    const Zc4PostingFirstAlign &get_first_align() const { return _first_align; }
     bool get_dynamic_k() const { return _dynamicK; }
     bool get_encode_interleaved_features() const { return _encode_interleaved_features; }
+    bool get_encode_block_max() const { return _encode_block_max; }
     void set_dynamic_k(bool dynamicK) { _dynamicK = dynamicK; }
     void set_encode_interleaved_features(bool encode_interleaved_features) { _encode_interleaved_features = encode_interleaved_features; }
     void set_posting_list_params(const index::PostingListParams &params);
@@ -34,13 +34,13 @@ ZcRareWordPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit
 template <bool bigEndian, bool dynamic_k>
 ZcPosOccIterator<bigEndian, dynamic_k>::
 ZcPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
-                 bool decode_normal_features, bool decode_interleaved_features,
+                 bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
                  bool unpack_normal_features, bool unpack_interleaved_features,
                  uint32_t minChunkDocs, const PostingListCounts &counts,
                  const PosOccFieldsParams *fieldsParams,
                  TermFieldMatchDataArray matchData)
     : ZcPostingIterator<bigEndian>(minChunkDocs, dynamic_k, counts, std::move(matchData), start, docIdLimit,
-                                   decode_normal_features, decode_interleaved_features,
+                                   decode_normal_features, decode_interleaved_features, decode_block_max,
                                    unpack_normal_features, unpack_interleaved_features),
       _decodeContextReal(start.getOccurences(), start.getBitOffset(), bitLength, fieldsParams)
 {
@@ -75,12 +75,14 @@ create_zc_posocc_iterator(const PostingListCounts &counts, bitcompression::Posit
     } else {
         if (posting_params._dynamic_k) {
             return std::make_unique<ZcPosOccIterator<bigEndian, true>>(start, bit_length, posting_params._doc_id_limit,
-                    posting_params._encode_features, posting_params._encode_interleaved_features, unpack_normal_features,
-                    unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, std::move(match_data));
+                    posting_params._encode_features, posting_params._encode_interleaved_features, posting_params._encode_block_max,
+                    unpack_normal_features, unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params,
+                    std::move(match_data));
         } else {
             return std::make_unique<ZcPosOccIterator<bigEndian, false>>(start, bit_length, posting_params._doc_id_limit,
-                    posting_params._encode_features, posting_params._encode_interleaved_features, unpack_normal_features,
-                    unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, std::move(match_data));
+                    posting_params._encode_features, posting_params._encode_interleaved_features, posting_params._encode_block_max,
+                    unpack_normal_features, unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params,
+                    std::move(match_data));
         }
     }
 }
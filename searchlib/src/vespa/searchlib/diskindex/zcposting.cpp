@@ -18,6 +18,22 @@ namespace {
 vespalib::string myId5("Zc.5");
 vespalib::string myId4("Zc.4");
 vespalib::string interleaved_features("interleaved_features");
+vespalib::string block_max("block_max");
+
+template <typename DecodeContext, typename EncodeContext>
+void
+copy_bits(DecodeContext &d, EncodeContext &e, uint64_t bits)
+{
+    while (bits >= 64) {
+        e.writeBits(d.readBits(64), 64);
+        e.writeComprBufferIfNeeded();
+        bits -= 64;
+    }
+    if (bits > 0) {
+        e.writeBits(d.readBits(bits), bits);
+        e.writeComprBufferIfNeeded();
+    }
+}
 
 }
 
@@ -26,6 +42,7 @@ namespace search::diskindex {
 using index::PostingListCountFileSeqRead;
 using index::PostingListCountFileSeqWrite;
 using common::FileHeaderContext;
+using bitcompression::DecodeContext64BE;
 using bitcompression::FeatureDecodeContextBE;
 using bitcompression::FeatureEncodeContextBE;
 using vespalib::getLastErrorString;
@@ -62,6 +79,18 @@ Zc4PostingSeqRead::readCounts(const PostingListCounts &counts)
     _reader.set_counts(counts);
 }
 
+void
+Zc4PostingSeqRead::skipWord(const PostingListCounts &counts)
+{
+    // Previous word has been read, thus posting list for word starts at current position
+    auto &readContext = _reader.get_read_context();
+    auto &d = _reader.get_decode_features();
+    readContext.setPosition(d.getReadOffset() + counts._bitLength);
+    if (d._valI >= d._valE) {
+        readContext.readComprBuffer();
+    }
+}
+
 
 bool
 Zc4PostingSeqRead::open(const vespalib::string &name,
@@ -122,6 +151,7 @@ Zc4PostingSeqRead::getParams(PostingListParams &params)
     }
     params.set("minSkipDocs", _reader.get_posting_params()._min_skip_docs);
     params.set(interleaved_features, _reader.get_posting_params()._encode_interleaved_features);
+    params.set(block_max, _reader.get_posting_params()._encode_block_max);
 }
 
 
@@ -168,6 +198,9 @@ Zc4PostingSeqRead::readHeader()
     if (header.hasTag(interleaved_features) && (header.getTag(interleaved_features).asInteger() != 0)) {
        posting_params._encode_interleaved_features = true;
     }
+    if (header.hasTag(block_max) && (header.getTag(block_max).asInteger() != 0)) {
+       posting_params._encode_block_max = true;
+    }
     assert(header.getTag("endian").asString() == "big");
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
@@ -235,6 +268,7 @@ Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
     header.putTag(Tag("format.0", myId));
     header.putTag(Tag("format.1", f.getIdentifier()));
     header.putTag(Tag("interleaved_features", _writer.get_encode_interleaved_features() ? 1 : 0));
+    header.putTag(Tag("block_max", _writer.get_encode_block_max() ? 1 : 0));
     header.putTag(Tag("numWords", 0));
     header.putTag(Tag("minChunkDocs", _writer.get_min_chunk_docs()));
     header.putTag(Tag("docIdLimit", _writer.get_docid_limit()));
@@ -324,6 +358,61 @@ Zc4PostingSeqWrite::close()
     return success;
 }
 
+bool
+Zc4PostingSeqWrite::append(const vespalib::string &name, const Zc4PostingFirstAlign &first_align,
+                           const TuneFileSeqRead &tuneFileRead, int32_t &pad_delta)
+{
+    FastOS_File file;
+    if (tuneFileRead.getWantDirectIO()) {
+        file.EnableDirectIO();
+    }
+    if (!file.OpenReadOnly(name.c_str())) {
+        LOG(error, "could not open %s: %s", file.GetFileName(), getLastErrorString().c_str());
+        return false;
+    }
+    DecodeContext64BE d;
+    ComprFileReadContext readContext(d);
+    d.setReadContext(&readContext);
+    readContext.setFile(&file);
+    readContext.setFileSize(file.getSize());
+    readContext.allocComprBuf(65536u, 32768u);
+    d.emptyBuffer(0);
+    readContext.readComprBuffer();
+
+    vespalib::FileHeader header;
+    d.readHeader(header, file.getSize());
+    uint32_t headerLen = header.getSize();
+    headerLen += (-headerLen & 7);
+    assert(header.getTag("frozen").asInteger() != 0);
+    assert(header.getTag("minChunkDocs").asInteger() == _writer.get_min_chunk_docs());
+    assert(header.getTag("docIdLimit").asInteger() == _writer.get_docid_limit());
+    assert(header.getTag("minSkipDocs").asInteger() == _writer.get_min_skip_docs());
+    uint64_t fileBitSize = header.getTag("fileBitSize").asInteger();
+    uint64_t numWords = header.getTag("numWords").asInteger();
+    d.smallAlign(64);
+    assert(d.getReadOffset() == headerLen * 8);
+    if (d._valI >= d._valE) {
+        readContext.readComprBuffer();
+    }
+
+    EncodeContext &e = _writer.get_encode_context();
+    pad_delta = 0;
+    if (first_align._pos != 0) {
+        copy_bits(d, e, first_align._pos - d.getReadOffset());
+        if (first_align._pad != 0) {
+            (void) d.readBits(first_align._pad);
+        }
+        uint32_t pad = (- e.getWriteOffset()) & 7;
+        e.smallPadBits(pad);
+        pad_delta = static_cast<int32_t>(pad) - static_cast<int32_t>(first_align._pad);
+    }
+    copy_bits(d, e, fileBitSize - d.getReadOffset());
+    _writer.on_append(numWords);
+    readContext.dropComprBuf();
+    readContext.setFile(nullptr);
+    return file.Close();
+}
+
 void
 Zc4PostingSeqWrite::
 setParams(const PostingListParams &params)
@@ -356,6 +445,7 @@ getParams(PostingListParams &params)
     }
     params.set("minSkipDocs", _writer.get_min_skip_docs());
     params.set(interleaved_features, _writer.get_encode_interleaved_features());
+    params.set(block_max, _writer.get_encode_block_max());
 }
 
 
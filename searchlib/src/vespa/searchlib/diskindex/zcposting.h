@@ -38,6 +38,7 @@ public:
 
     void readDocIdAndFeatures(DocIdAndFeatures &features) override;
     void readCounts(const PostingListCounts &counts) override; // Fill in for next word
+    void skipWord(const PostingListCounts &counts) override;
     bool open(const vespalib::string &name, const TuneFileSeqRead &tuneFileRead) override;
     bool close() override;
     void getParams(PostingListParams &params) override;
@@ -80,6 +81,16 @@ public:
               const search::common::FileHeaderContext &fileHeaderContext) override;
 
     bool close() override;
+
+    /**
+     * Append the posting lists in another posting list file written with
+     * the same parameters. The padding at the first byte alignment in the
+     * other file is adjusted to the new file position, and pad_delta is set
+     * to the change in size for the posting list containing the padding.
+     */
+    bool append(const vespalib::string &name, const Zc4PostingFirstAlign &first_align,
+                const TuneFileSeqRead &tuneFileRead, int32_t &pad_delta);
+    const Zc4PostingFirstAlign &get_first_align() const { return _writer.get_first_align(); }
     void setParams(const PostingListParams &params) override;
     void getParams(PostingListParams &params) override;
     void setFeatureParams(const PostingListParams &params) override;
@@ -190,8 +190,10 @@ ZcRareWordPostingIterator<bigEndian, dynamic_k>::readWordStart(uint32_t docIdLim
 
 ZcPostingIteratorBase::ZcPostingIteratorBase(TermFieldMatchDataArray matchData, Position start, uint32_t docIdLimit,
                                              bool decode_normal_features, bool decode_interleaved_features,
+                                             bool decode_block_max,
                                              bool unpack_normal_features, bool unpack_interleaved_features)
     : ZcIteratorBase(std::move(matchData), start, docIdLimit),
+      BlockMaxInfo(),
       _valI(nullptr),
       _valIBase(nullptr),
       _featureSeekPos(0),
@@ -200,10 +202,12 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(TermFieldMatchDataArray matchData,
       _l3(),
       _l4(),
       _chunk(),
+      _block_max(),
       _featuresSize(0),
       _hasMore(false),
       _decode_normal_features(decode_normal_features),
       _decode_interleaved_features(decode_interleaved_features),
+      _decode_block_max(decode_block_max),
       _unpack_normal_features(unpack_normal_features),
       _unpack_interleaved_features(unpack_interleaved_features),
       _chunkNo(0),
@@ -220,9 +224,11 @@ ZcPostingIterator(uint32_t minChunkDocs,
                   search::fef::TermFieldMatchDataArray matchData,
                   Position start, uint32_t docIdLimit,
                   bool decode_normal_features, bool decode_interleaved_features,
+                  bool decode_block_max,
                   bool unpack_normal_features, bool unpack_interleaved_features)
     : ZcPostingIteratorBase(std::move(matchData), start, docIdLimit,
                             decode_normal_features, decode_interleaved_features,
+                            decode_block_max,
                             unpack_normal_features, unpack_interleaved_features),
       _decodeContext(nullptr),
       _minChunkDocs(minChunkDocs),
@@ -284,6 +290,11 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
         UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_L4SKIPSIZE, EC);
         l4SkipSize = val64;
     }
+    uint32_t blockMaxSize = 0;
+    if (_decode_block_max) {
+        UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_BLOCKMAXSIZE, EC);
+        blockMaxSize = val64;
+    }
     if (_decode_normal_features) {
         UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_FEATURESSIZE, EC);
         _featuresSize = val64;
@@ -315,6 +326,7 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     _l2.setup(prevDocId, _chunk._lastDocId, bcompr, l2SkipSize);
     _l3.setup(prevDocId, _chunk._lastDocId, bcompr, l3SkipSize);
     _l4.setup(prevDocId, _chunk._lastDocId, bcompr, l4SkipSize);
+    _block_max.setup(prevDocId, bcompr, blockMaxSize);
     _l1.postSetup(*this);
     _l2.postSetup(_l1);
     _l3.postSetup(_l2);
@@ -575,6 +587,19 @@ ZcPostingIteratorBase::doSeek(uint32_t docId)
 }
 
 
+bool
+ZcPostingIteratorBase::find_block(uint32_t docId, Block &block)
+{
+    if (!_decode_block_max || docId > _chunk._lastDocId || !_block_max.seek(docId)) {
+        return false;
+    }
+    block.last_doc_id = _block_max._lastDocId;
+    block.max_num_occs = _block_max._maxNumOccs;
+    block.min_field_length = _block_max._minFieldLength;
+    return true;
+}
+
+
 template <bool bigEndian>
 void
 ZcPostingIterator<bigEndian>::doUnpack(uint32_t docId)
@@ -4,6 +4,7 @@
 
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/compression.h>
+#include <vespa/searchlib/queryeval/block_max_info.h>
 #include <vespa/searchlib/queryeval/iterators.h>
 
 namespace search::diskindex {
@@ -134,7 +135,8 @@ public:
     void readWordStart(uint32_t docIdLimit) override;
 };
 
-class ZcPostingIteratorBase : public ZcIteratorBase
+class ZcPostingIteratorBase : public ZcIteratorBase,
+                              public queryeval::BlockMaxInfo
 {
 protected:
     const uint8_t *_valI;     // docid deltas
@@ -267,15 +269,60 @@ protected:
         }
     };
 
+    // Helper class for block max info
+    class BlockMax {
+    public:
+        const uint8_t *_valI;
+        const uint8_t *_valE;
+        uint32_t _lastDocId;      // Last document in current block
+        uint32_t _maxNumOccs;
+        uint32_t _minFieldLength;
+
+        BlockMax()
+            : _valI(nullptr),
+              _valE(nullptr),
+              _lastDocId(0),
+              _maxNumOccs(0),
+              _minFieldLength(0)
+        {
+        }
+
+        void setup(uint32_t prevDocId, const uint8_t *&bcompr, uint32_t size) {
+            _valI = bcompr;
+            bcompr += size;
+            _valE = bcompr;
+            _lastDocId = prevDocId;
+            if (size != 0) {
+                nextBlock();
+            }
+        }
+        void nextBlock() {
+            ZCDECODE(_valI, _lastDocId += 1 +);
+            ZCDECODE(_valI, _maxNumOccs = 1 +);
+            ZCDECODE(_valI, _minFieldLength = 1 +);
+        }
+        bool seek(uint32_t docId) {
+            while (__builtin_expect(docId > _lastDocId, false)) {
+                if (_valI >= _valE) {
+                    return false;
+                }
+                nextBlock();
+            }
+            return true;
+        }
+    };
+
     L1Skip _l1;
     L2Skip _l2;
     L3Skip _l3;
     L4Skip _l4;
     ChunkSkip _chunk;
+    BlockMax _block_max;
     uint64_t _featuresSize;
     bool     _hasMore;
     bool     _decode_normal_features;
     bool     _decode_interleaved_features;
+    bool     _decode_block_max;
     bool     _unpack_normal_features;
     bool     _unpack_interleaved_features;
     uint32_t _chunkNo;
@@ -300,8 +347,10 @@ protected:
     void doSeek(uint32_t docId) override;
 public:
     ZcPostingIteratorBase(fef::TermFieldMatchDataArray matchData, Position start, uint32_t docIdLimit,
-                          bool decode_normal_features, bool decode_interleaved_features,
+                          bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
                           bool unpack_normal_features, bool unpack_interleaved_features);
+    queryeval::BlockMaxInfo *as_block_max_info() noexcept override { return _decode_block_max ? this : nullptr; }
+    bool find_block(uint32_t docId, Block &block) override;
 };
 
 template <bool bigEndian>
@@ -329,7 +378,7 @@ public:
 
     ZcPostingIterator(uint32_t minChunkDocs, bool dynamicK, const PostingListCounts &counts,
                       search::fef::TermFieldMatchDataArray matchData, Position start, uint32_t docIdLimit,
-                      bool decode_normal_features, bool decode_interleaved_features,
+                      bool decode_normal_features, bool decode_interleaved_features, bool decode_block_max,
                       bool unpack_normal_features, bool unpack_interleaved_features);
 
 
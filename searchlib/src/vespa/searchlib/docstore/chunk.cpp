@@ -74,16 +74,23 @@ Chunk::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, CompressionC
 Chunk::Chunk(uint32_t id, const Config & config) :
     _id(id),
     _lastSerial(static_cast<uint64_t>(-1l)),
-    _format(std::make_unique<ChunkFormatV2>(config.getMaxBytes())),
+    _format(config.getDictionary()
+            ? std::unique_ptr<ChunkFormat>(std::make_unique<ChunkFormatV3>(config.getMaxBytes(), config.getDictionary()))
+            : std::unique_ptr<ChunkFormat>(std::make_unique<ChunkFormatV2>(config.getMaxBytes()))),
     _lock()
 {
     _lids.reserve(4_Ki/sizeof(Entry));
 }
 
 Chunk::Chunk(uint32_t id, const void * buffer, size_t len) :
+    Chunk(id, buffer, len, DictionarySP())
+{
+}
+
+Chunk::Chunk(uint32_t id, const void * buffer, size_t len, const DictionarySP & dictionary) :
     _id(id),
     _lastSerial(static_cast<uint64_t>(-1l)),
-    _format(ChunkFormat::deserialize(buffer, len))
+    _format(ChunkFormat::deserialize(buffer, len, dictionary))
 {
     vespalib::nbostream &os = getData();
     while (os.size() > sizeof(_lastSerial)) {
@@ -33,7 +33,7 @@ ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, Compre
     const size_t oldPos(compressed.getDataLen());
     compressed.writeInt8(compression.type);
     compressed.writeInt32(os.size());
-    CompressionConfig::Type type(compress(compression, vespalib::ConstBufferRef(os.data(), os.size()), compressed, false));
+    CompressionConfig::Type type(compressBody(compression, vespalib::ConstBufferRef(os.data(), os.size()), compressed));
     if (compression.type != type) {
         compressed.getData()[oldPos] = type;
     }
@@ -66,8 +66,22 @@ ChunkFormat::verifyCompression(uint8_t type)
     }
 }
 
+CompressionConfig::Type
+ChunkFormat::compressBody(CompressionConfig compression, vespalib::ConstBufferRef uncompressed,
+                          vespalib::DataBuffer & compressed) const
+{
+    return compress(compression, uncompressed, compressed, false);
+}
+
+void
+ChunkFormat::decompressBody(CompressionConfig::Type type, size_t uncompressedLen, vespalib::ConstBufferRef compressed,
+                            vespalib::DataBuffer & uncompressed) const
+{
+    decompress(type, uncompressedLen, compressed, uncompressed, true);
+}
+
 ChunkFormat::UP
-ChunkFormat::deserialize(const void * buffer, size_t len)
+ChunkFormat::deserialize(const void * buffer, size_t len, const DictionarySP & dictionary)
 {
     uint8_t version(0);
     vespalib::nbostream raw(buffer, len);
@@ -85,6 +99,8 @@ ChunkFormat::deserialize(const void * buffer, size_t len)
         return std::make_unique<ChunkFormatV1>(raw, crc32);
     } else if (version == ChunkFormatV2::VERSION) {
             return std::make_unique<ChunkFormatV2>(raw, crc32);
+    } else if (version == ChunkFormatV3::VERSION) {
+        return std::make_unique<ChunkFormatV3>(raw, crc32, dictionary);
     } else {
         throw ChunkException(make_string("Unknown version %d", version), VESPA_STRLOC);
     }
@@ -128,7 +144,7 @@ ChunkFormat::deserializeBody(vespalib::nbostream & is)
     // This is a dirty trick to fool some odd sanity checking in DataBuffer::swap
     vespalib::DataBuffer uncompressed(const_cast<char *>(is.peek()), (size_t)0);
     vespalib::ConstBufferRef data(is.peek(), is.size() - sizeof(uint32_t));
-    decompress(CompressionConfig::Type(type), uncompressedLen, data, uncompressed, true);
+    decompressBody(CompressionConfig::Type(type), uncompressedLen, data, uncompressed);
     assert(uncompressed.getData() == uncompressed.getDead());
     if (uncompressed.getData() != data.c_str()) {
         const size_t sz(uncompressed.getDataLen());
@@ -6,6 +6,9 @@
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/exception.h>
+#include <memory>
+
+namespace vespalib::compression { class ZStdDictionary; }
 
 namespace search {
 
@@ -22,6 +25,7 @@ public:
     virtual ~ChunkFormat();
     using UP = std::unique_ptr<ChunkFormat>;
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using DictionarySP = std::shared_ptr<const vespalib::compression::ZStdDictionary>;
     vespalib::nbostream & getBuffer() { return _dataBuf; }
     const vespalib::nbostream & getBuffer() const { return _dataBuf; }
 
@@ -36,8 +40,9 @@ public:
      * Will deserialize and create a representation of the uncompressed data.
      * param buffer Pointer to the serialized data
      * @param len Length of serialized data
+     * @param dictionary The compression dictionary of the file, required by chunks using one.
      */
-    static ChunkFormat::UP deserialize(const void * buffer, size_t len);
+    static ChunkFormat::UP deserialize(const void * buffer, size_t len, const DictionarySP & dictionary = DictionarySP());
     /**
      * return the maximum size a packet can have. It allows correct size estimation
      * need for direct io alignment.
@@ -66,6 +71,17 @@ protected:
      * Thows exception if check fails.
      */
     void verifyCrc(const vespalib::nbostream & is, uint32_t expected) const;
+    /**
+     * Compress the serialized entries into the packet.
+     * @return the compression type actually used.
+     */
+    virtual CompressionConfig::Type compressBody(CompressionConfig compression, vespalib::ConstBufferRef uncompressed,
+                                                 vespalib::DataBuffer & compressed) const;
+    /**
+     * Uncompress a packet body produced by compressBody.
+     */
+    virtual void decompressBody(CompressionConfig::Type type, size_t uncompressedLen, vespalib::ConstBufferRef compressed,
+                                vespalib::DataBuffer & uncompressed) const;
 private:
     /**
      * Used when serializing to obtain correct version.
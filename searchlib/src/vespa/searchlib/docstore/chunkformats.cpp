@@ -3,7 +3,9 @@
 #include "chunkformats.h"
 #include <vespa/vespalib/util/crc.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstd_dictionary.h>
 #include <xxhash.h>
+#include <cassert>
 
 namespace search {
 
@@ -57,4 +59,73 @@ ChunkFormatV2::verifyMagic(vespalib::nbostream & is) const
     }
 }
 
+ChunkFormatV3::ChunkFormatV3(vespalib::nbostream & is, uint32_t expectedCrc, DictionarySP dictionary) :
+    ChunkFormat(),
+    _dictionary(std::move(dictionary))
+{
+    verifyCrc(is, expectedCrc);
+    verifyMagicAndDictionary(is);
+    deserializeBody(is);
+}
+
+ChunkFormatV3::ChunkFormatV3(size_t maxSize, DictionarySP dictionary) :
+    ChunkFormat(maxSize),
+    _dictionary(std::move(dictionary))
+{
+    assert(_dictionary);
+}
+
+ChunkFormatV3::~ChunkFormatV3() = default;
+
+uint32_t
+ChunkFormatV3::computeCrc(const void * buf, size_t sz) const
+{
+    return XXH32(buf, sz, 0);
+}
+
+void
+ChunkFormatV3::writeHeader(vespalib::DataBuffer & buf) const
+{
+    buf.writeInt32(MAGIC);
+    buf.writeInt32(_dictionary->id());
+}
+
+void
+ChunkFormatV3::verifyMagicAndDictionary(vespalib::nbostream & is) const
+{
+    uint32_t magic;
+    uint32_t dictionaryId;
+    is >> magic >> dictionaryId;
+    if (magic != MAGIC) {
+        throw ChunkException(make_string("Unknown magic %0x, expected %0x", magic, MAGIC), VESPA_STRLOC);
+    }
+    if ( ! _dictionary) {
+        throw ChunkException(make_string("Missing compression dictionary %0x", dictionaryId), VESPA_STRLOC);
+    }
+    if (dictionaryId != _dictionary->id()) {
+        throw ChunkException(make_string("Compression dictionary %0x, expected %0x", _dictionary->id(), dictionaryId), VESPA_STRLOC);
+    }
+}
+
+ChunkFormat::CompressionConfig::Type
+ChunkFormatV3::compressBody(CompressionConfig compression, vespalib::ConstBufferRef uncompressed,
+                            vespalib::DataBuffer & compressed) const
+{
+    if (compression.type == CompressionConfig::ZSTD) {
+        return _dictionary->compress(compression, uncompressed, compressed);
+    }
+    return ChunkFormat::compressBody(compression, uncompressed, compressed);
+}
+
+void
+ChunkFormatV3::decompressBody(CompressionConfig::Type type, size_t uncompressedLen, vespalib::ConstBufferRef compressed,
+                              vespalib::DataBuffer & uncompressed) const
+{
+    if (type == CompressionConfig::ZSTD) {
+        _dictionary->decompress(uncompressedLen, compressed, uncompressed);
+    } else {
+        ChunkFormat::decompressBody(type, uncompressedLen, compressed, uncompressed);
+    }
+}
+
 } // namespace search
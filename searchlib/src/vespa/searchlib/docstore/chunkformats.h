@@ -42,5 +42,34 @@ private:
     void verifyMagic(vespalib::nbostream & is) const;
 };
 
+/**
+ * Same as V2, but zstd compressed bodies are compressed with the dictionary of
+ * the file, identified by its id in the header.
+ */
+class ChunkFormatV3 : public ChunkFormat
+{
+public:
+    enum {VERSION=2, MAGIC=0x3c8a17d5};
+    ChunkFormatV3(vespalib::nbostream & is, uint32_t expectedCrc, DictionarySP dictionary);
+    ChunkFormatV3(size_t maxSize, DictionarySP dictionary);
+    ~ChunkFormatV3() override;
+private:
+    bool includeSerializedSize() const override { return true; }
+    size_t getHeaderSize() const override {
+        // MAGIC + dictionary id
+        return 4 + 4;
+    }
+    uint8_t getVersion() const override { return VERSION; }
+    uint32_t computeCrc(const void * buf, size_t sz) const override;
+    void writeHeader(vespalib::DataBuffer & buf) const override;
+    CompressionConfig::Type compressBody(CompressionConfig compression, vespalib::ConstBufferRef uncompressed,
+                                         vespalib::DataBuffer & compressed) const override;
+    void decompressBody(CompressionConfig::Type type, size_t uncompressedLen, vespalib::ConstBufferRef compressed,
+                        vespalib::DataBuffer & uncompressed) const override;
+    void verifyMagicAndDictionary(vespalib::nbostream & is) const;
+
+    DictionarySP _dictionary;
+};
+
 } // namespace search
 
@@ -28,13 +28,25 @@ BucketIndexStore::BucketIndexStore(size_t maxSignificantBucketBits, uint32_t num
     : _inSignificantBucketBits((maxSignificantBucketBits > 8) ? (maxSignificantBucketBits - 8) : 0),
       _where(),
       _numPartitions(numPartitions),
+      _lidsPerPartition(0),
       _readyForIterate(true)
 {}
 BucketIndexStore::~BucketIndexStore() = default;
 
+BucketIndexStore
+BucketIndexStore::lidOrdered(uint32_t docIdLimit, uint32_t numPartitions) noexcept {
+    BucketIndexStore store(0, numPartitions);
+    store._lidsPerPartition = std::max(1u, (docIdLimit + numPartitions - 1) / numPartitions);
+    return store;
+}
+
 void
 BucketIndexStore::prepareForIterate() {
-    std::sort(_where.begin(), _where.end());
+    if (lidOrder()) {
+        std::sort(_where.begin(), _where.end(), [](const auto & a, const auto & b) noexcept { return a._lid < b._lid; });
+    } else {
+        std::sort(_where.begin(), _where.end());
+    }
     _readyForIterate = true;
 }
 
@@ -73,8 +85,8 @@ BucketIndexStore::LidIterator::LidIterator(const BucketIndexStore & store, size_
 
 bool
 BucketIndexStore::LidIterator::has_next() noexcept {
-    for (;(_current != _store._where.end()) && (_store.toPartitionId(_current->_bucketId) != _partitionId); _current++);
-    return (_current != _store._where.end()) && (_store.toPartitionId(_current->_bucketId) == _partitionId);
+    for (;(_current != _store._where.end()) && (_store.toPartitionId(*_current) != _partitionId); _current++);
+    return (_current != _store._where.end()) && (_store.toPartitionId(*_current) == _partitionId);
 }
 
 StoreByBucket::Index
@@ -84,13 +96,19 @@ BucketIndexStore::LidIterator::next() noexcept {
 
 BucketCompacter::BucketCompacter(size_t maxSignificantBucketBits, CompressionConfig compression, LogDataStore & ds,
                                  Executor & executor, const IBucketizer & bucketizer, FileId source, FileId destination)
+    : BucketCompacter(BucketIndexStore(maxSignificantBucketBits, NUM_PARTITIONS), compression, ds,
+                      executor, &bucketizer, source, destination)
+{ }
+
+BucketCompacter::BucketCompacter(BucketIndexStore indexStore, CompressionConfig compression, LogDataStore & ds,
+                                 Executor & executor, const IBucketizer * bucketizer, FileId source, FileId destination)
     : _sourceFileId(source),
       _destinationFileId(destination),
       _ds(ds),
       _bucketizer(bucketizer),
       _lock(),
       _backingMemory(Alloc::alloc(INITIAL_BACKING_BUFFER_SIZE), &_lock),
-      _bucketIndexStore(maxSignificantBucketBits, NUM_PARTITIONS),
+      _bucketIndexStore(std::move(indexStore)),
       _tmpStore(),
       _lidGuard(ds.getLidReadGuard()),
       _stat()
@@ -111,8 +129,10 @@ void
 BucketCompacter::write(LockGuard guard, uint32_t chunkId, uint32_t lid, ConstBufferRef data)
 {
     guard.unlock();
-    BucketId bucketId = (data.size() > 0) ? _bucketizer.getBucketOf(_bucketizer.getGuard(), lid) : BucketId();
-    _tmpStore[_bucketIndexStore.toPartitionId(bucketId)]->add(bucketId, chunkId, lid, data);
+    BucketId bucketId = ((data.size() > 0) && (_bucketizer != nullptr))
+                        ? _bucketizer->getBucketOf(_bucketizer->getGuard(), lid)
+                        : BucketId();
+    _tmpStore[_bucketIndexStore.toPartitionId(bucketId, lid)]->add(bucketId, chunkId, lid, data);
 }
 
 void
@@ -23,14 +23,30 @@ private:
     LogDataStore & _ds;
 };
 
+/**
+ * Keeps track of where the compacted data is and in which order it shall be written.
+ * The default is bucket order. With lid order the lids are spread evenly over the
+ * partitions, so that draining the partitions in order gives all data in lid order.
+ */
 class BucketIndexStore : public StoreByBucket::StoreIndex {
 public:
     BucketIndexStore(size_t maxSignificantBucketBits, uint32_t numPartitions) noexcept;
+    BucketIndexStore(BucketIndexStore &&) noexcept = default;
     ~BucketIndexStore() override;
+    static BucketIndexStore lidOrdered(uint32_t docIdLimit, uint32_t numPartitions) noexcept;
     size_t toPartitionId(document::BucketId bucketId) const noexcept {
         uint64_t sortableBucketId = bucketId.toKey();
         return (sortableBucketId >> _inSignificantBucketBits) % _numPartitions;
     }
+    size_t toPartitionId(document::BucketId bucketId, uint32_t lid) const noexcept {
+        return (_lidsPerPartition != 0)
+            ? std::min(lid / _lidsPerPartition, _numPartitions - 1)
+            : toPartitionId(bucketId);
+    }
+    size_t toPartitionId(const StoreByBucket::Index & index) const noexcept {
+        return toPartitionId(index._bucketId, index._lid);
+    }
+    bool lidOrder() const noexcept { return _lidsPerPartition != 0; }
     void store(const StoreByBucket::Index & index) override;
     size_t getBucketCount() const noexcept;
     size_t getLidCount() const noexcept { return _where.size(); }
@@ -51,6 +67,7 @@ private:
     size_t       _inSignificantBucketBits;
     IndexVector  _where;
     uint32_t     _numPartitions;
+    uint32_t     _lidsPerPartition;
     bool         _readyForIterate;
 };
 
@@ -58,6 +75,7 @@ private:
  * This will split the incoming data into buckets.
  * The buckets data will then be written out in bucket order.
  * The buckets will be ordered, and the objects inside the buckets will be further ordered.
+ * With lid order the data is instead written out ordered by lid, and no bucketizer is needed.
  * All data are kept compressed to minimize memory usage.
  **/
 class BucketCompacter : public IWriteData,
@@ -69,19 +87,21 @@ public:
     using FileId = FileChunk::FileId;
     BucketCompacter(size_t maxSignificantBucketBits, CompressionConfig compression, LogDataStore & ds,
                     Executor & executor, const IBucketizer & bucketizer, FileId source, FileId destination);
+    BucketCompacter(BucketIndexStore indexStore, CompressionConfig compression, LogDataStore & ds,
+                    Executor & executor, const IBucketizer * bucketizer, FileId source, FileId destination);
+    static constexpr size_t NUM_PARTITIONS = 256;
     ~BucketCompacter() override;
     void write(LockGuard guard, uint32_t chunkId, uint32_t lid, ConstBufferRef data) override;
     void write(BucketId bucketId, uint32_t chunkId, uint32_t lid, ConstBufferRef data) override;
     void close() override;
 private:
-    static constexpr size_t NUM_PARTITIONS = 256;
     using GenerationHandler = vespalib::GenerationHandler;
     using Partitions = std::array<std::unique_ptr<StoreByBucket>, NUM_PARTITIONS>;
     FileId getDestinationId(const LockGuard & guard) const;
     FileId                                 _sourceFileId;
     FileId                                 _destinationFileId;
     LogDataStore                         & _ds;
-    const IBucketizer                    & _bucketizer;
+    const IBucketizer                    * _bucketizer;
     std::mutex                             _lock;
     vespalib::MemoryDataStore              _backingMemory;
     BucketIndexStore                       _bucketIndexStore;
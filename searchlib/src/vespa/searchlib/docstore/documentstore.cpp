@@ -9,6 +9,8 @@
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <algorithm>
+#include <functional>
 
 #include <vespa/log/log.h>
 
@@ -35,6 +37,46 @@ private:
     IDocumentVisitor & _visitor;
 };
 
+/**
+ * Makes documents for a batch of lids, placing them at the position(s)
+ * of their lid in the batch.
+ */
+class DocumentBatchAdapter : public IBufferVisitor
+{
+public:
+    DocumentBatchAdapter(const DocumentTypeRepo & repo, const IDocumentStore::LidVector & lids,
+                         std::vector<IDocumentStore::DocumentUP> & docs);
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override;
+private:
+    const DocumentTypeRepo                   & _repo;
+    std::vector<std::pair<uint32_t, size_t>>   _positions;
+    std::vector<IDocumentStore::DocumentUP>  & _docs;
+};
+
+DocumentBatchAdapter::DocumentBatchAdapter(const DocumentTypeRepo & repo, const IDocumentStore::LidVector & lids,
+                                           std::vector<IDocumentStore::DocumentUP> & docs)
+    : _repo(repo),
+      _positions(),
+      _docs(docs)
+{
+    _positions.reserve(lids.size());
+    for (size_t i(0); i < lids.size(); i++) {
+        _positions.emplace_back(lids[i], i);
+    }
+    std::sort(_positions.begin(), _positions.end());
+}
+
+void
+DocumentBatchAdapter::visit(uint32_t lid, vespalib::ConstBufferRef buf) {
+    auto it = std::lower_bound(_positions.begin(), _positions.end(), std::make_pair(lid, size_t(0)));
+    for (; (it != _positions.end()) && (it->first == lid); ++it) {
+        if ((buf.size() > 0) && !_docs[it->second]) {
+            vespalib::nbostream is(buf.c_str(), buf.size());
+            _docs[it->second] = std::make_unique<document::Document>(_repo, is);
+        }
+    }
+}
+
 void
 DocumentVisitorAdapter::visit(uint32_t lid, vespalib::ConstBufferRef buf) {
     if (buf.size() > 0) {
@@ -57,6 +99,8 @@ public:
     { }
 
     bool read(DocumentIdT key, Value &value) const;
+    void read_batch(const IDocumentStore::LidVector &lids, const std::function<void(DocumentIdT, Value)> &found) const;
+    void read_batch(const IDocumentStore::LidVector &lids, IBufferVisitor &visitor) const { _backingStore.read(lids, visitor); }
     void visit(const IDocumentStore::LidVector &lids, const DocumentTypeRepo &repo, IDocumentVisitor &visitor) const;
     void write(DocumentIdT, const Value &);
     void erase(DocumentIdT) {}
@@ -86,6 +130,29 @@ BackingStore::read(DocumentIdT key, Value &value) const {
     return found;
 }
 
+void
+BackingStore::read_batch(const IDocumentStore::LidVector &lids,
+                         const std::function<void(DocumentIdT, Value)> &found) const
+{
+    class ValueVisitor : public IBufferVisitor {
+    public:
+        ValueVisitor(const std::function<void(DocumentIdT, Value)> &found_in, CompressionConfig compression_in)
+            : _found(found_in), _compression(compression_in) {}
+        void visit(uint32_t lid, vespalib::ConstBufferRef buf) override {
+            vespalib::DataBuffer copy(buf.size());
+            copy.writeBytes(buf.c_str(), buf.size());
+            Value value;
+            value.set(std::move(copy), buf.size(), _compression);
+            _found(lid, std::move(value));
+        }
+    private:
+        const std::function<void(DocumentIdT, Value)> &_found;
+        CompressionConfig                              _compression;
+    };
+    ValueVisitor visitor(found, getCompression());
+    _backingStore.read(lids, visitor);
+}
+
 void
 BackingStore::write(DocumentIdT lid, const Value & value)
 {
@@ -197,6 +264,32 @@ DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
     return std::unique_ptr<document::Document>();
 }
 
+std::vector<IDocumentStore::DocumentUP>
+DocumentStore::read_batch(const LidVector & lids, const DocumentTypeRepo &repo) const
+{
+    std::vector<DocumentUP> docs(lids.size());
+    if (useCache()) {
+        std::vector<Value> values = _cache->read_batch(lids);
+        for (size_t i(0); i < lids.size(); i++) {
+            if (values[i].empty()) {
+                continue;
+            }
+            Value::Result result = values[i].decompressed();
+            if (result.second) {
+                docs[i] = std::make_unique<document::Document>(repo, std::move(result.first));
+            } else {
+                // Let the single document read handle the corrupt cache entry
+                docs[i] = read(lids[i], repo);
+            }
+        }
+    } else {
+        _uncached_lookups.fetch_add(lids.size());
+        DocumentBatchAdapter adapter(repo, lids, docs);
+        _store->read_batch(lids, adapter);
+    }
+    return docs;
+}
+
 void
 DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const document::Document& doc) {
     nbostream stream(12345);
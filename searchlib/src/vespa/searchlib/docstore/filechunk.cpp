@@ -8,10 +8,12 @@
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/encoding/base64.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/executor.h>
 #include <vespa/vespalib/util/arrayqueue.hpp>
+#include <vespa/vespalib/util/zstd_dictionary.h>
 #include <vespa/fastos/file.h>
 #include <filesystem>
 #include <future>
@@ -30,6 +32,7 @@ namespace {
 constexpr size_t ALIGNMENT=0x1000;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
+const vespalib::string DICTIONARY_KEY("zstdDictionary");
 
 }
 
@@ -83,6 +86,7 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _idxHeaderLen(0u),
       _numLids(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
+      _dictionary(),
       _modificationTime()
 {
     FastOS_File dataFile(_dataFileName.c_str());
@@ -147,7 +151,7 @@ FileChunk::updateLidMap(const unique_lock &guard, ISetLid &ds, uint64_t serialNu
     }
     const int64_t fileSize = idxFile.getSize();
     if (_idxHeaderLen == 0) {
-        _idxHeaderLen = readIdxHeader(idxFile, _docIdLimit);
+        _idxHeaderLen = readIdxHeader(idxFile, _docIdLimit, _dictionary);
     }
     BucketDensityComputer globalBucketMap(_bucketizer);
     // Guard comes from the same bucketizer so the same guard can be used
@@ -223,6 +227,9 @@ FileChunk::enableRead()
     if (_tune._randRead.getWantDirectIO()) {
         LOG(debug, "enableRead(): DirectIORandRead: file='%s'", _dataFileName.c_str());
         _file = std::make_unique<DirectIORandRead>(_dataFileName);
+    } else if (_tune._randRead.getWantIoUring()) {
+        LOG(debug, "enableRead(): IoUringRandRead: file='%s'", _dataFileName.c_str());
+        _file = std::make_unique<IoUringRandRead>(_dataFileName);
     } else if (_tune._randRead.getWantMemoryMap()) {
         const int mmapFlags(_tune._randRead.getMemoryMapFlags());
         const int fadviseOptions(_tune._randRead.getAdvise());
@@ -308,27 +315,49 @@ FileChunk::appendTo(vespalib::Executor & executor, const IGetLid & db, IWriteDat
     assert(numChunks <= getNumChunks());
     FixedParams fixedParams = {db, dest, lidReadGuard, getFileId().getId(), visitorProgress};
     size_t limit = std::thread::hardware_concurrency();
-    vespalib::ArrayQueue<std::future<Chunk::UP>> queue;
-    for (size_t chunkId(0); chunkId < numChunks; chunkId++) {
-        std::promise<Chunk::UP> promisedChunk;
-        std::future<Chunk::UP> futureChunk = promisedChunk.get_future();
-        auto task = vespalib::makeLambdaTask([promise = std::move(promisedChunk), chunkId, this]() mutable {
-            const ChunkInfo & cInfo(_chunkInfo[chunkId]);
+    using Chunks = std::vector<Chunk::UP>;
+    vespalib::ArrayQueue<std::future<Chunks>> queue;
+    for (size_t firstChunkId(0); firstChunkId < numChunks; ) {
+        // Read ahead all following chunks that are adjacent on disk with the same read.
+        size_t endChunkId = firstChunkId + 1;
+        while ((endChunkId < numChunks) &&
+               canReadTogether(_chunkInfo[firstChunkId], _chunkInfo[endChunkId - 1], _chunkInfo[endChunkId]))
+        {
+            endChunkId++;
+        }
+        std::promise<Chunks> promisedChunks;
+        std::future<Chunks> futureChunks = promisedChunks.get_future();
+        auto task = vespalib::makeLambdaTask([promise = std::move(promisedChunks), firstChunkId, endChunkId, this]() mutable {
+            const ChunkInfo & first(_chunkInfo[firstChunkId]);
+            const ChunkInfo & last(_chunkInfo[endChunkId - 1]);
             vespalib::DataBuffer whole(0ul, ALIGNMENT);
-            FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+            FileRandRead::FSP keepAlive(_file->read(first.getOffset(), whole,
+                                                    last.getOffset() + last.getSize() - first.getOffset()));
+            Chunks chunks;
+            chunks.reserve(endChunkId - firstChunkId);
+            for (size_t chunkId(firstChunkId); chunkId < endChunkId; chunkId++) {
+                const ChunkInfo & cInfo(_chunkInfo[chunkId]);
+                chunks.push_back(std::make_unique<Chunk>(chunkId, whole.getData() + (cInfo.getOffset() - first.getOffset()),
+                                                         cInfo.getSize(), _dictionary));
+            }
+            promise.set_value(std::move(chunks));
         });
         executor.execute(CpuUsage::wrap(std::move(task), cpu_category));
 
         while (queue.size() >= limit) {
-            appendChunks(&fixedParams, queue.front().get());
+            for (Chunk::UP & chunk : queue.front().get()) {
+                appendChunks(&fixedParams, std::move(chunk));
+            }
             queue.pop();
         }
 
-        queue.push(std::move(futureChunk));
+        queue.push(std::move(futureChunks));
+        firstChunkId = endChunkId;
     }
     while ( ! queue.empty() ) {
-        appendChunks(&fixedParams, queue.front().get());
+        for (Chunk::UP & chunk : queue.front().get()) {
+            appendChunks(&fixedParams, std::move(chunk));
+        }
         queue.pop();
     }
     dest.close();
@@ -338,34 +367,77 @@ void
 FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
 {
     if (count == 0) { return; }
+    std::vector<ChunkLids> chunks;
     uint32_t prevChunk = begin->getChunkId();
     uint32_t start(0);
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         if (li.getChunkId() != prevChunk) {
-            ChunkInfo ci = _chunkInfo[prevChunk];
-            read(begin + start, i - start, ci, visitor);
+            chunks.push_back({begin + start, i - start, _chunkInfo[prevChunk]});
             prevChunk = li.getChunkId();
             start = i;
         }
     }
-    ChunkInfo ci = _chunkInfo[prevChunk];
-    read(begin + start, count - start, ci, visitor);
+    chunks.push_back({begin + start, count - start, _chunkInfo[prevChunk]});
+    read(chunks, visitor);
 }
 
 void
-FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const
+FileChunk::read(const std::vector<ChunkLids> & chunks, IBufferVisitor & visitor) const
 {
-    vespalib::DataBuffer whole(0ul, ALIGNMENT);
-    FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen());
-    for (size_t i(0); i < count; i++) {
-        const LidInfoWithLid & li = *(begin + i);
-        vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
-        if (buf.size() != 0) {
-            visitor.visit(li.getLid(), buf);
+    // Chunks adjacent on disk are read with a single read, and all reads in a batch are
+    // handed to the reader at once, letting it overlap them.
+    constexpr size_t MAX_READS_PER_BATCH = 64;
+    std::vector<size_t> readStart;
+    for (size_t i(0); i < chunks.size(); i++) {
+        if ((i == 0) || ! canReadTogether(chunks[readStart.back()].info, chunks[i - 1].info, chunks[i].info)) {
+            readStart.push_back(i);
         }
     }
+    const size_t numReads = readStart.size();
+    readStart.push_back(chunks.size());
+    std::vector<vespalib::DataBuffer> wholes;
+    std::vector<FileRandRead::ReadRequest> requests;
+    wholes.reserve(std::min(numReads, MAX_READS_PER_BATCH));
+    requests.reserve(wholes.capacity());
+    for (size_t firstRead(0); firstRead < numReads; firstRead += MAX_READS_PER_BATCH) {
+        size_t endRead = std::min(numReads, firstRead + MAX_READS_PER_BATCH);
+        wholes.clear();
+        requests.clear();
+        for (size_t r(firstRead); r < endRead; r++) {
+            const ChunkInfo & first = chunks[readStart[r]].info;
+            const ChunkInfo & last = chunks[readStart[r + 1] - 1].info;
+            wholes.emplace_back(0ul, ALIGNMENT);
+            requests.emplace_back(first.getOffset(), last.getOffset() + last.getSize() - first.getOffset(), wholes.back());
+        }
+        _file->read_batch(requests);
+        for (size_t r(firstRead); r < endRead; r++) {
+            const vespalib::DataBuffer & whole = wholes[r - firstRead];
+            const uint64_t wholeOffset = chunks[readStart[r]].info.getOffset();
+            for (size_t i(readStart[r]); i < readStart[r + 1]; i++) {
+                const ChunkInfo & cInfo = chunks[i].info;
+                Chunk chunk(chunks[i].begin->getChunkId(), whole.getData() + (cInfo.getOffset() - wholeOffset),
+                            cInfo.getSize(), _dictionary);
+                for (size_t j(0); j < chunks[i].count; j++) {
+                    const LidInfoWithLid & li = *(chunks[i].begin + j);
+                    vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
+                    if (buf.size() != 0) {
+                        visitor.visit(li.getLid(), buf);
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool
+FileChunk::canReadTogether(const ChunkInfo & first, const ChunkInfo & prev, const ChunkInfo & next) noexcept
+{
+    const uint64_t prevEnd = prev.getOffset() + prev.getSize();
+    // Chunks are padded to the alignment on disk.
+    return first.valid() && next.valid() &&
+           (next.getOffset() >= prevEnd) && (next.getOffset() - prevEnd < ALIGNMENT) &&
+           (next.getOffset() + next.getSize() - first.getOffset() <= READ_AHEAD_BYTES);
 }
 
 ssize_t
@@ -383,7 +455,7 @@ FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen());
+    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _dictionary);
     return chunk.read(lid, buffer);
 }
 
@@ -408,6 +480,13 @@ FileChunk::readDataHeader(FileRandRead &datFile)
 
 uint64_t
 FileChunk::readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit)
+{
+    DictionarySP dictionary;
+    return readIdxHeader(idxFile, docIdLimit, dictionary);
+}
+
+uint64_t
+FileChunk::readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit, DictionarySP &dictionary)
 {
     int64_t fileSize = idxFile.getSize();
     uint32_t hl = GenericHeader::getMinSize();
@@ -426,6 +505,7 @@ FileChunk::readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit)
     GenericHeader header;
     header.read(reader);
     docIdLimit = readDocIdLimit(header);
+    dictionary = readDictionary(header, READ_ONLY_DICTIONARY_LEVEL);
     return idxHeaderLen;
 }
 
@@ -445,6 +525,63 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+FileChunk::DictionarySP
+FileChunk::readDictionary(vespalib::GenericHeader &header, int compressionLevel)
+{
+    if (header.hasTag(DICTIONARY_KEY)) {
+        const vespalib::string & encoded = header.getTag(DICTIONARY_KEY).asString();
+        std::string content = vespalib::Base64::decode(encoded.c_str(), encoded.size());
+        return std::make_shared<vespalib::compression::ZStdDictionary>(vespalib::ConstBufferRef(content.data(), content.size()),
+                                                                       compressionLevel);
+    }
+    return {};
+}
+
+void
+FileChunk::writeDictionary(vespalib::GenericHeader &header, const DictionarySP &dictionary)
+{
+    if (dictionary) {
+        vespalib::ConstBufferRef content = dictionary->content();
+        header.putTag(vespalib::GenericHeader::Tag(DICTIONARY_KEY, vespalib::Base64::encode(content.c_str(), content.size())));
+    }
+}
+
+std::vector<vespalib::string>
+FileChunk::sampleEntries(size_t maxBytes) const
+{
+    std::vector<vespalib::string> samples;
+    const size_t numChunks = getNumChunks();
+    if (numChunks == 0) {
+        return samples;
+    }
+    // Start with a coarse stride over the file, refining it until enough is sampled.
+    size_t sampled(0);
+    std::vector<bool> visited(numChunks, false);
+    for (size_t stride = std::max(1ul, numChunks / 16); (sampled < maxBytes); stride = std::max(1ul, stride / 2)) {
+        for (size_t chunkId(0); (chunkId < numChunks) && (sampled < maxBytes); chunkId += stride) {
+            const ChunkInfo & cInfo(_chunkInfo[chunkId]);
+            if (visited[chunkId] || !cInfo.valid()) {
+                continue;
+            }
+            visited[chunkId] = true;
+            vespalib::DataBuffer whole(0ul, ALIGNMENT);
+            FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
+            Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _dictionary);
+            for (const Chunk::Entry & e : chunk.getUniqueLids()) {
+                vespalib::ConstBufferRef data(chunk.getLid(e.getLid()));
+                if (data.size() > 0) {
+                    samples.emplace_back(data.c_str(), data.size());
+                    sampled += data.size();
+                }
+            }
+        }
+        if (stride == 1) {
+            break;
+        }
+    }
+    return samples;
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -459,7 +596,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), _dictionary);
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
@@ -505,6 +642,10 @@ FileChunk::getMemoryUsage() const
     result.incUsedBytes(sizeof(*this));
     result.incAllocatedBytes(_chunkInfo.capacity()*sizeof(ChunkInfoVector::value_type));
     result.incUsedBytes(_chunkInfo.size()*sizeof(ChunkInfoVector::value_type));
+    if (_dictionary) {
+        result.incAllocatedBytes(_dictionary->size());
+        result.incUsedBytes(_dictionary->size());
+    }
     return result;
 }
 
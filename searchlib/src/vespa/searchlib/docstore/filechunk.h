@@ -105,6 +105,9 @@ public:
     using LidBufferMap = vespalib::hash_map<uint32_t, std::unique_ptr<vespalib::DataBuffer>>;
     using UP = std::unique_ptr<FileChunk>;
     using SubChunkId = uint32_t;
+    using DictionarySP = Chunk::DictionarySP;
+    // Compression level for dictionaries that are only used for decompression.
+    static constexpr int READ_ONLY_DICTIONARY_LEVEL = 3;
     FileChunk(FileId fileId, NameId nameId, const vespalib::string &baseName, const TuneFileSummary &tune,
               const IBucketizer *bucketizer);
     virtual ~FileChunk();
@@ -166,6 +169,16 @@ public:
     void appendTo(vespalib::Executor & executor, const IGetLid & db, IWriteData & dest,
                   uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress,
                   vespalib::CpuUsage::Category cpu_category);
+    /**
+     * Collect entries from chunks spread evenly over the file until at least
+     * maxBytes are sampled or the file is exhausted. Used for training a
+     * compression dictionary.
+     */
+    std::vector<vespalib::string> sampleEntries(size_t maxBytes) const;
+    /**
+     * The zstd dictionary used for compressing the chunks in this file, if any.
+     */
+    const DictionarySP & getDictionary() const { return _dictionary; }
     /**
      * Must be called after chunk has been created to allow correct
      * underlying file object to be created.  Must be called before
@@ -193,7 +206,10 @@ public:
      * Read header and return number of bytes it consist of.
      */
     static uint64_t readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit);
+    static uint64_t readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit, DictionarySP &dictionary);
     static uint64_t readDataHeader(FileRandRead &idxFile);
+    static DictionarySP readDictionary(vespalib::GenericHeader &header, int compressionLevel);
+    static void writeDictionary(vespalib::GenericHeader &header, const DictionarySP &dictionary);
     static bool isIdxFileEmpty(const vespalib::string & name);
     static void eraseIdxFile(const vespalib::string & name);
     static void eraseDatFile(const vespalib::string & name);
@@ -241,9 +257,25 @@ protected:
         uint32_t _size;
     };
 
+    /**
+     * The lids to visit in a single chunk stored on file.
+     */
+    struct ChunkLids {
+        LidInfoWithLidV::const_iterator begin;
+        size_t                          count;
+        ChunkInfo                       info;
+    };
+
     void setNumUniqueBuckets(size_t numUniqueBuckets) { _numUniqueBuckets = numUniqueBuckets; }
     ssize_t read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo, vespalib::DataBuffer & buffer) const;
-    void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
+    void read(const std::vector<ChunkLids> & chunks, IBufferVisitor & visitor) const;
+    /**
+     * Chunks that are adjacent on disk are read ahead with a single read of at most this many bytes.
+     * Visiting a file compacted in bucket or lid order then streams through it sequentially.
+     */
+    static constexpr size_t READ_AHEAD_BYTES = 0x100000;
+    /// Tells if next can be read with the same read as the adjacent chunks from first to prev.
+    static bool canReadTogether(const ChunkInfo & first, const ChunkInfo & prev, const ChunkInfo & next) noexcept;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
 
@@ -259,6 +291,7 @@ protected:
     uint32_t               _idxHeaderLen;
     uint32_t               _numLids;
     uint32_t               _docIdLimit; // Limit when the file was created. Stored in idx file header.
+    DictionarySP           _dictionary; // Stored in idx file header.
     vespalib::system_time  _modificationTime;
 };
 
@@ -14,4 +14,10 @@ IDataStore::~IDataStore()
 {
 }
 
+IDataStore::DictionarySP
+IDataStore::getCompressionDictionary() const
+{
+    return {};
+}
+
 } // namespace search
@@ -8,9 +8,11 @@
 #include <vespa/vespalib/util/memoryusage.h>
 #include <vespa/vespalib/util/time.h>
 #include <atomic>
+#include <memory>
 #include <vector>
 
 namespace vespalib { class DataBuffer; }
+namespace vespalib::compression { class ZStdDictionary; }
 namespace search {
 
 class IBufferVisitor;
@@ -40,6 +42,7 @@ class IDataStore : public common::ICompactableLidSpace
 {
 public:
     using LidVector = std::vector<uint32_t>;
+    using DictionarySP = std::shared_ptr<const vespalib::compression::ZStdDictionary>;
     /**
      * Construct an idata store.
      * A data store has a base directory. The rest is up to the implementation.
@@ -124,6 +127,11 @@ public:
      */
     virtual size_t getMaxSpreadAsBloat() const = 0;
 
+    /**
+     * The most recent zstd dictionary used by the store, if any.
+     * Can be used to compress other representations of the same data.
+     */
+    virtual DictionarySP getCompressionDictionary() const;
 
     /**
      * The sync token used for the last successful flush() operation,
@@ -6,6 +6,7 @@
 #include <vespa/searchlib/common/i_compactable_lid_space.h>
 #include <vespa/searchlib/query/base.h>
 #include <future>
+#include <vector>
 
 namespace document {
     class Document;
@@ -75,6 +76,14 @@ public:
      * @return NULL if there is no document associated with the lid.
      **/
     virtual DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const = 0;
+
+    /**
+     * Make Documents for several local IDs at once, in the same order as
+     * the given lids. The default implementation reads them one by one,
+     * while a store backed by disk fetches all of them in one batch.
+     * @return NULL for lids without an associated document.
+     **/
+    virtual std::vector<DocumentUP> read_batch(const LidVector & lids, const document::DocumentTypeRepo &repo) const;
     virtual void visit(const LidVector & lidVector, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
 
     /**
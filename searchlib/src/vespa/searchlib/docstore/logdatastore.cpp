@@ -10,6 +10,7 @@
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/zstd_dictionary.h>
 #include <thread>
 #include <cassert>
 #include <filesystem>
@@ -47,6 +48,8 @@ LogDataStore::Config::Config()
       _maxBucketSpread(2.5),
       _minFileSizeFactor(0.2),
       _maxNumLids(DEFAULT_MAX_LIDS_PER_FILE),
+      _compactOrder(CompactOrder::BUCKET),
+      _compactDictionarySize(0),
       _compactCompression(CompressionConfig::LZ4),
       _fileConfig()
 { }
@@ -56,6 +59,8 @@ LogDataStore::Config::operator == (const Config & rhs) const {
     return (_maxBucketSpread == rhs._maxBucketSpread) &&
             (_maxFileSize == rhs._maxFileSize) &&
             (_minFileSizeFactor == rhs._minFileSizeFactor) &&
+            (_compactOrder == rhs._compactOrder) &&
+            (_compactDictionarySize == rhs._compactDictionarySize) &&
             (_compactCompression == rhs._compactCompression) &&
             (_fileConfig == rhs._fileConfig);
 }
@@ -304,6 +309,10 @@ size_t
 LogDataStore::getMaxSpreadAsBloat() const
 {
     const size_t diskFootPrint = getDiskFootprint();
+    if (compactInLidOrder()) {
+        // Bucket spread is not a goal when compacting in lid order.
+        return 0;
+    }
     const double maxSpread = getMaxBucketSpread();
     return (maxSpread > _config.getMaxBucketSpread())
         ? diskFootPrint * (1.0 - 1.0/maxSpread)
@@ -350,7 +359,7 @@ LogDataStore::findNextToCompact(bool dueToBloat)
         const auto & fc(_fileChunks[i]);
         if (fc && fc->frozen() && (_currentlyCompacting.find(fc->getNameId()) == _currentlyCompacting.end())) {
             uint64_t usage = fc->getDiskFootprint();
-            if ( ! dueToBloat && _bucketizer) {
+            if ( ! dueToBloat && _bucketizer && ! compactInLidOrder()) {
                 worst.emplace(fc->getBucketSpread(), FileId(i));
             } else if (dueToBloat && usage > 0) {
                 double tmp(double(fc->getDiskBloat())/usage);
@@ -441,6 +450,7 @@ void LogDataStore::setNewFileChunk(const MonitorGuard & guard, FileChunk::UP fil
     assert(hasUpdateLock(guard));
     size_t fileId = file->getFileId().getId();
     assert( ! _fileChunks[fileId]);
+    updateCompressionDictionary(*file);
     _fileChunks[fileId] = std::move(file);
 }
 
@@ -452,7 +462,7 @@ void LogDataStore::compactFile(FileId fileId)
               fc->getName().c_str(), 100*fc->getDiskBloat()/double(fc->getDiskFootprint()), fc->getBucketSpread());
     std::unique_ptr<IWriteData> compacter;
     FileId destinationFileId = FileId::active();
-    if (_bucketizer) {
+    if (_bucketizer || compactInLidOrder()) {
         size_t compacted_size;
         {
             MonitorGuard guard(_updateLock);
@@ -461,13 +471,21 @@ void LogDataStore::compactFile(FileId fileId)
             compacted_size = (disk_footprint <= disk_bloat) ? 0u : (disk_footprint - disk_bloat);
         }
         if ( ! shouldCompactToActiveFile(compacted_size)) {
+            DictionarySP dictionary = trainDictionary(*fc);
             MonitorGuard guard(_updateLock);
             destinationFileId = allocateFileId(guard);
-            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(), fc->getNameId().next()));
+            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(),
+                                                      fc->getNameId().next(), std::move(dictionary)));
+        }
+        if (compactInLidOrder()) {
+            auto indexStore = docstore::BucketIndexStore::lidOrdered(getDocIdLimit(), BucketCompacter::NUM_PARTITIONS);
+            compacter = std::make_unique<BucketCompacter>(std::move(indexStore), _config.compactCompression(), *this,
+                                                          _executor, _bucketizer.get(), fc->getFileId(), destinationFileId);
+        } else {
+            size_t numSignificantBucketBits = computeNumberOfSignificantBucketIdBits(*_bucketizer, fc->getFileId());
+            compacter = std::make_unique<BucketCompacter>(numSignificantBucketBits, _config.compactCompression(), *this,
+                                                          _executor, *_bucketizer, fc->getFileId(), destinationFileId);
         }
-        size_t numSignificantBucketBits = computeNumberOfSignificantBucketIdBits(*_bucketizer, fc->getFileId());
-        compacter = std::make_unique<BucketCompacter>(numSignificantBucketBits, _config.compactCompression(), *this,
-                                                      _executor, *_bucketizer, fc->getFileId(), destinationFileId);
     } else {
         compacter = std::make_unique<docstore::Compacter>(*this);
     }
@@ -642,8 +660,57 @@ LogDataStore::createReadOnlyFile(FileId fileId, NameId nameId) {
     return file;
 }
 
+LogDataStore::DictionarySP
+LogDataStore::trainDictionary(const FileChunk & source) const
+{
+    const WriteableFileChunk::Config & fileConfig = _config.getFileConfig();
+    size_t dictionarySize = _config.getCompactDictionarySize();
+    if ((dictionarySize == 0) || (fileConfig.getCompression().type != CompressionConfig::ZSTD)) {
+        return {};
+    }
+    // zstd recommends around 100 times the dictionary size as training data.
+    std::vector<vespalib::string> samples = source.sampleEntries(dictionarySize * 100);
+    std::vector<ConstBufferRef> sampleRefs;
+    sampleRefs.reserve(samples.size());
+    for (const auto & sample : samples) {
+        sampleRefs.emplace_back(sample.data(), sample.size());
+    }
+    auto dictionary = vespalib::compression::ZStdDictionary::train(sampleRefs, dictionarySize,
+                                                                   fileConfig.getCompression().compressionLevel);
+    if (dictionary) {
+        LOG(info, "Trained zstd dictionary %u of %zu bytes from %zu samples of file '%s'",
+            dictionary->id(), dictionary->size(), samples.size(), source.getName().c_str());
+    } else {
+        LOG(warning, "Failed training zstd dictionary from %zu samples of file '%s', compacting without",
+            samples.size(), source.getName().c_str());
+    }
+    return dictionary;
+}
+
+void
+LogDataStore::updateCompressionDictionary(const FileChunk & file)
+{
+    if (file.getDictionary()) {
+        std::lock_guard guard(_dictionaryLock);
+        _compressionDictionary = file.getDictionary();
+    }
+}
+
+LogDataStore::DictionarySP
+LogDataStore::getCompressionDictionary() const
+{
+    std::lock_guard guard(_dictionaryLock);
+    return _compressionDictionary;
+}
+
 FileChunk::UP
 LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId)
+{
+    return createWritableFile(fileId, serialNum, nameId, {});
+}
+
+FileChunk::UP
+LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId, DictionarySP dictionary)
 {
     for (const auto & fc : _fileChunks) {
         if (fc && (fc->getNameId() == nameId)) {
@@ -655,7 +722,7 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
     uint32_t docIdLimit = (getDocIdLimit() != 0) ? getDocIdLimit() : std::numeric_limits<uint32_t>::max();
     auto file = std::make_unique< WriteableFileChunk>(_executor, fileId, nameId, getBaseDir(), serialNum,docIdLimit,
                                                       _config.getFileConfig(), _tune, _fileHeaderContext,
-                                                      _bucketizer.get());
+                                                      _bucketizer.get(), std::move(dictionary));
     file->enableRead();
     return file;
 }
@@ -779,6 +846,9 @@ LogDataStore::preload()
             throw vespalib::IllegalArgumentException(getBaseDir() + " does not have any summary data... And that is no good in readonly case.");
         }
     }
+    for (const auto & fc : _fileChunks) {
+        updateCompressionDictionary(*fc);
+    }
     _active = FileId(_fileChunks.size() - 1);
     _prevActive = _active.prev();
 }
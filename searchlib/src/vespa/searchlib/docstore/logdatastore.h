@@ -42,12 +42,16 @@ public:
     using AtomicValueWrapper = vespalib::datastore::AtomicValueWrapper<T>;
     class Config {
     public:
+        /// The order data is written in when a file is compacted into a new file.
+        enum class CompactOrder : uint8_t { BUCKET, LID };
         Config();
 
         Config & setMaxFileSize(size_t v) { _maxFileSize = v; return *this; }
         Config & setMaxNumLids(size_t v) { _maxNumLids = v; return *this; }
         Config & setMaxBucketSpread(double v) noexcept { _maxBucketSpread.store_relaxed(v); return *this; }
         Config & setMinFileSizeFactor(double v) { _minFileSizeFactor = v; return *this; }
+        Config & setCompactDictionarySize(size_t v) { _compactDictionarySize = v; return *this; }
+        Config & setCompactOrder(CompactOrder v) { _compactOrder = v; return *this; }
 
         Config & compactCompression(CompressionConfig v) { _compactCompression = v; return *this; }
         Config & setFileConfig(WriteableFileChunk::Config v) { _fileConfig = v; return *this; }
@@ -56,6 +60,9 @@ public:
         double getMaxBucketSpread() const noexcept { return _maxBucketSpread.load_relaxed(); }
         double getMinFileSizeFactor() const { return _minFileSizeFactor; }
         uint32_t getMaxNumLids() const { return _maxNumLids; }
+        /// Max size of the zstd dictionary trained when compacting to a new file, 0 disables it.
+        size_t getCompactDictionarySize() const { return _compactDictionarySize; }
+        CompactOrder getCompactOrder() const { return _compactOrder; }
 
         CompressionConfig compactCompression() const { return _compactCompression; }
 
@@ -67,6 +74,8 @@ public:
         AtomicValueWrapper<double>  _maxBucketSpread;
         double                      _minFileSizeFactor;
         uint32_t                    _maxNumLids;
+        CompactOrder                _compactOrder;
+        size_t                      _compactDictionarySize;
         CompressionConfig           _compactCompression;
         WriteableFileChunk::Config  _fileConfig;
     };
@@ -110,6 +119,7 @@ public:
     size_t getDiskHeaderFootprint() const override;
     size_t getDiskBloat() const override;
     size_t getMaxSpreadAsBloat() const override;
+    DictionarySP getCompressionDictionary() const override;
 
     void compactBloat(uint64_t syncToken) { compactWorst(syncToken, true); }
     void compactSpread(uint64_t syncToken) { compactWorst(syncToken, false);}
@@ -215,6 +225,9 @@ private:
     FileChunk::UP createReadOnlyFile(FileId fileId, NameId nameId);
     FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum);
     FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId);
+    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId, DictionarySP dictionary);
+    DictionarySP trainDictionary(const FileChunk & source) const;
+    void updateCompressionDictionary(const FileChunk & file);
     vespalib::string createFileName(NameId id) const;
     vespalib::string createDatFileName(NameId id) const;
     vespalib::string createIdxFileName(NameId id) const;
@@ -241,6 +254,7 @@ private:
         return (_fileChunks.empty() ? 0 : _fileChunks.back()->getLastPersistedSerialNum());
     }
     bool shouldCompactToActiveFile(size_t compactedSize) const;
+    bool compactInLidOrder() const { return _config.getCompactOrder() == Config::CompactOrder::LID; }
     std::pair<bool, FileId> findNextToCompact(bool compactDiskBloat);
     void incGeneration();
     bool canShrinkLidSpace(const MonitorGuard &guard) const;
@@ -256,6 +270,9 @@ private:
     FileId                                   _active;
     FileId                                   _prevActive;
     mutable std::mutex                       _updateLock;
+    // Dictionary of the newest file chunk having one, kept outside _updateLock for cheap lookup.
+    mutable std::mutex                       _dictionaryLock;
+    DictionarySP                             _compressionDictionary;
     bool                                     _readOnly;
     vespalib::Executor                      &_executor;
     SerialNum                                _initFlushSyncToken;
@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 
 class FastOS_FileInterface;
 
@@ -16,8 +17,25 @@ class FileRandRead
 {
 public:
     using FSP = std::shared_ptr<FastOS_FileInterface>;
+    /**
+     * A single read in a batch of reads. The returned file handle
+     * must be kept alive as long as the buffer is used.
+     */
+    struct ReadRequest {
+        size_t                 offset;
+        size_t                 size;
+        vespalib::DataBuffer & buffer;
+        FSP                    keepAlive;
+        ReadRequest(size_t offset_in, size_t size_in, vespalib::DataBuffer & buffer_in) noexcept
+            : offset(offset_in), size(size_in), buffer(buffer_in), keepAlive() {}
+    };
     virtual ~FileRandRead() = default;
     virtual FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) = 0;
+    /**
+     * Perform all reads in the batch. The default implementation
+     * performs them one by one.
+     */
+    virtual void read_batch(std::span<ReadRequest> requests);
     virtual int64_t getSize() const = 0;
 };
 
@@ -3,13 +3,26 @@
 #include "randreaders.h"
 #include "summaryexceptions.h"
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/io/batch_pread.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/fastos/file.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".search.docstore.randreaders");
 
 namespace search {
 
+void
+FileRandRead::read_batch(std::span<ReadRequest> requests)
+{
+    for (auto & request : requests) {
+        request.keepAlive = read(request.offset, request.buffer, request.size);
+    }
+}
+
 DirectIORandRead::DirectIORandRead(const vespalib::string & fileName)
     : _file(std::make_unique<FastOS_File>(fileName.c_str())),
       _alignment(1),
@@ -160,6 +173,61 @@ NormalRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
     return FSP();
 }
 
+IoUringRandRead::IoUringRandRead(const vespalib::string & fileName)
+    : _file(std::make_unique<FastOS_File>(fileName.c_str())),
+      _fd(-1)
+{
+    if ( ! _file->OpenReadOnly()) {
+        throw SummaryException("Failed opening data file", *_file, VESPA_STRLOC);
+    }
+    _fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (_fd < 0) {
+        throw SummaryException("Failed opening data file for batched reads", *_file, VESPA_STRLOC);
+    }
+}
+
+IoUringRandRead::~IoUringRandRead()
+{
+    ::close(_fd);
+}
+
+FileRandRead::FSP
+IoUringRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
+{
+    buffer.clear();
+    buffer.ensureFree(sz);
+    _file->ReadBuf(buffer.getFree(), sz, offset);
+    buffer.moveFreeToData(sz);
+    return FSP();
+}
+
+void
+IoUringRandRead::read_batch(std::span<ReadRequest> requests)
+{
+    std::vector<vespalib::BatchPread::Request> reads;
+    reads.reserve(requests.size());
+    for (auto & request : requests) {
+        request.buffer.clear();
+        request.buffer.ensureFree(request.size);
+        reads.emplace_back(_fd, request.buffer.getFree(), request.size, request.offset);
+    }
+    vespalib::BatchPread::read(reads);
+    for (size_t i(0); i < requests.size(); i++) {
+        if (reads[i].result != ssize_t(requests[i].size)) {
+            throw SummaryException(vespalib::make_string("Batched read of %zu bytes at offset %zu returned %zd",
+                                                         requests[i].size, requests[i].offset, reads[i].result),
+                                   *_file, VESPA_STRLOC);
+        }
+        requests[i].buffer.moveFreeToData(requests[i].size);
+    }
+}
+
+int64_t
+IoUringRandRead::getSize() const
+{
+    return _file->getSize();
+}
+
 int64_t
 NormalRandRead::getSize() const
 {
@@ -50,6 +50,24 @@ private:
     std::mutex                                _lock;
 };
 
+/**
+ * Reads using normal (buffered) io. A batch of reads is submitted to
+ * the kernel at once using io_uring when it is available, so that the
+ * storage device can serve the reads in parallel.
+ */
+class IoUringRandRead : public FileRandRead
+{
+public:
+    IoUringRandRead(const vespalib::string & fileName);
+    ~IoUringRandRead() override;
+    FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
+    void read_batch(std::span<ReadRequest> requests) override;
+    int64_t getSize() const override;
+private:
+    std::unique_ptr<FastOS_FileInterface>  _file;
+    int                                    _fd;
+};
+
 class NormalRandRead : public FileRandRead
 {
 public:
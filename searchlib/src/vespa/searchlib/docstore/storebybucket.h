@@ -29,7 +29,9 @@ public:
                 _bucketId(bucketId), _localChunkId(localChunkId), _chunkId(chunkId), _lid(entry)
         { }
         bool operator < (const Index & b) const noexcept {
-            return BucketId::bucketIdToKey(_bucketId.getRawId()) < BucketId::bucketIdToKey(b._bucketId.getRawId());
+            uint64_t aKey = BucketId::bucketIdToKey(_bucketId.getRawId());
+            uint64_t bKey = BucketId::bucketIdToKey(b._bucketId.getRawId());
+            return (aKey < bKey) || ((aKey == bKey) && (_lid < b._lid));
         }
         BucketId _bucketId;
         uint32_t _localChunkId;
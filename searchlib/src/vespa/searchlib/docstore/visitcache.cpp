@@ -7,6 +7,7 @@
 #include <vespa/vespalib/stllike/cache.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstd_dictionary.h>
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/stllike/cache.hpp>
 #include <vespa/vespalib/stllike/hash_map.hpp>
@@ -80,21 +81,34 @@ CompressedBlobSet::CompressedBlobSet() noexcept
     : _positions(),
       _buffer(),
       _used(0),
-      _compression(CompressionConfig::Type::LZ4)
+      _compression(CompressionConfig::Type::LZ4),
+      _dictionary()
 { }
 
 CompressedBlobSet::~CompressedBlobSet() = default;
 
 CompressedBlobSet::CompressedBlobSet(CompressionConfig compression, BlobSet uncompressed)
+    : CompressedBlobSet(compression, DictionarySP(), std::move(uncompressed))
+{ }
+
+CompressedBlobSet::CompressedBlobSet(CompressionConfig compression, const DictionarySP & dictionary, BlobSet uncompressed)
     : _positions(uncompressed.stealPositions()),
       _buffer(),
       _used(0),
-      _compression(compression.type)
+      _compression(compression.type),
+      _dictionary()
 {
     if ( ! _positions.empty() ) {
         DataBuffer compressed;
         ConstBufferRef org = uncompressed.getBuffer();
-        _compression = vespalib::compression::compress(compression, org, compressed, false);
+        if (dictionary && (compression.type == CompressionConfig::ZSTD)) {
+            _compression = dictionary->compress(compression, org, compressed);
+            if (_compression == CompressionConfig::ZSTD) {
+                _dictionary = dictionary;
+            }
+        } else {
+            _compression = vespalib::compression::compress(compression, org, compressed, false);
+        }
         _used = compressed.getDataLen();
         _buffer = std::make_shared<Alloc>(Alloc::alloc(_used));
         memcpy(_buffer->get(), compressed.getData(), _used);
@@ -110,8 +124,12 @@ CompressedBlobSet::getBlobSet() const
     // These are frequent lage allocations that are to expensive to mmap.
     DataBuffer uncompressed(0, 1, Alloc::alloc(0, 16 * MemoryAllocator::HUGEPAGE_SIZE));
     if ( ! _positions.empty() ) {
-        decompress(_compression, getBufferSize(_positions),
-                   ConstBufferRef(_buffer->get(), _used), uncompressed, false);
+        if (_dictionary) {
+            _dictionary->decompress(getBufferSize(_positions), ConstBufferRef(_buffer->get(), _used), uncompressed);
+        } else {
+            decompress(_compression, getBufferSize(_positions),
+                       ConstBufferRef(_buffer->get(), _used), uncompressed, false);
+        }
     }
     return BlobSet(_positions, std::move(uncompressed).stealBuffer());
 }
@@ -185,7 +203,12 @@ VisitCache::BackingStore::read(const KeySet &key, CompressedBlobSet &blobs) cons
     blobSet.reserve(key.getKeys().size());
     VisitCollector collector(blobSet);
     _backingStore.read(key.getKeys(), collector);
-    blobs = CompressedBlobSet(_compression.load(std::memory_order_relaxed), std::move(blobSet));
+    CompressionConfig compression = _compression.load(std::memory_order_relaxed);
+    IDataStore::DictionarySP dictionary;
+    if (compression.type == CompressionConfig::ZSTD) {
+        dictionary = _backingStore.getCompressionDictionary();
+    }
+    blobs = CompressedBlobSet(compression, dictionary, std::move(blobSet));
     return ! blobs.empty();
 }
 
@@ -70,8 +70,14 @@ private:
 class CompressedBlobSet {
 public:
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using DictionarySP = IDataStore::DictionarySP;
     CompressedBlobSet() noexcept;
     CompressedBlobSet(CompressionConfig compression, BlobSet uncompressed);
+    /**
+     * The dictionary, if any, is used instead of plain zstd when compression is ZSTD.
+     * It is kept alive as long as the set refers to it.
+     */
+    CompressedBlobSet(CompressionConfig compression, const DictionarySP & dictionary, BlobSet uncompressed);
     CompressedBlobSet(CompressedBlobSet && rhs) noexcept = default;
     CompressedBlobSet & operator=(CompressedBlobSet && rhs) noexcept = default;
     CompressedBlobSet(const CompressedBlobSet & rhs) = default;
@@ -86,6 +92,7 @@ private:
     std::shared_ptr<Alloc>  _buffer;
     uint32_t                 _used;
     CompressionConfig::Type _compression;
+    DictionarySP            _dictionary;
 };
 
 /**
@@ -81,7 +81,8 @@ WriteableFileChunk(vespalib::Executor &executor,
                    const Config &config,
                    const TuneFileSummary &tune,
                    const FileHeaderContext &fileHeaderContext,
-                   const IBucketizer * bucketizer)
+                   const IBucketizer * bucketizer,
+                   DictionarySP dictionary)
     : FileChunk(fileId, nameId, baseName, tune, bucketizer),
       _config(config),
       _serialNum(initialSerialNum),
@@ -98,7 +99,7 @@ WriteableFileChunk(vespalib::Executor &executor,
       _idxFileSize(0),
       _currentDiskFootprint(0),
       _nextChunkId(1),
-      _active(std::make_unique<Chunk>(0, Chunk::Config(config.getMaxChunkBytes()))),
+      _active(),
       _alignment(1),
       _granularity(1),
       _maxChunkSize(0x100000),
@@ -110,6 +111,7 @@ WriteableFileChunk(vespalib::Executor &executor,
       _bucketMap(bucketizer)
 {
     _docIdLimit = docIdLimit;
+    _dictionary = std::move(dictionary);
     if (tune._write.getWantDirectIO()) {
         _dataFile.EnableDirectIO();
     }
@@ -131,7 +133,7 @@ WriteableFileChunk(vespalib::Executor &executor,
         auto idxFile = openIdx();
         readIdxHeader(*idxFile);
         if (_idxHeaderLen == 0) {
-            _idxHeaderLen = writeIdxHeader(fileHeaderContext, _docIdLimit, *idxFile);
+            _idxHeaderLen = writeIdxHeader(fileHeaderContext, _docIdLimit, _dictionary, *idxFile);
         }
         _idxFileSize.store(idxFile->getSize(), std::memory_order_relaxed);
         if ( ! idxFile->Sync()) {
@@ -140,6 +142,8 @@ WriteableFileChunk(vespalib::Executor &executor,
     } else {
         throw SummaryException("Failed opening data file", _dataFile, VESPA_STRLOC);
     }
+    // The dictionary is known after the headers are read or written.
+    _active = std::make_unique<Chunk>(0, createChunkConfig());
     _firstChunkIdToBeWritten = _active->getId();
     updateCurrentDiskFootprint();
 }
@@ -178,7 +182,7 @@ WriteableFileChunk::updateLidMap(const unique_lock &guard, ISetLid &ds, uint64_t
 {
     FileChunk::updateLidMap(guard, ds, serialNum, docIdLimit);
     _nextChunkId = _chunkInfo.size();
-    _active = std::make_unique<Chunk>(_nextChunkId++, Chunk::Config(_config.getMaxChunkBytes()));
+    _active = std::make_unique<Chunk>(_nextChunkId++, createChunkConfig());
     _serialNum = getLastPersistedSerialNum();
     _firstChunkIdToBeWritten = _active->getId();
     setDiskFootprint(0);
@@ -250,11 +254,14 @@ WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IB
             visitor.visit(entry._lid, vespalib::ConstBufferRef(entry._buf.get(), entry._size));
             entry._buf = vespalib::alloc::Alloc();
         }
+        std::vector<ChunkLids> chunks;
+        chunks.reserve(chunksOnFile.size());
         for (auto & it : chunksOnFile) {
             auto first = find_first(begin, it.first);
             auto last = seek_past(first, begin + count, it.first);
-            FileChunk::read(first, last - first, it.second, visitor);
+            chunks.push_back({first, size_t(last - first), it.second});
         }
+        FileChunk::read(chunks, visitor);
     } else {
         FileChunk::read(begin, count, visitor);
     }
@@ -661,7 +668,7 @@ int32_t WriteableFileChunk::flushLastIfNonEmpty(bool force)
         chunkId = _active->getId();
         _chunkMap[chunkId] = std::move(_active);
         assert(_nextChunkId < LidInfo::getChunkIdLimit());
-        _active = std::make_unique<Chunk>(_nextChunkId++, Chunk::Config(_config.getMaxChunkBytes()));
+        _active = std::make_unique<Chunk>(_nextChunkId++, createChunkConfig());
     }
     return chunkId;
 }
@@ -780,6 +787,7 @@ WriteableFileChunk::readIdxHeader(FastOS_FileInterface & idxFile)
         _idxHeaderLen = h.readFile(idxFile);
         idxFile.SetPosition(_idxHeaderLen);
         _docIdLimit = readDocIdLimit(h);
+        _dictionary = readDictionary(h, _config.getCompression().compressionLevel);
     } catch (IllegalHeaderException &e) {
         idxFile.SetPosition(0);
         try {
@@ -813,12 +821,14 @@ WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext)
     assert(_dataFile.getPosition() == 0);
     fileHeaderContext.addTags(h, _dataFile.GetFileName());
     h.putTag(Tag("desc", "Log data store chunk data"));
+    writeDictionary(h, _dictionary);
     _dataHeaderLen = h.writeFile(_dataFile);
 }
 
 
 uint64_t
-WriteableFileChunk::writeIdxHeader(const FileHeaderContext &fileHeaderContext, uint32_t docIdLimit, FastOS_FileInterface &file)
+WriteableFileChunk::writeIdxHeader(const FileHeaderContext &fileHeaderContext, uint32_t docIdLimit,
+                                   const DictionarySP &dictionary, FastOS_FileInterface &file)
 {
     using Tag = FileHeader::Tag;
     FileHeader h;
@@ -828,6 +838,7 @@ WriteableFileChunk::writeIdxHeader(const FileHeaderContext &fileHeaderContext, u
     fileHeaderContext.addTags(h, file.GetFileName());
     h.putTag(Tag("desc", "Log data store chunk index"));
     writeDocIdLimit(h, docIdLimit);
+    writeDictionary(h, dictionary);
     return h.writeFile(file);
 }
 
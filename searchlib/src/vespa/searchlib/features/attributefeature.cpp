@@ -16,6 +16,7 @@
 #include <vespa/searchlib/attribute/singlenumericattribute.h>
 #include <vespa/searchlib/attribute/multinumericattribute.h>
 #include <vespa/vespalib/util/issue.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".features.attributefeature");
@@ -121,6 +122,8 @@ public:
         o[3].as_number = 1;  // count
     }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(const Batch &batch) override;
 };
 
 class BoolAttributeExecutor final : public fef::FeatureExecutor {
@@ -133,6 +136,13 @@ public:
     void execute(uint32_t docId) override {
         outputs().set_number(0, _attribute.getFloat(docId));
     }
+    bool supports_batch() const override { return true; }
+    void execute_batch(const Batch &batch) override {
+        feature_t *values = batch.outputs[0];
+        for (size_t i = 0; i < batch.size(); ++i) {
+            values[i] = _attribute.getFloat(batch.docids[i]);
+        }
+    }
 };
 
 /**
@@ -236,6 +246,23 @@ SingleAttributeExecutor<T>::execute(uint32_t docId)
                      : util::getAsFeature(v);
 }
 
+template <typename T>
+void
+SingleAttributeExecutor<T>::execute_batch(const Batch &batch)
+{
+    const uint32_t *docids = batch.docids.data();
+    feature_t *values = batch.outputs[0];
+    for (size_t i = 0; i < batch.size(); ++i) {
+        typename T::LoadedValueType v = _attribute.getFast(docids[i]);
+        values[i] = __builtin_expect(attribute::isUndefined(v), false)
+                    ? attribute::getUndefined<feature_t>()
+                    : util::getAsFeature(v);
+    }
+    std::fill_n(batch.outputs[1], batch.size(), 0.0); // weight
+    std::fill_n(batch.outputs[2], batch.size(), 0.0); // contains
+    std::fill_n(batch.outputs[3], batch.size(), 1.0); // count
+}
+
 template <typename BaseType>
 void
 ArrayAttributeExecutor<BaseType>::execute(uint32_t docId)
@@ -53,11 +53,14 @@ private:
     const FastForest &_forest;
     FastForest::Context::UP _ctx;
     ArrayRef<float> _params;
+    std::vector<float> _batch_params;
 
 public:
     FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(const Batch &batch) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -76,6 +79,8 @@ public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(const Batch &batch) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -93,6 +98,8 @@ public:
     LazyCompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(const Batch &batch) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -151,7 +158,8 @@ public:
 FastForestExecutor::FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest)
     : _forest(forest),
       _ctx(_forest.create_context()),
-      _params(param_space)
+      _params(param_space),
+      _batch_params()
 {
 }
 
@@ -171,6 +179,21 @@ FastForestExecutor::execute(uint32_t)
     outputs().set_number(0, _forest.eval(*_ctx, &_params[0]));
 }
 
+void
+FastForestExecutor::execute_batch(const Batch &batch)
+{
+    size_t num_docs = batch.size();
+    _batch_params.resize(_params.size() * num_docs);
+    for (size_t i = 0; i < _params.size(); ++i) {
+        const feature_t *src = batch.inputs[i];
+        float *dst = &_batch_params[i * num_docs];
+        for (size_t doc = 0; doc < num_docs; ++doc) {
+            dst[doc] = src[doc];
+        }
+    }
+    _forest.eval_batch(*_ctx, _batch_params.data(), num_docs, batch.outputs[0]);
+}
+
 //-----------------------------------------------------------------------------
 
 CompiledRankingExpressionExecutor::CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
@@ -195,6 +218,18 @@ CompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(_params.data()));
 }
 
+void
+CompiledRankingExpressionExecutor::execute_batch(const Batch &batch)
+{
+    feature_t *result = batch.outputs[0];
+    for (size_t doc = 0; doc < batch.size(); ++doc) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = batch.inputs[i][doc];
+        }
+        result[doc] = _ranking_function(_params.data());
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 namespace {
@@ -203,6 +238,15 @@ using Context = fef::FeatureExecutor::Inputs;
 double resolve_input(void *ctx, size_t idx) { return ((const Context *)(ctx))->get_number(idx); }
 Context *make_ctx(const Context &inputs) { return const_cast<Context *>(&inputs); }
 
+struct BatchContext {
+    const fef::FeatureExecutor::Batch &batch;
+    size_t doc;
+};
+double resolve_batch_input(void *ctx, size_t idx) {
+    const auto &self = *((const BatchContext *)(ctx));
+    return self.batch.inputs[idx][self.doc];
+}
+
 }
 
 LazyCompiledRankingExpressionExecutor::LazyCompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
@@ -216,6 +260,16 @@ LazyCompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(resolve_input, make_ctx(inputs())));
 }
 
+void
+LazyCompiledRankingExpressionExecutor::execute_batch(const Batch &batch)
+{
+    feature_t *result = batch.outputs[0];
+    BatchContext ctx{batch, 0};
+    for (; ctx.doc < batch.size(); ++ctx.doc) {
+        result[ctx.doc] = _ranking_function(resolve_batch_input, &ctx);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 InterpretedRankingExpressionExecutor::InterpretedRankingExpressionExecutor(const InterpretedFunction &function,
@@ -90,6 +90,22 @@ public:
         vespalib::ArrayRef<NumberOrObject> _outputs;
     };
 
+    /**
+     * Columns of number values used when executing a block of
+     * documents at once. Input (output) column i holds the values of
+     * input (output) i for each document in docids.
+     **/
+    struct Batch {
+        vespalib::ConstArrayRef<uint32_t>          docids;
+        vespalib::ConstArrayRef<const feature_t *> inputs;
+        vespalib::ConstArrayRef<feature_t *>       outputs;
+        Batch(vespalib::ConstArrayRef<uint32_t> docids_in,
+              vespalib::ConstArrayRef<const feature_t *> inputs_in,
+              vespalib::ConstArrayRef<feature_t *> outputs_in) noexcept
+            : docids(docids_in), inputs(inputs_in), outputs(outputs_in) {}
+        size_t size() const noexcept { return docids.size(); }
+    };
+
 private:
     Inputs  _inputs;
     Outputs _outputs;
@@ -148,6 +164,25 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor supports batch execution. An
+     * executor supporting batch execution must only calculate number
+     * outputs, only use number inputs and must not use match
+     * data. This method returns false by default.
+     *
+     * @return true if execute_batch is implemented
+     **/
+    virtual bool supports_batch() const;
+
+    /**
+     * Execute this feature executor for a block of documents,
+     * reading inputs from and writing outputs to the columns of the
+     * given batch. Only called if supports_batch returns true.
+     *
+     * @param batch the documents to evaluate and their value columns
+     **/
+    virtual void execute_batch(const Batch &batch);
+
     /**
      * Make sure this executor has been executed for the given
      * document.
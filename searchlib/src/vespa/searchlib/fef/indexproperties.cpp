@@ -200,6 +200,21 @@ WeakAndRange::lookup(const Properties &props, double defaultValue)
     return lookupDouble(props, NAME, defaultValue);
 }
 
+const vespalib::string WeakAndBlockMax::NAME("vespa.weakand.block_max");
+const bool WeakAndBlockMax::DEFAULT_VALUE(false);
+
+bool
+WeakAndBlockMax::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+WeakAndBlockMax::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
 }
 
 namespace mutate {
@@ -397,6 +412,36 @@ NumSearchPartitions::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const vespalib::string WorkStealing::NAME("vespa.matching.work_stealing");
+const bool WorkStealing::DEFAULT_VALUE(false);
+
+bool
+WorkStealing::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+WorkStealing::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
+const vespalib::string QueryResultCacheMaxEntries::NAME("vespa.matching.query_result_cache.max_entries");
+const uint32_t QueryResultCacheMaxEntries::DEFAULT_VALUE(0);
+
+uint32_t
+QueryResultCacheMaxEntries::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+QueryResultCacheMaxEntries::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 const vespalib::string MinHitsPerThread::NAME("vespa.matching.minhitsperthread");
 const uint32_t MinHitsPerThread::DEFAULT_VALUE(0);
 
@@ -488,6 +533,36 @@ bool AlwaysMarkPhraseExpensive::check(const Properties &props, bool fallback) {
     return lookupBool(props, NAME, fallback);
 }
 
+const vespalib::string FirstPhaseBatchSize::NAME("vespa.matching.first_phase_batch_size");
+const uint32_t FirstPhaseBatchSize::DEFAULT_VALUE(0);
+
+uint32_t
+FirstPhaseBatchSize::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+FirstPhaseBatchSize::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string SecondPhaseBatchSize::NAME("vespa.matching.second_phase_batch_size");
+const uint32_t SecondPhaseBatchSize::DEFAULT_VALUE(0);
+
+uint32_t
+SecondPhaseBatchSize::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+SecondPhaseBatchSize::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 } // namespace matching
 
 namespace softtimeout {
@@ -191,6 +191,19 @@ struct WeakAndRange {
     static double lookup(const Properties &props);
     static double lookup(const Properties &props, double defaultValue);
 };
+
+/**
+ * Use block-max WAND for WeakAndOperator when all terms search the
+ * same index field. Terms are scored with bm25 using interleaved
+ * features, so the field must have them (enable-bm25).
+ * Default is false.
+ **/
+struct WeakAndBlockMax {
+    static const vespalib::string NAME;
+    static const bool DEFAULT_VALUE;
+    static bool lookup(const Properties &props);
+    static bool lookup(const Properties &props, bool defaultValue);
+};
 }
 
 namespace mutate::on_match {
@@ -297,6 +310,32 @@ namespace matching {
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
 
+    /**
+     * Property to select the lock-free work-stealing docid range
+     * scheduler for multi-threaded matching. When enabled it takes
+     * precedence over the number of search partitions. The default
+     * value is false.
+     **/
+    struct WorkStealing {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+
+    /**
+     * Property for the max number of search replies kept in the
+     * query result cache of a rank profile. The cached replies are
+     * invalidated when new documents become visible to search. The
+     * default value is 0, meaning that no query results are cached.
+     **/
+    struct QueryResultCacheMaxEntries {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+
     /**
      * Property to control fallback to not building a global filter
      * for a query with a blueprint that wants a global filter. If the
@@ -369,6 +408,32 @@ namespace matching {
         static bool check(const Properties &props) { return check(props, DEFAULT_VALUE); }
         static bool check(const Properties &props, bool fallback);
     };
+
+    /**
+     * Property for the number of matched documents to calculate the
+     * first phase rank score for at a time. Batch execution is only
+     * used when all features of the first phase rank program support
+     * it. The default value is 0 (never use batch execution).
+     **/
+    struct FirstPhaseBatchSize {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+
+    /**
+     * Property for the number of hits to calculate the second phase
+     * rank score for at a time. Batch execution is only used when all
+     * features of the second phase rank program support it. The
+     * default value is 0 (never use batch execution).
+     **/
+    struct SecondPhaseBatchSize {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
 }
 
 namespace softtimeout {
@@ -13,6 +13,7 @@
 #include <vespa/vespalib/objects/nbostream.h>
 #include <algorithm>
 #include <cassert>
+#include <map>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".fef.rankprogram");
@@ -223,7 +224,10 @@ RankProgram::RankProgram(BlueprintResolver::SP resolver)
       _cold_stash(),
       _executors(),
       _unboxed_seeds(),
-      _is_const()
+      _is_const(),
+      _max_batch_size(0),
+      _batch_steps(),
+      _batch_seed(nullptr)
 {
 }
 
@@ -306,6 +310,88 @@ RankProgram::setup(const MatchData &md,
     }
 }
 
+bool
+RankProgram::setup_batch(size_t max_batch_size)
+{
+    assert(_max_batch_size == 0);
+    const auto &specs = _resolver->getExecutorSpecs();
+    const auto &seeds = _resolver->getSeedMap();
+    if ((max_batch_size == 0) || (seeds.size() != 1)) {
+        return false;
+    }
+    auto seed = seeds.begin()->second;
+    if (specs[seed.executor].output_types[seed.output].is_object()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < specs.size(); ++i) {
+        FeatureExecutor *executor = _executors[i];
+        const auto &outputs = executor->outputs();
+        if ((outputs.size() == 0) || check_const(outputs.get_raw(0))) {
+            continue;
+        }
+        if (!executor->supports_batch()) {
+            return false;
+        }
+        for (const auto &type: specs[i].output_types) {
+            if (type.is_object()) {
+                return false;
+            }
+        }
+        for (const auto &ref: specs[i].inputs) {
+            if (specs[ref.executor].output_types[ref.output].is_object()) {
+                return false;
+            }
+        }
+    }
+    std::map<const NumberOrObject *, feature_t *> columns;
+    auto make_column = [&](const NumberOrObject *value) {
+        vespalib::ArrayRef<feature_t> column = _hot_stash.create_array<feature_t>(max_batch_size, 0.0);
+        columns.emplace(value, column.data());
+        return column.data();
+    };
+    auto get_column = [&](const NumberOrObject *value) {
+        auto pos = columns.find(value);
+        if (pos != columns.end()) {
+            return pos->second;
+        }
+        // constant values are broadcast into a column of their own
+        assert(check_const(value));
+        feature_t *column = make_column(value);
+        std::fill(column, column + max_batch_size, value->as_number);
+        return column;
+    };
+    for (uint32_t i = 0; i < specs.size(); ++i) {
+        FeatureExecutor *executor = _executors[i];
+        const auto &outputs = executor->outputs();
+        if ((outputs.size() == 0) || check_const(outputs.get_raw(0))) {
+            continue;
+        }
+        const auto &input_refs = specs[i].inputs;
+        vespalib::ArrayRef<const feature_t *> inputs = _hot_stash.create_array<const feature_t *>(input_refs.size(), nullptr);
+        for (size_t input_idx = 0; input_idx < input_refs.size(); ++input_idx) {
+            auto ref = input_refs[input_idx];
+            inputs[input_idx] = get_column(_executors[ref.executor]->outputs().get_raw(ref.output));
+        }
+        vespalib::ArrayRef<feature_t *> output_columns = _hot_stash.create_array<feature_t *>(outputs.size(), nullptr);
+        for (size_t out_idx = 0; out_idx < outputs.size(); ++out_idx) {
+            output_columns[out_idx] = make_column(outputs.get_raw(out_idx));
+        }
+        _batch_steps.push_back(BatchStep{executor, inputs, output_columns});
+    }
+    _batch_seed = get_column(_executors[seed.executor]->outputs().get_raw(seed.output));
+    _max_batch_size = max_batch_size;
+    return true;
+}
+
+void
+RankProgram::execute_batch(vespalib::ConstArrayRef<uint32_t> docids)
+{
+    assert(docids.size() <= _max_batch_size);
+    for (const auto &step: _batch_steps) {
+        step.executor->execute_batch(FeatureExecutor::Batch(docids, step.inputs, step.outputs));
+    }
+}
+
 FeatureResolver
 RankProgram::get_seeds(bool unbox_seeds) const
 {
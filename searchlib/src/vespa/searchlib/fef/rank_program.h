@@ -34,12 +34,21 @@ private:
     using ValueSet = vespalib::hash_set<const NumberOrObject *, vespalib::hash<const NumberOrObject *>,
                                         std::equal_to<>, vespalib::hashtable_base::and_modulator>;
 
+    struct BatchStep {
+        FeatureExecutor                            *executor;
+        vespalib::ConstArrayRef<const feature_t *>  inputs;
+        vespalib::ConstArrayRef<feature_t *>        outputs;
+    };
+
     BlueprintResolver::SP            _resolver;
     vespalib::Stash                  _hot_stash;
     vespalib::Stash                  _cold_stash;
     std::vector<FeatureExecutor *>   _executors;
     MappedValues                     _unboxed_seeds;
     ValueSet                         _is_const;
+    size_t                           _max_batch_size;
+    std::vector<BatchStep>           _batch_steps;
+    const feature_t                 *_batch_seed;
 
     bool check_const(const NumberOrObject *value) const { return (_is_const.count(value) == 1); }
     bool check_const(FeatureExecutor *executor, const std::vector<BlueprintResolver::FeatureRef> &inputs) const;
@@ -73,6 +82,32 @@ public:
                const Properties &featureOverrides = Properties(),
                vespalib::ExecutionProfiler *profiler = nullptr);
 
+    /**
+     * Prepare this rank program for calculating its seed for blocks
+     * of up to max_batch_size documents at a time. This is only
+     * possible when the program has a single number seed and all
+     * non-constant feature executors support batch execution (which
+     * also means that no executor uses match data). Must be called
+     * after setup.
+     *
+     * @return true if batch execution is possible
+     * @param max_batch_size the maximum number of documents in a batch
+     **/
+    bool setup_batch(size_t max_batch_size);
+
+    /**
+     * The maximum number of documents in a batch, 0 if batch
+     * execution has not been set up.
+     **/
+    size_t max_batch_size() const { return _max_batch_size; }
+
+    /**
+     * Calculate the seed for all the given documents. Values are
+     * written to the batch seed column, one value per document.
+     **/
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids);
+    const feature_t *get_batch_seed() const { return _batch_seed; }
+
     /**
      * Obtain the names and storage locations of all seed features for
      * this rank program. Programs for ranking phases will only have a
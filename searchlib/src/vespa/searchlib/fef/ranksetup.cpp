@@ -41,6 +41,8 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _secondPhaseRankFeature(),
       _degradationAttribute(),
       _termwise_limit(1.0),
+      _first_phase_batch_size(0),
+      _second_phase_batch_size(0),
       _numThreads(0),
       _minHitsPerThread(0),
       _numSearchPartitions(0),
@@ -65,6 +67,7 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _compileError(false),
       _degradationAscendingOrder(false),
       _always_mark_phrase_expensive(false),
+      _work_stealing(false),
       _diversityAttribute(),
       _diversityMinGroups(1),
       _diversityCutoffFactor(10.0),
@@ -75,6 +78,7 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _global_filter_upper_limit(1.0),
       _target_hits_max_adjustment_factor(20.0),
       _weakand_range(0.0),
+      _weakand_block_max(false),
       _fuzzy_matching_algorithm(vespalib::FuzzyMatchingAlgorithm::DfaTable),
       _mutateOnMatch(),
       _mutateOnFirstPhase(),
@@ -106,9 +110,12 @@ RankSetup::configure()
         _feature_rename_map[rename.first] = rename.second;
     }
     set_termwise_limit(matching::TermwiseLimit::lookup(_indexEnv.getProperties()));
+    set_first_phase_batch_size(matching::FirstPhaseBatchSize::lookup(_indexEnv.getProperties()));
+    set_second_phase_batch_size(matching::SecondPhaseBatchSize::lookup(_indexEnv.getProperties()));
     setNumThreadsPerSearch(matching::NumThreadsPerSearch::lookup(_indexEnv.getProperties()));
     setMinHitsPerThread(matching::MinHitsPerThread::lookup(_indexEnv.getProperties()));
     setNumSearchPartitions(matching::NumSearchPartitions::lookup(_indexEnv.getProperties()));
+    set_work_stealing(matching::WorkStealing::lookup(_indexEnv.getProperties()));
     setHeapSize(hitcollector::HeapSize::lookup(_indexEnv.getProperties()));
     setArraySize(hitcollector::ArraySize::lookup(_indexEnv.getProperties()));
     setDegradationAttribute(matchphase::DegradationAttribute::lookup(_indexEnv.getProperties()));
@@ -132,6 +139,7 @@ RankSetup::configure()
     set_target_hits_max_adjustment_factor(matching::TargetHitsMaxAdjustmentFactor::lookup(_indexEnv.getProperties()));
     set_fuzzy_matching_algorithm(matching::FuzzyAlgorithm::lookup(_indexEnv.getProperties()));
     set_weakand_range(temporary::WeakAndRange::lookup(_indexEnv.getProperties()));
+    set_weakand_block_max(temporary::WeakAndBlockMax::lookup(_indexEnv.getProperties()));
     _mutateOnMatch._attribute = mutate::on_match::Attribute::lookup(_indexEnv.getProperties());
     _mutateOnMatch._operation = mutate::on_match::Operation::lookup(_indexEnv.getProperties());
     _mutateOnFirstPhase._attribute = mutate::on_first_phase::Attribute::lookup(_indexEnv.getProperties());
@@ -50,6 +50,8 @@ private:
     vespalib::string         _secondPhaseRankFeature;
     vespalib::string         _degradationAttribute;
     double                   _termwise_limit;
+    uint32_t                 _first_phase_batch_size;
+    uint32_t                 _second_phase_batch_size;
     uint32_t                 _numThreads;
     uint32_t                 _minHitsPerThread;
     uint32_t                 _numSearchPartitions;
@@ -74,6 +76,7 @@ private:
     bool                     _compileError;
     bool                     _degradationAscendingOrder;
     bool                     _always_mark_phrase_expensive;
+    bool                     _work_stealing;
     vespalib::string         _diversityAttribute;
     uint32_t                 _diversityMinGroups;
     double                   _diversityCutoffFactor;
@@ -84,6 +87,7 @@ private:
     double                   _global_filter_upper_limit;
     double                   _target_hits_max_adjustment_factor;
     double                   _weakand_range;
+    bool                     _weakand_block_max;
     vespalib::FuzzyMatchingAlgorithm _fuzzy_matching_algorithm;
     MutateOperation          _mutateOnMatch;
     MutateOperation          _mutateOnFirstPhase;
@@ -170,6 +174,20 @@ public:
      **/
     double get_termwise_limit() const { return _termwise_limit; }
 
+    /**
+     * Set the number of matched documents to calculate the first
+     * phase rank score for at a time. 0 means no batch execution.
+     **/
+    void set_first_phase_batch_size(uint32_t value) { _first_phase_batch_size = value; }
+    uint32_t get_first_phase_batch_size() const { return _first_phase_batch_size; }
+
+    /**
+     * Set the number of hits to calculate the second phase rank
+     * score for at a time. 0 means no batch execution.
+     **/
+    void set_second_phase_batch_size(uint32_t value) { _second_phase_batch_size = value; }
+    uint32_t get_second_phase_batch_size() const { return _second_phase_batch_size; }
+
     /**
      * Sets the number of threads per search.
      *
@@ -190,6 +208,9 @@ public:
 
     uint32_t getNumSearchPartitions() const { return _numSearchPartitions; }
 
+    void set_work_stealing(bool value) { _work_stealing = value; }
+    bool get_work_stealing() const { return _work_stealing; }
+
     /**
      * Sets the heap size to be used in the hit collector.
      *
@@ -412,6 +433,8 @@ public:
     vespalib::FuzzyMatchingAlgorithm get_fuzzy_matching_algorithm() const { return _fuzzy_matching_algorithm; }
     void set_weakand_range(double v) { _weakand_range = v; }
     double get_weakand_range() const { return _weakand_range; }
+    void set_weakand_block_max(bool v) { _weakand_block_max = v; }
+    bool get_weakand_block_max() const { return _weakand_block_max; }
 
     /**
      * This method may be used to indicate that certain features
@@ -2,6 +2,7 @@
 
 #include "postinglistfile.h"
 #include "postinglistparams.h"
+#include "docidandfeatures.h"
 #include <vespa/fastos/file.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
 
@@ -10,6 +11,17 @@ namespace search::index {
 PostingListFileSeqRead::PostingListFileSeqRead() = default;
 PostingListFileSeqRead::~PostingListFileSeqRead() = default;
 
+void
+PostingListFileSeqRead::
+skipWord(const PostingListCounts &counts)
+{
+    DocIdAndFeatures features;
+    readCounts(counts);
+    for (uint64_t i = 0; i < counts._numDocs; ++i) {
+        readDocIdAndFeatures(features);
+    }
+}
+
 void
 PostingListFileSeqRead::
 getParams(PostingListParams &params)
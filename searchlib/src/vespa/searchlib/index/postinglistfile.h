@@ -36,6 +36,12 @@ public:
      */
     virtual void readCounts(const PostingListCounts &counts) = 0;
 
+    /**
+     * Skip posting list for a word, instead of reading counts and
+     * document ids for it.
+     */
+    virtual void skipWord(const PostingListCounts &counts);
+
     /**
      * Open posting list file for sequential read.
      */
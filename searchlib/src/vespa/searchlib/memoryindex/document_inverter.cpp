@@ -4,6 +4,7 @@
 #include "document_inverter_context.h"
 #include "i_field_index_collection.h"
 #include "field_inverter.h"
+#include "invert_context.h"
 #include "invert_task.h"
 #include "push_task.h"
 #include "remove_task.h"
@@ -87,6 +88,17 @@ DocumentInverter::removeDocuments(LidVector lids)
     }
 }
 
+void
+DocumentInverter::prepare_push(const InvertContext& invert_context)
+{
+    for (auto field_id : invert_context.get_fields()) {
+        _inverters[field_id]->prepare_push();
+    }
+    for (auto uri_field_id : invert_context.get_uri_fields()) {
+        _urlInverters[uri_field_id]->prepare_push();
+    }
+}
+
 void
 DocumentInverter::pushDocuments(OnWriteDoneType on_write_done)
 {
@@ -107,7 +119,8 @@ DocumentInverter::pushDocuments(OnWriteDoneType on_write_done)
             assert(pusher < all_push_tasks.size());
             push_tasks.emplace_back(all_push_tasks[pusher]);
         }
-        invert_threads.execute(invert_context.get_id(), [push_tasks(std::move(push_tasks))]() { });
+        // Push tasks are scheduled when the last reference is dropped, after sorting on the invert threads
+        invert_threads.execute(invert_context.get_id(), [this, &invert_context, push_tasks(std::move(push_tasks))]() { prepare_push(invert_context); });
     }
 }
 
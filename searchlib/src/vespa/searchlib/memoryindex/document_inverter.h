@@ -22,6 +22,7 @@ namespace search::memoryindex {
 
 class DocumentInverterContext;
 class FieldInverter;
+class InvertContext;
 class UrlFieldInverter;
 class IFieldIndexCollection;
 
@@ -44,6 +45,7 @@ private:
     std::vector<std::unique_ptr<UrlFieldInverter>> _urlInverters;
     vespalib::MonitoredRefCount                    _ref_count;
 
+    void prepare_push(const InvertContext& invert_context);
 public:
     /**
      * Create a new document inverter based on the given schema.
@@ -58,8 +60,9 @@ public:
      * Push the current batch of inverted documents to corresponding field indexes.
      *
      * This function is async:
-     * For each field inverter a task for pushing the inverted documents to the corresponding field index
-     * is added to the 'push threads' executor, then this function returns.
+     * For each field inverter a task for sorting the inverted documents is added to the 'invert threads'
+     * executor. When sorting is completed, a task for pushing the inverted documents to the corresponding
+     * field index is added to the 'push threads' executor. This function returns without waiting.
      * All tasks hold a reference to the 'on_write_done' callback, so when the last task is completed,
      * the callback is destructed.
      *
@@ -72,6 +72,8 @@ FieldInverter::reset()
     _pendingDocs.clear();
     _abortedDocs.clear();
     _removeDocs.clear();
+    _prepared = false;
+    _prepared_positions = 0;
     _oldPosSize = 0u;
 }
 
@@ -259,6 +261,8 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
       _abortedDocs(),
       _pendingDocs(),
       _removeDocs(),
+      _prepared(false),
+      _prepared_positions(0),
       _remover(remover),
       _inserter(inserter),
       _calculator(calculator)
@@ -410,9 +414,49 @@ FieldInverter::applyRemoves()
     _removeDocs.clear();
 }
 
+void
+FieldInverter::sort_words_and_positions()
+{
+    sortWords();
+
+    // Sort for terms.
+    ShiftBasedRadixSorter<PosInfo, FullRadix, std::less<PosInfo>, 56, true>::
+        radix_sort(FullRadix(), std::less<PosInfo>(), &_positions[0], _positions.size(), 16);
+}
+
+void
+FieldInverter::prepare_push()
+{
+    if (_prepared) {
+        return;
+    }
+    trimAbortedDocs();
+    if (!_positions.empty()) {
+        sort_words_and_positions();
+    }
+    _prepared = true;
+    _prepared_positions = _positions.size();
+}
+
+void
+FieldInverter::undo_prepare_push()
+{
+    // Replace word numbers with word references for positions sorted by prepare_push()
+    for (size_t i = 0; i < _prepared_positions; ++i) {
+        auto &p = _positions[i];
+        p._wordNum = _wordRefs[p._wordNum];
+    }
+    _prepared = false;
+    _prepared_positions = 0;
+}
+
 void
 FieldInverter::push_documents_internal()
 {
+    if (_prepared && _positions.size() != _prepared_positions) {
+        // Removes applied by the push thread added positions, sort again
+        undo_prepare_push();
+    }
     trimAbortedDocs();
 
     if (_positions.empty()) {
@@ -420,11 +464,9 @@ FieldInverter::push_documents_internal()
         return;             // All documents with words aborted
     }
 
-    sortWords();
-
-    // Sort for terms.
-    ShiftBasedRadixSorter<PosInfo, FullRadix, std::less<PosInfo>, 56, true>::
-        radix_sort(FullRadix(), std::less<PosInfo>(), &_positions[0], _positions.size(), 16);
+    if (!_prepared) {
+        sort_words_and_positions();
+    }
 
     constexpr uint32_t NO_ELEMENT_ID = std::numeric_limits<uint32_t>::max();
     constexpr uint32_t NO_WORD_POS = std::numeric_limits<uint32_t>::max();
@@ -188,6 +188,8 @@ private:
     std::vector<PositionRange>                  _abortedDocs;
     vespalib::hash_map<uint32_t, PositionRange> _pendingDocs;
     UInt32Vector                                _removeDocs;
+    bool                                        _prepared;
+    size_t                                      _prepared_positions;
 
     FieldIndexRemover                &_remover;
     IOrderedFieldIndexInserter       &_inserter;
@@ -267,6 +269,12 @@ private:
      */
     void sortWords();
 
+    /**
+     * Sort words and positions, to prepare for pushing to the memory index.
+     */
+    void sort_words_and_positions();
+    void undo_prepare_push();
+
     void moveNotAbortedDocs(uint32_t &dstIdx, uint32_t srcIdx, uint32_t nextTrimIdx);
 
     void trimAbortedDocs();
@@ -298,6 +306,15 @@ public:
      */
     void applyRemoves();
 
+    /**
+     * Trim aborted documents and sort inverted documents. Called by the
+     * invert thread before the push thread calls pushDocuments(),
+     * leaving the push thread with only the updates to the memory index
+     * structures for this field. Sorting is redone by the push thread if
+     * applying removes for previously pushed documents adds positions.
+     */
+    void prepare_push();
+
     /**
      * Push the current batch of inverted documents to the FieldIndex using the given inserter.
      */
@@ -293,6 +293,19 @@ UrlFieldInverter::applyRemoves()
     _hostname->applyRemoves();
 }
 
+void
+UrlFieldInverter::prepare_push()
+{
+    _all->prepare_push();
+    _scheme->prepare_push();
+    _host->prepare_push();
+    _port->prepare_push();
+    _path->prepare_push();
+    _query->prepare_push();
+    _fragment->prepare_push();
+    _hostname->prepare_push();
+}
+
 void
 UrlFieldInverter::pushDocuments()
 {
@@ -53,6 +53,7 @@ public:
     void removeDocument(uint32_t docId);
 
     void applyRemoves();
+    void prepare_push();
     void pushDocuments();
 };
 
@@ -0,0 +1,38 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstdint>
+
+namespace search::queryeval {
+
+/**
+ * Interface for getting upper bounds of the interleaved features
+ * (number of occurrences and field length) for blocks of documents in
+ * a posting list, without decoding the documents in the block.
+ *
+ * Used by block-max WAND to skip blocks of documents that cannot
+ * produce a hit.
+ */
+class BlockMaxInfo {
+public:
+    struct Block {
+        uint32_t last_doc_id;      // last document id covered by block
+        uint32_t max_num_occs;     // max number of occurrences in block
+        uint32_t min_field_length; // min field length in block
+        Block() noexcept : last_doc_id(0), max_num_occs(0), min_field_length(0) {}
+    };
+    virtual ~BlockMaxInfo() = default;
+    /**
+     * Locate the block containing the given docid without moving the
+     * iterator. The bounds are valid for all documents in the posting
+     * list in the range [docid, block.last_doc_id] that are not
+     * before the current position of the iterator. The docid must not
+     * be less than the docid given in the previous call since the
+     * last call to initRange.
+     *
+     * @return false if no block info is available for the docid.
+     **/
+    virtual bool find_block(uint32_t docid, Block &block) = 0;
+};
+
+}
@@ -9,6 +9,7 @@
 #include "full_search.h"
 #include "leaf_blueprints.h"
 #include "matching_elements_search.h"
+#include "nearest_neighbor_blueprint.h"
 #include "orsearch.h"
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/vespalib/objects/visit.hpp>
@@ -651,11 +652,20 @@ IntermediateBlueprint::sort(InFlow in_flow)
 void
 IntermediateBlueprint::set_global_filter(const GlobalFilter &global_filter, double estimated_hit_ratio)
 {
+    std::vector<NearestNeighborBlueprint*> nearest_neighbor_children;
     for (auto & child : _children) {
         if (child->getState().want_global_filter()) {
-            child->set_global_filter(global_filter, estimated_hit_ratio);
+            if (auto* nn = child->as_nearest_neighbor()) {
+                // Searched together below, to let the index share work between query vectors
+                nearest_neighbor_children.push_back(nn);
+            } else {
+                child->set_global_filter(global_filter, estimated_hit_ratio);
+            }
         }
     }
+    if (!nearest_neighbor_children.empty()) {
+        NearestNeighborBlueprint::set_global_filter(nearest_neighbor_children, global_filter, estimated_hit_ratio);
+    }
 }
 
 SearchIterator::UP
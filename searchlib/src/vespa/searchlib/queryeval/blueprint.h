@@ -36,6 +36,7 @@ class AndBlueprint;
 class AndNotBlueprint;
 class OrBlueprint;
 class EmptyBlueprint;
+class NearestNeighborBlueprint;
 
 /**
  * A Blueprint is an intermediate representation of a search. More
@@ -417,6 +418,7 @@ public:
     virtual OrBlueprint * asOr() noexcept { return nullptr; }
     virtual SourceBlenderBlueprint * asSourceBlender() noexcept { return nullptr; }
     virtual WeakAndBlueprint * asWeakAnd() noexcept { return nullptr; }
+    virtual NearestNeighborBlueprint * as_nearest_neighbor() noexcept { return nullptr; }
     virtual bool isRank() const noexcept { return false; }
     virtual const attribute::ISearchContext *get_attribute_search_context() const noexcept { return nullptr; }
 
@@ -11,7 +11,9 @@
 #include "termwise_blueprint_helper.h"
 #include "isourceselector.h"
 #include "field_spec.hpp"
+#include <vespa/searchlib/queryeval/wand/block_max_wand_search.h>
 #include <vespa/searchlib/queryeval/wand/weak_and_search.h>
+#include <vespa/searchlib/fef/matchdata.h>
 
 namespace search::queryeval {
 
@@ -424,11 +426,29 @@ WeakAndBlueprint::WeakAndBlueprint(uint32_t n, float idf_range, bool thread_safe
       _n(n),
       _idf_range(idf_range),
       _weights(),
-      _matching_phase(MatchingPhase::FIRST_PHASE)
+      _matching_phase(MatchingPhase::FIRST_PHASE),
+      _block_max(false),
+      _average_field_length(0.0)
 {}
 
 WeakAndBlueprint::~WeakAndBlueprint() = default;
 
+bool
+WeakAndBlueprint::use_block_max(const fef::MatchData &md) const noexcept
+{
+    if (!_block_max || childCnt() == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < childCnt(); ++i) {
+        const State &state = getChild(i).getState();
+        if (state.numFields() != 1 || state.field(0).isFilter() || state.field(0).resolve(md) == nullptr ||
+            state.field(0).getFieldId() != getChild(0).getState().field(0).getFieldId()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 FlowStats
 WeakAndBlueprint::calculate_flow_stats(uint32_t docid_limit) const {
     double child_est = OrFlow::estimate_of(get_children());
@@ -477,19 +497,45 @@ WeakAndBlueprint::always_needs_unpack() const
     return true;
 }
 
+SearchIterator::UP
+WeakAndBlueprint::createSearch(fef::MatchData &md) const
+{
+    if (use_block_max(md)) {
+        // term iterators decide what to unpack when they are created
+        for (size_t i = 0; i < childCnt(); ++i) {
+            getChild(i).getState().field(0).resolve(md)->setNeedInterleavedFeatures(true);
+        }
+    }
+    return IntermediateBlueprint::createSearch(md);
+}
+
 SearchIterator::UP
 WeakAndBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
-                                           search::fef::MatchData &) const
+                                           search::fef::MatchData &md) const
 {
     WeakAndSearch::Terms terms;
     assert(sub_searches.size() == childCnt());
     assert(_weights.size() == childCnt());
+    bool readonly_scores_heap = (_matching_phase != MatchingPhase::FIRST_PHASE);
+    if (use_block_max(md)) {
+        for (size_t i = 0; i < sub_searches.size(); ++i) {
+            terms.emplace_back(sub_searches[i].release(), _weights[i],
+                               getChild(i).getState().estimate().estHits,
+                               getChild(i).getState().field(0).resolve(md));
+        }
+        // the weakAnd score is not exposed, the root match data is only scratch space
+        auto scratch = std::make_unique<fef::MatchData>(fef::MatchData::params().numTermFields(1));
+        fef::TermFieldMatchData &root_tfmd = *scratch->resolveTermField(0);
+        return BlockMaxWandSearch::create(terms, wand::Bm25BlockMaxScorer(get_docid_limit(), _average_field_length),
+                                          wand::MatchParams(*_scores),
+                                          BlockMaxWandSearch::RankParams(root_tfmd, std::move(scratch)),
+                                          strict(), readonly_scores_heap);
+    }
     for (size_t i = 0; i < sub_searches.size(); ++i) {
         // TODO: pass ownership with unique_ptr
         terms.emplace_back(sub_searches[i].release(), _weights[i],
                            getChild(i).getState().estimate().estHits);
     }
-    bool readonly_scores_heap = (_matching_phase != MatchingPhase::FIRST_PHASE);
     return (_idf_range == 0.0)
         ? WeakAndSearch::create(terms, wand::MatchParams(*_scores), wand::TermFrequencyScorer(), _n, strict(),
                                 readonly_scores_heap)
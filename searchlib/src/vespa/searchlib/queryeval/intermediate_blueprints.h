@@ -94,8 +94,11 @@ private:
     float                 _idf_range;
     std::vector<uint32_t> _weights;
     MatchingPhase         _matching_phase;
+    bool                  _block_max;
+    double                _average_field_length;
 
     AnyFlow my_flow(InFlow in_flow) const override;
+    bool use_block_max(const fef::MatchData &md) const noexcept;
 public:
     FlowStats calculate_flow_stats(uint32_t docid_limit) const final;
     HitEstimate combine(const std::vector<HitEstimate> &data) const override;
@@ -104,6 +107,7 @@ public:
     void sort(Children &children, InFlow in_flow) const override;
     bool always_needs_unpack() const override;
     WeakAndBlueprint * asWeakAnd() noexcept final { return this; }
+    SearchIterator::UP createSearch(fef::MatchData &md) const override;
     SearchIterator::UP
     createIntermediateSearch(MultiSearch::Children subSearches,
                              fef::MatchData &md) const override;
@@ -118,6 +122,17 @@ public:
     }
     uint32_t getN() const noexcept { return _n; }
     const std::vector<uint32_t> &getWeights() const noexcept { return _weights; }
+    /**
+     * Use block-max WAND with bm25 scoring of the interleaved features
+     * (number of occurrences and field length) of the terms. Only used
+     * when all terms search the same non-filter index field, which
+     * must have interleaved features.
+     **/
+    void enable_block_max(double average_field_length) noexcept {
+        _block_max = true;
+        _average_field_length = average_field_length;
+    }
+    bool is_block_max_enabled() const noexcept { return _block_max; }
     void set_matching_phase(MatchingPhase matching_phase) noexcept override;
 };
 
@@ -4,6 +4,7 @@
 #include "andsearch.h"
 #include "andnotsearch.h"
 #include "sourceblendersearch.h"
+#include <vespa/searchlib/common/bitvector.h>
 #include <vespa/vespalib/hwaccelerated/iaccelerated.h>
 
 namespace search::queryeval {
@@ -85,6 +86,17 @@ MultiBitVector<Update>::fetchChunk(uint32_t index) noexcept
     _lastMaxDocIdLimitRequireFetch = (baseIndex + NumWordsInBatch) * BitWord::WordLen;
 }
 
+template<typename Update>
+void
+MultiBitVector<Update>::assignTo(BitVector &result) const
+{
+    if (Update::isAnd()) {
+        result.assignAnd(_bvs, _numDocs);
+    } else {
+        result.assignOr(_bvs, _numDocs);
+    }
+}
+
 template<typename Update>
 uint32_t
 MultiBitVector<Update>::strictSeek(uint32_t docId) noexcept
@@ -129,6 +141,17 @@ public:
         _mbv.reset();
     }
     UP andWith(UP filter, uint32_t estimate) override;
+    BitVector::UP get_hits(uint32_t begin_id) override {
+        BitVector::UP result(BitVector::create(begin_id, getEndId()));
+        _mbv.assignTo(*result);
+        return result;
+    }
+    void or_hits_into(BitVector &result, uint32_t begin_id) override {
+        result.orWith(*get_hits(begin_id));
+    }
+    void and_hits_into(BitVector &result, uint32_t begin_id) override {
+        result.andWith(*get_hits(begin_id));
+    }
 protected:
     void doSeek(uint32_t docId) override;
     Trinary is_strict() const override { return Trinary::False; }
@@ -6,6 +6,8 @@
 #include "unpackinfo.h"
 #include <vespa/searchlib/common/bitword.h>
 
+namespace search { class BitVector; }
+
 namespace vespalib::hwaccelerated { class IAccelerated; }
 
 namespace search::queryeval {
@@ -36,6 +38,8 @@ public:
     uint32_t strictSeek(uint32_t docId) noexcept;
     bool seek(uint32_t docId) noexcept;
     bool acceptExtraFilter() const noexcept { return Update::isAnd(); }
+    // Combine all sources into result in one pass, instead of 128 bytes at a time.
+    void assignTo(BitVector &result) const;
 private:
     bool updateLastValue(uint32_t docId) noexcept {
         if (docId >= _lastMaxDocIdLimit) {
@@ -79,8 +79,8 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& f
 
 NearestNeighborBlueprint::~NearestNeighborBlueprint() = default;
 
-void
-NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter, double estimated_hit_ratio)
+bool
+NearestNeighborBlueprint::prepare_top_k(const GlobalFilter &global_filter, double estimated_hit_ratio)
 {
     _global_filter = global_filter.shared_from_this();
     _global_filter_set = true;
@@ -107,22 +107,70 @@ NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter, d
         if (_algorithm != Algorithm::EXACT_FALLBACK) {
             est_hits = std::min(est_hits, _adjusted_target_hits);
             setEstimate(HitEstimate(est_hits, false));
-            perform_top_k(nns_index);
+            return true;
         }
     }
+    return false;
 }
 
 void
-NearestNeighborBlueprint::perform_top_k(const search::tensor::NearestNeighborIndex* nns_index)
+NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter, double estimated_hit_ratio)
+{
+    if (prepare_top_k(global_filter, estimated_hit_ratio)) {
+        perform_top_k(_attr_tensor.nearest_neighbor_index());
+    }
+}
+
+bool
+NearestNeighborBlueprint::can_batch_top_k_with(const NearestNeighborBlueprint& rhs) const noexcept
 {
-    uint32_t k = _adjusted_target_hits;
-    const auto &df = _distance_calc->function();
-    if (_global_filter->is_active()) {
-        _found_hits = nns_index->find_top_k_with_filter(k, df, *_global_filter, k + _explore_additional_hits, _doom, _distance_threshold);
-        _algorithm = Algorithm::INDEX_TOP_K_WITH_FILTER;
-    } else {
-        _found_hits = nns_index->find_top_k(k, df, k + _explore_additional_hits, _doom, _distance_threshold);
-        _algorithm = Algorithm::INDEX_TOP_K;
+    return (_attr_tensor.nearest_neighbor_index() == rhs._attr_tensor.nearest_neighbor_index()) &&
+           (_adjusted_target_hits == rhs._adjusted_target_hits) &&
+           (_explore_additional_hits == rhs._explore_additional_hits) &&
+           (_distance_threshold == rhs._distance_threshold) &&
+           (&_doom == &rhs._doom);
+}
+
+void
+NearestNeighborBlueprint::set_global_filter(std::span<NearestNeighborBlueprint* const> blueprints,
+                                            const GlobalFilter &global_filter, double estimated_hit_ratio)
+{
+    std::vector<NearestNeighborBlueprint*> pending;
+    for (auto* bp : blueprints) {
+        if (bp->prepare_top_k(global_filter, estimated_hit_ratio)) {
+            pending.push_back(bp);
+        }
+    }
+    std::vector<NearestNeighborBlueprint*> batch;
+    std::vector<const search::tensor::BoundDistanceFunction*> dfs;
+    while (!pending.empty()) {
+        const auto& first = *pending.front();
+        batch.clear();
+        std::erase_if(pending, [&first, &batch](NearestNeighborBlueprint* bp) {
+            if (bp->can_batch_top_k_with(first)) {
+                batch.push_back(bp);
+                return true;
+            }
+            return false;
+        });
+        auto nns_index = batch.front()->_attr_tensor.nearest_neighbor_index();
+        if (batch.size() == 1) {
+            batch.front()->perform_top_k(nns_index);
+            continue;
+        }
+        dfs.clear();
+        for (auto* bp : batch) {
+            dfs.push_back(&bp->_distance_calc->function());
+        }
+        const auto& leader = *batch.front();
+        uint32_t k = leader._adjusted_target_hits;
+        const GlobalFilter* filter = global_filter.is_active() ? &global_filter : nullptr;
+        auto found_hits = nns_index->find_top_k_batch(k, dfs, filter, k + leader._explore_additional_hits,
+                                                      leader._doom, leader._distance_threshold);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            batch[i]->_found_hits = std::move(found_hits[i]);
+            batch[i]->_algorithm = (filter != nullptr) ? Algorithm::INDEX_TOP_K_WITH_FILTER : Algorithm::INDEX_TOP_K;
+        }
     }
 }
 
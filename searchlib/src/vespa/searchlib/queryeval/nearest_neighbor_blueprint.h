@@ -7,6 +7,7 @@
 #include <vespa/searchlib/tensor/distance_function.h>
 #include <vespa/searchlib/tensor/nearest_neighbor_index.h>
 #include <optional>
+#include <span>
 
 namespace search::tensor { class ITensorAttribute; }
 namespace vespalib::eval { struct Value; }
@@ -49,7 +50,9 @@ private:
     const vespalib::Doom& _doom;
     MatchingPhase _matching_phase;
 
+    bool prepare_top_k(const GlobalFilter &global_filter, double estimated_hit_ratio);
     void perform_top_k(const search::tensor::NearestNeighborIndex* nns_index);
+    bool can_batch_top_k_with(const NearestNeighborBlueprint& rhs) const noexcept;
 public:
     NearestNeighborBlueprint(const queryeval::FieldSpec& field,
                              std::unique_ptr<search::tensor::DistanceCalculator> distance_calc,
@@ -67,6 +70,13 @@ public:
     uint32_t get_target_hits() const { return _target_hits; }
     uint32_t get_adjusted_target_hits() const { return _adjusted_target_hits; }
     void set_global_filter(const GlobalFilter &global_filter, double estimated_hit_ratio) override;
+    /**
+     * Sets the global filter on a group of sibling blueprints. Blueprints searching the same
+     * nearest neighbor index with the same parameters are searched together using
+     * NearestNeighborIndex::find_top_k_batch(), sharing the graph traversal of the upper layers.
+     */
+    static void set_global_filter(std::span<NearestNeighborBlueprint* const> blueprints,
+                                  const GlobalFilter &global_filter, double estimated_hit_ratio);
     Algorithm get_algorithm() const { return _algorithm; }
     double get_distance_threshold() const { return _distance_threshold; }
 
@@ -82,6 +92,7 @@ public:
     void visitMembers(vespalib::ObjectVisitor& visitor) const override;
     bool always_needs_unpack() const override;
     void set_matching_phase(MatchingPhase matching_phase) noexcept override;
+    NearestNeighborBlueprint* as_nearest_neighbor() noexcept override { return this; }
 };
 
 std::ostream&
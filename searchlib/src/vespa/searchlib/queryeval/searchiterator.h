@@ -22,6 +22,7 @@ namespace search::attribute { class ISearchContext; }
 namespace search::queryeval {
 
 struct WeakAndSearch;
+class BlockMaxInfo;
 
 /**
  * This is the abstract superclass of all search objects. Each search
@@ -362,6 +363,12 @@ public:
 
     virtual WeakAndSearch *as_weak_and() noexcept { return nullptr; }
 
+    /**
+     * @return block max info for the underlying posting list, or
+     *         nullptr if not available.
+     */
+    virtual BlockMaxInfo *as_block_max_info() noexcept { return nullptr; }
+
     /**
      * This is used for adding an extra filter. If it is accepted it will return an empty UP.
      * If not you will get in in return. Currently it will only be accepted by a
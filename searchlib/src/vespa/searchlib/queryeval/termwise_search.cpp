@@ -29,6 +29,10 @@ struct TermwiseSearch : public SearchIterator {
             search->initRange(beginid, endid);
             my_first_hit = std::max(getDocId(), search->getDocId());
             result = search->get_hits(beginid);
+            if (!result->hasTrueBits()) {
+                // cheap when the hits were combined with a maintained count
+                my_first_hit = endid;
+            }
         }
         setDocId(my_first_hit);
     }
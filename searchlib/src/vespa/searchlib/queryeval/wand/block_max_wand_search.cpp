@@ -0,0 +1,259 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "block_max_wand_search.h"
+#include <vespa/searchlib/queryeval/block_max_info.h>
+#include <vespa/vespalib/objects/visit.h>
+
+namespace search::queryeval {
+
+namespace {
+
+struct BlockMaxTerm {
+    SearchIterator::UP       search;
+    BlockMaxInfo            *block_max;
+    fef::TermFieldMatchData *tfmd;
+    int32_t                  weight;
+    double                   factor;
+    wand::score_t            max_score;
+    BlockMaxTerm(SearchIterator *search_in, fef::TermFieldMatchData *tfmd_in, int32_t weight_in,
+                 double factor_in, wand::score_t max_score_in) noexcept
+        : search(search_in),
+          block_max(search->as_block_max_info()),
+          tfmd(tfmd_in),
+          weight(weight_in),
+          factor(factor_in),
+          max_score(max_score_in)
+    {}
+    uint32_t doc_id() const noexcept { return search->getDocId(); }
+};
+
+template <bool IS_STRICT>
+class BlockMaxWandSearchImpl final : public BlockMaxWandSearch
+{
+private:
+    using Block = BlockMaxInfo::Block;
+
+    fef::TermFieldMatchData   &_tfmd;
+    fef::MatchData::UP         _childrenMatchData;
+    std::vector<BlockMaxTerm>  _terms;
+    std::vector<uint32_t>      _order;
+    const Scorer               _scorer;
+    const wand::MatchParams    _matchParams;
+    score_t                    _threshold;
+    score_t                    _score;
+    std::vector<score_t>       _localScores;
+    const bool                 _readonly_scores_heap;
+
+    void updateThreshold(score_t newThreshold) {
+        if (newThreshold > _threshold) {
+            _threshold = newThreshold;
+        }
+    }
+
+    // Sort term indexes on current docid. Only a few terms are moved
+    // between each call, so insertion sort is sufficient.
+    void sort_terms() {
+        for (size_t i = 1; i < _order.size(); ++i) {
+            uint32_t idx = _order[i];
+            uint32_t doc_id = _terms[idx].doc_id();
+            size_t j = i;
+            for (; j > 0 && _terms[_order[j - 1]].doc_id() > doc_id; --j) {
+                _order[j] = _order[j - 1];
+            }
+            _order[j] = idx;
+        }
+    }
+
+    // Upper bound for the score of the given term for docid, also
+    // limiting next_doc_id to the first docid after the block.
+    score_t block_max_score(const BlockMaxTerm &term, uint32_t docid, uint32_t &next_doc_id) const {
+        Block block;
+        if (term.block_max != nullptr && term.block_max->find_block(docid, block)) {
+            if (block.last_doc_id < next_doc_id) {
+                next_doc_id = block.last_doc_id + 1;
+            }
+            return _scorer.calculate_block_max_score(term.factor, block.max_num_occs, block.min_field_length);
+        }
+        next_doc_id = docid + 1;
+        return term.max_score;
+    }
+
+    score_t calculate_score(uint32_t docid) {
+        score_t score = 0;
+        for (auto &term : _terms) {
+            if (term.doc_id() == docid) {
+                term.search->unpack(docid);
+                score += _scorer.calculate_score(term.factor, term.tfmd->getNumOccs(), term.tfmd->getFieldLength());
+            }
+        }
+        return score;
+    }
+
+    // Returns the number of terms (in docid order) needed to make the
+    // sum of the max scores exceed the threshold, including all terms
+    // positioned at the pivot docid. Returns 0 if there is no pivot.
+    size_t find_pivot() const {
+        score_t sum = 0;
+        for (size_t i = 0; i < _order.size(); ++i) {
+            const auto &term = _terms[_order[i]];
+            if (term.search->isAtEnd()) {
+                return 0;
+            }
+            sum += term.max_score;
+            if (sum > _threshold) {
+                uint32_t pivot_doc_id = term.doc_id();
+                size_t num = i + 1;
+                while (num < _order.size() && _terms[_order[num]].doc_id() == pivot_doc_id) {
+                    ++num;
+                }
+                return num;
+            }
+        }
+        return 0;
+    }
+
+    // Index (into _order) of the term with the largest max score among
+    // the first num terms that are positioned before docid.
+    size_t select_term_to_advance(size_t num, uint32_t docid) const {
+        size_t best = 0;
+        score_t best_score = -1;
+        for (size_t i = 0; i < num; ++i) {
+            const auto &term = _terms[_order[i]];
+            if (term.doc_id() < docid && term.max_score > best_score) {
+                best = i;
+                best_score = term.max_score;
+            }
+        }
+        return best;
+    }
+
+    void seek_strict(uint32_t docid) {
+        for (auto &term : _terms) {
+            if (term.doc_id() < docid) {
+                term.search->seek(docid);
+            }
+        }
+        for (;;) {
+            sort_terms();
+            size_t num = find_pivot();
+            if (num == 0) {
+                setAtEnd();
+                return;
+            }
+            uint32_t pivot_doc_id = _terms[_order[num - 1]].doc_id();
+            uint32_t next_doc_id = (num < _order.size()) ? _terms[_order[num]].doc_id() : getEndId();
+            score_t bound = 0;
+            for (size_t i = 0; i < num; ++i) {
+                bound += block_max_score(_terms[_order[i]], pivot_doc_id, next_doc_id);
+            }
+            if (bound <= _threshold) {
+                // no document before next_doc_id can beat the threshold
+                auto &term = _terms[_order[select_term_to_advance(num, next_doc_id)]];
+                term.search->seek(std::max(next_doc_id, pivot_doc_id + 1));
+            } else if (_terms[_order[0]].doc_id() == pivot_doc_id) {
+                _score = calculate_score(pivot_doc_id);
+                if (_score > _threshold) {
+                    setDocId(pivot_doc_id);
+                    return;
+                }
+                for (size_t i = 0; i < num; ++i) {
+                    _terms[_order[i]].search->seek(pivot_doc_id + 1);
+                }
+            } else {
+                auto &term = _terms[_order[select_term_to_advance(num, pivot_doc_id)]];
+                term.search->seek(pivot_doc_id);
+            }
+        }
+    }
+
+    void seek_unstrict(uint32_t docid) {
+        score_t bound = 0;
+        uint32_t next_doc_id = getEndId();
+        for (auto &term : _terms) {
+            if (term.doc_id() == docid || (term.doc_id() < docid && term.search->seek(docid))) {
+                bound += block_max_score(term, docid, next_doc_id);
+            }
+        }
+        if (bound > _threshold) {
+            _score = calculate_score(docid);
+            if (_score > _threshold) {
+                setDocId(docid);
+            }
+        }
+    }
+
+public:
+    BlockMaxWandSearchImpl(const Terms &terms, const Scorer &scorer, const wand::MatchParams &matchParams,
+                           RankParams &&rankParams, bool readonly_scores_heap)
+        : _tfmd(rankParams.rootMatchData),
+          _childrenMatchData(std::move(rankParams.childrenMatchData)),
+          _terms(),
+          _order(),
+          _scorer(scorer),
+          _matchParams(matchParams),
+          _threshold(matchParams.scoreThreshold),
+          _score(0),
+          _localScores(),
+          _readonly_scores_heap(readonly_scores_heap)
+    {
+        _terms.reserve(terms.size());
+        _order.reserve(terms.size());
+        for (const auto &term : terms) {
+            double factor = _scorer.calculate_term_factor(term.estHits, term.weight);
+            _order.push_back(_terms.size());
+            _terms.emplace_back(term.search, term.matchData, term.weight, factor, _scorer.calculate_max_score(factor));
+        }
+        _localScores.reserve(_matchParams.scoresAdjustFrequency);
+    }
+    size_t get_num_terms() const override { return _terms.size(); }
+    score_t get_max_score(size_t idx) const override { return _terms[idx].max_score; }
+
+    void doSeek(uint32_t docid) override {
+        updateThreshold(_matchParams.scores.getMinScore());
+        if (IS_STRICT) {
+            seek_strict(docid);
+        } else {
+            seek_unstrict(docid);
+        }
+    }
+    void doUnpack(uint32_t docid) override {
+        if (!_readonly_scores_heap) {
+            _localScores.push_back(_score);
+            if (_localScores.size() == _matchParams.scoresAdjustFrequency) {
+                _matchParams.scores.adjust(&_localScores[0], &_localScores[0] + _localScores.size());
+                _localScores.clear();
+            }
+        }
+        _tfmd.setRawScore(docid, _score);
+    }
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override {
+        for (size_t i = 0; i < _terms.size(); ++i) {
+            visit(visitor, vespalib::make_string("children[%zu]", i), _terms[i].search.get());
+        }
+    }
+    void initRange(uint32_t begin, uint32_t end) override {
+        BlockMaxWandSearch::initRange(begin, end);
+        for (auto &term : _terms) {
+            term.search->initRange(begin, end);
+        }
+    }
+    Trinary is_strict() const final { return IS_STRICT ? Trinary::True : Trinary::False; }
+};
+
+}
+
+SearchIterator::UP
+BlockMaxWandSearch::create(const Terms &terms,
+                           const Scorer &scorer,
+                           const wand::MatchParams &matchParams,
+                           RankParams &&rankParams,
+                           bool strict,
+                           bool readonly_scores_heap)
+{
+    if (strict) {
+        return std::make_unique<BlockMaxWandSearchImpl<true>>(terms, scorer, matchParams, std::move(rankParams), readonly_scores_heap);
+    }
+    return std::make_unique<BlockMaxWandSearchImpl<false>>(terms, scorer, matchParams, std::move(rankParams), readonly_scores_heap);
+}
+
+}
@@ -0,0 +1,52 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "wand_parts.h"
+#include "weak_and_heap.h"
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchlib/fef/matchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+
+namespace search::queryeval {
+
+/**
+ * Block-max WAND search iterator using a BM25 scorer based on the
+ * interleaved features (number of occurrences and field length) of the
+ * terms. Term iterators exposing BlockMaxInfo are used to skip blocks of
+ * documents where the sum of the per block upper bounds cannot beat the
+ * current threshold. Term iterators without block max information fall
+ * back to using the global max score of the term as upper bound.
+ *
+ * The match data of each term must be unpacked with interleaved features.
+ */
+struct BlockMaxWandSearch : public SearchIterator
+{
+    using score_t = wand::score_t;
+    using Terms = wand::Terms;
+    using Scorer = wand::Bm25BlockMaxScorer;
+
+    /**
+     * Params used for rank calculation.
+     */
+    struct RankParams
+    {
+        fef::TermFieldMatchData &rootMatchData;
+        fef::MatchData::UP       childrenMatchData;
+        RankParams(fef::TermFieldMatchData &rootMatchData_,
+                   fef::MatchData::UP &&childrenMatchData_) noexcept
+            : rootMatchData(rootMatchData_),
+              childrenMatchData(std::move(childrenMatchData_))
+        {}
+    };
+
+    virtual size_t get_num_terms() const = 0;
+    virtual score_t get_max_score(size_t idx) const = 0;
+
+    /**
+     * Takes ownership of the term search iterators.
+     **/
+    static SearchIterator::UP create(const Terms &terms, const Scorer &scorer, const wand::MatchParams &matchParams,
+                                     RankParams &&rankParams, bool strict, bool readonly_scores_heap);
+};
+
+}
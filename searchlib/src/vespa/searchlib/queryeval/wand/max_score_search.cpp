@@ -0,0 +1,247 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "max_score_search.h"
+#include <vespa/searchlib/attribute/i_docid_with_weight_posting_store.h>
+#include <algorithm>
+#include <numeric>
+#include <cassert>
+
+namespace search::queryeval {
+
+namespace {
+
+using score_t = wand::score_t;
+using MatchParams = MaxScoreSearch::MatchParams;
+
+score_t weight_bound(int32_t weight, int32_t min_weight, int32_t max_weight) noexcept {
+    // negative term contributions never help a document beat the threshold
+    return std::max(score_t(0), std::max(weight * (score_t)min_weight, weight * (score_t)max_weight));
+}
+
+template <bool IS_STRICT>
+class MaxScoreSearchImpl final : public MaxScoreSearch
+{
+private:
+    fef::TermFieldMatchData              &_tfmd;
+    // all per term vectors are ordered by increasing max score
+    std::vector<DocidWithWeightIterator>  _iterators;
+    std::vector<int32_t>                  _weights;
+    std::vector<score_t>                  _max_score;
+    // sum of max score for terms [0, i]
+    std::vector<score_t>                  _prefix_bound;
+    // terms [0, _num_non_essential) are non-essential
+    size_t                                _num_non_essential;
+    score_t                               _threshold;
+    score_t                               _boostedThreshold;
+    score_t                               _score;
+    const MatchParams                     _matchParams;
+    std::vector<score_t>                  _localScores;
+    const bool                            _readonly_scores_heap;
+
+    // As for ParallelWeakAndSearch, the boosted threshold is only used
+    // to decide which documents to skip (here: which terms are needed
+    // to produce candidates), while the score of a candidate is checked
+    // against the real threshold, see check_non_essential.
+    void update_essential_terms() {
+        while (_num_non_essential < _iterators.size() && _prefix_bound[_num_non_essential] <= _boostedThreshold) {
+            ++_num_non_essential;
+        }
+    }
+
+    void updateThreshold(score_t newThreshold) {
+        if (newThreshold > _threshold) {
+            _threshold = newThreshold;
+            _boostedThreshold = (newThreshold * _matchParams.thresholdBoostFactor);
+            update_essential_terms();
+        }
+    }
+
+    uint32_t doc_id(size_t i) const noexcept {
+        return _iterators[i].valid() ? _iterators[i].getKey() : search::endDocId;
+    }
+
+    score_t term_score(size_t i) const noexcept {
+        return _weights[i] * (score_t)_iterators[i].getData();
+    }
+
+    void seek_term(size_t i, uint32_t docid) noexcept {
+        auto &itr = _iterators[i];
+        if (itr.valid() && itr.getKey() < docid) {
+            itr.linearSeek(docid);
+        }
+    }
+
+    // Upper bound for the contribution of term i to docid without seeking the term.
+    score_t block_max_score(size_t i, uint32_t docid) const noexcept {
+        const auto &itr = _iterators[i];
+        if (!itr.valid()) {
+            return 0;
+        }
+        if (itr.getKey() >= docid) {
+            return (itr.getKey() == docid) ? term_score(i) : 0;
+        }
+        if (itr.getLeafLastKey() < docid) {
+            return _max_score[i];
+        }
+        const auto &aggr = itr.getLeafAggregated();
+        return weight_bound(_weights[i], aggr.getMin(), aggr.getMax());
+    }
+
+    // Adds the contribution of the non-essential terms to the partial
+    // score of docid, stopping early when the (unboosted) threshold
+    // cannot be beaten.
+    bool check_non_essential(uint32_t docid, score_t score) {
+        for (size_t i = _num_non_essential; i-- > 0; ) {
+            score_t rest = (i > 0) ? _prefix_bound[i - 1] : 0;
+            if (score + rest + block_max_score(i, docid) <= _threshold) {
+                return false;
+            }
+            seek_term(i, docid);
+            if (doc_id(i) == docid) {
+                score += term_score(i);
+            }
+        }
+        if (score > _threshold) {
+            _score = score;
+            return true;
+        }
+        return false;
+    }
+
+    void seek_strict(uint32_t docid) {
+        for (;;) {
+            if (_num_non_essential == _iterators.size()) {
+                // no document can beat the threshold
+                setAtEnd();
+                return;
+            }
+            uint32_t candidate = search::endDocId;
+            for (size_t i = _num_non_essential; i < _iterators.size(); ++i) {
+                seek_term(i, docid);
+                candidate = std::min(candidate, doc_id(i));
+            }
+            if (candidate >= getEndId()) {
+                setAtEnd();
+                return;
+            }
+            score_t score = 0;
+            for (size_t i = _num_non_essential; i < _iterators.size(); ++i) {
+                if (doc_id(i) == candidate) {
+                    score += term_score(i);
+                }
+            }
+            if (check_non_essential(candidate, score)) {
+                setDocId(candidate);
+                return;
+            }
+            docid = candidate + 1;
+        }
+    }
+
+    void seek_unstrict(uint32_t docid) {
+        score_t score = 0;
+        bool essential_hit = false;
+        for (size_t i = _iterators.size(); i-- > _num_non_essential; ) {
+            seek_term(i, docid);
+            if (doc_id(i) == docid) {
+                score += term_score(i);
+                essential_hit = true;
+            }
+        }
+        if (essential_hit && check_non_essential(docid, score)) {
+            setDocId(docid);
+        }
+    }
+
+public:
+    MaxScoreSearchImpl(fef::TermFieldMatchData &tfmd, const MatchParams &matchParams,
+                       const std::vector<int32_t> &weights,
+                       const std::vector<IDirectPostingStore::LookupResult> &dict_entries,
+                       const IDocidWithWeightPostingStore &attr, bool readonly_scores_heap)
+        : _tfmd(tfmd),
+          _iterators(),
+          _weights(),
+          _max_score(),
+          _prefix_bound(),
+          _num_non_essential(0),
+          _threshold(matchParams.scoreThreshold),
+          _boostedThreshold(_threshold * matchParams.thresholdBoostFactor),
+          _score(0),
+          _matchParams(matchParams),
+          _localScores(),
+          _readonly_scores_heap(readonly_scores_heap)
+    {
+        size_t num_terms = weights.size();
+        std::vector<score_t> bounds;
+        bounds.reserve(num_terms);
+        for (size_t i = 0; i < num_terms; ++i) {
+            bounds.push_back(weight_bound(weights[i], dict_entries[i].min_weight, dict_entries[i].max_weight));
+        }
+        std::vector<uint32_t> order(num_terms);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&bounds](uint32_t a, uint32_t b) { return bounds[a] < bounds[b]; });
+        _iterators.reserve(num_terms);
+        _weights.reserve(num_terms);
+        _max_score.reserve(num_terms);
+        _prefix_bound.reserve(num_terms);
+        score_t sum = 0;
+        for (uint32_t ref : order) {
+            attr.create(dict_entries[ref].posting_idx, _iterators);
+            _weights.push_back(weights[ref]);
+            _max_score.push_back(bounds[ref]);
+            sum += bounds[ref];
+            _prefix_bound.push_back(sum);
+        }
+        update_essential_terms();
+        _localScores.reserve(_matchParams.scoresAdjustFrequency);
+    }
+    size_t get_num_terms() const override { return _iterators.size(); }
+    score_t get_max_score(size_t idx) const override { return _max_score[idx]; }
+    size_t get_num_essential_terms() const override { return _iterators.size() - _num_non_essential; }
+
+    void doSeek(uint32_t docid) override {
+        updateThreshold(_matchParams.scores.getMinScore());
+        if (IS_STRICT) {
+            seek_strict(docid);
+        } else {
+            seek_unstrict(docid);
+        }
+    }
+    void doUnpack(uint32_t docid) override {
+        if (!_readonly_scores_heap) {
+            _localScores.push_back(_score);
+            if (_localScores.size() == _matchParams.scoresAdjustFrequency) {
+                _matchParams.scores.adjust(&_localScores[0], &_localScores[0] + _localScores.size());
+                _localScores.clear();
+            }
+        }
+        _tfmd.setRawScore(docid, _score);
+    }
+    void initRange(uint32_t begin, uint32_t end) override {
+        MaxScoreSearch::initRange(begin, end);
+        for (auto &itr : _iterators) {
+            itr.lower_bound(begin);
+        }
+    }
+    Trinary is_strict() const final { return IS_STRICT ? Trinary::True : Trinary::False; }
+};
+
+}
+
+SearchIterator::UP
+MaxScoreSearch::create(fef::TermFieldMatchData &tfmd,
+                       const MatchParams &matchParams,
+                       const std::vector<int32_t> &weights,
+                       const std::vector<IDirectPostingStore::LookupResult> &dict_entries,
+                       const IDocidWithWeightPostingStore &attr,
+                       bool strict,
+                       bool readonly_scores_heap)
+{
+    assert(weights.size() == dict_entries.size());
+    if (strict) {
+        return std::make_unique<MaxScoreSearchImpl<true>>(tfmd, matchParams, weights, dict_entries, attr, readonly_scores_heap);
+    }
+    return std::make_unique<MaxScoreSearchImpl<false>>(tfmd, matchParams, weights, dict_entries, attr, readonly_scores_heap);
+}
+
+}
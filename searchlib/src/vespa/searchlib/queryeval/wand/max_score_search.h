@@ -0,0 +1,44 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "parallel_weak_and_search.h"
+
+namespace search::queryeval {
+
+/**
+ * Dot product top-k search iterator over weighted set attribute
+ * posting lists using the MaxScore algorithm. Terms are ordered by
+ * their upper bound score, and the terms with the lowest upper bounds
+ * that together cannot beat the current threshold are non-essential:
+ * they are only used to score candidate documents produced by the
+ * essential terms. Non-essential terms are evaluated in decreasing
+ * upper bound order, and a candidate is dropped as soon as its
+ * remaining upper bound cannot beat the threshold. The min/max
+ * weights aggregated per posting list btree leaf are used as block
+ * upper bounds before seeking a non-essential term.
+ *
+ * The threshold is shared with other match threads through the scores
+ * heap, in the same way as for ParallelWeakAndSearch. This makes it
+ * well suited for queries with many terms, e.g. learned sparse query
+ * vectors with hundreds of tokens.
+ */
+struct MaxScoreSearch : public SearchIterator
+{
+    using score_t = wand::score_t;
+    using MatchParams = ParallelWeakAndSearch::MatchParams;
+
+    // Queries with fewer terms than this are better served by ParallelWeakAndSearch.
+    static constexpr size_t min_num_terms = 64;
+
+    virtual size_t get_num_terms() const = 0;
+    virtual score_t get_max_score(size_t idx) const = 0;
+    virtual size_t get_num_essential_terms() const = 0;
+
+    static SearchIterator::UP create(fef::TermFieldMatchData &tfmd, const MatchParams &matchParams,
+                                     const std::vector<int32_t> &weights,
+                                     const std::vector<IDirectPostingStore::LookupResult> &dict_entries,
+                                     const IDocidWithWeightPostingStore &attr, bool strict,
+                                     bool readonly_scores_heap);
+};
+
+}
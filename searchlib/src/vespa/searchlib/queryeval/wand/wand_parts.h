@@ -13,6 +13,7 @@
 #include <vespa/vespalib/util/priority_queue.h>
 #include <vespa/searchlib/attribute/i_docid_with_weight_posting_store.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
 #include <cmath>
 
 namespace search::queryeval { class WeakAndHeap; }
@@ -474,6 +475,51 @@ private:
     double   _max_idf;
 };
 
+/**
+ * BM25 scorer used by block-max WAND. The term score depends on the
+ * number of occurrences and the field length of the document, and the
+ * upper bound for a block of documents is calculated from the max number
+ * of occurrences and the min field length within the block.
+ */
+class Bm25BlockMaxScorer
+{
+public:
+    using Bm25Executor = features::Bm25Executor;
+    static constexpr double default_k1 = 1.2;
+    static constexpr double default_b = 0.75;
+    Bm25BlockMaxScorer(uint32_t num_docs, double avg_field_length, double k1, double b) noexcept
+        : _num_docs(num_docs),
+          _k1_plus_one(k1 + 1.0),
+          _k1_mul_one_minus_b(k1 * (1.0 - b)),
+          _k1_mul_b_div_avg_field_length(k1 * b / std::max(1.0, avg_field_length))
+    { }
+    Bm25BlockMaxScorer(uint32_t num_docs, double avg_field_length) noexcept
+        : Bm25BlockMaxScorer(num_docs, avg_field_length, default_k1, default_b)
+    { }
+    // weight * bm25_idf, scaled to fixedpoint
+    double calculate_term_factor(uint32_t est_hits, int32_t weight) const noexcept {
+        return TermFrequencyScorer_TERM_SCORE_FACTOR * weight *
+            Bm25Executor::calculate_inverse_document_frequency({est_hits, _num_docs});
+    }
+    score_t calculate_score(double term_factor, uint32_t num_occs, uint32_t field_length) const noexcept {
+        double occs = num_occs;
+        return score_t(term_factor * (occs * _k1_plus_one) /
+                       (occs + _k1_mul_one_minus_b + _k1_mul_b_div_avg_field_length * field_length));
+    }
+    // term score when the number of occurrences goes towards infinity
+    score_t calculate_max_score(double term_factor) const noexcept {
+        return score_t(term_factor * _k1_plus_one) + 1;
+    }
+    score_t calculate_block_max_score(double term_factor, uint32_t max_num_occs, uint32_t min_field_length) const noexcept {
+        return calculate_score(term_factor, max_num_occs, min_field_length) + 1;
+    }
+private:
+    uint32_t _num_docs;
+    double   _k1_plus_one;
+    double   _k1_mul_one_minus_b;
+    double   _k1_mul_b_div_avg_field_length;
+};
+
 //-----------------------------------------------------------------------------
 
 /**
@@ -8,6 +8,8 @@
 
 namespace search::tensor {
 
+class BoundQuantizedDistance;
+
 /**
  * Interface used to calculate the distance from a prebound n-dimensional vector.
  *
@@ -30,6 +32,9 @@ public:
 
     // calculate internal distance, early return allowed if > limit
     virtual double calc_with_limit(TypedCells rhs, double limit) const noexcept = 0;
+
+    // approximate distance to quantized vectors, nullptr if not supported
+    virtual const BoundQuantizedDistance* as_quantized() const noexcept { return nullptr; }
 protected:
     static const double *cast(const double * p) { return p; }
     static const float *cast(const float * p) { return p; }
@@ -30,7 +30,8 @@ DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors,
                                          size_t vector_size,
                                          bool multi_vector_index,
                                          vespalib::eval::CellType cell_type,
-                                         const search::attribute::HnswIndexParams& params) const
+                                         const search::attribute::HnswIndexParams& params,
+                                         std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator) const
 {
     (void) vector_size;
     uint32_t m = params.max_links_per_node();
@@ -39,16 +40,25 @@ DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors,
                         params.neighbors_to_explore_at_insert(),
                         10000,
                         true);
+    cfg.set_product_quantization(params.distance_metric(), params.quantization_subvectors(), params.quantization_rerank())
+       .set_quantization_training_size(params.quantization_training_size());
+    // Link arrays are only stored using the attribute memory allocator when asked for.
+    std::shared_ptr<vespalib::alloc::MemoryAllocator> links_memory_allocator;
+    if (params.paged_links()) {
+        links_memory_allocator = std::move(memory_allocator);
+    }
     if (multi_vector_index) {
         return std::make_unique<HnswIndex<HnswIndexType::MULTI>>(vectors,
                                                                   make_distance_function_factory(params.distance_metric(), cell_type),
                                                                   make_random_level_generator(m),
-                                                                  cfg);
+                                                                  cfg,
+                                                                  links_memory_allocator);
     } else {
         return std::make_unique<HnswIndex<HnswIndexType::SINGLE>>(vectors,
                                                                   make_distance_function_factory(params.distance_metric(), cell_type),
                                                                   make_random_level_generator(m),
-                                                                  cfg);
+                                                                  cfg,
+                                                                  links_memory_allocator);
     }
 }
 
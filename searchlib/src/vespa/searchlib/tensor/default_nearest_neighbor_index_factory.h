@@ -15,7 +15,8 @@ public:
                                                size_t vector_size,
                                                bool multi_vector_index,
                                                vespalib::eval::CellType cell_type,
-                                               const search::attribute::HnswIndexParams& params) const override;
+                                               const search::attribute::HnswIndexParams& params,
+                                               std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator) const override;
 };
 
 }
@@ -15,6 +15,9 @@ namespace search::tensor {
 /**
  * Storage of a hierarchical navigable small world graph (HNSW)
  * that is used for approximate K-nearest neighbor search.
+ *
+ * The link arrays can be stored using a separate memory allocator (e.g. backed by a memory mapped file),
+ * while the nodes and level arrays used to navigate the graph are always kept in memory.
  */
 template <HnswIndexType type>
 struct HnswGraph {
@@ -53,7 +56,7 @@ struct HnswGraph {
 
     std::atomic<uint64_t> entry_nodeid_and_level;
 
-    HnswGraph();
+    explicit HnswGraph(std::shared_ptr<vespalib::alloc::MemoryAllocator> links_memory_allocator = {});
     ~HnswGraph();
 
     LevelsRef make_node(uint32_t nodeid, uint32_t docid, uint32_t subspace, uint32_t num_levels);
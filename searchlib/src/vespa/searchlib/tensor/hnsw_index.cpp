@@ -6,7 +6,10 @@
 #include "hnsw_index_loader.hpp"
 #include "hnsw_index_saver.h"
 #include "mips_distance_transform.h"
+#include "quantized_distance.h"
+#include "quantized_vector_store.h"
 #include "random_level_generator.h"
+#include "temporary_vector_store.h"
 #include "vector_bundle.h"
 #include <vespa/searchlib/attribute/address_space_components.h>
 #include <vespa/searchlib/attribute/address_space_usage.h>
@@ -18,9 +21,13 @@
 #include <vespa/vespalib/datastore/array_store.hpp>
 #include <vespa/vespalib/datastore/compaction_strategy.h>
 #include <vespa/vespalib/util/doom.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/time.h>
+#include <functional>
+#include <numeric>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".searchlib.tensor.hnsw_index");
@@ -46,6 +53,26 @@ constexpr vespalib::duration MAX_COUNT_DURATION(1000ms);
 
 const vespalib::string hnsw_max_squared_norm = "hnsw.max_squared_norm";
 
+/**
+ * Loader that calls the given function when the wrapped loader is complete.
+ */
+class CompletionNotifyingLoader : public NearestNeighborIndexLoader {
+    std::unique_ptr<NearestNeighborIndexLoader> _loader;
+    std::function<void()>                       _on_complete;
+public:
+    CompletionNotifyingLoader(std::unique_ptr<NearestNeighborIndexLoader> loader, std::function<void()> on_complete)
+        : _loader(std::move(loader)),
+          _on_complete(std::move(on_complete))
+    {}
+    bool load_next() override {
+        if (_loader->load_next()) {
+            return true;
+        }
+        _on_complete();
+        return false;
+    }
+};
+
 void save_mips_max_distance(GenericHeader& header, DistanceFunctionFactory& dff) {
     auto* mips_dff = dynamic_cast<MipsDistanceFunctionFactoryBase*>(&dff);
     if (mips_dff != nullptr) {
@@ -335,6 +362,9 @@ template <HnswIndexType type>
 double
 HnswIndex<type>::calc_distance(const BoundDistanceFunction &df, uint32_t rhs_nodeid) const
 {
+    if (const auto *quantized_df = df.as_quantized()) {
+        return quantized_df->calc_code(_quantized->acquire_code(rhs_nodeid));
+    }
     auto rhs = get_vector(rhs_nodeid);
     return calc_distance_helper(df, rhs);
 }
@@ -347,6 +377,16 @@ HnswIndex<type>::calc_distance(const BoundDistanceFunction &df, uint32_t rhs_doc
     return calc_distance_helper(df, rhs);
 }
 
+template <HnswIndexType type>
+double
+HnswIndex<type>::calc_distance(const BoundDistanceFunction &df, uint32_t rhs_nodeid, uint32_t rhs_docid, uint32_t rhs_subspace) const
+{
+    if (const auto *quantized_df = df.as_quantized()) {
+        return quantized_df->calc_code(_quantized->acquire_code(rhs_nodeid));
+    }
+    return calc_distance(df, rhs_docid, rhs_subspace);
+}
+
 template <HnswIndexType type>
 uint32_t
 HnswIndex<type>::estimate_visited_nodes(uint32_t level, uint32_t nodeid_limit, uint32_t neighbors_to_find, const GlobalFilter* filter) const
@@ -384,7 +424,7 @@ HnswIndex<type>::find_nearest_in_layer(const BoundDistanceFunction &df, const Hn
             auto neighbor_ref = neighbor_node.levels_ref().load_acquire();
             uint32_t neighbor_docid = acquire_docid(neighbor_node, neighbor_nodeid);
             uint32_t neighbor_subspace = neighbor_node.acquire_subspace();
-            double dist = calc_distance(df, neighbor_docid, neighbor_subspace);
+            double dist = calc_distance(df, neighbor_nodeid, neighbor_docid, neighbor_subspace);
             if (_graph.still_valid(neighbor_nodeid, neighbor_ref)
                 && dist < nearest.distance)
             {
@@ -396,6 +436,62 @@ HnswIndex<type>::find_nearest_in_layer(const BoundDistanceFunction &df, const Hn
     return nearest;
 }
 
+template <HnswIndexType type>
+void
+HnswIndex<type>::find_nearest_in_layer_batch(std::span<const BoundDistanceFunction* const> dfs, std::vector<HnswCandidate>& nearest,
+                                             uint32_t level) const
+{
+    // Indexes of the input vectors that are still searching, grouped by their current nearest node.
+    std::vector<uint32_t> active(dfs.size());
+    std::iota(active.begin(), active.end(), 0u);
+    std::vector<uint32_t> next_active;
+    while (!active.empty()) {
+        std::sort(active.begin(), active.end(), [&nearest](uint32_t lhs, uint32_t rhs)
+                  { return nearest[lhs].nodeid < nearest[rhs].nodeid; });
+        next_active.clear();
+        for (size_t group_start = 0; group_start < active.size();) {
+            const auto node = nearest[active[group_start]];
+            size_t group_end = group_start + 1;
+            while (group_end < active.size() && nearest[active[group_end]].nodeid == node.nodeid) {
+                ++group_end;
+            }
+            size_t next_active_start = next_active.size();
+            for (uint32_t neighbor_nodeid : _graph.get_link_array(node.levels_ref, level)) {
+                auto& neighbor_node = _graph.acquire_node(neighbor_nodeid);
+                auto neighbor_ref = neighbor_node.levels_ref().load_acquire();
+                uint32_t neighbor_docid = acquire_docid(neighbor_node, neighbor_nodeid);
+                uint32_t neighbor_subspace = neighbor_node.acquire_subspace();
+                // The neighbor vector (or code) is read once and used for all input vectors in the group.
+                TypedCells rhs;
+                bool has_rhs = false;
+                for (size_t i = group_start; i < group_end; ++i) {
+                    uint32_t query = active[i];
+                    const auto& df = *dfs[query];
+                    double dist;
+                    if (const auto *quantized_df = df.as_quantized()) {
+                        dist = quantized_df->calc_code(_quantized->acquire_code(neighbor_nodeid));
+                    } else {
+                        if (!has_rhs) {
+                            rhs = get_vector(neighbor_docid, neighbor_subspace);
+                            has_rhs = true;
+                        }
+                        dist = calc_distance_helper(df, rhs);
+                    }
+                    if (dist < nearest[query].distance && _graph.still_valid(neighbor_nodeid, neighbor_ref)) {
+                        nearest[query] = HnswCandidate(neighbor_nodeid, neighbor_docid, neighbor_ref, dist);
+                        next_active.push_back(query);
+                    }
+                }
+            }
+            // An input vector can be added more than once when several neighbors are closer.
+            std::sort(next_active.begin() + next_active_start, next_active.end());
+            next_active.erase(std::unique(next_active.begin() + next_active_start, next_active.end()), next_active.end());
+            group_start = group_end;
+        }
+        active.swap(next_active);
+    }
+}
+
 template <HnswIndexType type>
 template <class VisitedTracker, class BestNeighbors>
 void
@@ -446,7 +542,7 @@ HnswIndex<type>::search_layer_helper(const BoundDistanceFunction &df, uint32_t n
             }
             uint32_t neighbor_docid = acquire_docid(neighbor_node, neighbor_nodeid);
             uint32_t neighbor_subspace = neighbor_node.acquire_subspace();
-            double dist_to_input = calc_distance(df, neighbor_docid, neighbor_subspace);
+            double dist_to_input = calc_distance(df, neighbor_nodeid, neighbor_docid, neighbor_subspace);
             if (dist_to_input < limit_dist) {
                 candidates.emplace(neighbor_nodeid, neighbor_ref, dist_to_input);
                 if (filter_wrapper.check(neighbor_docid)) {
@@ -482,14 +578,30 @@ HnswIndex<type>::search_layer(const BoundDistanceFunction &df, uint32_t neighbor
 template <HnswIndexType type>
 HnswIndex<type>::HnswIndex(const DocVectorAccess& vectors, DistanceFunctionFactory::UP distance_ff,
                            RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg)
-    : _graph(),
+    : HnswIndex(vectors, std::move(distance_ff), std::move(level_generator), cfg, {})
+{
+}
+
+template <HnswIndexType type>
+HnswIndex<type>::HnswIndex(const DocVectorAccess& vectors, DistanceFunctionFactory::UP distance_ff,
+                           RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg,
+                           std::shared_ptr<vespalib::alloc::MemoryAllocator> links_memory_allocator)
+    : _graph(std::move(links_memory_allocator)),
       _vectors(vectors),
       _distance_ff(std::move(distance_ff)),
       _level_generator(std::move(level_generator)),
       _id_mapping(),
-      _cfg(cfg)
+      _cfg(cfg),
+      _quantized(),
+      _query_distance_ff(),
+      _pending_quantizer(),
+      _quantizer_training_executor()
 {
     assert(_distance_ff);
+    if (_cfg.quantization_subvectors() > 0 && QuantizedDistanceFunctionFactory::supports(_cfg.distance_metric())) {
+        _quantized = std::make_unique<QuantizedVectorStore>(_cfg.quantization_subvectors(), _cfg.quantization_training_size());
+        _query_distance_ff = std::make_unique<QuantizedDistanceFunctionFactory>(*_distance_ff, *_quantized, _cfg.distance_metric());
+    }
 }
 
 template <HnswIndexType type>
@@ -512,7 +624,7 @@ HnswIndex<type>::add_document(uint32_t docid)
     assert(nodeids.size() == subspaces);
     for (uint32_t subspace = 0; subspace < subspaces; ++subspace) {
         auto entry = _graph.get_entry_node();
-        internal_prepare_add_node(op, input_vectors.cells(subspace), entry);
+        internal_prepare_add_node(op, input_vectors.cells(subspace), subspace, entry);
         internal_complete_add_node(nodeids[subspace], docid, subspace, op.nodes.back());
     }
 }
@@ -526,16 +638,17 @@ HnswIndex<type>::internal_prepare_add(uint32_t docid, VectorBundle input_vectors
     auto subspaces = input_vectors.subspaces();
     op.nodes.reserve(subspaces);
     for (uint32_t subspace = 0; subspace < subspaces; ++subspace) {
-        internal_prepare_add_node(op, input_vectors.cells(subspace), entry);
+        internal_prepare_add_node(op, input_vectors.cells(subspace), subspace, entry);
     }
     return op;
 }
 
 template <HnswIndexType type>
 void
-HnswIndex<type>::internal_prepare_add_node(PreparedAddDoc& op, TypedCells input_vector, const typename GraphType::EntryNode& entry) const
+HnswIndex<type>::internal_prepare_add_node(PreparedAddDoc& op, TypedCells input_vector, uint32_t subspace,
+                                           const typename GraphType::EntryNode& entry) const
 {
-    int node_max_level = std::min(_level_generator->max_level(), max_max_level);
+    int node_max_level = std::min(_level_generator->max_level_for(op.docid, subspace), max_max_level);
     std::vector<PreparedAddNode::Links> connections(node_max_level + 1);
     if (entry.nodeid == 0) {
         // graph has no entry point
@@ -614,6 +727,10 @@ void
 HnswIndex<type>::internal_complete_add_node(uint32_t nodeid, uint32_t docid, uint32_t subspace, PreparedAddNode &prepared_node)
 {
     int32_t num_levels = prepared_node.connections.size();
+    if (_quantized) {
+        // The code must be in place before the node is reachable by readers.
+        _quantized->set_code(nodeid, get_vector(docid, subspace));
+    }
     auto levels_ref = _graph.make_node(nodeid, docid, subspace, num_levels);
     for (int level = 0; level < num_levels; ++level) {
         auto neighbors = filter_valid_nodeids(level, prepared_node.connections[level], nodeid);
@@ -622,6 +739,118 @@ HnswIndex<type>::internal_complete_add_node(uint32_t nodeid, uint32_t docid, uin
     if (num_levels - 1 > get_entry_level()) {
         _graph.set_entry_node({nodeid, levels_ref, num_levels - 1});
     }
+    maybe_train_quantizer();
+}
+
+template <HnswIndexType type>
+std::vector<float>
+HnswIndex<type>::sample_training_vectors(uint32_t& dim) const
+{
+    uint32_t nodeid_limit = _graph.size();
+    uint32_t stride = std::max(1u, _graph.get_active_nodes() / _quantized->training_size());
+    std::vector<float> samples;
+    dim = 0;
+    uint32_t valid_nodes = 0;
+    for (uint32_t nodeid = 1; nodeid < nodeid_limit; ++nodeid) {
+        if (!_graph.get_levels_ref(nodeid).valid() || (valid_nodes++ % stride) != 0) {
+            continue;
+        }
+        auto cells = get_vector(nodeid);
+        if (cells.non_existing_attribute_value() || cells.size == 0 || (dim != 0 && cells.size != dim)) {
+            continue;
+        }
+        dim = cells.size;
+        TemporaryVectorStore<float> tmp_space(dim);
+        auto vector = tmp_space.storeLhs(cells);
+        samples.insert(samples.end(), vector.begin(), vector.end());
+    }
+    return samples;
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::install_quantizer(std::unique_ptr<ProductQuantizer> quantizer)
+{
+    if (!quantizer) {
+        return;
+    }
+    auto before = vespalib::steady_clock::now();
+    _quantized->install(std::move(quantizer));
+    // Codes for nodes added while training in the background are set here as well.
+    uint32_t nodeid_limit = _graph.size();
+    for (uint32_t nodeid = 1; nodeid < nodeid_limit; ++nodeid) {
+        if (_graph.get_levels_ref(nodeid).valid()) {
+            _quantized->set_code(nodeid, get_vector(nodeid));
+        }
+    }
+    _quantized->publish();
+    LOG(info, "Installed product quantizer with %u subvectors for %u vectors (used %6.3fs)",
+        _quantized->num_subvectors(), _graph.get_active_nodes(),
+        vespalib::to_s(vespalib::steady_clock::now() - before));
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::train_quantizer()
+{
+    uint32_t dim = 0;
+    auto samples = sample_training_vectors(dim);
+    if (!samples.empty()) {
+        install_quantizer(_quantized->make_quantizer(samples, dim));
+    }
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::start_quantizer_training()
+{
+    uint32_t dim = 0;
+    auto samples = sample_training_vectors(dim);
+    if (samples.empty()) {
+        return;
+    }
+    if (!_quantizer_training_executor) {
+        _quantizer_training_executor = std::make_unique<vespalib::ThreadStackExecutor>(1);
+    }
+    std::promise<std::unique_ptr<ProductQuantizer>> promise;
+    _pending_quantizer = promise.get_future();
+    // Training only uses the samples copied above, leaving the writer free to continue feeding.
+    auto task = vespalib::makeLambdaTask([quantized = _quantized.get(), samples = std::move(samples), dim,
+                                          promise = std::move(promise)]() mutable {
+        auto before = vespalib::steady_clock::now();
+        auto quantizer = quantized->make_quantizer(samples, dim);
+        LOG(info, "Trained product quantizer using %zu vectors (used %6.3fs)",
+            samples.size() / dim, vespalib::to_s(vespalib::steady_clock::now() - before));
+        promise.set_value(std::move(quantizer));
+    });
+    auto rejected = _quantizer_training_executor->execute(std::move(task));
+    assert(!rejected);
+    (void) rejected;
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::maybe_train_quantizer()
+{
+    if (!_quantized || _quantized->trained()) {
+        return;
+    }
+    if (_pending_quantizer.valid()) {
+        if (_pending_quantizer.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            install_quantizer(_pending_quantizer.get());
+        }
+    } else if (_graph.get_active_nodes() >= _quantized->training_size()) {
+        start_quantizer_training();
+    }
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::wait_for_quantizer_training()
+{
+    if (_pending_quantizer.valid()) {
+        install_quantizer(_pending_quantizer.get());
+    }
 }
 
 template <HnswIndexType type>
@@ -736,6 +965,11 @@ HnswIndex<type>::assign_generation(generation_t current_gen)
     _graph.levels_store.assign_generation(current_gen);
     _graph.links_store.assign_generation(current_gen);
     _id_mapping.assign_generation(current_gen);
+    if (_quantized) {
+        // Install a quantizer trained in the background, also when no documents are added.
+        maybe_train_quantizer();
+        _quantized->assign_generation(current_gen);
+    }
 }
 
 template <HnswIndexType type>
@@ -746,6 +980,9 @@ HnswIndex<type>::reclaim_memory(generation_t oldest_used_gen)
     _graph.levels_store.reclaim_memory(oldest_used_gen);
     _graph.links_store.reclaim_memory(oldest_used_gen);
     _id_mapping.reclaim_memory(oldest_used_gen);
+    if (_quantized) {
+        _quantized->reclaim_memory(oldest_used_gen);
+    }
 }
 
 template <HnswIndexType type>
@@ -810,6 +1047,9 @@ HnswIndex<type>::update_stat(const CompactionStrategy& compaction_strategy)
     result.merge(_graph.levels_store.update_stat(compaction_strategy));
     result.merge(_graph.links_store.update_stat(compaction_strategy));
     result.merge(_id_mapping.update_stat(compaction_strategy));
+    if (_quantized) {
+        result.merge(_quantized->memory_usage());
+    }
     return result;
 }
 
@@ -822,6 +1062,9 @@ HnswIndex<type>::memory_usage() const
     result.merge(_graph.levels_store.getMemoryUsage());
     result.merge(_graph.links_store.getMemoryUsage());
     result.merge(_id_mapping.memory_usage());
+    if (_quantized) {
+        result.merge(_quantized->memory_usage());
+    }
     return result;
 }
 
@@ -846,6 +1089,9 @@ HnswIndex<type>::get_state(const vespalib::slime::Inserter& inserter) const
     StateExplorerUtils::memory_usage_to_slime(_graph.nodes.getMemoryUsage(), memUsageObj.setObject("nodes"));
     StateExplorerUtils::memory_usage_to_slime(_graph.levels_store.getMemoryUsage(), memUsageObj.setObject("levels"));
     StateExplorerUtils::memory_usage_to_slime(_graph.links_store.getMemoryUsage(), memUsageObj.setObject("links"));
+    if (_quantized) {
+        StateExplorerUtils::memory_usage_to_slime(_quantized->memory_usage(), memUsageObj.setObject("quantized_vectors"));
+    }
     object.setLong("nodeid_limit", _graph.size());
     object.setLong("nodes", _graph.get_active_nodes());
     auto& histogram_array = object.setArray("level_histogram");
@@ -875,6 +1121,11 @@ HnswIndex<type>::get_state(const vespalib::slime::Inserter& inserter) const
     cfgObj.setLong("max_links_on_inserts", _cfg.max_links_on_inserts());
     cfgObj.setLong("neighbors_to_explore_at_construction",
                    _cfg.neighbors_to_explore_at_construction());
+    if (_quantized) {
+        cfgObj.setLong("quantization_subvectors", _quantized->num_subvectors());
+        cfgObj.setBool("quantization_rerank", _cfg.quantization_rerank());
+        object.setBool("quantizer_trained", _quantized->acquire_quantizer() != nullptr);
+    }
 }
 
 template <HnswIndexType type>
@@ -896,7 +1147,7 @@ template <HnswIndexType type>
 std::unique_ptr<NearestNeighborIndexSaver>
 HnswIndex<type>::make_saver(GenericHeader& header) const
 {
-    save_mips_max_distance(header, distance_function_factory());
+    save_mips_max_distance(header, *_distance_ff);
     return std::make_unique<HnswIndexSaver<type>>(_graph);
 }
 
@@ -905,10 +1156,20 @@ std::unique_ptr<NearestNeighborIndexLoader>
 HnswIndex<type>::make_loader(FastOS_FileInterface& file, const vespalib::GenericHeader& header)
 {
     assert(get_entry_nodeid() == 0); // cannot load after index has data
-    load_mips_max_distance(header, distance_function_factory());
+    load_mips_max_distance(header, *_distance_ff);
     using ReaderType = FileReader<uint32_t>;
     using LoaderType = HnswIndexLoader<ReaderType, type>;
-    return std::make_unique<LoaderType>(_graph, _id_mapping, std::make_unique<ReaderType>(&file));
+    auto loader = std::make_unique<LoaderType>(_graph, _id_mapping, std::make_unique<ReaderType>(&file));
+    if (_quantized) {
+        // Quantized codes are not saved, they are recalculated when the graph is loaded.
+        // Loading is not done by the writer thread, so the quantizer is trained right away.
+        return std::make_unique<CompletionNotifyingLoader>(std::move(loader), [this]() {
+            if (_graph.get_active_nodes() >= _quantized->training_size()) {
+                train_quantizer();
+            }
+        });
+    }
+    return loader;
 }
 
 struct NeighborsByDocId {
@@ -924,7 +1185,17 @@ std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex<type>::top_k_by_docid(uint32_t k, const BoundDistanceFunction &df, const GlobalFilter *filter,
                                 uint32_t explore_k, const vespalib::Doom& doom, double distance_threshold) const
 {
-    SearchBestNeighbors candidates = top_k_candidates(df, std::max(k, explore_k), filter, doom);
+    return candidates_by_docid(k, df, top_k_candidates(df, std::max(k, explore_k), filter, doom), distance_threshold);
+}
+
+template <HnswIndexType type>
+std::vector<NearestNeighborIndex::Neighbor>
+HnswIndex<type>::candidates_by_docid(uint32_t k, const BoundDistanceFunction &df, SearchBestNeighbors candidates,
+                                     double distance_threshold) const
+{
+    if (df.as_quantized() != nullptr && _cfg.quantization_rerank()) {
+        candidates = rerank(df, candidates);
+    }
     auto result = candidates.get_neighbors(k, distance_threshold);
     std::sort(result.begin(), result.end(), NeighborsByDocId());
     return result;
@@ -946,6 +1217,40 @@ HnswIndex<type>::find_top_k_with_filter(uint32_t k, const BoundDistanceFunction
     return top_k_by_docid(k, df, &filter, explore_k, doom, distance_threshold);
 }
 
+template <HnswIndexType type>
+std::vector<std::vector<NearestNeighborIndex::Neighbor>>
+HnswIndex<type>::find_top_k_batch(uint32_t k, std::span<const BoundDistanceFunction* const> dfs,
+                                  const GlobalFilter* filter, uint32_t explore_k,
+                                  const vespalib::Doom& doom, double distance_threshold) const
+{
+    std::vector<std::vector<Neighbor>> result(dfs.size());
+    auto entry = _graph.get_entry_node();
+    if (entry.nodeid == 0) {
+        // graph has no entry point
+        return result;
+    }
+    if (filter != nullptr && !filter->is_active()) {
+        filter = nullptr;
+    }
+    uint32_t entry_docid = get_docid(entry.nodeid);
+    std::vector<HnswCandidate> entry_points;
+    entry_points.reserve(dfs.size());
+    for (const auto* df : dfs) {
+        entry_points.emplace_back(entry.nodeid, entry_docid, entry.levels_ref, calc_distance(*df, entry.nodeid));
+    }
+    // The upper layers are small and the greedy searches from the common entry point overlap a lot.
+    for (int search_level = entry.level; search_level > 0; --search_level) {
+        find_nearest_in_layer_batch(dfs, entry_points, search_level);
+    }
+    for (size_t i = 0; i < dfs.size(); ++i) {
+        SearchBestNeighbors candidates;
+        candidates.push(entry_points[i]);
+        search_layer(*dfs[i], std::max(k, explore_k), candidates, 0, &doom, filter);
+        result[i] = candidates_by_docid(k, *dfs[i], std::move(candidates), distance_threshold);
+    }
+    return result;
+}
+
 template <HnswIndexType type>
 typename HnswIndex<type>::SearchBestNeighbors
 HnswIndex<type>::top_k_candidates(const BoundDistanceFunction &df, uint32_t k, const GlobalFilter *filter, const vespalib::Doom& doom) const
@@ -970,6 +1275,18 @@ HnswIndex<type>::top_k_candidates(const BoundDistanceFunction &df, uint32_t k, c
     return best_neighbors;
 }
 
+template <HnswIndexType type>
+typename HnswIndex<type>::SearchBestNeighbors
+HnswIndex<type>::rerank(const BoundDistanceFunction &df, const SearchBestNeighbors& candidates) const
+{
+    SearchBestNeighbors result;
+    for (const auto& candidate : candidates.peek()) {
+        uint32_t subspace = _graph.acquire_node(candidate.nodeid).acquire_subspace();
+        result.emplace(candidate.nodeid, candidate.docid, candidate.levels_ref, calc_distance(df, candidate.docid, subspace));
+    }
+    return result;
+}
+
 template <HnswIndexType type>
 HnswTestNode
 HnswIndex<type>::get_node(uint32_t nodeid) const
@@ -23,9 +23,15 @@
 #include <vespa/vespalib/datastore/compaction_spec.h>
 #include <vespa/vespalib/datastore/entryref.h>
 #include <vespa/vespalib/stllike/allocator.h>
+#include <future>
+
+namespace vespalib { class ThreadStackExecutor; }
 
 namespace search::tensor {
 
+class ProductQuantizer;
+class QuantizedVectorStore;
+
 /**
  * Implementation of a hierarchical navigable small world graph (HNSW)
  * that is used for approximate K-nearest neighbor search.
@@ -37,6 +43,12 @@ namespace search::tensor {
  * "Efficient and robust approximate nearest neighbor search using Hierarchical Navigable Small World graphs" (Yu. A. Malkov, D. A. Yashunin),
  * but some adjustments are made to support proper removes.
  *
+ * When product quantization is configured, compact codes for all nodes are kept next to the graph
+ * and used for approximate distances during query graph traversal, optionally followed by reranking
+ * the candidates using the full precision vectors. Graph construction always uses full precision vectors,
+ * which are kept as well, so the codes add to the memory usage. The quantizer is trained in a background
+ * thread once enough nodes are present, and installed by the writer thread when ready.
+ *
  * TODO: Add details on how to handle removes.
  */
 
@@ -120,6 +132,11 @@ protected:
     RandomLevelGenerator::UP _level_generator;
     IdMapping _id_mapping; // mapping from docid to nodeid vector
     HnswIndexConfig _cfg;
+    std::unique_ptr<QuantizedVectorStore> _quantized;
+    std::unique_ptr<DistanceFunctionFactory> _query_distance_ff;
+    std::future<std::unique_ptr<ProductQuantizer>> _pending_quantizer;
+    // Declared last to be destroyed first, waiting for any ongoing quantizer training.
+    std::unique_ptr<vespalib::ThreadStackExecutor> _quantizer_training_executor;
 
     uint32_t max_links_for_level(uint32_t level) const;
     void add_link_to(uint32_t nodeid, uint32_t level, const LinkArrayRef& old_links, uint32_t new_link) {
@@ -166,12 +183,19 @@ protected:
 
     double calc_distance(const BoundDistanceFunction &df, uint32_t rhs_nodeid) const;
     double calc_distance(const BoundDistanceFunction &df, uint32_t rhs_docid, uint32_t rhs_subspace) const;
+    double calc_distance(const BoundDistanceFunction &df, uint32_t rhs_nodeid, uint32_t rhs_docid, uint32_t rhs_subspace) const;
     uint32_t estimate_visited_nodes(uint32_t level, uint32_t nodeid_limit, uint32_t neighbors_to_find, const GlobalFilter* filter) const;
 
     /**
      * Performs a greedy search in the given layer to find the candidate that is nearest the input vector.
      */
     HnswCandidate find_nearest_in_layer(const BoundDistanceFunction &df, const HnswCandidate& entry_point, uint32_t level) const __attribute__((noinline));
+    /**
+     * Performs the greedy search in the given layer for a batch of input vectors. Input vectors that are at the
+     * same node share the link array and the vector reads of the neighbors.
+     */
+    void find_nearest_in_layer_batch(std::span<const BoundDistanceFunction* const> dfs, std::vector<HnswCandidate>& nearest,
+                                     uint32_t level) const;
     template <class VisitedTracker, class BestNeighbors>
     void search_layer_helper(const BoundDistanceFunction &df, uint32_t neighbors_to_find, BestNeighbors& best_neighbors,
                              uint32_t level, const GlobalFilter *filter, uint32_t nodeid_limit,
@@ -181,19 +205,32 @@ protected:
                       uint32_t level, const vespalib::Doom* const doom, const GlobalFilter *filter = nullptr) const;
     std::vector<Neighbor> top_k_by_docid(uint32_t k, const BoundDistanceFunction &df, const GlobalFilter *filter,
                                          uint32_t explore_k, const vespalib::Doom& doom, double distance_threshold) const;
+    std::vector<Neighbor> candidates_by_docid(uint32_t k, const BoundDistanceFunction &df, SearchBestNeighbors candidates,
+                                              double distance_threshold) const;
 
     internal::PreparedAddDoc internal_prepare_add(uint32_t docid, VectorBundle input_vectors,
                                                   vespalib::GenerationHandler::Guard read_guard) const;
-    void internal_prepare_add_node(internal::PreparedAddDoc& op, TypedCells input_vector, const typename GraphType::EntryNode& entry) const;
+    void internal_prepare_add_node(internal::PreparedAddDoc& op, TypedCells input_vector, uint32_t subspace,
+                                   const typename GraphType::EntryNode& entry) const;
     LinkArray filter_valid_nodeids(uint32_t level, const internal::PreparedAddNode::Links &neighbors, uint32_t self_nodeid);
     void internal_complete_add(uint32_t docid, internal::PreparedAddDoc &op);
     void internal_complete_add_node(uint32_t nodeid, uint32_t docid, uint32_t subspace, internal::PreparedAddNode &prepared_node);
 
     // Called from writer only.
     uint32_t get_subspaces(uint32_t docid) const noexcept;
+    std::vector<float> sample_training_vectors(uint32_t& dim) const;
+    void install_quantizer(std::unique_ptr<ProductQuantizer> quantizer);
+    void train_quantizer();
+    void start_quantizer_training();
+    void maybe_train_quantizer();
+    SearchBestNeighbors rerank(const BoundDistanceFunction &df, const SearchBestNeighbors& candidates) const;
 public:
     HnswIndex(const DocVectorAccess& vectors, DistanceFunctionFactory::UP distance_ff,
               RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg);
+    // The link arrays of the graph are allocated using links_memory_allocator (when set).
+    HnswIndex(const DocVectorAccess& vectors, DistanceFunctionFactory::UP distance_ff,
+              RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg,
+              std::shared_ptr<vespalib::alloc::MemoryAllocator> links_memory_allocator);
     ~HnswIndex() override;
 
     const HnswIndexConfig& config() const { return _cfg; }
@@ -225,7 +262,13 @@ public:
     std::vector<Neighbor> find_top_k_with_filter(uint32_t k, const BoundDistanceFunction &df, const GlobalFilter &filter,
                                                  uint32_t explore_k, const vespalib::Doom& doom, double distance_threshold) const override;
 
-    DistanceFunctionFactory &distance_function_factory() const override { return *_distance_ff; }
+    std::vector<std::vector<Neighbor>> find_top_k_batch(uint32_t k, std::span<const BoundDistanceFunction* const> dfs,
+                                                         const GlobalFilter* filter, uint32_t explore_k,
+                                                         const vespalib::Doom& doom, double distance_threshold) const override;
+
+    DistanceFunctionFactory &distance_function_factory() const override {
+        return _query_distance_ff ? *_query_distance_ff : *_distance_ff;
+    }
 
     SearchBestNeighbors top_k_candidates(const BoundDistanceFunction &df, uint32_t k, const GlobalFilter *filter,
                                          const vespalib::Doom& doom) const;
@@ -245,6 +288,7 @@ public:
     std::pair<uint32_t, bool> count_reachable_nodes() const;
     GraphType& get_graph() { return _graph; }
     IdMapping& get_id_mapping() { return _id_mapping; }
+    void wait_for_quantizer_training();
 
     static vespalib::datastore::ArrayStoreConfig make_default_level_array_store_config();
     static vespalib::datastore::ArrayStoreConfig make_default_link_array_store_config();
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/searchcommon/attribute/distance_metric.h>
 #include <cstdint>
 
 namespace search::tensor {
@@ -16,6 +17,11 @@ private:
     uint32_t _neighbors_to_explore_at_construction;
     uint32_t _min_size_before_two_phase;
     bool     _heuristic_select_neighbors;
+    // Number of product quantization subvectors, 0 means no quantization.
+    uint32_t _quantization_subvectors;
+    uint32_t _quantization_training_size;
+    bool     _quantization_rerank;
+    search::attribute::DistanceMetric _distance_metric;
 
 public:
     HnswIndexConfig(uint32_t max_links_at_level_0_in,
@@ -27,13 +33,32 @@ public:
           _max_links_on_inserts(max_links_on_inserts_in),
           _neighbors_to_explore_at_construction(neighbors_to_explore_at_construction_in),
           _min_size_before_two_phase(min_size_before_two_phase_in),
-          _heuristic_select_neighbors(heuristic_select_neighbors_in)
+          _heuristic_select_neighbors(heuristic_select_neighbors_in),
+          _quantization_subvectors(0),
+          _quantization_training_size(10000),
+          _quantization_rerank(true),
+          _distance_metric(search::attribute::DistanceMetric::Euclidean)
     {}
+    HnswIndexConfig& set_product_quantization(search::attribute::DistanceMetric distance_metric_in,
+                                              uint32_t subvectors_in, bool rerank_in) {
+        _distance_metric = distance_metric_in;
+        _quantization_subvectors = subvectors_in;
+        _quantization_rerank = rerank_in;
+        return *this;
+    }
+    HnswIndexConfig& set_quantization_training_size(uint32_t value) {
+        _quantization_training_size = value;
+        return *this;
+    }
     uint32_t max_links_at_level_0() const { return _max_links_at_level_0; }
     uint32_t max_links_on_inserts() const { return _max_links_on_inserts; }
     uint32_t neighbors_to_explore_at_construction() const { return _neighbors_to_explore_at_construction; }
     uint32_t min_size_before_two_phase() const { return _min_size_before_two_phase; }
     bool heuristic_select_neighbors() const { return _heuristic_select_neighbors; }
+    uint32_t quantization_subvectors() const { return _quantization_subvectors; }
+    uint32_t quantization_training_size() const { return _quantization_training_size; }
+    bool quantization_rerank() const { return _quantization_rerank; }
+    search::attribute::DistanceMetric distance_metric() const { return _distance_metric; }
 };
 
 }
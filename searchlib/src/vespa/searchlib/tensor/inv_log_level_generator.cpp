@@ -1,3 +1,21 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "inv_log_level_generator.h"
+
+namespace search::tensor {
+
+uint32_t
+InvLogLevelGenerator::max_level_for(uint32_t docid, uint32_t subspace)
+{
+    // splitmix64 finalizer, gives a well mixed 64-bit value for each (docid, subspace) pair.
+    uint64_t x = _seed ^ ((uint64_t(docid) << 32) | subspace);
+    x += 0x9e3779b97f4a7c15uLL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9uLL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebuLL;
+    x ^= (x >> 31);
+    // Use the upper 53 bits to make a uniform number in [0, 1).
+    double unif = double(x >> 11) * 0x1.0p-53;
+    return level_for_uniform(unif);
+}
+
+}
@@ -1,6 +1,9 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#pragma once
+
 #include "random_level_generator.h"
+#include <cmath>
 #include <random>
 #include <mutex>
 
@@ -20,24 +23,33 @@ class InvLogLevelGenerator : public RandomLevelGenerator {
     std::mutex _mutex;
     std::uniform_real_distribution<double> _uniform;
     const double _levelMultiplier;
+    const uint64_t _seed;
 
     double get_uniform() {
         std::lock_guard<std::mutex> guard(_mutex);
         return _uniform(_rng);
     }
+    uint32_t level_for_uniform(double unif) const noexcept {
+        double r = -log(1.0-unif) * _levelMultiplier;
+        return (uint32_t) r;
+    }
 public:
-    InvLogLevelGenerator(uint32_t m)
-      : _rng(0x1234deadbeef5678uLL),
+    static constexpr uint64_t default_seed = 0x1234deadbeef5678uLL;
+
+    InvLogLevelGenerator(uint32_t m, uint64_t seed = default_seed)
+      : _rng(seed),
         _mutex(),
         _uniform(0.0, 1.0),
-        _levelMultiplier(1.0 / log(1.0 * m))
+        _levelMultiplier(1.0 / log(1.0 * m)),
+        _seed(seed)
     {}
 
     uint32_t max_level() override {
-        double unif = get_uniform();
-        double r = -log(1.0-unif) * _levelMultiplier;
-        return (uint32_t) r;
+        return level_for_uniform(get_uniform());
     }
+
+    // The level is a function of the seed, docid and subspace, and this is thread safe.
+    uint32_t max_level_for(uint32_t docid, uint32_t subspace) override;
 };
 
 }
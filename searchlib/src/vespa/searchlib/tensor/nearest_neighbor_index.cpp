@@ -1,3 +1,24 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "nearest_neighbor_index.h"
+
+namespace search::tensor {
+
+std::vector<std::vector<NearestNeighborIndex::Neighbor>>
+NearestNeighborIndex::find_top_k_batch(uint32_t k, std::span<const BoundDistanceFunction* const> dfs,
+                                       const GlobalFilter* filter, uint32_t explore_k,
+                                       const vespalib::Doom& doom, double distance_threshold) const
+{
+    std::vector<std::vector<Neighbor>> result;
+    result.reserve(dfs.size());
+    for (const auto* df : dfs) {
+        if (filter != nullptr) {
+            result.emplace_back(find_top_k_with_filter(k, *df, *filter, explore_k, doom, distance_threshold));
+        } else {
+            result.emplace_back(find_top_k(k, *df, explore_k, doom, distance_threshold));
+        }
+    }
+    return result;
+}
+
+}
@@ -10,6 +10,7 @@
 #include <vespa/vespalib/util/memoryusage.h>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 
 class FastOS_FileInterface;
@@ -113,6 +114,20 @@ public:
                                                          const vespalib::Doom& doom,
                                                          double distance_threshold) const = 0;
 
+    /**
+     * Finds the top k neighbors for a batch of query vectors, represented by one bound distance function each.
+     * The result contains the neighbors for each query vector, in the same order as the distance functions.
+     * This allows an index to share graph traversal and vector reads between the query vectors.
+     *
+     * The default implementation searches for each query vector separately.
+     */
+    virtual std::vector<std::vector<Neighbor>> find_top_k_batch(uint32_t k,
+                                                                 std::span<const BoundDistanceFunction* const> dfs,
+                                                                 const GlobalFilter* filter,
+                                                                 uint32_t explore_k,
+                                                                 const vespalib::Doom& doom,
+                                                                 double distance_threshold) const;
+
     virtual DistanceFunctionFactory &distance_function_factory() const = 0;
 
     /*
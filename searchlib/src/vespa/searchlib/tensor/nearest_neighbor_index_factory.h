@@ -6,6 +6,7 @@
 #include <memory>
 
 namespace search::attribute { class HnswIndexParams; }
+namespace vespalib::alloc { class MemoryAllocator; }
 
 namespace search::tensor {
 
@@ -14,6 +15,9 @@ class NearestNeighborIndex;
 
 /**
  * Factory interface used to instantiate an index used for (approximate) nearest neighbor search.
+ *
+ * The memory allocator is the one used by the attribute vector (e.g. backed by a memory mapped file
+ * for paged attributes), and might be empty.
  */
 class NearestNeighborIndexFactory {
 public:
@@ -22,7 +26,8 @@ public:
                                                        size_t vector_size,
                                                        bool multi_vector_index,
                                                        vespalib::eval::CellType cell_type,
-                                                       const search::attribute::HnswIndexParams& params) const = 0;
+                                                       const search::attribute::HnswIndexParams& params,
+                                                       std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator) const = 0;
 };
 
 }
@@ -0,0 +1,145 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "product_quantizer.h"
+#include <vespa/vespalib/hwaccelerated/iaccelerated.h>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace search::tensor {
+
+namespace {
+
+float
+squared_distance(const float* a, const float* b, uint32_t size) noexcept
+{
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < size; ++i) {
+        float diff = a[i] - b[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+float
+dot_product(const float* a, const float* b, uint32_t size) noexcept
+{
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < size; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+}
+
+float
+ProductQuantizer::calc_distance(const float* table, const uint8_t* code, uint32_t code_size) noexcept
+{
+    static_assert(max_centroids == 256, "table stride used by sum_of_table_lookups");
+    static const auto& accelerator = vespalib::hwaccelerated::IAccelerated::getAccelerator();
+    return accelerator.sum_of_table_lookups(table, code, code_size);
+}
+
+ProductQuantizer::ProductQuantizer(uint32_t dim, uint32_t num_subvectors)
+    : _dim(dim),
+      _num_subvectors(std::clamp(num_subvectors, 1u, dim)),
+      _num_centroids(0),
+      _offsets(),
+      _centroids()
+{
+    _offsets.reserve(_num_subvectors + 1);
+    for (uint32_t m = 0; m <= _num_subvectors; ++m) {
+        _offsets.push_back(uint64_t(m) * _dim / _num_subvectors);
+    }
+}
+
+ProductQuantizer::~ProductQuantizer() = default;
+
+uint32_t
+ProductQuantizer::nearest_centroid(uint32_t m, const float* subvector) const noexcept
+{
+    uint32_t size = sub_dim(m);
+    const float* c = centroids(m);
+    uint32_t best = 0;
+    float best_dist = std::numeric_limits<float>::max();
+    for (uint32_t i = 0; i < _num_centroids; ++i, c += size) {
+        float dist = squared_distance(subvector, c, size);
+        if (dist < best_dist) {
+            best_dist = dist;
+            best = i;
+        }
+    }
+    return best;
+}
+
+void
+ProductQuantizer::train(const float* samples, uint32_t num_samples, uint32_t iterations)
+{
+    assert(num_samples > 0);
+    _num_centroids = std::min(num_samples, max_centroids);
+    _centroids.assign(size_t(_dim) * _num_centroids, 0.0f);
+    std::vector<double> sums;
+    std::vector<uint32_t> counts(_num_centroids);
+    for (uint32_t m = 0; m < _num_subvectors; ++m) {
+        uint32_t offset = _offsets[m];
+        uint32_t size = sub_dim(m);
+        float* c = _centroids.data() + size_t(offset) * _num_centroids;
+        // Initial centroids are samples spread evenly over the sample set.
+        for (uint32_t i = 0; i < _num_centroids; ++i) {
+            const float* sample = samples + size_t(uint64_t(i) * num_samples / _num_centroids) * _dim + offset;
+            std::copy(sample, sample + size, c + size_t(i) * size);
+        }
+        for (uint32_t iter = 0; iter < iterations; ++iter) {
+            sums.assign(size_t(_num_centroids) * size, 0.0);
+            std::fill(counts.begin(), counts.end(), 0u);
+            for (uint32_t s = 0; s < num_samples; ++s) {
+                const float* sample = samples + size_t(s) * _dim + offset;
+                uint32_t nearest = nearest_centroid(m, sample);
+                ++counts[nearest];
+                double* sum = sums.data() + size_t(nearest) * size;
+                for (uint32_t j = 0; j < size; ++j) {
+                    sum[j] += sample[j];
+                }
+            }
+            for (uint32_t i = 0; i < _num_centroids; ++i) {
+                // Empty clusters keep their previous centroid.
+                if (counts[i] != 0) {
+                    for (uint32_t j = 0; j < size; ++j) {
+                        c[size_t(i) * size + j] = sums[size_t(i) * size + j] / counts[i];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+ProductQuantizer::encode(const float* vector, uint8_t* code) const noexcept
+{
+    for (uint32_t m = 0; m < _num_subvectors; ++m) {
+        code[m] = nearest_centroid(m, vector + _offsets[m]);
+    }
+}
+
+void
+ProductQuantizer::make_distance_table(const float* query, bool inner_product, float* table) const noexcept
+{
+    for (uint32_t m = 0; m < _num_subvectors; ++m, table += max_centroids) {
+        uint32_t size = sub_dim(m);
+        const float* subvector = query + _offsets[m];
+        const float* c = centroids(m);
+        for (uint32_t i = 0; i < _num_centroids; ++i, c += size) {
+            table[i] = inner_product ? -dot_product(subvector, c, size) : squared_distance(subvector, c, size);
+        }
+    }
+}
+
+vespalib::MemoryUsage
+ProductQuantizer::memory_usage() const
+{
+    size_t bytes = sizeof(ProductQuantizer) + _offsets.capacity() * sizeof(uint32_t) + _centroids.capacity() * sizeof(float);
+    return {bytes, bytes, 0, 0};
+}
+
+}
@@ -0,0 +1,75 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/memoryusage.h>
+#include <cstdint>
+#include <vector>
+
+namespace search::tensor {
+
+/**
+ * Product quantizer for float vectors.
+ *
+ * A vector with dim cells is split into num_subvectors consecutive subvectors,
+ * and each subvector is replaced by the index of the nearest of (at most) 256
+ * centroids trained for that subvector using k-means. A vector is thus encoded
+ * as num_subvectors bytes.
+ *
+ * Distances between a query vector and encoded vectors are calculated using
+ * asymmetric distance computation (ADC): a table with the distance between each
+ * query subvector and each centroid is made once per query, and the distance to
+ * an encoded vector is the sum of num_subvectors table lookups.
+ *
+ * The quantizer is immutable after training and can be used by multiple threads.
+ */
+class ProductQuantizer {
+public:
+    static constexpr uint32_t max_centroids = 256;
+
+    ProductQuantizer(uint32_t dim, uint32_t num_subvectors);
+    ~ProductQuantizer();
+
+    /**
+     * Trains the centroids using num_samples vectors stored consecutively in samples.
+     * Called once, before any calls to encode() or make_distance_table().
+     */
+    void train(const float* samples, uint32_t num_samples, uint32_t iterations);
+
+    void encode(const float* vector, uint8_t* code) const noexcept;
+
+    /**
+     * Makes the ADC table for the given query vector (table_size() entries).
+     * When inner_product is false, entries are the squared euclidean distances between
+     * query subvectors and centroids, otherwise entries are the negated dot products.
+     * Entries for centroids beyond num_centroids() are not used and left untouched.
+     */
+    void make_distance_table(const float* query, bool inner_product, float* table) const noexcept;
+
+    /**
+     * Calculates the distance to an encoded vector using the ADC table.
+     * The table lookups are vectorized (gathered) when the cpu supports it.
+     */
+    static float calc_distance(const float* table, const uint8_t* code, uint32_t code_size) noexcept;
+
+    uint32_t dim() const noexcept { return _dim; }
+    uint32_t code_size() const noexcept { return _num_subvectors; }
+    uint32_t num_centroids() const noexcept { return _num_centroids; }
+    size_t table_size() const noexcept { return size_t(_num_subvectors) * max_centroids; }
+    vespalib::MemoryUsage memory_usage() const;
+
+private:
+    uint32_t              _dim;
+    uint32_t              _num_subvectors;
+    uint32_t              _num_centroids;
+    // Start cell of each subvector, with dim as the last element.
+    std::vector<uint32_t> _offsets;
+    // Centroids for subvector m start at _offsets[m] * _num_centroids.
+    std::vector<float>    _centroids;
+
+    uint32_t sub_dim(uint32_t m) const noexcept { return _offsets[m + 1] - _offsets[m]; }
+    const float* centroids(uint32_t m) const noexcept { return _centroids.data() + size_t(_offsets[m]) * _num_centroids; }
+    uint32_t nearest_centroid(uint32_t m, const float* subvector) const noexcept;
+};
+
+}
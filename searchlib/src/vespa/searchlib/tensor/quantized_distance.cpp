@@ -0,0 +1,81 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quantized_distance.h"
+#include "quantized_vector_store.h"
+#include "temporary_vector_store.h"
+
+using search::attribute::DistanceMetric;
+
+namespace search::tensor {
+
+BoundQuantizedDistance::BoundQuantizedDistance(BoundDistanceFunction::UP exact, const ProductQuantizer* quantizer,
+                                               DistanceMetric metric, TypedCells lhs)
+    : _computer(vespalib::hwaccelerated::IAccelerated::getAccelerator()),
+      _exact(std::move(exact)),
+      _quantizer(quantizer),
+      _table(),
+      _offset(0.0)
+{
+    if (_quantizer == nullptr || lhs.size != _quantizer->dim()) {
+        _quantizer = nullptr;
+        return;
+    }
+    TemporaryVectorStore<float> tmp_space(lhs.size);
+    auto query = tmp_space.storeLhs(lhs);
+    bool inner_product = (metric != DistanceMetric::Euclidean);
+    if (metric == DistanceMetric::InnerProduct || metric == DistanceMetric::PrenormalizedAngular) {
+        // Same as the full precision distance: squared query norm minus dot product.
+        for (float cell : query) {
+            _offset += double(cell) * cell;
+        }
+    }
+    _table.resize(_quantizer->table_size());
+    _quantizer->make_distance_table(query.data(), inner_product, _table.data());
+}
+
+BoundQuantizedDistance::~BoundQuantizedDistance() = default;
+
+QuantizedDistanceFunctionFactory::QuantizedDistanceFunctionFactory(const DistanceFunctionFactory& exact_ff,
+                                                                   const QuantizedVectorStore& store,
+                                                                   DistanceMetric metric) noexcept
+    : DistanceFunctionFactory(),
+      _exact_ff(exact_ff),
+      _store(store),
+      _metric(metric)
+{
+}
+
+QuantizedDistanceFunctionFactory::~QuantizedDistanceFunctionFactory() = default;
+
+BoundDistanceFunction::UP
+QuantizedDistanceFunctionFactory::for_query_vector(TypedCells lhs) const
+{
+    auto exact = _exact_ff.for_query_vector(lhs);
+    auto quantizer = _store.acquire_quantizer();
+    if (quantizer == nullptr) {
+        return exact;
+    }
+    return std::make_unique<BoundQuantizedDistance>(std::move(exact), quantizer, _metric, lhs);
+}
+
+BoundDistanceFunction::UP
+QuantizedDistanceFunctionFactory::for_insertion_vector(TypedCells lhs) const
+{
+    return _exact_ff.for_insertion_vector(lhs);
+}
+
+bool
+QuantizedDistanceFunctionFactory::supports(DistanceMetric metric) noexcept
+{
+    switch (metric) {
+    case DistanceMetric::Euclidean:
+    case DistanceMetric::InnerProduct:
+    case DistanceMetric::PrenormalizedAngular:
+    case DistanceMetric::Dotproduct:
+        return true;
+    default:
+        return false;
+    }
+}
+
+}
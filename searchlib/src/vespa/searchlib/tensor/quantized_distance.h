@@ -0,0 +1,66 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "distance_function_factory.h"
+#include "product_quantizer.h"
+#include <vespa/vespalib/hwaccelerated/iaccelerated.h>
+#include <vector>
+
+namespace search::tensor {
+
+class QuantizedVectorStore;
+
+/**
+ * Distance function bound to a query vector that in addition to the full precision
+ * distance (calc) can calculate the approximate distance to a product quantized
+ * vector code using a precomputed ADC table.
+ *
+ * The approximate distance uses the same internal distance units as the wrapped
+ * full precision distance function.
+ */
+class BoundQuantizedDistance : public BoundDistanceFunction {
+private:
+    const vespalib::hwaccelerated::IAccelerated& _computer;
+    BoundDistanceFunction::UP _exact;
+    const ProductQuantizer*   _quantizer;
+    std::vector<float>        _table;
+    double                    _offset;
+public:
+    BoundQuantizedDistance(BoundDistanceFunction::UP exact, const ProductQuantizer* quantizer,
+                           search::attribute::DistanceMetric metric, TypedCells lhs);
+    ~BoundQuantizedDistance() override;
+    double calc(TypedCells rhs) const noexcept override { return _exact->calc(rhs); }
+    double calc_with_limit(TypedCells rhs, double limit) const noexcept override { return _exact->calc_with_limit(rhs, limit); }
+    double convert_threshold(double threshold) const noexcept override { return _exact->convert_threshold(threshold); }
+    double to_rawscore(double distance) const noexcept override { return _exact->to_rawscore(distance); }
+    double to_distance(double rawscore) const noexcept override { return _exact->to_distance(rawscore); }
+    double min_rawscore() const noexcept override { return _exact->min_rawscore(); }
+    const BoundQuantizedDistance* as_quantized() const noexcept override { return (_quantizer != nullptr) ? this : nullptr; }
+
+    double calc_code(const uint8_t* code) const noexcept {
+        return _offset + _computer.sum_of_table_lookups(_table.data(), code, _quantizer->code_size());
+    }
+};
+
+/**
+ * Distance function factory used for queries against a hnsw index with product
+ * quantized vectors. Query vectors are bound to a BoundQuantizedDistance when the
+ * quantizer is trained, insertion vectors use the wrapped factory directly.
+ */
+class QuantizedDistanceFunctionFactory : public DistanceFunctionFactory {
+private:
+    const DistanceFunctionFactory&    _exact_ff;
+    const QuantizedVectorStore&       _store;
+    search::attribute::DistanceMetric _metric;
+public:
+    QuantizedDistanceFunctionFactory(const DistanceFunctionFactory& exact_ff, const QuantizedVectorStore& store,
+                                     search::attribute::DistanceMetric metric) noexcept;
+    ~QuantizedDistanceFunctionFactory() override;
+    BoundDistanceFunction::UP for_query_vector(TypedCells lhs) const override;
+    BoundDistanceFunction::UP for_insertion_vector(TypedCells lhs) const override;
+
+    static bool supports(search::attribute::DistanceMetric metric) noexcept;
+};
+
+}
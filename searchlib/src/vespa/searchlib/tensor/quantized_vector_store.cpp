@@ -0,0 +1,70 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quantized_vector_store.h"
+#include "temporary_vector_store.h"
+#include <vespa/vespalib/util/rcuvector.hpp>
+#include <cassert>
+
+using vespalib::eval::TypedCells;
+
+namespace search::tensor {
+
+namespace {
+
+constexpr uint32_t training_iterations = 10;
+
+}
+
+QuantizedVectorStore::QuantizedVectorStore(uint32_t num_subvectors, uint32_t training_size)
+    : _num_subvectors(num_subvectors),
+      _training_size(training_size),
+      _quantizer(),
+      _published(nullptr),
+      _codes()
+{
+}
+
+QuantizedVectorStore::~QuantizedVectorStore() = default;
+
+std::unique_ptr<ProductQuantizer>
+QuantizedVectorStore::make_quantizer(const std::vector<float>& samples, uint32_t dim) const
+{
+    assert(dim > 0 && !samples.empty() && (samples.size() % dim) == 0);
+    auto quantizer = std::make_unique<ProductQuantizer>(dim, _num_subvectors);
+    quantizer->train(samples.data(), samples.size() / dim, training_iterations);
+    return quantizer;
+}
+
+void
+QuantizedVectorStore::install(std::unique_ptr<ProductQuantizer> quantizer)
+{
+    assert(!_quantizer && quantizer);
+    // The number of subvectors is clamped to the vector dimension.
+    _num_subvectors = quantizer->code_size();
+    _quantizer = std::move(quantizer);
+}
+
+void
+QuantizedVectorStore::set_code(uint32_t nodeid, TypedCells vector)
+{
+    if (!_quantizer || vector.size != _quantizer->dim()) {
+        return;
+    }
+    TemporaryVectorStore<float> tmp_space(vector.size);
+    auto cells = tmp_space.convertRhs(vector);
+    size_t offset = size_t(nodeid) * _num_subvectors;
+    _codes.ensure_size(offset + _num_subvectors, 0);
+    _quantizer->encode(cells.data(), &_codes[offset]);
+}
+
+vespalib::MemoryUsage
+QuantizedVectorStore::memory_usage() const
+{
+    auto result = _codes.getMemoryUsage();
+    if (_quantizer) {
+        result.merge(_quantizer->memory_usage());
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,67 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "product_quantizer.h"
+#include <vespa/eval/eval/typed_cells.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <atomic>
+#include <memory>
+
+namespace search::tensor {
+
+/**
+ * Storage of product quantized codes for the nodes in a hnsw index, used to
+ * calculate approximate distances during graph traversal without touching the
+ * full precision vectors.
+ *
+ * The quantizer is trained once (when enough vectors are available), installed
+ * by the writer thread and then published to readers. Codes for existing nodes
+ * must be set before the quantizer is published, and codes for new nodes must be
+ * set before the node is linked into the graph.
+ *
+ * The codes are kept in memory (num_subvectors bytes per node), while the
+ * full precision vectors of the attribute are stored in a memory mapped file
+ * and only read when inserting nodes and when reranking search results.
+ */
+class QuantizedVectorStore {
+public:
+    using generation_t = vespalib::GenerationHandler::generation_t;
+    using TypedCells = vespalib::eval::TypedCells;
+
+    QuantizedVectorStore(uint32_t num_subvectors, uint32_t training_size);
+    ~QuantizedVectorStore();
+
+    uint32_t num_subvectors() const noexcept { return _num_subvectors; }
+    uint32_t training_size() const noexcept { return _training_size; }
+
+    // Trains a quantizer using the given samples. Does not touch the store and can be called from any thread.
+    std::unique_ptr<ProductQuantizer> make_quantizer(const std::vector<float>& samples, uint32_t dim) const;
+
+    // Called from writer only.
+    bool trained() const noexcept { return static_cast<bool>(_quantizer); }
+    void install(std::unique_ptr<ProductQuantizer> quantizer);
+    void train(const std::vector<float>& samples, uint32_t dim) { install(make_quantizer(samples, dim)); }
+    void set_code(uint32_t nodeid, TypedCells vector);
+    void publish() noexcept { _published.store(_quantizer.get(), std::memory_order_release); }
+
+    // Returns nullptr until the quantizer is published.
+    const ProductQuantizer* acquire_quantizer() const noexcept { return _published.load(std::memory_order_acquire); }
+    const uint8_t* acquire_code(uint32_t nodeid) const noexcept {
+        return &_codes.acquire_elem_ref(size_t(nodeid) * _num_subvectors);
+    }
+
+    void assign_generation(generation_t current_gen) { _codes.setGeneration(current_gen + 1); }
+    void reclaim_memory(generation_t oldest_used_gen) { _codes.reclaim_memory(oldest_used_gen); }
+    vespalib::MemoryUsage memory_usage() const;
+
+private:
+    uint32_t                                _num_subvectors;
+    uint32_t                                _training_size;
+    std::unique_ptr<ProductQuantizer>       _quantizer;
+    std::atomic<const ProductQuantizer*>    _published;
+    vespalib::RcuVector<uint8_t>            _codes;
+};
+
+}
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 namespace search::tensor {
@@ -14,6 +15,16 @@ public:
     using UP = std::unique_ptr<RandomLevelGenerator>;
     virtual ~RandomLevelGenerator() {}
     virtual uint32_t max_level() = 0;
+    /**
+     * Draws the max level for the node representing the given document subspace.
+     * Generators can override this to make the level independent of the order of calls,
+     * the default implementation draws the next level using max_level().
+     */
+    virtual uint32_t max_level_for(uint32_t docid, uint32_t subspace) {
+        (void) docid;
+        (void) subspace;
+        return max_level();
+    }
 };
 
 }
@@ -69,7 +69,8 @@ TensorAttribute::TensorAttribute(std::string_view name, const Config &cfg, Tenso
     if (cfg.hnsw_index_params().has_value()) {
         auto tensor_type = cfg.tensorType();
         size_t vector_size = tensor_type.dense_subspace_size();
-        _index = index_factory.make(*this, vector_size, !_is_dense, tensor_type.cell_type(), cfg.hnsw_index_params().value());
+        _index = index_factory.make(*this, vector_size, !_is_dense, tensor_type.cell_type(), cfg.hnsw_index_params().value(),
+                                    get_memory_allocator());
     }
 }
 
@@ -12,12 +12,10 @@
 #include <vespa/searchlib/attribute/blob_sequence_reader.h>
 #include <vespa/searchlib/attribute/load_utils.h>
 #include <vespa/searchlib/attribute/readerbase.h>
-#include <vespa/vespalib/util/arrayqueue.hpp>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/objects/nbostream.h>
-#include <mutex>
-#include <condition_variable>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.tensor.tensor_attribute_loader");
@@ -75,8 +73,11 @@ public:
 };
 
 /**
- * Will build nearest neighbor index in parallel. Note that indexing order is not guaranteed,
- * but that is inline with the guarantees vespa already has.
+ * Will build nearest neighbor index in parallel, in batches of documents.
+ *
+ * All documents in a batch are prepared by the shared executor against the same graph, and
+ * the prepared documents are then completed in lid order by the calling thread. Given
+ * the same documents (and level generator seed) the resulting graph is thus deterministic.
  */
 class ThreadedIndexBuilder : public IndexBuilder {
 public:
@@ -85,92 +86,62 @@ public:
           _generation_handler(generation_handler),
           _index(index),
           _shared_executor(shared_executor),
-          _queue(MAX_PENDING),
-          _pending(0)
+          _lids(),
+          _prepared()
     {
         (void) store;
+        _lids.reserve(BATCH_SIZE);
+    }
+    void add(uint32_t lid) override {
+        _lids.push_back(lid);
+        if (_lids.size() >= BATCH_SIZE) {
+            build_batch();
+        }
     }
-    void add(uint32_t lid) override;
     void wait_complete() override {
-        drainUntilPending(0);
+        build_batch();
     }
 private:
-    using Entry = std::pair<uint32_t, std::unique_ptr<PrepareResult>>;
-    using Queue = vespalib::ArrayQueue<Entry>;
-
-    bool pop(Entry & entry) {
-        std::unique_lock guard(_mutex);
-        if (_queue.empty()) return false;
-        entry = std::move(_queue.front());
-        _queue.pop();
-        return true;
+    void prepare(size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            uint32_t lid = _lids[i];
+            _prepared[i] = _index.prepare_add_document(lid, _attr.get_vectors(lid), _generation_handler.takeGuard());
+        }
     }
-    void drainQ() {
-        Queue queue(MAX_PENDING);
-        {
-            std::unique_lock guard(_mutex);
-            queue.swap(_queue);
+    void build_batch() {
+        if (_lids.empty()) {
+            return;
         }
-        while (!queue.empty()) {
-            auto item = std::move(queue.front());
-            queue.pop();
-            complete(item.first, std::move(item.second));
+        _prepared.clear();
+        _prepared.resize(_lids.size());
+        size_t num_tasks = (_lids.size() + TASK_SIZE - 1) / TASK_SIZE;
+        vespalib::CountDownLatch latch(num_tasks);
+        for (size_t begin = 0; begin < _lids.size(); begin += TASK_SIZE) {
+            size_t end = std::min(begin + TASK_SIZE, _lids.size());
+            auto task = vespalib::makeLambdaTask([this, begin, end, &latch]() {
+                prepare(begin, end);
+                latch.countDown();
+            });
+            _shared_executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
         }
-    }
-
-    void complete(uint32_t lid, std::unique_ptr<PrepareResult> prepared) {
-        _index.complete_add_document(lid, std::move(prepared));
-        --_pending;
-        if ((lid % LOAD_COMMIT_INTERVAL) == 0) {
-            _attr.commit();
-        };
-    }
-    void drainUntilPending(uint32_t maxPending) {
-        while (_pending > maxPending) {
-            {
-                std::unique_lock guard(_mutex);
-                while (_queue.empty()) {
-                    _cond.wait(guard);
-                }
-            }
-            drainQ();
+        latch.await();
+        for (size_t i = 0; i < _lids.size(); ++i) {
+            _index.complete_add_document(_lids[i], std::move(_prepared[i]));
         }
+        _prepared.clear();
+        _lids.clear();
+        _attr.commit();
     }
-    static constexpr uint32_t MAX_PENDING = 1000;
+    static constexpr size_t BATCH_SIZE = 1000;
+    static constexpr size_t TASK_SIZE = 16;
     TensorAttribute&        _attr;
     const vespalib::GenerationHandler& _generation_handler;
     NearestNeighborIndex&   _index;
     vespalib::Executor&     _shared_executor;
-    std::mutex              _mutex;
-    std::condition_variable _cond;
-    Queue                   _queue;
-    uint64_t                _pending; // _pending is only modified in forground thread
+    std::vector<uint32_t>   _lids;
+    std::vector<std::unique_ptr<PrepareResult>> _prepared;
 };
 
-void
-ThreadedIndexBuilder::add(uint32_t lid) {
-    Entry item;
-    while (pop(item)) {
-        // First process items that are ready to complete
-        complete(item.first, std::move(item.second));
-    }
-    // Then ensure that there no more than MAX_PENDING inflight
-    drainUntilPending(MAX_PENDING);
-
-    // Then we can issue a new one
-    ++_pending;
-    auto task = vespalib::makeLambdaTask([this, lid]() {
-        auto prepared = _index.prepare_add_document(lid, _attr.get_vectors(lid),
-                                                    _generation_handler.takeGuard());
-        std::unique_lock guard(_mutex);
-        _queue.push(std::make_pair(lid, std::move(prepared)));
-        if (_queue.size() == 1) {
-            _cond.notify_all();
-        }
-    });
-    _shared_executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
-}
-
 class ForegroundIndexBuilder : public IndexBuilder {
 public:
     ForegroundIndexBuilder(AttributeVector& attr, NearestNeighborIndex& index)
@@ -9,10 +9,12 @@
 #include <vespa/searchlib/diskindex/zc4_posting_reader.h>
 #include <vespa/searchlib/diskindex/zc4_posting_writer.h>
 #include <vespa/searchlib/index/postinglistparams.h>
+#include <vespa/searchlib/queryeval/block_max_info.h>
 
 using search::fef::TermFieldMatchData;
 using search::fef::TermFieldMatchDataArray;
 using search::fef::TermFieldMatchDataPosition;
+using search::queryeval::BlockMaxInfo;
 using search::queryeval::SearchIterator;
 using search::index::PostingListCounts;
 using search::index::PostingListParams;
@@ -139,6 +141,9 @@ FakeZcFilterOcc::setup(const FakeWord &fw)
         setupT<false>(fw);
     }
     validate_read(fw);
+    if (_posting_params._encode_block_max) {
+        validate_block_max(fw);
+    }
 }
 
 
@@ -169,6 +174,7 @@ FakeZcFilterOcc::setupT(const FakeWord &fw)
     params.set("minChunkDocs", _posting_params._min_chunk_docs); // Control chunking
     params.set("minSkipDocs", _posting_params._min_skip_docs);   // Control skip info
     params.set("interleaved_features", _posting_params._encode_interleaved_features);
+    params.set("block_max", _posting_params._encode_block_max);
     writer.set_posting_list_params(params);
     auto &writeContext = writer.get_write_context();
     search::ComprBuffer &cb = writeContext;
@@ -282,6 +288,41 @@ FakeZcFilterOcc::validate_read(const FakeWord &fw) const
     assert(static_cast<int32_t>(features.doc_id()) == -1);
 }
 
+void
+FakeZcFilterOcc::validate_block_max(const FakeWord &fw) const
+{
+    PostingListCounts counts;
+    counts._bitLength = _compressedBits;
+    counts._numDocs = _hitDocs;
+    auto itr = create_zc_posocc_iterator(_bigEndian, counts, Position(_compressed.first, 0), _compressedBits,
+                                         _posting_params, _fieldsParams, TermFieldMatchDataArray());
+    itr->initRange(1, fw._docIdLimit);
+    BlockMaxInfo *block_max = itr->as_block_max_info();
+    assert((block_max != nullptr) == (_hitDocs >= _posting_params._min_skip_docs));
+    if (block_max == nullptr) {
+        return;
+    }
+    BlockMaxInfo::Block block;
+    uint32_t prev_last_doc_id = 0;
+    for (const auto &doc : fw._postings) {
+        bool found = block_max->find_block(doc._docId, block);
+        assert(found);
+        (void) found;
+        assert(doc._docId <= block.last_doc_id);
+        assert(block.last_doc_id >= prev_last_doc_id);
+        assert(doc._collapsedDocWordFeatures._num_occs <= block.max_num_occs);
+        assert(doc._collapsedDocWordFeatures._field_len >= block.min_field_length);
+        prev_last_doc_id = block.last_doc_id;
+        bool hit = itr->seek(doc._docId);
+        assert(hit);
+        (void) hit;
+    }
+    assert(prev_last_doc_id == _lastDocId);
+    bool found_past_end = block_max->find_block(_lastDocId + 1, block);
+    assert(!found_past_end);
+    (void) found_past_end;
+}
+
 FakeZcFilterOcc::~FakeZcFilterOcc() = default;
 
 
@@ -795,6 +836,26 @@ public:
 template <bool bigEndian>
 FakeZc4SkipPosOccCf<bigEndian>::~FakeZc4SkipPosOccCf() = default;
 
+template <bool bigEndian>
+class FakeZc4SkipPosOccCfBlockMax : public FakeZc4SkipPosOcc<bigEndian>
+{
+    static Zc4PostingParams make_posting_params(const FakeWord &fw) {
+        Zc4PostingParams posting_params(force_skip, disable_chunking, fw._docIdLimit, false, true, true);
+        posting_params._encode_block_max = true;
+        return posting_params;
+    }
+public:
+    FakeZc4SkipPosOccCfBlockMax(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<bigEndian>(fw, make_posting_params(fw),
+                                       (bigEndian ? ".zc4skipposoccbe.cf.bm" : ".zc4skipposoccle.cf.bm"))
+    {
+    }
+    ~FakeZc4SkipPosOccCfBlockMax() override;
+};
+
+template <bool bigEndian>
+FakeZc4SkipPosOccCfBlockMax<bigEndian>::~FakeZc4SkipPosOccCfBlockMax() = default;
+
 class FakeZc4SkipPosOccCfNoNormalUnpack : public FakeZc4SkipPosOcc<true>
 {
 public:
@@ -929,6 +990,15 @@ static FPFactoryInit
 initSkipPos0lecf(std::make_pair("Zc4SkipPosOccLE.cf",
                                 makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCf<false> > >));
 
+static FPFactoryInit
+initSkipPos0becfbm(std::make_pair("Zc4SkipPosOccBE.cf.bm",
+                                  makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBlockMax<true> > >));
+
+
+static FPFactoryInit
+initSkipPos0lecfbm(std::make_pair("Zc4SkipPosOccLE.cf.bm",
+                                  makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBlockMax<false> > >));
+
 static FPFactoryInit
 initSkipPos0becfnnu(std::make_pair("Zc4SkipPosOccBE.cf.nnu",
                                 makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfNoNormalUnpack > >));
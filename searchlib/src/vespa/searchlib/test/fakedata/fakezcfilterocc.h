@@ -42,6 +42,7 @@ protected:
     void validate_read(const FakeWord &fw) const;
     template <bool bigEndian>
     void validate_read(const FakeWord &fw) const;
+    void validate_block_max(const FakeWord &fw) const;
 
 public:
     explicit FakeZcFilterOcc(const FakeWord &fw);
@@ -42,6 +42,12 @@ ImpureValueBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash
 
 struct DocidExecutor : FeatureExecutor {
     void execute(uint32_t docid) override { outputs().set_number(0, docid); }
+    bool supports_batch() const override { return true; }
+    void execute_batch(const Batch &batch) override {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            batch.outputs[0][i] = batch.docids[i];
+        }
+    }
 };
 
 bool
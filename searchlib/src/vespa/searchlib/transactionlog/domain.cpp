@@ -46,6 +46,11 @@ Domain::Domain(const string &domainName, const string & baseDir, vespalib::Execu
                const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext)
     : _config(cfg),
       _currentChunk(createCommitChunk(cfg)),
+      _unsyncedChunks(),
+      _firstUnsyncedTime(),
+      _pendingCommits(0),
+      _numCommittedChunks(0),
+      _numSyncs(0),
       _lastSerial(0),
       _singleCommitter(std::make_unique<vespalib::ThreadStackExecutor>(1, CpuUsage::wrap(tls_domain_commit, CpuCategory::WRITE))),
       _executor(executor),
@@ -130,6 +135,9 @@ Domain::getDomainInfo() const
 {
     std::unique_lock guard(_partsMutex);
     DomainInfo info(SerialNumRange(begin(guard), end(guard)), size(guard), byteSize(guard), _maxSessionRunTime);
+    info.numCommittedChunks = _numCommittedChunks.load(std::memory_order_relaxed);
+    info.numSyncs = _numSyncs.load(std::memory_order_relaxed);
+    info.pendingCommits = _pendingCommits.load(std::memory_order_relaxed);
     for (const auto &entry: _parts) {
         const DomainPart &part = *entry.second;
         info.parts.emplace_back(PartInfo(part.range(), part.size(), part.byteSize(), part.fileName()));
@@ -223,6 +231,7 @@ Domain::triggerSyncNow(std::unique_ptr<vespalib::IDestructorCallback> after_sync
     _singleCommitter->execute(makeLambdaTask([this, after_sync=std::move(after_sync)]() {
         (void) after_sync;
         getActivePart()->sync();
+        releaseSyncedChunks();
     }));
 }
 
@@ -305,6 +314,7 @@ Domain::optionallyRotateFile(SerialNum serialNum) {
     DomainPart::SP dp = getActivePart();
     if (dp->byteSize() > _config.getPartSizeLimit()) {
         dp->sync();
+        releaseSyncedChunks();
         dp->close();
         dp = std::make_shared<DomainPart>(_name, dir(), serialNum, _fileHeaderContext, false);
         {
@@ -369,6 +379,7 @@ void
 Domain::commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunkOrderGuard) {
     assert(chunkOrderGuard.mutex() == &_currentChunkMutex && chunkOrderGuard.owns_lock());
     if (chunk->getPacket().empty()) return;
+    _pendingCommits.fetch_add(1, std::memory_order_relaxed);
     chunk->shrinkPayloadToFit();
     std::promise<SerializedChunk> promise;
     std::future<SerializedChunk> future = promise.get_future();
@@ -381,20 +392,54 @@ Domain::commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunk
     }));
 }
 
-
-
 void
-Domain::doCommit(const SerializedChunk & serialized) {
+Domain::doCommit(SerializedChunk serialized) {
 
     SerialNumRange range = serialized.range();
     DomainPart::SP dp = optionallyRotateFile(range.from());
     dp->commit(serialized);
-    if (_config.getFSyncOnCommit()) {
-        dp->sync();
-    }
+    _numCommittedChunks.fetch_add(1, std::memory_order_relaxed);
     cleanSessions();
-    LOG(debug, "Releasing %zu acks and %zu entries and %zu bytes.",
+    LOG(debug, "Committed %zu acks and %zu entries and %zu bytes.",
         serialized.getNumCallBacks(), serialized.getNumEntries(), serialized.getData().size());
+    if (_config.getFSyncOnCommit()) {
+        vespalib::steady_time now = vespalib::steady_clock::now();
+        if (_unsyncedChunks.empty()) {
+            _firstUnsyncedTime = now;
+        }
+        _unsyncedChunks.push_back(std::move(serialized));
+        if (shouldSyncNow(now)) {
+            dp->sync();
+            _numSyncs.fetch_add(1, std::memory_order_relaxed);
+            releaseSyncedChunks();
+        }
+    } else {
+        if (!_unsyncedChunks.empty()) {
+            // fsync on commit was turned off while chunks were waiting for a group commit sync
+            dp->sync();
+            _numSyncs.fetch_add(1, std::memory_order_relaxed);
+            releaseSyncedChunks();
+        }
+        _pendingCommits.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+bool
+Domain::shouldSyncNow(vespalib::steady_time now) const {
+    // Group commit: As long as more chunks are queued behind this one, and the latency budget
+    // is not spent, the sync is postponed so that a single sync covers all of them.
+    size_t queuedBehind = _pendingCommits.load(std::memory_order_relaxed) - _unsyncedChunks.size();
+    return (queuedBehind == 0) || ((now - _firstUnsyncedTime) >= _config.getGroupCommitLatency());
+}
+
+void
+Domain::releaseSyncedChunks() {
+    if (_unsyncedChunks.empty()) return;
+    LOG(debug, "Releasing %zu synced chunks.", _unsyncedChunks.size());
+    size_t numChunks = _unsyncedChunks.size();
+    _pendingCommits.fetch_sub(numChunks, std::memory_order_relaxed);
+    // Destructing the chunks acks the operations in them.
+    _unsyncedChunks.clear();
 }
 
 bool
@@ -63,7 +63,9 @@ private:
 
     std::unique_ptr<CommitChunk> grabCurrentChunk(const UniqueLock & guard);
     void commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunkOrderGuard);
-    void doCommit(const SerializedChunk & serialized);
+    void doCommit(SerializedChunk serialized);
+    bool shouldSyncNow(vespalib::steady_time now) const;
+    void releaseSyncedChunks();
     SerialNum begin(const UniqueLock & guard) const;
     SerialNum end(const UniqueLock & guard) const;
     size_t byteSize(const UniqueLock & guard) const;
@@ -82,8 +84,16 @@ private:
     using DurationSeconds = std::chrono::duration<double>;
     using Executor = vespalib::Executor;
 
+    using SerializedChunks = std::vector<SerializedChunk>;
+
     DomainConfig                 _config;
     std::unique_ptr<CommitChunk> _currentChunk;
+    // Written, but not yet synced chunks, holding back their acks. Only used by the single committer.
+    SerializedChunks             _unsyncedChunks;
+    vespalib::steady_time        _firstUnsyncedTime;
+    std::atomic<size_t>          _pendingCommits; // Chunks committed, but not yet acked.
+    std::atomic<size_t>          _numCommittedChunks;
+    std::atomic<size_t>          _numSyncs;
     SerialNum                    _lastSerial;
     std::unique_ptr<Executor>    _singleCommitter;
     Executor                    &_executor;
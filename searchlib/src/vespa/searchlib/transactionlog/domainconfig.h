@@ -16,17 +16,24 @@ public:
     DomainConfig & setChunkSizeLimit(size_t v)      { _chunkSizeLimit = v; return *this; }
     DomainConfig & setCompressionLevel(uint8_t v)   { _compressionLevel = v; return *this; }
     DomainConfig & setFSyncOnCommit(bool v)         { _fSyncOnCommit = v; return *this; }
+    DomainConfig & setGroupCommitLatency(duration v) { _groupCommitLatency = v; return *this; }
     Encoding          getEncoding() const { return _encoding; }
     size_t       getPartSizeLimit() const { return _partSizeLimit; }
     size_t      getChunkSizeLimit() const { return _chunkSizeLimit; }
     uint8_t   getCompressionlevel() const { return _compressionLevel; }
     bool         getFSyncOnCommit() const { return _fSyncOnCommit; }
+    /**
+     * Max time the acks of a commit can be held back while more commits are queued,
+     * letting them share a single fsync. Zero syncs after every commit.
+     */
+    duration getGroupCommitLatency() const { return _groupCommitLatency; }
 private:
     Encoding     _encoding;
     uint8_t      _compressionLevel;
     bool         _fSyncOnCommit;
     size_t       _partSizeLimit;
     size_t       _chunkSizeLimit;
+    duration     _groupCommitLatency;
 };
 
 struct PartInfo {
@@ -48,11 +55,16 @@ struct DomainInfo {
     size_t numEntries;
     size_t byteSize;
     DurationSeconds maxSessionRunTime;
+    size_t pendingCommits;      // Chunks queued for writing, or written and waiting for fsync.
+    size_t numCommittedChunks;  // Chunks written since start.
+    size_t numSyncs;            // fsyncs done after writing chunks since start.
     std::vector<PartInfo> parts;
     DomainInfo(SerialNumRange range_in, size_t numEntries_in, size_t byteSize_in, DurationSeconds maxSessionRunTime_in)
-            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts() {}
+            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in),
+              pendingCommits(0), numCommittedChunks(0), numSyncs(0), parts() {}
     DomainInfo()
-            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts() {}
+            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), pendingCommits(0), numCommittedChunks(0),
+              numSyncs(0), parts() {}
 };
 
 using DomainStats = std::map<vespalib::string, DomainInfo>;
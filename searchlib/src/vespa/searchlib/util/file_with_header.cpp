@@ -6,6 +6,8 @@
 #include <vespa/fastos/file.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <cassert>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace search {
 
@@ -39,6 +41,22 @@ FileWithHeader::FileWithHeader(std::unique_ptr<FastOS_FileInterface> file_in)
 
 FileWithHeader::~FileWithHeader() = default;
 
+vespalib::alloc::Alloc
+FileWithHeader::map_data(size_t capacity) const
+{
+    if (!valid()) {
+        return {};
+    }
+    // The file descriptor of _file is not exposed, and the mapping outlives it anyway.
+    int fd = ::open(_file->GetFileName(), O_RDONLY);
+    if (fd < 0) {
+        return {};
+    }
+    auto alloc = vespalib::alloc::Alloc::mmap_file_private(fd, _header_len, data_size(), capacity);
+    ::close(fd);
+    return alloc;
+}
+
 bool
 FileWithHeader::valid() const
 {
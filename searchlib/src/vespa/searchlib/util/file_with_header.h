@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/util/alloc.h>
 #include <memory>
 
 class FastOS_FileInterface;
@@ -30,6 +31,12 @@ public:
     uint64_t file_size() const { return _file_size; }
     uint64_t data_size() const { return _file_size - _header_len; }
 
+    /**
+     * Map the binary data as a private, copy on write, allocation with room for at least capacity bytes.
+     * Returns an empty allocation if the data can not be mapped.
+     */
+    vespalib::alloc::Alloc map_data(size_t capacity) const;
+
     bool valid() const;
     void rewind();
     void close();
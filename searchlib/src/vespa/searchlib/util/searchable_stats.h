@@ -1,10 +1,25 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <vespa/vespalib/stllike/cache_stats.h>
+#include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/memoryusage.h>
+#include <map>
 
 namespace search {
 
+/**
+ * Cache statistics for a single disk index.
+ **/
+struct DiskIndexCacheStats {
+    vespalib::CacheStats posting_list;
+    vespalib::CacheStats bit_vector;
+
+    DiskIndexCacheStats() : posting_list(), bit_vector() {}
+    DiskIndexCacheStats(const vespalib::CacheStats& posting_list_in, const vespalib::CacheStats& bit_vector_in)
+        : posting_list(posting_list_in), bit_vector(bit_vector_in) {}
+};
+
 /**
  * Simple statistics for a single Searchable component or multiple components that are merged together.
  *
@@ -17,9 +32,14 @@ private:
     size_t _docsInMemory;
     size_t _sizeOnDisk; // in bytes
     size_t _fusion_size_on_disk; // in bytes
+    // Keyed by disk index directory. Counters restart when a disk index is replaced or reloaded.
+    std::map<vespalib::string, DiskIndexCacheStats> _disk_index_cache_stats;
 
 public:
-    SearchableStats() : _memoryUsage(), _docsInMemory(0), _sizeOnDisk(0), _fusion_size_on_disk(0) {}
+    SearchableStats()
+        : _memoryUsage(), _docsInMemory(0), _sizeOnDisk(0), _fusion_size_on_disk(0),
+          _disk_index_cache_stats()
+    {}
     SearchableStats &memoryUsage(const vespalib::MemoryUsage &usage) {
         _memoryUsage = usage;
         return *this;
@@ -40,12 +60,20 @@ public:
         return *this;
     }
     size_t fusion_size_on_disk() const { return _fusion_size_on_disk; }
+    SearchableStats& disk_index_cache_stats(const vespalib::string& index_dir, const DiskIndexCacheStats& value) {
+        _disk_index_cache_stats[index_dir] = value;
+        return *this;
+    }
+    const std::map<vespalib::string, DiskIndexCacheStats>& disk_index_cache_stats() const {
+        return _disk_index_cache_stats;
+    }
 
     SearchableStats &merge(const SearchableStats &rhs) {
         _memoryUsage.merge(rhs._memoryUsage);
         _docsInMemory += rhs._docsInMemory;
         _sizeOnDisk += rhs._sizeOnDisk;
         _fusion_size_on_disk += rhs._fusion_size_on_disk;
+        _disk_index_cache_stats.insert(rhs._disk_index_cache_stats.begin(), rhs._disk_index_cache_stats.end());
         return *this;
     }
 };
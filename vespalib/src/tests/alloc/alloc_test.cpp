@@ -9,6 +9,10 @@
 #include <vespa/vespalib/util/size_literals.h>
 #include <cstddef>
 #include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <vector>
 
 using namespace vespalib;
 using namespace vespalib::alloc;
@@ -297,4 +301,32 @@ TEST("auto alloced mmap alloc can not be shrinked below HUGEPAGE_SIZE/2 + 1 ") {
     EXPECT_EQUAL(SZ, buf.size());
 }
 
+TEST("file can be mapped as private copy on write alloc") {
+    const char * name = "mmap_file_private.dat";
+    size_t page = MemoryAllocator::PAGE_SIZE;
+    std::vector<char> content(page + 100);
+    for (size_t i(0); i < content.size(); i++) {
+        content[i] = char(i % 127);
+    }
+    int fd = open(name, O_CREAT | O_TRUNC | O_RDWR, 0644);
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_EQUAL(ssize_t(content.size()), write(fd, content.data(), content.size()));
+    {
+        Alloc buf = Alloc::mmap_file_private(fd, page, 100, 3 * page);
+        ASSERT_TRUE(buf.get() != nullptr);
+        EXPECT_EQUAL(3 * page, buf.size());
+        const char * mapped = static_cast<const char *>(buf.get());
+        EXPECT_EQUAL(0, memcmp(mapped, content.data() + page, 100));
+        EXPECT_EQUAL(0, mapped[3 * page - 1]);
+        static_cast<char *>(buf.get())[0] = 'x';
+        EXPECT_EQUAL('x', mapped[0]);
+        EXPECT_TRUE(Alloc::mmap_file_private(fd, 100, 100, page).get() == nullptr);
+    }
+    char first(0);
+    ASSERT_EQUAL(1, pread(fd, &first, 1, page));
+    EXPECT_EQUAL(content[page], first);
+    close(fd);
+    unlink(name);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -4,6 +4,8 @@
 #include <vespa/vespalib/testkit/test_master.hpp>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstd_dictionary.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <atomic>
 
@@ -74,6 +76,83 @@ TEST("require that CompressionConfig is Atomic") {
     EXPECT_TRUE(std::atomic<CompressionConfig>::is_always_lock_free);
 }
 
+std::vector<vespalib::string>
+make_small_documents(size_t count) {
+    std::vector<vespalib::string> docs;
+    for (size_t i(0); i < count; i++) {
+        docs.push_back(make_string("{\"title\":\"Document number %zu\",\"category\":\"category_%zu\","
+                                   "\"description\":\"A small document with an identifier of %zu\",\"price\":%zu}",
+                                   i, i % 17, i * 7919, i % 1000));
+    }
+    return docs;
+}
+
+std::vector<ConstBufferRef>
+as_samples(const std::vector<vespalib::string> & docs) {
+    std::vector<ConstBufferRef> samples;
+    for (const auto & doc : docs) {
+        samples.emplace_back(doc.data(), doc.size());
+    }
+    return samples;
+}
+
+TEST("require that zstd dictionary compresses small buffers better") {
+    auto docs = make_small_documents(2000);
+    auto dictionary = ZStdDictionary::train(as_samples(docs), 4096, 9);
+    ASSERT_TRUE(dictionary);
+    EXPECT_NOT_EQUAL(0u, dictionary->id());
+    EXPECT_LESS_EQUAL(dictionary->size(), 4096u);
+
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD);
+    ConstBufferRef ref(docs[42].data(), docs[42].size());
+    DataBuffer plain;
+    DataBuffer withDictionary;
+    compress(cfg, ref, plain, false);
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, dictionary->compress(cfg, ref, withDictionary));
+    EXPECT_LESS(withDictionary.getDataLen(), plain.getDataLen());
+
+    DataBuffer uncompressed;
+    dictionary->decompress(docs[42].size(), ConstBufferRef(withDictionary.getData(), withDictionary.getDataLen()), uncompressed);
+    EXPECT_EQUAL(docs[42], vespalib::string(uncompressed.getData(), uncompressed.getDataLen()));
+}
+
+TEST("require that zstd dictionary can be recreated from its content") {
+    auto docs = make_small_documents(2000);
+    auto dictionary = ZStdDictionary::train(as_samples(docs), 4096, 9);
+    ASSERT_TRUE(dictionary);
+    ZStdDictionary copy(dictionary->content(), 3);
+    EXPECT_EQUAL(dictionary->id(), copy.id());
+
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD);
+    DataBuffer compressed;
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD,
+                 dictionary->compress(cfg, ConstBufferRef(docs[7].data(), docs[7].size()), compressed));
+    DataBuffer uncompressed;
+    copy.decompress(docs[7].size(), ConstBufferRef(compressed.getData(), compressed.getDataLen()), uncompressed);
+    EXPECT_EQUAL(docs[7], vespalib::string(uncompressed.getData(), uncompressed.getDataLen()));
+    EXPECT_EXCEPTION(copy.decompress(docs[7].size() + 1, ConstBufferRef(compressed.getData(), compressed.getDataLen()), uncompressed),
+                     std::runtime_error, "zstd dictionary");
+}
+
+TEST("require that zstd dictionary falls back to no compression") {
+    auto docs = make_small_documents(2000);
+    auto dictionary = ZStdDictionary::train(as_samples(docs), 4096, 9);
+    ASSERT_TRUE(dictionary);
+    vespalib::string random;
+    for (size_t i(0); i < 64; i++) {
+        random.push_back(char((i * 2654435761u) >> 13));
+    }
+    DataBuffer compressed;
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD);
+    EXPECT_EQUAL(CompressionConfig::Type::NONE, dictionary->compress(cfg, ConstBufferRef(random.data(), random.size()), compressed));
+    EXPECT_EQUAL(random, vespalib::string(compressed.getData(), compressed.getDataLen()));
+}
+
+TEST("require that zstd dictionary is not trained without samples") {
+    EXPECT_FALSE(ZStdDictionary::train({}, 4096, 9));
+    EXPECT_EXCEPTION(ZStdDictionary(ConstBufferRef("not a dictionary", 16), 9), std::runtime_error, "Not a zstd dictionary");
+}
+
 TEST_MAIN() {
     TEST_RUN_ALL();
 }
@@ -47,4 +47,73 @@ TEST("test euclidean distance") {
     TEST_DO(verifyEuclideanDistance(hwaccelerated::IAccelerated::getAccelerator(), TEST_LENGTH));
 }
 
+void
+verifySumOfTableLookups(const hwaccelerated::IAccelerated & accel) {
+    srand(1);
+    for (size_t sz : {1, 7, 8, 9, 15, 16, 17, 32, 96, 100}) {
+        std::vector<float> table(sz * 256);
+        for (auto & v : table) {
+            v = float(rand() % 500) / 8;
+        }
+        std::vector<uint8_t> codes(sz);
+        for (auto & c : codes) {
+            c = rand() % 256;
+        }
+        double expected(0);
+        for (size_t i(0); i < sz; i++) {
+            expected += table[i * 256 + codes[i]];
+        }
+        EXPECT_APPROX(expected, accel.sum_of_table_lookups(table.data(), codes.data(), sz), expected * 0.0001);
+    }
+}
+
+TEST("test sum of table lookups") {
+    TEST_DO(verifySumOfTableLookups(hwaccelerated::GenericAccelrator()));
+    TEST_DO(verifySumOfTableLookups(hwaccelerated::IAccelerated::getAccelerator()));
+}
+
+void
+verifyCombineAndCount(const hwaccelerated::IAccelerated & accel, bool isAnd, size_t numSources) {
+    constexpr size_t NUM_WORDS = 16 * 9;
+    constexpr size_t OFFSET_WORDS = 16;
+    srand(numSources);
+    std::vector<std::vector<uint64_t>> words(numSources, std::vector<uint64_t>(NUM_WORDS));
+    std::vector<std::pair<const void *, bool>> src;
+    for (size_t i(0); i < numSources; i++) {
+        for (auto & w : words[i]) {
+            w = (uint64_t(rand()) << 32) ^ uint64_t(rand()) ^ (uint64_t(rand()) << 16);
+        }
+        src.emplace_back(words[i].data(), (i % 3) == 2);
+    }
+    size_t bytes = (NUM_WORDS - OFFSET_WORDS) * sizeof(uint64_t);
+    std::vector<uint64_t> dest(NUM_WORDS - OFFSET_WORDS);
+    size_t count = isAnd
+        ? accel.andN(OFFSET_WORDS * sizeof(uint64_t), bytes, src, dest.data())
+        : accel.orN(OFFSET_WORDS * sizeof(uint64_t), bytes, src, dest.data());
+    size_t expectedCount(0);
+    for (size_t w(OFFSET_WORDS); w < NUM_WORDS; w++) {
+        uint64_t expected = src[0].second ? ~words[0][w] : words[0][w];
+        for (size_t i(1); i < numSources; i++) {
+            uint64_t v = src[i].second ? ~words[i][w] : words[i][w];
+            expected = isAnd ? (expected & v) : (expected | v);
+        }
+        EXPECT_EQUAL(expected, dest[w - OFFSET_WORDS]);
+        expectedCount += __builtin_popcountl(expected);
+    }
+    EXPECT_EQUAL(expectedCount, count);
+}
+
+void
+verifyCombineAndCount(const hwaccelerated::IAccelerated & accel) {
+    for (size_t numSources : {1, 2, 3, 7}) {
+        TEST_DO(verifyCombineAndCount(accel, true, numSources));
+        TEST_DO(verifyCombineAndCount(accel, false, numSources));
+    }
+}
+
+TEST("test N-way and/or with population count") {
+    TEST_DO(verifyCombineAndCount(hwaccelerated::GenericAccelrator()));
+    TEST_DO(verifyCombineAndCount(hwaccelerated::IAccelerated::getAccelerator()));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
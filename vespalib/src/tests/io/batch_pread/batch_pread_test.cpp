@@ -0,0 +1,81 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/io/batch_pread.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+using vespalib::BatchPread;
+using Request = BatchPread::Request;
+
+struct BatchPreadTest : ::testing::Test {
+    std::string file_name;
+    std::string content;
+    int fd;
+    BatchPreadTest()
+        : file_name("batch_pread_test.dat"),
+          content(),
+          fd(-1)
+    {
+        for (size_t i = 0; i < 100000; ++i) {
+            content.push_back('a' + (i % 23));
+        }
+        int wfd = ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        EXPECT_EQ(::write(wfd, content.data(), content.size()), ssize_t(content.size()));
+        ::close(wfd);
+        fd = ::open(file_name.c_str(), O_RDONLY);
+    }
+    ~BatchPreadTest() override {
+        ::close(fd);
+        ::unlink(file_name.c_str());
+    }
+};
+
+TEST_F(BatchPreadTest, many_reads_can_be_performed_at_once)
+{
+    fprintf(stderr, "io_uring is %s\n", BatchPread::has_io_uring() ? "used" : "not used");
+    std::vector<std::string> bufs(200);
+    std::vector<Request> requests;
+    for (size_t i = 0; i < bufs.size(); ++i) {
+        size_t offset = (i * 7919) % 90000;
+        size_t size = 1 + (i * 31) % 9000;
+        bufs[i].resize(size);
+        requests.emplace_back(fd, bufs[i].data(), size, offset);
+    }
+    BatchPread::read(requests);
+    for (size_t i = 0; i < requests.size(); ++i) {
+        EXPECT_EQ(requests[i].result, ssize_t(requests[i].size));
+        EXPECT_EQ(bufs[i], content.substr(requests[i].offset, requests[i].size));
+    }
+}
+
+TEST_F(BatchPreadTest, reads_are_short_at_end_of_file_and_failures_are_reported)
+{
+    std::string buf1(1000, '\0');
+    std::string buf2(1000, '\0');
+    std::string buf3(1000, '\0');
+    std::vector<Request> requests;
+    requests.emplace_back(fd, buf1.data(), buf1.size(), content.size() - 300);
+    requests.emplace_back(fd, buf2.data(), buf2.size(), content.size() + 300);
+    requests.emplace_back(-1, buf3.data(), buf3.size(), 0);
+    BatchPread::read(requests);
+    EXPECT_EQ(requests[0].result, 300);
+    EXPECT_EQ(buf1.substr(0, 300), content.substr(content.size() - 300));
+    EXPECT_EQ(requests[1].result, 0);
+    EXPECT_EQ(requests[2].result, -EBADF);
+}
+
+TEST_F(BatchPreadTest, single_and_empty_batches_are_handled)
+{
+    std::string buf(10, '\0');
+    std::vector<Request> requests;
+    BatchPread::read(requests);
+    requests.emplace_back(fd, buf.data(), buf.size(), 5);
+    BatchPread::read(requests);
+    EXPECT_EQ(requests[0].result, 10);
+    EXPECT_EQ(buf, content.substr(5, 10));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
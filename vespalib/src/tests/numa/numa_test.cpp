@@ -0,0 +1,99 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/numa.h>
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <functional>
+#include <sched.h>
+#include <thread>
+
+using vespalib::NumaNodeCpus;
+using vespalib::Runnable;
+using vespalib::parse_cpu_list;
+using vespalib::ScopedCpuPinning;
+using vespalib::pin_to_cpus;
+
+struct RunFun : Runnable {
+    std::function<void()> my_fun;
+    RunFun(std::function<void()> fun_in) : my_fun(fun_in) {}
+    void run() override { my_fun(); }
+};
+
+int my_init_fun(Runnable &target) {
+    target.run();
+    return 1;
+}
+
+void run_with_init(std::function<void()> my_fun, Runnable::init_fun_t init_fun) {
+    std::thread thread([init_fun, my_fun]
+                       {
+                           RunFun run_fun(my_fun);
+                           EXPECT_EQUAL(init_fun(run_fun), 1);
+                       });
+    thread.join();
+}
+
+std::vector<int> my_cpus() {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    std::vector<int> result;
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &cpu_set)) {
+                result.push_back(cpu);
+            }
+        }
+    }
+    return result;
+}
+
+TEST("require that cpu lists can be parsed") {
+    EXPECT_TRUE(parse_cpu_list("") == std::vector<int>());
+    EXPECT_TRUE(parse_cpu_list("5\n") == std::vector<int>({5}));
+    EXPECT_TRUE(parse_cpu_list("0-3,8,10-11") == std::vector<int>({0,1,2,3,8,10,11}));
+    EXPECT_TRUE(parse_cpu_list("1,x,3-a,4") == std::vector<int>({1,4}));
+}
+
+TEST("require that numa node cpus can be listed") {
+    auto nodes = vespalib::numa_node_cpus();
+    fprintf(stderr, "found %zu numa nodes\n", nodes.size());
+    for (const auto &cpus: nodes) {
+        EXPECT_FALSE(cpus.empty());
+    }
+}
+
+TEST("require that init function is used as is without cpus") {
+    size_t cnt = 0;
+    auto before = my_cpus();
+    run_with_init([&]{ ++cnt; EXPECT_TRUE(my_cpus() == before); }, pin_to_cpus(my_init_fun, {}));
+    EXPECT_EQUAL(cnt, 1u);
+}
+
+TEST("require that started threads are pinned to the given cpus") {
+    auto cpus = my_cpus();
+    ASSERT_TRUE(!cpus.empty());
+    std::vector<int> wanted({cpus.back()});
+    size_t cnt = 0;
+    run_with_init([&]{ ++cnt; EXPECT_TRUE(my_cpus() == wanted); }, pin_to_cpus(my_init_fun, wanted));
+    EXPECT_EQUAL(cnt, 1u);
+}
+
+TEST("require that scoped cpu pinning restores the previous cpus") {
+    auto before = my_cpus();
+    ASSERT_TRUE(!before.empty());
+    std::vector<int> wanted({before.front()});
+    std::thread thread([&]
+                       {
+                           {
+                               ScopedCpuPinning pinning(wanted);
+                               EXPECT_TRUE(my_cpus() == wanted);
+                           }
+                           EXPECT_TRUE(my_cpus() == before);
+                           {
+                               ScopedCpuPinning pinning({});
+                               EXPECT_TRUE(my_cpus() == before);
+                           }
+                       });
+    thread.join();
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
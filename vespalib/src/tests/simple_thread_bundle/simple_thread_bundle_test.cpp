@@ -6,6 +6,9 @@
 #include <vespa/vespalib/util/small_vector.h>
 #include <vespa/vespalib/util/gate.h>
 #include <thread>
+#ifdef __linux__
+#include <sched.h>
+#endif
 #include <forward_list>
 
 using namespace vespalib;
@@ -182,6 +185,52 @@ TEST_F("require that bundle pool reuses bundles", SimpleThreadBundle::Pool(5)) {
     EXPECT_EQUAL(ptr, &bundle.bundle());
 }
 
+#ifdef __linux__
+
+std::vector<int> my_cpus() {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    std::vector<int> result;
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &cpu_set)) {
+                result.push_back(cpu);
+            }
+        }
+    }
+    return result;
+}
+
+struct CpuRecorder : Runnable {
+    std::vector<int> cpus;
+    void run() override { cpus = my_cpus(); }
+};
+
+void verify_bundle_cpus(SimpleThreadBundle &bundle, const std::vector<int> &wanted) {
+    std::vector<CpuRecorder> recorders(bundle.size());
+    bundle.run(recorders);
+    for (const auto &recorder: recorders) {
+        EXPECT_TRUE(recorder.cpus == wanted);
+    }
+}
+
+TEST("require that bundle pool pins all threads of each bundle to a single numa node") {
+    auto before = my_cpus();
+    ASSERT_TRUE(!before.empty());
+    std::vector<int> node_a({before.front()});
+    std::vector<int> node_b({before.back()});
+    SimpleThreadBundle::Pool pool(3, Runnable::default_init_function, NumaNodeCpus({node_a, node_b}));
+    auto bundle_a = pool.obtain();
+    auto bundle_b = pool.obtain();
+    auto bundle_c = pool.obtain();
+    TEST_DO(verify_bundle_cpus(*bundle_a, node_a));
+    TEST_DO(verify_bundle_cpus(*bundle_b, node_b));
+    TEST_DO(verify_bundle_cpus(*bundle_c, node_a));
+    EXPECT_TRUE(my_cpus() == before);
+}
+
+#endif
+
 TEST_MT_FF("require that bundle pool works with multiple threads", 32, SimpleThreadBundle::Pool(3),
            std::vector<SimpleThreadBundle*>(num_threads, 0))
 {
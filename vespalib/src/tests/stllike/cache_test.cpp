@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/stllike/small_string.h>
 #include <vespa/vespalib/stllike/cache.hpp>
+#include <functional>
 #include <map>
 
 using namespace vespalib;
@@ -26,6 +27,21 @@ public:
     void erase(const K & k) {
         M::erase(k);
     }
+    template <typename F>
+    void read_batch(const std::vector<K> & keys, F found) const {
+        ++batch_reads;
+        for (const K & k : keys) {
+            const_iterator it = M::find(k);
+            if (it != this->end()) {
+                found(k, it->second);
+            }
+        }
+        if (after_batch_read) {
+            after_batch_read();
+        }
+    }
+    mutable size_t batch_reads = 0;
+    std::function<void()> after_batch_read;
 };
 
 using P = LruParam<uint32_t, vespa_string>;
@@ -48,6 +64,55 @@ TEST("testCache") {
     EXPECT_TRUE(cache.size() == 1);
 }
 
+TEST("require that multiple objects can be read at once") {
+    B m;
+    cache< CacheParam<P, B> > cache(m, -1);
+    cache.write(1, "first");
+    m[2] = "second";
+    m[3] = "third";
+    auto values = cache.read_batch({3, 1, 4, 2, 3});
+    ASSERT_EQUAL(5u, values.size());
+    EXPECT_EQUAL("third", values[0]);
+    EXPECT_EQUAL("first", values[1]);
+    EXPECT_EQUAL("", values[2]);
+    EXPECT_EQUAL("second", values[3]);
+    EXPECT_EQUAL("third", values[4]);
+    EXPECT_EQUAL(1u, m.batch_reads);
+    EXPECT_TRUE(cache.hasKey(2));
+    EXPECT_TRUE(cache.hasKey(3));
+    EXPECT_FALSE(cache.hasKey(4));
+    EXPECT_EQUAL(1u, cache.getHit());
+    EXPECT_EQUAL(4u, cache.getMiss());
+    EXPECT_EQUAL(2u, cache.getInsert());
+    EXPECT_EQUAL(1u, cache.getNoneExisting());
+    values = cache.read_batch({2, 3});
+    EXPECT_EQUAL("second", values[0]);
+    EXPECT_EQUAL("third", values[1]);
+    EXPECT_EQUAL(1u, m.batch_reads);
+}
+
+TEST("require that batch read objects are not cached when invalidated while reading") {
+    B m;
+    cache< CacheParam<P, B> > cache(m, -1);
+    m[1] = "old";
+    m[2] = "other";
+    m.after_batch_read = [&cache]() { cache.write(1, "new"); };
+    auto values = cache.read_batch({1, 2});
+    EXPECT_EQUAL("old", values[0]);
+    EXPECT_EQUAL("other", values[1]);
+    EXPECT_EQUAL("new", cache.read(1));
+    EXPECT_FALSE(cache.hasKey(2));
+    EXPECT_EQUAL(1u, cache.getRace());
+    m.after_batch_read = [&cache]() { cache.invalidate(2); };
+    values = cache.read_batch({2});
+    EXPECT_EQUAL("other", values[0]);
+    EXPECT_FALSE(cache.hasKey(2));
+    m.after_batch_read = {};
+    values = cache.read_batch({2});
+    EXPECT_EQUAL("other", values[0]);
+    EXPECT_TRUE(cache.hasKey(2));
+}
+
 TEST("testCacheSize")
 {
     B m;
@@ -82,6 +147,7 @@ TEST("testCacheEntriesHonoured") {
     EXPECT_TRUE( cache.hasKey(2) );
     EXPECT_FALSE( cache.hasKey(1) );
     EXPECT_EQUAL(96u, cache.sizeBytes());
+    EXPECT_EQUAL(1u, cache.getEvictions());
 }
 
 TEST("testCacheMaxSizeHonoured") {
@@ -96,9 +162,11 @@ TEST("testCacheMaxSizeHonoured") {
     cache.write(3, "17 bytes stringgg");
     EXPECT_EQUAL(3u, cache.size());
     EXPECT_EQUAL(288u, cache.sizeBytes());
+    EXPECT_EQUAL(0u, cache.get_stats().evictions);
     cache.write(4, "18 bytes stringggg");
     EXPECT_EQUAL(3u, cache.size());
     EXPECT_EQUAL(291u, cache.sizeBytes());
+    EXPECT_EQUAL(1u, cache.get_stats().evictions);
 }
 
 TEST("testThatMultipleRemoveOnOverflowIsFine") {
@@ -409,6 +409,14 @@ public:
      */
     const AggrT & getAggregated() const noexcept;
 
+    /*
+     * Get aggregated values for the current leaf node, and the last key in
+     * the current leaf node. Used to skip past whole leaf nodes based on
+     * the aggregated values. Iterator must be valid.
+     */
+    const AggrT & getLeafAggregated() const noexcept { return _leaf.getNode()->getAggregated(); }
+    const KeyType & getLeafLastKey() const noexcept { return _leaf.getNode()->getLastKey(); }
+
     bool identical(const BTreeIteratorBase &rhs) const noexcept;
 
     template <typename FunctionType>
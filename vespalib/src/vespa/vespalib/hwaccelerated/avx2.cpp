@@ -2,6 +2,7 @@
 
 #include "avx2.h"
 #include "avxprivate.hpp"
+#include <immintrin.h>
 
 namespace vespalib::hwaccelerated {
 
@@ -25,6 +26,23 @@ Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * b, siz
     return avx::euclideanDistanceSelectAlignment<double, 32>(a, b, sz);
 }
 
+float
+Avx2Accelrator::sum_of_table_lookups(const float * table, const uint8_t * codes, size_t sz) const noexcept {
+    // Gather the table entries for 8 codes at a time, lane j reads from the table for code i + j.
+    const __m256i lane_offsets = _mm256_setr_epi32(0, 256, 512, 768, 1024, 1280, 1536, 1792);
+    __m256 sum = _mm256_setzero_ps();
+    size_t i(0);
+    for (; i + 8 <= sz; i += 8, table += 8 * 256) {
+        __m128i code_bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(codes + i));
+        __m256i indexes = _mm256_add_epi32(_mm256_cvtepu8_epi32(code_bytes), lane_offsets);
+        sum = _mm256_add_ps(sum, _mm256_i32gather_ps(table, indexes, sizeof(float)));
+    }
+    __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    sum4 = _mm_hadd_ps(sum4, sum4);
+    sum4 = _mm_hadd_ps(sum4, sum4);
+    return _mm_cvtss_f32(sum4) + helper::sum_of_table_lookups(table, codes + i, sz - i);
+}
+
 void
 Avx2Accelrator::and128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept {
     helper::andChunks<32u, 4u>(offset, src, dest);
@@ -35,6 +53,16 @@ Avx2Accelrator::or128(size_t offset, const std::vector<std::pair<const void *, b
     helper::orChunks<32u, 4u>(offset, src, dest);
 }
 
+size_t
+Avx2Accelrator::andN(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept {
+    return helper::andChunksAndCount<32u, 4u>(offset, bytes, src, dest);
+}
+
+size_t
+Avx2Accelrator::orN(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept {
+    return helper::orChunksAndCount<32u, 4u>(offset, bytes, src, dest);
+}
+
 void
 Avx2Accelrator::convert_bfloat16_to_float(const uint16_t * src, float * dest, size_t sz) const noexcept {
     helper::convert_bfloat16_to_float(src, dest, sz);
@@ -2,6 +2,7 @@
 
 #include "avx512.h"
 #include "avxprivate.hpp"
+#include <immintrin.h>
 
 namespace vespalib:: hwaccelerated {
 
@@ -35,6 +36,21 @@ Avx512Accelrator::squaredEuclideanDistance(const double * a, const double * b, s
     return avx::euclideanDistanceSelectAlignment<double, 64>(a, b, sz);
 }
 
+float
+Avx512Accelrator::sum_of_table_lookups(const float * table, const uint8_t * codes, size_t sz) const noexcept {
+    // Gather the table entries for 16 codes at a time, lane j reads from the table for code i + j.
+    const __m512i lane_offsets = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                                                    _mm512_set1_epi32(256));
+    __m512 sum = _mm512_setzero_ps();
+    size_t i(0);
+    for (; i + 16 <= sz; i += 16, table += 16 * 256) {
+        __m128i code_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(codes + i));
+        __m512i indexes = _mm512_add_epi32(_mm512_cvtepu8_epi32(code_bytes), lane_offsets);
+        sum = _mm512_add_ps(sum, _mm512_i32gather_ps(indexes, table, sizeof(float)));
+    }
+    return _mm512_reduce_add_ps(sum) + Avx2Accelrator::sum_of_table_lookups(table, codes + i, sz - i);
+}
+
 void
 Avx512Accelrator::and128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept {
     helper::andChunks<64, 2>(offset, src, dest);
@@ -45,6 +61,16 @@ Avx512Accelrator::or128(size_t offset, const std::vector<std::pair<const void *,
     helper::orChunks<64, 2>(offset, src, dest);
 }
 
+size_t
+Avx512Accelrator::andN(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept {
+    return helper::andChunksAndCount<64, 2>(offset, bytes, src, dest);
+}
+
+size_t
+Avx512Accelrator::orN(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept {
+    return helper::orChunksAndCount<64, 2>(offset, bytes, src, dest);
+}
+
 void
 Avx512Accelrator::convert_bfloat16_to_float(const uint16_t * src, float * dest, size_t sz) const noexcept {
     helper::convert_bfloat16_to_float(src, dest, sz);
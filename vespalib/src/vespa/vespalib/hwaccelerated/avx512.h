@@ -18,10 +18,13 @@ public:
     double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const noexcept override;
     double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const noexcept override;
     double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const noexcept override;
+    float sum_of_table_lookups(const float * table, const uint8_t * codes, size_t sz) const noexcept override;
     void convert_bfloat16_to_float(const uint16_t * src, float * dest, size_t sz) const noexcept override;
     int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const noexcept override;
     void and128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept override;
     void or128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept override;
+    size_t andN(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept override;
+    size_t orN(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept override;
 };
 
 }
@@ -152,6 +152,11 @@ GenericAccelrator::notBit(void * aOrg, size_t bytes) const noexcept
     }
 }
 
+float
+GenericAccelrator::sum_of_table_lookups(const float * table, const uint8_t * codes, size_t sz) const noexcept {
+    return helper::sum_of_table_lookups(table, codes, sz);
+}
+
 void
 GenericAccelrator::convert_bfloat16_to_float(const uint16_t * src, float * dest, size_t sz) const noexcept {
     helper::convert_bfloat16_to_float(src, dest, sz);
@@ -187,4 +192,14 @@ GenericAccelrator::or128(size_t offset, const std::vector<std::pair<const void *
     helper::orChunks<16, 8>(offset, src, dest);
 }
 
+size_t
+GenericAccelrator::andN(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept {
+    return helper::andChunksAndCount<16, 8>(offset, bytes, src, dest);
+}
+
+size_t
+GenericAccelrator::orN(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept {
+    return helper::orChunksAndCount<16, 8>(offset, bytes, src, dest);
+}
+
 }
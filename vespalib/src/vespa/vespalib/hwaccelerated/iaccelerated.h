@@ -32,10 +32,17 @@ public:
     virtual double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const noexcept = 0;
     virtual double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const noexcept = 0;
     virtual double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const noexcept = 0;
+    // Sum of table[i * 256 + codes[i]] for i in [0, sz), as used for asymmetric distance computation
+    // against product quantized vectors. The table has 256 entries per code.
+    virtual float sum_of_table_lookups(const float * table, const uint8_t * codes, size_t sz) const noexcept = 0;
     // AND 128 bytes from multiple, optionally inverted sources
     virtual void and128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept = 0;
     // OR 128 bytes from multiple, optionally inverted sources
     virtual void or128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept = 0;
+    // AND bytes, a multiple of 128, from multiple, optionally inverted sources. Returns the population count of dest.
+    virtual size_t andN(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept = 0;
+    // OR bytes, a multiple of 128, from multiple, optionally inverted sources. Returns the population count of dest.
+    virtual size_t orN(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept = 0;
 
     static const IAccelerated & getAccelerator() __attribute__((noinline));
 };
@@ -85,6 +85,58 @@ orChunks(size_t offset, const std::vector<std::pair<const void *, bool>> &src, v
     }
 }
 
+/*
+ * Combine all 128 byte blocks in [offset, offset + bytes) of multiple, optionally inverted, sources
+ * into dest. Each block is kept in registers while all sources are applied, and is counted before
+ * it is stored, so the population count of the result comes without a second pass over dest.
+ */
+template<unsigned ChunkSize, unsigned Chunks, typename Combine>
+size_t
+combineChunksAndCount(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src,
+                      void *dest, Combine combine)
+{
+    typedef uint64_t Chunk __attribute__ ((vector_size (ChunkSize)));
+    static_assert(sizeof(Chunk) == ChunkSize, "sizeof(Chunk) == ChunkSize");
+    static_assert(ChunkSize * Chunks == 128, "ChunkSize*Chunks == 128");
+    constexpr size_t WordsPerChunk = ChunkSize / sizeof(uint64_t);
+    size_t count(0);
+    char * out = static_cast<char *>(dest);
+    for (size_t block(0); block < bytes; block += 128) {
+        Chunk acc[Chunks];
+        const Chunk * tmp = cast<Chunk, ChunkSize>(src[0].first, offset + block);
+        for (size_t n = 0; n < Chunks; n++) {
+            acc[n] = get<Chunk, ChunkSize>(tmp + n, src[0].second);
+        }
+        for (size_t i(1); i < src.size(); i++) {
+            tmp = cast<Chunk, ChunkSize>(src[i].first, offset + block);
+            for (size_t n = 0; n < Chunks; n++) {
+                acc[n] = combine(acc[n], get<Chunk, ChunkSize>(tmp + n, src[i].second));
+            }
+        }
+        for (size_t n = 0; n < Chunks; n++) {
+            for (size_t w = 0; w < WordsPerChunk; w++) {
+                count += Optimized::popCount(acc[n][w]);
+            }
+        }
+        memcpy(out + block, acc, sizeof(acc));
+    }
+    return count;
+}
+
+template<unsigned ChunkSize, unsigned Chunks>
+size_t
+andChunksAndCount(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) {
+    return combineChunksAndCount<ChunkSize, Chunks>(offset, bytes, src, dest,
+                                                    [](auto a, auto b) noexcept { return a & b; });
+}
+
+template<unsigned ChunkSize, unsigned Chunks>
+size_t
+orChunksAndCount(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) {
+    return combineChunksAndCount<ChunkSize, Chunks>(offset, bytes, src, dest,
+                                                    [](auto a, auto b) noexcept { return a | b; });
+}
+
 template<typename TemporaryT=int32_t>
 double squaredEuclideanDistanceT(const int8_t *a, const int8_t *b, size_t sz) __attribute__((noinline));
 
@@ -113,6 +165,27 @@ squaredEuclideanDistance(const int8_t *a, const int8_t *b, size_t sz) {
     return sum;
 }
 
+inline float
+sum_of_table_lookups(const float *table, const uint8_t *codes, size_t sz) noexcept {
+    constexpr size_t TABLE_STRIDE = 256;
+    // Four independent sums keeps the table lookups from being serialized on a single accumulator.
+    float sum0(0);
+    float sum1(0);
+    float sum2(0);
+    float sum3(0);
+    size_t i(0);
+    for (; i + 4 <= sz; i += 4, table += 4 * TABLE_STRIDE) {
+        sum0 += table[codes[i]];
+        sum1 += table[TABLE_STRIDE + codes[i + 1]];
+        sum2 += table[2 * TABLE_STRIDE + codes[i + 2]];
+        sum3 += table[3 * TABLE_STRIDE + codes[i + 3]];
+    }
+    for (; i < sz; i++, table += TABLE_STRIDE) {
+        sum0 += table[codes[i]];
+    }
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
 inline void
 convert_bfloat16_to_float(const uint16_t *src, float *dest, size_t sz) noexcept {
     uint32_t *asu32 = reinterpret_cast<uint32_t *>(dest);
@@ -0,0 +1,156 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "batch_pread.h"
+#include <vespa/config.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <unistd.h>
+
+#ifdef VESPA_HAS_IO_URING
+#include <liburing.h>
+#endif
+
+namespace vespalib {
+
+namespace {
+
+// complete a (possibly partially performed) read using blocking pread
+void finish_with_pread(BatchPread::Request &req) {
+    size_t done = (req.result > 0) ? size_t(req.result) : 0;
+    while (done < req.size) {
+        ssize_t res = ::pread(req.fd, req.buf + done, req.size - done, req.offset + done);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            req.result = -errno;
+            return;
+        }
+        if (res == 0) {
+            break; // end of file
+        }
+        done += res;
+    }
+    req.result = done;
+}
+
+#ifdef VESPA_HAS_IO_URING
+
+constexpr size_t ring_entries = 64;
+
+struct Ring {
+    io_uring uring;
+    bool     initialized;
+    bool     valid;
+    Ring() : uring(), initialized(false), valid(false) {
+        io_uring_probe *probe = io_uring_get_probe();
+        bool can_read = (probe != nullptr) && io_uring_opcode_supported(probe, IORING_OP_READ);
+        free(probe);
+        initialized = can_read && (io_uring_queue_init(ring_entries, &uring, 0) == 0);
+        valid = initialized;
+    }
+    ~Ring() {
+        if (initialized) {
+            io_uring_queue_exit(&uring);
+        }
+    }
+    // wait for a single completion and record its result in the request
+    void reap_one() {
+        io_uring_cqe *cqe = nullptr;
+        while (io_uring_wait_cqe(&uring, &cqe) != 0 || cqe == nullptr) {
+            // interrupted; the read is still in flight into the request buffer, so keep waiting
+        }
+        auto *req = static_cast<BatchPread::Request *>(io_uring_cqe_get_data(cqe));
+        req->result = cqe->res;
+        io_uring_cqe_seen(&uring, cqe);
+    }
+    // Submit reads (at most ring_entries) and wait for all submitted
+    // reads to complete. Requests that could not be submitted are left
+    // with a result of 0, to be completed using pread by the caller.
+    // If the kernel refuses to accept the remaining entries, the ring
+    // is marked as invalid since those entries are still queued in it.
+    void read(std::span<BatchPread::Request> requests) {
+        size_t prepared = 0;
+        for (auto &req: requests) {
+            req.result = 0;
+            io_uring_sqe *sqe = io_uring_get_sqe(&uring);
+            if (sqe == nullptr) {
+                break;
+            }
+            io_uring_prep_read(sqe, req.fd, req.buf, req.size, req.offset);
+            io_uring_sqe_set_data(sqe, &req);
+            ++prepared;
+        }
+        size_t submitted = 0;
+        size_t completed = 0;
+        while (submitted < prepared) {
+            int res = io_uring_submit(&uring);
+            if (res > 0) {
+                submitted += res; // a short submit is legal, try again with the rest
+            } else if (res == -EINTR) {
+                continue;
+            } else if ((res == 0 || res == -EAGAIN || res == -EBUSY) && completed < submitted) {
+                reap_one(); // make room for more requests in the kernel
+                ++completed;
+            } else {
+                valid = false;
+                break;
+            }
+        }
+        for (; completed < submitted; ++completed) {
+            reap_one();
+        }
+    }
+};
+
+Ring &thread_ring() {
+    thread_local Ring ring;
+    return ring;
+}
+
+#endif
+
+}
+
+void
+BatchPread::read(std::span<Request> requests)
+{
+#ifdef VESPA_HAS_IO_URING
+    if (requests.size() > 1) {
+        Ring &ring = thread_ring();
+        if (ring.valid) {
+            for (auto &req: requests) {
+                req.result = 0;
+            }
+            for (size_t i = 0; i < requests.size() && ring.valid; i += ring_entries) {
+                ring.read(requests.subspan(i, std::min(ring_entries, requests.size() - i)));
+            }
+            // short reads are completed (and failed reads retried) synchronously
+            for (auto &req: requests) {
+                if ((req.result < 0) || (size_t(req.result) < req.size)) {
+                    req.result = std::max(req.result, ssize_t(0));
+                    finish_with_pread(req);
+                }
+            }
+            return;
+        }
+    }
+#endif
+    for (auto &req: requests) {
+        req.result = 0;
+        finish_with_pread(req);
+    }
+}
+
+bool
+BatchPread::has_io_uring()
+{
+#ifdef VESPA_HAS_IO_URING
+    return thread_ring().valid;
+#else
+    return false;
+#endif
+}
+
+}
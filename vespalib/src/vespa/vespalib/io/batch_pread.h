@@ -0,0 +1,38 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <sys/types.h>
+
+namespace vespalib {
+
+/**
+ * Reads several regions of (possibly different) files at once. When
+ * io_uring is available, all reads are submitted to the kernel
+ * together, letting the storage device serve them in parallel instead
+ * of paying the full device latency for each of them in turn. If
+ * io_uring is not available, the reads are performed one by one
+ * using pread.
+ **/
+class BatchPread {
+public:
+    struct Request {
+        int      fd;
+        char    *buf;
+        size_t   size;
+        uint64_t offset;
+        ssize_t  result; // number of bytes read, or -errno on failure
+        Request(int fd_in, char *buf_in, size_t size_in, uint64_t offset_in) noexcept
+            : fd(fd_in), buf(buf_in), size(size_in), offset(offset_in), result(0) {}
+    };
+    // Performs all reads. A request is only given less than the
+    // wanted number of bytes if end of file is reached or it fails.
+    static void read(std::span<Request> requests);
+    // Whether reads performed by the calling thread use io_uring.
+    static bool has_io_uring();
+};
+
+}
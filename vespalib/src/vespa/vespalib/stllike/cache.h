@@ -5,6 +5,7 @@
 #include <vespa/vespalib/util/memoryusage.h>
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 namespace vespalib {
 
@@ -98,6 +99,15 @@ public:
      */
     V read(const K & key);
 
+    /**
+     * Return the objects with the given keys, in the same order. Objects not in the cache
+     * are fetched from the backing store with a single call to its read_batch function,
+     * which must call a given function with key and value for each object found.
+     * No locks are held while reading from the backing store. The cache is updated with the
+     * fetched objects unless objects were written or invalidated in the meantime.
+     */
+    std::vector<V> read_batch(const std::vector<K> & keys);
+
     /**
      * Update the cache and write through to backing store.
      * Object is then put at head of LRU list.
@@ -120,6 +130,7 @@ public:
     size_t        getWrite() const { return _write.load(std::memory_order_relaxed); }
     size_t   getInvalidate() const { return _invalidate.load(std::memory_order_relaxed); }
     size_t       getlookup() const { return _lookup.load(std::memory_order_relaxed); }
+    size_t    getEvictions() const { return _evictions.load(std::memory_order_relaxed); }
 
 protected:
     using UniqueLock = std::unique_lock<std::mutex>;
@@ -164,6 +175,9 @@ private:
     mutable std::atomic<size_t> _update;
     mutable std::atomic<size_t> _invalidate;
     mutable std::atomic<size_t> _lookup;
+    std::atomic<size_t>         _evictions;
+    /// Bumped (under _hashLock) by every write and invalidation, used to detect stale batch reads.
+    uint64_t                    _modificationGeneration;
     BackingStore              & _store;
     mutable std::mutex          _hashLock;
     /// Striped locks that can be used for having a locked access to the backing store.
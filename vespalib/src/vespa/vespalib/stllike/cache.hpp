@@ -4,6 +4,7 @@
 #include "cache.h"
 #include "cache_stats.h"
 #include "lrucache_map.hpp"
+#include <unordered_map>
 
 namespace vespalib {
 
@@ -52,6 +53,8 @@ cache<P>::cache(BackingStore & b, size_t maxBytes) :
     _update(0),
     _invalidate(0),
     _lookup(0),
+    _evictions(0),
+    _modificationGeneration(0),
     _store(b)
 { }
 
@@ -71,6 +74,7 @@ cache<P>::removeOldest(const value_type & v) {
     bool remove(Lru::removeOldest(v) || (sizeBytes() >= capacityBytes()));
     if (remove) {
         _sizeBytes.store(sizeBytes() - calcSize(v.first, v.second._value), std::memory_order_relaxed);
+        _evictions.store(getEvictions() + 1, std::memory_order_relaxed);
     }
     return remove;
 }
@@ -116,6 +120,61 @@ cache<P>::read(const K & key)
     return value;
 }
 
+template< typename P >
+std::vector<typename P::Value>
+cache<P>::read_batch(const std::vector<K> & keys)
+{
+    std::vector<V> values(keys.size());
+    std::vector<K> toFetch;
+    std::vector<size_t> fetchIdx;
+    uint64_t generation(0);
+    {
+        std::lock_guard guard(_hashLock);
+        for (size_t i(0); i < keys.size(); i++) {
+            if (Lru::hasKey(keys[i])) {
+                increment_stat(_hit, guard);
+                values[i] = V((*this)[keys[i]]);
+            } else {
+                increment_stat(_miss, guard);
+                toFetch.push_back(keys[i]);
+                fetchIdx.push_back(i);
+            }
+        }
+        generation = _modificationGeneration;
+    }
+    if (toFetch.empty()) {
+        return values;
+    }
+    // The backing store is read without holding any locks, so that writers are not stalled by disk I/O.
+    std::unordered_map<K, V, Hash> fetched;
+    _store.read_batch(toFetch, [&fetched](const K & key, V value) { fetched[key] = std::move(value); });
+    {
+        std::lock_guard guard(_hashLock);
+        // A write or invalidation while reading might have made the fetched objects stale, so they are
+        // only returned, not cached, in that case.
+        if (generation == _modificationGeneration) {
+            for (const auto & entry : fetched) {
+                if ( ! Lru::hasKey(entry.first)) {
+                    Lru::insert(entry.first, entry.second);
+                    _sizeBytes.store(sizeBytes() + calcSize(entry.first, entry.second), std::memory_order_relaxed);
+                    increment_stat(_insert, guard);
+                }
+            }
+        } else {
+            increment_stat(_race, guard);
+        }
+    }
+    for (size_t i : fetchIdx) {
+        auto found = fetched.find(keys[i]);
+        if (found != fetched.end()) {
+            values[i] = V(found->second);
+        } else {
+            _noneExisting.fetch_add(1);
+        }
+    }
+    return values;
+}
+
 template< typename P >
 void
 cache<P>::write(const K & key, V value)
@@ -128,6 +187,7 @@ cache<P>::write(const K & key, V value)
             _sizeBytes.store(sizeBytes() - calcSize(key, (*this)[key]), std::memory_order_relaxed);
             increment_stat(_update, guard);
         }
+        ++_modificationGeneration;
     }
 
     _store.write(key, value);
@@ -136,6 +196,7 @@ cache<P>::write(const K & key, V value)
         (*this)[key] = std::move(value);
         _sizeBytes.store(sizeBytes() + newSize, std::memory_order_relaxed);
         increment_stat(_write, guard);
+        ++_modificationGeneration;
     }
 }
 
@@ -146,6 +207,8 @@ cache<P>::erase(const K & key)
     std::lock_guard storeGuard(getLock(key));
     invalidate(key);
     _store.erase(key);
+    // Drop anything a concurrent read_batch fetched before the backing store was updated.
+    invalidate(key);
 }
 
 template< typename P >
@@ -153,6 +216,7 @@ void
 cache<P>::invalidate(const UniqueLock & guard, const K & key)
 {
     verifyHashLock(guard);
+    ++_modificationGeneration;
     if (Lru::hasKey(key)) {
         _sizeBytes.store(sizeBytes() - calcSize(key, (*this)[key]), std::memory_order_relaxed);
         increment_stat(_invalidate, guard);
@@ -181,7 +245,9 @@ CacheStats
 cache<P>::get_stats() const
 {
     std::lock_guard guard(_hashLock);
-    return CacheStats(getHit(), getMiss(), Lru::size(), sizeBytes(), getInvalidate());
+    CacheStats stats(getHit(), getMiss(), Lru::size(), sizeBytes(), getInvalidate());
+    stats.evictions = getEvictions();
+    return stats;
 }
 
 }
@@ -13,13 +13,15 @@ struct CacheStats {
     size_t elements;
     size_t memory_used;
     size_t invalidations;
+    size_t evictions;
 
     CacheStats()
         : hits(0),
           misses(0),
           elements(0),
           memory_used(0),
-          invalidations(0)
+          invalidations(0),
+          evictions(0)
     { }
 
     CacheStats(size_t hits_, size_t misses_, size_t elements_, size_t memory_used_, size_t invalidations_)
@@ -27,7 +29,8 @@ struct CacheStats {
           misses(misses_),
           elements(elements_),
           memory_used(memory_used_),
-          invalidations(invalidations_)
+          invalidations(invalidations_),
+          evictions(0)
     { }
 
     CacheStats &
@@ -38,6 +41,7 @@ struct CacheStats {
         elements += rhs.elements;
         memory_used += rhs.memory_used;
         invalidations += rhs.invalidations;
+        evictions += rhs.evictions;
         return *this;
     }
 
@@ -578,6 +578,25 @@ Alloc::alloc_with_allocator(const MemoryAllocator* allocator) noexcept
     return Alloc(allocator);
 }
 
+Alloc
+Alloc::mmap_file_private(int fd, size_t offset, size_t sz, size_t capacity)
+{
+    if ((offset % MemoryAllocator::PAGE_SIZE) != 0) {
+        return Alloc();
+    }
+    // Reserve the full capacity as anonymous memory, and map the file content on top of the start of it.
+    PtrAndSize reserved = MMapAllocator::salloc(std::max(sz, capacity), nullptr);
+    if (sz > 0) {
+        void * buf = mmap(reserved.get(), sz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, offset);
+        if (buf == MAP_FAILED) {
+            LOG(warning, "Failed mmaping %zu bytes at offset %zu of fd %d, errno(%d)", sz, offset, fd, errno);
+            MMapAllocator::sfree(reserved);
+            return Alloc();
+        }
+    }
+    return Alloc(&MMapAllocator::getDefault(), reserved);
+}
+
 PtrAndSize::PtrAndSize(void * ptr, size_t sz) noexcept
     : _ptr(ptr), _sz(sz)
 {
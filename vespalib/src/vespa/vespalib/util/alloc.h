@@ -79,11 +79,23 @@ public:
     static Alloc alloc(size_t sz, size_t mmapLimit, size_t alignment=0) noexcept;
     static Alloc alloc() noexcept;
     static Alloc alloc_with_allocator(const MemoryAllocator* allocator) noexcept;
+    /**
+     * Map sz bytes of the open file fd, starting at the page aligned offset, as a private
+     * allocation of at least capacity bytes. Pages are read from the file on demand, and
+     * copied to anonymous memory only when written to. The memory beyond the file content
+     * is zero filled. Later allocations created from this one are anonymous mmaps.
+     * Returns an empty allocation if the file could not be mapped.
+     */
+    static Alloc mmap_file_private(int fd, size_t offset, size_t sz, size_t capacity);
 private:
     Alloc(const MemoryAllocator * allocator, size_t sz) noexcept
         : _alloc(allocator->alloc(sz)),
           _allocator(allocator)
     { }
+    Alloc(const MemoryAllocator * allocator, PtrAndSize alloc) noexcept
+        : _alloc(alloc),
+          _allocator(allocator)
+    { }
     explicit Alloc(const MemoryAllocator * allocator) noexcept
         : _alloc(),
           _allocator(allocator)
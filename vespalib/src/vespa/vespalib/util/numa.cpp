@@ -0,0 +1,137 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numa.h"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#ifndef __APPLE__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace vespalib {
+
+namespace {
+
+bool parse_int(std::string_view str, int &value) {
+    auto res = std::from_chars(str.data(), str.data() + str.size(), value);
+    return (res.ec == std::errc()) && (res.ptr == str.data() + str.size());
+}
+
+void pin_current_thread(const std::vector<int> &cpus) {
+#ifndef __APPLE__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu: cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+    // failing to pin (e.g. due to cpuset restrictions) is not fatal
+    (void) pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#else
+    (void) cpus;
+#endif
+}
+
+}
+
+std::vector<int> parse_cpu_list(std::string_view list) {
+    std::vector<int> result;
+    while (!list.empty()) {
+        auto pos = list.find(',');
+        auto part = list.substr(0, pos);
+        list = (pos == std::string_view::npos) ? std::string_view() : list.substr(pos + 1);
+        while (!part.empty() && (part.back() == '\n' || part.back() == ' ')) {
+            part.remove_suffix(1);
+        }
+        int first = 0;
+        int last = 0;
+        auto dash = part.find('-');
+        if (dash == std::string_view::npos) {
+            if (parse_int(part, first)) {
+                result.push_back(first);
+            }
+        } else if (parse_int(part.substr(0, dash), first) && parse_int(part.substr(dash + 1), last)) {
+            for (int cpu = first; cpu <= last; ++cpu) {
+                result.push_back(cpu);
+            }
+        }
+    }
+    return result;
+}
+
+NumaNodeCpus numa_node_cpus() {
+    std::vector<std::pair<int,std::vector<int>>> nodes;
+    std::error_code ec;
+    for (const auto &entry: std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+        std::string name = entry.path().filename().string();
+        int node_id = 0;
+        if (!name.starts_with("node") || !parse_int(std::string_view(name).substr(4), node_id)) {
+            continue;
+        }
+        std::ifstream file(entry.path() / "cpulist");
+        std::string line;
+        if (std::getline(file, line)) {
+            auto cpus = parse_cpu_list(line);
+            if (!cpus.empty()) {
+                nodes.emplace_back(node_id, std::move(cpus));
+            }
+        }
+    }
+    std::sort(nodes.begin(), nodes.end());
+    NumaNodeCpus result;
+    for (auto &node: nodes) {
+        result.push_back(std::move(node.second));
+    }
+    return result;
+}
+
+Runnable::init_fun_t pin_to_cpus(Runnable::init_fun_t init, std::vector<int> cpus) {
+    if (cpus.empty()) {
+        return init;
+    }
+    return [init, cpus = std::move(cpus)](Runnable &target) {
+        pin_current_thread(cpus);
+        return init(target);
+    };
+}
+
+#ifndef __APPLE__
+struct ScopedCpuPinning::SavedAffinity {
+    cpu_set_t cpu_set;
+};
+#else
+struct ScopedCpuPinning::SavedAffinity {};
+#endif
+
+ScopedCpuPinning::ScopedCpuPinning(const std::vector<int> &cpus)
+    : _saved()
+{
+#ifndef __APPLE__
+    if (cpus.empty()) {
+        return;
+    }
+    auto saved = std::make_unique<SavedAffinity>();
+    if (pthread_getaffinity_np(pthread_self(), sizeof(saved->cpu_set), &saved->cpu_set) == 0) {
+        _saved = std::move(saved);
+        pin_current_thread(cpus);
+    }
+#else
+    (void) cpus;
+#endif
+}
+
+ScopedCpuPinning::~ScopedCpuPinning()
+{
+#ifndef __APPLE__
+    if (_saved) {
+        (void) pthread_setaffinity_np(pthread_self(), sizeof(_saved->cpu_set), &_saved->cpu_set);
+    }
+#endif
+}
+
+} // namespace
@@ -0,0 +1,45 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "runnable.h"
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace vespalib {
+
+using NumaNodeCpus = std::vector<std::vector<int>>;
+
+// Parses a cpu list as found in sysfs (e.g. "0-3,8,10-11") into the
+// list of cpus it contains. Malformed parts of the list are ignored.
+
+std::vector<int> parse_cpu_list(std::string_view list);
+
+// Returns the cpus of each numa node with at least one cpu, ordered
+// by node id. The result is empty if the numa topology is unknown.
+
+NumaNodeCpus numa_node_cpus();
+
+// Wraps an init function inside another init function that pins the
+// thread being started to the given cpus. If no cpus are given, the
+// init function is returned unchanged.
+
+Runnable::init_fun_t pin_to_cpus(Runnable::init_fun_t init, std::vector<int> cpus);
+
+// Pins the calling thread to the given cpus for the lifetime of this
+// object, restoring the previous cpu affinity when destructed. Used
+// to temporarily pin threads that are not owned by the caller. Does
+// nothing if no cpus are given.
+
+class ScopedCpuPinning {
+private:
+    struct SavedAffinity;
+    std::unique_ptr<SavedAffinity> _saved;
+public:
+    explicit ScopedCpuPinning(const std::vector<int> &cpus);
+    ScopedCpuPinning(const ScopedCpuPinning &) = delete;
+    ScopedCpuPinning &operator=(const ScopedCpuPinning &) = delete;
+    ~ScopedCpuPinning();
+};
+
+}
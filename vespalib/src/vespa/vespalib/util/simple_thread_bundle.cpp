@@ -60,12 +60,18 @@ Signal::Signal() noexcept
 {}
 Signal::~Signal() = default;
 
-SimpleThreadBundle::Pool::Pool(size_t bundleSize, init_fun_t init_fun)
+SimpleThreadBundle::Pool::Pool(size_t bundleSize, init_fun_t init_fun, NumaNodeCpus numa_nodes)
     : _lock(),
       _bundleSize(bundleSize),
       _init_fun(init_fun),
+      _numa_nodes(),
+      _next_numa_node(0),
       _bundles()
 {
+    // Pinning to a single node is pointless.
+    if (numa_nodes.size() > 1) {
+        _numa_nodes = std::move(numa_nodes);
+    }
 }
 
 SimpleThreadBundle::Pool::~Pool()
@@ -79,6 +85,7 @@ SimpleThreadBundle::Pool::~Pool()
 SimpleThreadBundle::UP
 SimpleThreadBundle::Pool::obtain()
 {
+    std::vector<int> cpus;
     {
         std::lock_guard guard(_lock);
         if (!_bundles.empty()) {
@@ -86,8 +93,11 @@ SimpleThreadBundle::Pool::obtain()
             _bundles.pop_back();
             return ret;
         }
+        if (!_numa_nodes.empty()) {
+            cpus = _numa_nodes[_next_numa_node++ % _numa_nodes.size()];
+        }
     }
-    return std::make_unique<SimpleThreadBundle>(_bundleSize, _init_fun, USE_SIGNAL_LIST);
+    return std::make_unique<SimpleThreadBundle>(_bundleSize, _init_fun, USE_SIGNAL_LIST, std::move(cpus));
 }
 
 void
@@ -100,11 +110,12 @@ SimpleThreadBundle::Pool::release(SimpleThreadBundle::UP bundle)
 
 //-----------------------------------------------------------------------------
 
-SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Runnable::init_fun_t init_fun, Strategy strategy)
+SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Runnable::init_fun_t init_fun, Strategy strategy, std::vector<int> cpus)
     : _work(),
       _signals(),
       _workers(),
-      _hook()
+      _hook(),
+      _cpus(std::move(cpus))
 {
     if (size_in == 0) {
         throw IllegalArgumentException("size must be greater than 0");
@@ -135,7 +146,7 @@ SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Runnable::init_fun_t init
             _hook = std::move(hook);
         } else {
             size_t signal_idx = (strategy == USE_BROADCAST) ? 0 : (i - 1);
-            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], init_fun, std::move(hook)));
+            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], pin_to_cpus(init_fun, _cpus), std::move(hook)));
         }
     }
 }
@@ -165,6 +176,8 @@ SimpleThreadBundle::run(Runnable* const* targets, size_t cnt)
     if (cnt == 0) {
         return;
     }
+    // The caller performs the first part, so it is kept on the same cpus as the workers while doing so.
+    ScopedCpuPinning pinning(_cpus);
     if (cnt == 1) {
         targets[0]->run();
         return;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "count_down_latch.h"
+#include "numa.h"
 #include "thread.h"
 #include "runnable.h"
 #include "thread_bundle.h"
@@ -94,12 +95,19 @@ public:
     using UP = std::unique_ptr<SimpleThreadBundle>;
     enum Strategy { USE_SIGNAL_LIST, USE_SIGNAL_TREE, USE_BROADCAST };
 
+    /**
+     * When given more than one numa node, each bundle created by the
+     * pool is pinned to the cpus of a single node, spreading bundles
+     * across nodes in round-robin order.
+     **/
     class Pool
     {
     private:
-        std::mutex _lock;
-        size_t     _bundleSize;
-        init_fun_t _init_fun;
+        std::mutex   _lock;
+        size_t       _bundleSize;
+        init_fun_t   _init_fun;
+        NumaNodeCpus _numa_nodes;
+        size_t       _next_numa_node;
         std::vector<SimpleThreadBundle*> _bundles;
 
     public:
@@ -114,7 +122,8 @@ public:
             SimpleThreadBundle::UP  _bundle;
             Pool                   &_pool;
         };
-        Pool(size_t bundleSize, init_fun_t init_fun);
+        Pool(size_t bundleSize, init_fun_t init_fun, NumaNodeCpus numa_nodes);
+        Pool(size_t bundleSize, init_fun_t init_fun) : Pool(bundleSize, std::move(init_fun), NumaNodeCpus()) {}
         explicit Pool(size_t bundleSize) : Pool(bundleSize, Runnable::default_init_function) {}
         ~Pool();
         Guard getBundle() { return Guard(*this); }
@@ -137,9 +146,13 @@ private:
     std::vector<Signal>     _signals;
     std::vector<Worker::UP> _workers;
     Runnable::UP            _hook;
+    std::vector<int>        _cpus;
 
 public:
-    SimpleThreadBundle(size_t size, init_fun_t init_fun, Strategy strategy);
+    // All threads (including the caller while running targets) are pinned to the given cpus, if any.
+    SimpleThreadBundle(size_t size, init_fun_t init_fun, Strategy strategy, std::vector<int> cpus);
+    SimpleThreadBundle(size_t size, init_fun_t init_fun, Strategy strategy)
+      : SimpleThreadBundle(size, std::move(init_fun), strategy, std::vector<int>()) {}
     SimpleThreadBundle(size_t size, Strategy strategy)
       : SimpleThreadBundle(size, Runnable::default_init_function, strategy) {}
     explicit SimpleThreadBundle(size_t size)
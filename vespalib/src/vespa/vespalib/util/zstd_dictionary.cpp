@@ -0,0 +1,125 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "zstd_dictionary.h"
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <stdexcept>
+#include <zstd.h>
+#include <zdict.h>
+
+namespace vespalib::compression {
+
+namespace {
+
+class CompressContext {
+public:
+    CompressContext() : _ctx(ZSTD_createCCtx()) {}
+    ~CompressContext() { ZSTD_freeCCtx(_ctx); }
+    ZSTD_CCtx * get() { return _ctx; }
+private:
+    ZSTD_CCtx * _ctx;
+};
+class DecompressContext {
+public:
+    DecompressContext() : _ctx(ZSTD_createDCtx()) {}
+    ~DecompressContext() { ZSTD_freeDCtx(_ctx); }
+    ZSTD_DCtx * get() { return _ctx; }
+private:
+    ZSTD_DCtx * _ctx;
+};
+
+thread_local std::unique_ptr<CompressContext>  _tlCompressState;
+thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
+
+}
+
+struct ZStdDictionary::Digested {
+    Digested(const std::vector<char> & content, int compressionLevel)
+        : cdict(ZSTD_createCDict(content.data(), content.size(), compressionLevel)),
+          ddict(ZSTD_createDDict(content.data(), content.size()))
+    { }
+    ~Digested() {
+        ZSTD_freeCDict(cdict);
+        ZSTD_freeDDict(ddict);
+    }
+    ZSTD_CDict * cdict;
+    ZSTD_DDict * ddict;
+};
+
+ZStdDictionary::ZStdDictionary(ConstBufferRef content, int compressionLevel)
+    : _content(content.c_str(), content.c_str() + content.size()),
+      _id(ZDICT_getDictID(_content.data(), _content.size())),
+      _digested()
+{
+    if (_id == 0) {
+        throw std::runtime_error(make_string("Not a zstd dictionary (%zu bytes)", _content.size()));
+    }
+    _digested = std::make_unique<Digested>(_content, compressionLevel);
+    if ((_digested->cdict == nullptr) || (_digested->ddict == nullptr)) {
+        throw std::runtime_error(make_string("Failed digesting zstd dictionary %u", _id));
+    }
+}
+
+ZStdDictionary::~ZStdDictionary() = default;
+
+ZStdDictionary::SP
+ZStdDictionary::train(const std::vector<ConstBufferRef> & samples, size_t maxSize, int compressionLevel)
+{
+    std::vector<char> samplesBuffer;
+    std::vector<size_t> sampleSizes;
+    sampleSizes.reserve(samples.size());
+    for (const ConstBufferRef & sample : samples) {
+        if (sample.size() > 0) {
+            samplesBuffer.insert(samplesBuffer.end(), sample.c_str(), sample.c_str() + sample.size());
+            sampleSizes.push_back(sample.size());
+        }
+    }
+    if (sampleSizes.empty() || (maxSize == 0)) {
+        return {};
+    }
+    std::vector<char> dictionary(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samplesBuffer.data(),
+                                      sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return {};
+    }
+    return std::make_shared<ZStdDictionary>(ConstBufferRef(dictionary.data(), sz), compressionLevel);
+}
+
+CompressionConfig::Type
+ZStdDictionary::compress(CompressionConfig config, const ConstBufferRef & org, DataBuffer & dest) const
+{
+    if (org.size() >= config.minSize) {
+        if ( ! _tlCompressState) {
+            _tlCompressState = std::make_unique<CompressContext>();
+        }
+        dest.ensureFree(ZSTD_compressBound(org.size()));
+        size_t sz = ZSTD_compress_usingCDict(_tlCompressState->get(), dest.getFree(), dest.getFreeLen(),
+                                             org.c_str(), org.size(), _digested->cdict);
+        if ( ! ZSTD_isError(sz) && (sz < ((org.size() * config.threshold)/100))) {
+            dest.moveFreeToData(sz);
+            return CompressionConfig::ZSTD;
+        }
+    }
+    dest.writeBytes(org.c_str(), org.size());
+    return CompressionConfig::NONE;
+}
+
+void
+ZStdDictionary::decompress(size_t uncompressedLen, const ConstBufferRef & org, DataBuffer & dest) const
+{
+    if ( ! _tlDecompressState) {
+        _tlDecompressState = std::make_unique<DecompressContext>();
+    }
+    dest.ensureFree(uncompressedLen);
+    size_t sz = ZSTD_decompress_usingDDict(_tlDecompressState->get(), dest.getFree(), uncompressedLen,
+                                           org.c_str(), org.size(), _digested->ddict);
+    if (ZSTD_isError(sz) || (sz != uncompressedLen)) {
+        throw std::runtime_error(make_string("Failed decompressing %zu bytes with zstd dictionary %u, wanted %zu: %s",
+                                             org.size(), _id, uncompressedLen,
+                                             ZSTD_isError(sz) ? ZSTD_getErrorName(sz) : "wrong size"));
+    }
+    dest.moveFreeToData(sz);
+}
+
+}
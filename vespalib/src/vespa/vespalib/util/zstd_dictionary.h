@@ -0,0 +1,66 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "compressionconfig.h"
+#include "buffer.h"
+#include <memory>
+#include <vector>
+
+namespace vespalib { class DataBuffer; }
+
+namespace vespalib::compression {
+
+/**
+ * A zstd dictionary trained on samples of many small and similar blobs.
+ * Compressing small buffers with a shared dictionary gives far better
+ * ratios than compressing each of them on its own, as the common content
+ * is found in the dictionary instead of being repeated in every buffer.
+ *
+ * The digested dictionary is immutable and can be used by many threads.
+ */
+class ZStdDictionary
+{
+public:
+    using SP = std::shared_ptr<const ZStdDictionary>;
+
+    /**
+     * Create a dictionary from the serialized form, as returned by content().
+     * Throws std::runtime_error if the content is not a zstd dictionary.
+     * @param compressionLevel is the level used when compressing with this dictionary.
+     */
+    ZStdDictionary(ConstBufferRef content, int compressionLevel);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator = (const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+
+    /**
+     * Train a dictionary of at most maxSize bytes from the given samples.
+     * Returns an empty pointer if there is not enough sample data to train on.
+     */
+    static SP train(const std::vector<ConstBufferRef> & samples, size_t maxSize, int compressionLevel);
+
+    uint32_t id() const noexcept { return _id; }
+    ConstBufferRef content() const noexcept { return {_content.data(), _content.size()}; }
+    size_t size() const noexcept { return _content.size(); }
+
+    /**
+     * Compress org with this dictionary and append it to dest. Falls back to
+     * appending the uncompressed data if the criteria in the config are not
+     * met, in the same way as compress() does.
+     * @return ZSTD if compressed, NONE otherwise.
+     */
+    CompressionConfig::Type compress(CompressionConfig config, const ConstBufferRef & org, DataBuffer & dest) const;
+
+    /**
+     * Decompress org, compressed with this dictionary, and append it to dest.
+     * Throws std::runtime_error if the data can not be decompressed.
+     */
+    void decompress(size_t uncompressedLen, const ConstBufferRef & org, DataBuffer & dest) const;
+private:
+    struct Digested;
+    std::vector<char>         _content;
+    uint32_t                  _id;
+    std::unique_ptr<Digested> _digested;
+};
+
+}